@@ -82,6 +82,11 @@
 #  define HAVE_WAIT4    1
 #endif
 
+#if !defined(__APPLE__)
+/* vfork(2) is deprecated on Darwin */
+#  define HAVE_VFORK    1
+#endif
+
 #if defined(__APPLE__)
 /* Up until OS X 10.7, waitid(P_ALL, ...) will return success, but will not
  * fill in the details of the dead child. That means waitid is not useful to us.
@@ -718,6 +723,66 @@ err_free:
     return -1;
 }
 
+#ifdef HAVE_VFORK
+static int forkfd_vfork_fallback(int flags, pid_t *ppid, int (*childFn)(void *), void *token)
+{
+    Header *header;
+    ProcessInfo *info;
+    struct pipe_payload payload;
+    pid_t pid;
+    int death_pipe[2];
+    int ret;
+
+    (void) pthread_once(&forkfd_initialization, forkfd_initialize);
+
+    info = allocateInfo(&header);
+    if (info == NULL) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    /* create the pipe before we fork */
+    if (create_pipe(death_pipe, flags) == -1)
+        goto err_free; /* failed to create the pipes, pass errno */
+
+    /*
+     * The parent process is suspended until the child has called execve(2) or
+     * _exit(2), so we cannot make the child wait for us to store its PID, like
+     * forkfd_fork_fallback() does. Instead, we check if it has already exited
+     * after storing it, like spawnfd() does.
+     */
+    pid = vfork();
+    if (pid == 0) {
+        /* this is the child process: it shares its memory with the parent, so
+         * it must not touch anything but its own file descriptors */
+        EINTR_LOOP(ret, close(death_pipe[0]));
+        EINTR_LOOP(ret, close(death_pipe[1]));
+        _exit(childFn(token));
+    }
+    if (pid == -1)
+        goto err_close; /* failed to fork, pass errno */
+    if (ppid)
+        *ppid = pid;
+
+    info->deathPipe = death_pipe[1];
+    ffd_atomic_store(&info->pid, pid, FFD_ATOMIC_RELEASE);
+
+    /* check if the child has already exited */
+    if (tryReaping(pid, &payload))
+        notifyAndFreeInfo(header, info, &payload);
+
+    return death_pipe[0];
+
+err_close:
+    EINTR_LOOP(ret, close(death_pipe[0]));
+    EINTR_LOOP(ret, close(death_pipe[1]));
+err_free:
+    /* free the info pointer */
+    freeInfo(header, info);
+    return -1;
+}
+#endif
+
 /**
  * @brief forkfd returns a file descriptor representing a child process
  * @return a file descriptor, or -1 in case of failure
@@ -743,6 +808,11 @@ err_free:
  * fork(), such as not calling the functions registered with pthread_atfork().
  * If that's necessary, pass this flag.
  *
+ * @li @c FFD_VFORK_SEMANTICS Only used by vforkfd(). Tell it that the child
+ * function is safe to run in a child process that shares the memory of the
+ * parent, so that vfork(2) may be used where no system implementation is
+ * available.
+ *
  * The file descriptor returned by forkfd() supports the following operations:
  *
  * @li read(2) When the child process exits, then the buffer supplied to
@@ -798,7 +868,10 @@ int forkfd(int flags, pid_t *ppid)
  * implementation.
  *
  * Currently, only on Linux will this function have any behavior different from
- * forkfd(). In all other systems, it is equivalent to the following code:
+ * forkfd(), unless the @c FFD_VFORK_SEMANTICS flag is passed. In that case, if
+ * there is no system implementation available, vfork(2) is used instead of
+ * fork(2), which avoids copying the address space of large parent processes.
+ * Otherwise, it is equivalent to the following code:
  *
  * @code
  *     int ffd = forkfd(flags, &pid);
@@ -814,6 +887,10 @@ int vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token)
         fd = system_vforkfd(flags, ppid, childFn, token, &system_forkfd_works);
         if (system_forkfd_works || disable_fork_fallback())
             return fd;
+#ifdef HAVE_VFORK
+        if (flags & FFD_VFORK_SEMANTICS)
+            return forkfd_vfork_fallback(flags, ppid, childFn, token);
+#endif
     }
 
     fd = forkfd_fork_fallback(flags, ppid);
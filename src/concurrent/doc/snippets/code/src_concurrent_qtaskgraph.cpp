@@ -0,0 +1,16 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+QtConcurrent::QTaskGraph graph;
+const auto decodeAudio = graph.addTask([&] { audio = decode(audioInput); });
+const auto decodeVideo = graph.addTask([&] { video = decode(videoInput); }, 10);
+const auto transform = graph.addTask([&] { video = transformFrames(video); }, 20);
+const auto encode = graph.addTask([&] { output = encode(audio, video); }, 5);
+
+graph.addDependency(transform, decodeVideo);
+graph.addDependency(encode, decodeAudio);
+graph.addDependency(encode, transform);
+
+QFuture<void> future = graph.run();
+//! [0]
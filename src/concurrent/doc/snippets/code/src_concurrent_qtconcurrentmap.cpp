@@ -185,3 +185,21 @@ QList<QImage> collage = QtConcurrent::mappedReduced(images,
         }
    ).results();
 //! [17]
+
+//! [18]
+QList<float> samples = ...;
+QtConcurrent::blockingMapBlocks(samples, [gain](auto begin, auto end) {
+    for (auto it = begin; it != end; ++it)
+        *it *= gain;
+}, 4096);
+//! [18]
+
+//! [19]
+const double sum = QtConcurrent::blockingMappedReducedBlocks(samples.cbegin(), samples.cend(),
+        [](auto begin, auto end) {
+            return std::accumulate(begin, end, 0.0);
+        },
+        [](double &result, double partial) {
+            result += partial;
+        });
+//! [19]
@@ -0,0 +1,360 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qtaskgraph.h"
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_QDOC)
+
+#include <QtCore/qexception.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qthreadpool.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtConcurrent {
+
+/*!
+    \class QtConcurrent::QTaskGraph
+    \inmodule QtConcurrent
+    \since 6.5
+    \brief The QTaskGraph class runs a set of tasks with dependencies between
+    them on a thread pool.
+    \ingroup thread
+    \reentrant
+
+    A task graph is a directed acyclic graph of functions. Each task is added
+    with addTask(), which returns its index in the graph, and
+    addDependency() declares that a task may only start after another one has
+    finished. run() then executes the whole graph on a QThreadPool and returns
+    a QFuture that finishes after the last task.
+
+    \snippet code/src_concurrent_qtaskgraph.cpp 0
+
+    Each task keeps a counter of the dependencies it still waits for. When a
+    task finishes, the thread that ran it decrements the counters of the
+    tasks that depend on it, continues directly with one of the tasks that
+    became ready, and hands the other ones over to the thread pool. Tasks are
+    prioritized by the cost of the longest chain of tasks that depends on
+    them, so that the critical path of the graph is dispatched first. The cost
+    of each task is an estimate passed to addTask().
+
+    Canceling the returned future cancels the graph as a unit: tasks that have
+    not started yet are not run anymore. If a task throws an exception, the
+    exception is reported to the future and the graph is canceled.
+
+    QTaskGraph is implicitly shared; modifying a graph while it runs does not
+    affect that run.
+
+    \sa QtConcurrent::task(), QFuture, QThreadPool
+*/
+
+class QTaskGraphPrivate : public QSharedData
+{
+public:
+    struct Task
+    {
+        std::function<void()> function;
+        QList<qsizetype> dependents;
+        int cost = 1;
+        int dependencyCount = 0;
+    };
+
+    QList<Task> tasks;
+};
+
+namespace {
+
+class TaskGraphRun
+{
+public:
+    TaskGraphRun(const QExplicitlySharedDataPointer<QTaskGraphPrivate> &graph, QThreadPool *pool)
+        : graph(graph),
+          pool(pool),
+          pendingDependencies(new QAtomicInt[graph->tasks.size()]),
+          remaining(graph->tasks.size())
+    {
+        for (qsizetype i = 0; i < graph->tasks.size(); ++i)
+            pendingDependencies[i].storeRelaxed(graph->tasks.at(i).dependencyCount);
+    }
+
+    bool computePriorities();
+    void dispatch(const QSharedPointer<TaskGraphRun> &self, qsizetype task);
+    void execute(const QSharedPointer<TaskGraphRun> &self, qsizetype task);
+
+    const QExplicitlySharedDataPointer<QTaskGraphPrivate> graph;
+    QThreadPool *const pool;
+    const std::unique_ptr<QAtomicInt[]> pendingDependencies;
+    QAtomicInteger<qsizetype> remaining;
+    QList<int> priorities;
+    QFutureInterface<void> futureInterface;
+
+private:
+    void runTask(qsizetype task);
+};
+
+class TaskGraphRunnable : public QRunnable
+{
+public:
+    TaskGraphRunnable(const QSharedPointer<TaskGraphRun> &state, qsizetype task)
+        : state(state), task(task)
+    {
+    }
+
+    void run() override { state->execute(state, task); }
+
+private:
+    const QSharedPointer<TaskGraphRun> state;
+    const qsizetype task;
+};
+
+/*
+    Computes, for each task, the cost of the most expensive chain of tasks
+    starting with it. Returns false if the graph has a cycle.
+*/
+bool TaskGraphRun::computePriorities()
+{
+    const auto &tasks = graph->tasks;
+    const qsizetype count = tasks.size();
+
+    // Kahn's algorithm; order doubles as the queue of ready tasks
+    QList<qsizetype> order;
+    order.reserve(count);
+    QList<int> dependencies(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        dependencies[i] = tasks.at(i).dependencyCount;
+        if (dependencies[i] == 0)
+            order.append(i);
+    }
+    for (qsizetype i = 0; i < order.size(); ++i) {
+        for (qsizetype dependent : tasks.at(order.at(i)).dependents) {
+            if (--dependencies[dependent] == 0)
+                order.append(dependent);
+        }
+    }
+    if (order.size() != count)
+        return false;
+
+    QList<qint64> chainCost(count);
+    for (auto it = order.crbegin(); it != order.crend(); ++it) {
+        const auto &task = tasks.at(*it);
+        qint64 longestDependent = 0;
+        for (qsizetype dependent : task.dependents)
+            longestDependent = std::max(longestDependent, chainCost.at(dependent));
+        chainCost[*it] = task.cost + longestDependent;
+    }
+
+    priorities.resize(count);
+    for (qsizetype i = 0; i < count; ++i)
+        priorities[i] = int(std::min<qint64>(chainCost.at(i), std::numeric_limits<int>::max()));
+    return true;
+}
+
+void TaskGraphRun::dispatch(const QSharedPointer<TaskGraphRun> &self, qsizetype task)
+{
+    pool->start(new TaskGraphRunnable(self, task), priorities.at(task));
+}
+
+void TaskGraphRun::runTask(qsizetype task)
+{
+    if (futureInterface.isCanceled())
+        return;
+
+#ifndef QT_NO_EXCEPTIONS
+    try {
+#endif
+        graph->tasks.at(task).function();
+#ifndef QT_NO_EXCEPTIONS
+    } catch (QException &e) {
+        futureInterface.reportException(e);
+    } catch (...) {
+        futureInterface.reportException(QUnhandledException(std::current_exception()));
+    }
+#endif
+}
+
+void TaskGraphRun::execute(const QSharedPointer<TaskGraphRun> &self, qsizetype task)
+{
+    while (task >= 0) {
+        runTask(task);
+
+        // Continue with the most critical of the tasks that became ready,
+        // and let the pool run the others.
+        qsizetype next = -1;
+        for (qsizetype dependent : graph->tasks.at(task).dependents) {
+            if (!pendingDependencies[dependent].deref()) {
+                if (next < 0) {
+                    next = dependent;
+                } else if (priorities.at(dependent) > priorities.at(next)) {
+                    dispatch(self, next);
+                    next = dependent;
+                } else {
+                    dispatch(self, dependent);
+                }
+            }
+        }
+
+        if (remaining.fetchAndSubOrdered(1) == 1)
+            futureInterface.reportFinished();
+        task = next;
+    }
+}
+
+} // unnamed namespace
+
+} // namespace QtConcurrent
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QtConcurrent::QTaskGraphPrivate)
+
+namespace QtConcurrent {
+
+/*!
+    Constructs an empty task graph.
+*/
+QTaskGraph::QTaskGraph()
+    : d(new QTaskGraphPrivate)
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QTaskGraph::QTaskGraph(const QTaskGraph &other) = default;
+
+/*!
+    \fn QtConcurrent::QTaskGraph::QTaskGraph(QTaskGraph &&other)
+
+    Move-constructs a task graph from \a other.
+
+    \note The moved-from object \a other is placed in a
+    partially-formed state, in which the only valid operations are
+    destruction and assignment of a new value.
+*/
+
+/*!
+    Assigns \a other to this task graph.
+*/
+QTaskGraph &QTaskGraph::operator=(const QTaskGraph &other) = default;
+
+/*!
+    \fn QTaskGraph &QtConcurrent::QTaskGraph::operator=(QTaskGraph &&other)
+
+    Move-assigns \a other to this task graph.
+*/
+
+/*!
+    \fn void QtConcurrent::QTaskGraph::swap(QTaskGraph &other)
+
+    Swaps this task graph with \a other. This operation is very fast and
+    never fails.
+*/
+
+/*!
+    Destroys the task graph. Runs in progress are not affected.
+*/
+QTaskGraph::~QTaskGraph() = default;
+
+/*!
+    Adds \a function as a new task to the graph, and returns its index.
+
+    \a cost is an estimate of how long the task takes to run, relative to the
+    other tasks of the graph. It is used to dispatch the tasks on the critical
+    path first.
+
+    \sa addDependency()
+*/
+qsizetype QTaskGraph::addTask(std::function<void()> function, int cost)
+{
+    d.detach();
+    QTaskGraphPrivate::Task task;
+    task.function = std::move(function);
+    task.cost = std::max(cost, 0);
+    d->tasks.append(std::move(task));
+    return d->tasks.size() - 1;
+}
+
+/*!
+    Makes the task with index \a task depend on the task with index \a
+    dependency: it only starts after \a dependency has finished.
+
+    Returns \c false if either index is not valid, or if both are the same
+    task. Cycles spanning several tasks are detected by run().
+*/
+bool QTaskGraph::addDependency(qsizetype task, qsizetype dependency)
+{
+    const qsizetype count = size();
+    if (task < 0 || task >= count || dependency < 0 || dependency >= count || task == dependency) {
+        qWarning("QTaskGraph::addDependency: Invalid tasks %lld and %lld",
+                 qlonglong(task), qlonglong(dependency));
+        return false;
+    }
+    d.detach();
+    d->tasks[dependency].dependents.append(task);
+    ++d->tasks[task].dependencyCount;
+    return true;
+}
+
+/*!
+    Returns the number of tasks in the graph.
+*/
+qsizetype QTaskGraph::size() const
+{
+    return d->tasks.size();
+}
+
+/*!
+    \fn bool QtConcurrent::QTaskGraph::isEmpty() const
+
+    Returns \c true if the graph has no task.
+*/
+
+/*!
+    Runs all tasks of the graph on \a pool, or on QThreadPool::globalInstance()
+    if \a pool is \nullptr, and returns a future that finishes when all of them
+    have finished.
+
+    If the graph has a cycle, no task is run and the returned future is
+    canceled.
+*/
+QFuture<void> QTaskGraph::run(QThreadPool *pool) const
+{
+    if (isEmpty())
+        return QtFuture::makeReadyFuture();
+
+    if (!pool)
+        pool = QThreadPool::globalInstance();
+
+    auto state = QSharedPointer<TaskGraphRun>::create(d, pool);
+    if (!state->computePriorities()) {
+        qWarning("QTaskGraph::run: The graph has a cycle");
+        return QFuture<void>();
+    }
+
+    state->futureInterface.reportStarted();
+    QFuture<void> future = state->futureInterface.future();
+
+    QList<qsizetype> ready;
+    for (qsizetype i = 0; i < size(); ++i) {
+        if (d->tasks.at(i).dependencyCount == 0)
+            ready.append(i);
+    }
+    std::stable_sort(ready.begin(), ready.end(), [&state](qsizetype lhs, qsizetype rhs) {
+        return state->priorities.at(lhs) > state->priorities.at(rhs);
+    });
+    for (qsizetype task : std::as_const(ready))
+        state->dispatch(state, task);
+
+    return future;
+}
+
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
@@ -0,0 +1,61 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTCONCURRENT_TASKGRAPH_H
+#define QTCONCURRENT_TASKGRAPH_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_QDOC)
+
+#include <QtCore/qfuture.h>
+#include <QtCore/qshareddata.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+class QThreadPool;
+
+namespace QtConcurrent {
+class QTaskGraphPrivate;
+}
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QtConcurrent::QTaskGraphPrivate, Q_CONCURRENT_EXPORT)
+
+namespace QtConcurrent {
+
+class Q_CONCURRENT_EXPORT QTaskGraph
+{
+public:
+    QTaskGraph();
+    QTaskGraph(const QTaskGraph &other);
+    QTaskGraph(QTaskGraph &&other) noexcept = default;
+    QTaskGraph &operator=(const QTaskGraph &other);
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QTaskGraph)
+    ~QTaskGraph();
+
+    void swap(QTaskGraph &other) noexcept { d.swap(other.d); }
+
+    qsizetype addTask(std::function<void()> function, int cost = 1);
+    bool addDependency(qsizetype task, qsizetype dependency);
+
+    qsizetype size() const;
+    bool isEmpty() const { return size() == 0; }
+
+    [[nodiscard]] QFuture<void> run(QThreadPool *pool = nullptr) const;
+
+private:
+    QExplicitlySharedDataPointer<QTaskGraphPrivate> d;
+};
+
+inline void swap(QTaskGraph &lhs, QTaskGraph &rhs) noexcept { lhs.swap(rhs); }
+
+} // namespace QtConcurrent
+
+Q_DECLARE_TYPEINFO(QtConcurrent::QTaskGraph, Q_RELOCATABLE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // !defined(QT_NO_CONCURRENT)
+
+#endif // QTCONCURRENT_TASKGRAPH_H
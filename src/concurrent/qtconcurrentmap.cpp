@@ -57,6 +57,24 @@
   \internal
 */
 
+/*!
+  \class QtConcurrent::BlockIterateKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::BlockMapKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::BlockMappedReducedKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
 /*!
   \fn [qtconcurrentmapkernel-1] ThreadEngineStarter<void> QtConcurrent::startMap(Iterator begin, Iterator end, Functor &&functor)
   \internal
@@ -92,6 +110,16 @@
   \internal
 */
 
+/*!
+  \fn [qtconcurrentmapkernel-8] ThreadEngineStarter<void> QtConcurrent::startMapBlocks(QThreadPool *pool, Iterator begin, Iterator end, BlockFunctor &&functor, int grainSize)
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentmapkernel-9] ThreadEngineStarter<ResultType> QtConcurrent::startMappedReducedBlocks(QThreadPool *pool, Iterator begin, Iterator end, BlockFunctor &&blockFunctor, ReduceFunctor &&reduceFunctor, int grainSize)
+  \internal
+*/
+
 /*!
     \enum QtConcurrent::ReduceOption
     This enum specifies the order of which results from the map or filter
@@ -281,6 +309,29 @@
     value for the \e{width} and the \e{transformation mode}:
 
     \snippet code/src_concurrent_qtconcurrentmap.cpp 13
+
+    \section2 Processing Blocks of Items
+
+    For cheap operations on large sequences, calling the map function once
+    for each item can cost more than the operation itself.
+    QtConcurrent::mapBlocks() instead calls the function once for each
+    contiguous block of items, passing iterators to the beginning and the end
+    of the block, so that the function can process the items in a tight loop
+    that the compiler can vectorize. The \e{grain size} sets the number of
+    items in a block; if it is 0, the block size is adapted to the time spent
+    in the function.
+
+    \snippet code/src_concurrent_qtconcurrentmap.cpp 18
+
+    QtConcurrent::mappedReducedBlocks() reduces the results of the block
+    function. Each thread reduces the results of its blocks into an
+    accumulator of its own, and the accumulators are only combined when the
+    threads are done, so the reduce function must not depend on the order of
+    the results.
+
+    \snippet code/src_concurrent_qtconcurrentmap.cpp 19
+
+    These functions require random access iterators.
 */
 
 /*!
@@ -744,3 +795,158 @@
 
   \sa blockingMappedReduced(), {Concurrent Map and Map-Reduce}
 */
+
+/*!
+    \fn template <typename Sequence, typename BlockFunctor> QFuture<void> QtConcurrent::mapBlocks(QThreadPool *pool, Sequence &&sequence, BlockFunctor &&function, int grainSize)
+    \since 6.5
+
+    Calls \a function once for each block of contiguous items in \a sequence,
+    with iterators to the beginning and the end of the block.
+    All calls to \a function are invoked from the threads taken from the QThreadPool \a pool.
+    Each block has \a grainSize items, except possibly the last one. If
+    \a grainSize is 0, the block size is adapted to the time spent in
+    \a function.
+
+    \sa map(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BlockFunctor> QFuture<void> QtConcurrent::mapBlocks(Sequence &&sequence, BlockFunctor &&function, int grainSize)
+    \since 6.5
+
+    Calls \a function once for each block of contiguous items in \a sequence,
+    with iterators to the beginning and the end of the block. Each block has
+    \a grainSize items, except possibly the last one. If \a grainSize is 0,
+    the block size is adapted to the time spent in \a function.
+
+    \sa map(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BlockFunctor> QFuture<void> QtConcurrent::mapBlocks(QThreadPool *pool, Iterator begin, Iterator end, BlockFunctor &&function, int grainSize)
+    \since 6.5
+
+    Calls \a function once for each block of contiguous items from \a begin
+    to \a end, with iterators to the beginning and the end of the block.
+    All calls to \a function are invoked from the threads taken from the QThreadPool \a pool.
+    Each block has \a grainSize items, except possibly the last one. If
+    \a grainSize is 0, the block size is adapted to the time spent in
+    \a function.
+
+    \sa map(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BlockFunctor> QFuture<void> QtConcurrent::mapBlocks(Iterator begin, Iterator end, BlockFunctor &&function, int grainSize)
+    \since 6.5
+
+    Calls \a function once for each block of contiguous items from \a begin
+    to \a end, with iterators to the beginning and the end of the block.
+    Each block has \a grainSize items, except possibly the last one. If
+    \a grainSize is 0, the block size is adapted to the time spent in
+    \a function.
+
+    \sa map(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BlockFunctor> void QtConcurrent::blockingMapBlocks(QThreadPool *pool, Sequence &&sequence, BlockFunctor &&function, int grainSize)
+    \since 6.5
+
+    Calls \a function once for each block of \a grainSize contiguous items in
+    \a sequence, using threads from \a pool.
+
+    \note This function will block until all items in the sequence have been processed.
+
+    \sa mapBlocks(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BlockFunctor> void QtConcurrent::blockingMapBlocks(Sequence &&sequence, BlockFunctor &&function, int grainSize)
+    \since 6.5
+
+    Calls \a function once for each block of \a grainSize contiguous items in
+    \a sequence.
+
+    \note This function will block until all items in the sequence have been processed.
+
+    \sa mapBlocks(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BlockFunctor> void QtConcurrent::blockingMapBlocks(QThreadPool *pool, Iterator begin, Iterator end, BlockFunctor &&function, int grainSize)
+    \since 6.5
+
+    Calls \a function once for each block of \a grainSize contiguous items
+    from \a begin to \a end, using threads from \a pool.
+
+    \note This function will block until all items have been processed.
+
+    \sa mapBlocks(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BlockFunctor> void QtConcurrent::blockingMapBlocks(Iterator begin, Iterator end, BlockFunctor &&function, int grainSize)
+    \since 6.5
+
+    Calls \a function once for each block of \a grainSize contiguous items
+    from \a begin to \a end.
+
+    \note This function will block until all items have been processed.
+
+    \sa mapBlocks(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BlockFunctor, typename ReduceFunctor, typename ResultType> QFuture<ResultType> QtConcurrent::mappedReducedBlocks(QThreadPool *pool, Iterator begin, Iterator end, BlockFunctor &&blockFunction, ReduceFunctor &&reduceFunction, int grainSize)
+    \since 6.5
+
+    Calls \a blockFunction once for each block of \a grainSize contiguous
+    items from \a begin to \a end, using threads from \a pool, and combines
+    the returned values with \a reduceFunction, which has the form
+    \c{void reduce(ResultType &result, const ResultType &partial)}.
+
+    Each thread reduces the values returned for its blocks on its own, without
+    locking, and the results of the threads are combined when they finish.
+    The order of the reduction is therefore undefined. If the range is empty,
+    the result is a default-constructed ResultType.
+
+    \sa mappedReduced(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BlockFunctor, typename ReduceFunctor, typename ResultType> QFuture<ResultType> QtConcurrent::mappedReducedBlocks(Iterator begin, Iterator end, BlockFunctor &&blockFunction, ReduceFunctor &&reduceFunction, int grainSize)
+    \since 6.5
+
+    Calls \a blockFunction once for each block of \a grainSize contiguous
+    items from \a begin to \a end, and combines the returned values with
+    \a reduceFunction, in an undefined order.
+
+    \sa mappedReduced(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BlockFunctor, typename ReduceFunctor, typename ResultType> ResultType QtConcurrent::blockingMappedReducedBlocks(QThreadPool *pool, Iterator begin, Iterator end, BlockFunctor &&blockFunction, ReduceFunctor &&reduceFunction, int grainSize)
+    \since 6.5
+
+    Calls \a blockFunction once for each block of \a grainSize contiguous
+    items from \a begin to \a end, using threads from \a pool, and combines
+    the returned values with \a reduceFunction, in an undefined order.
+
+    \note This function will block until all items have been processed.
+
+    \sa mappedReducedBlocks(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BlockFunctor, typename ReduceFunctor, typename ResultType> ResultType QtConcurrent::blockingMappedReducedBlocks(Iterator begin, Iterator end, BlockFunctor &&blockFunction, ReduceFunctor &&reduceFunction, int grainSize)
+    \since 6.5
+
+    Calls \a blockFunction once for each block of \a grainSize contiguous
+    items from \a begin to \a end, and combines the returned values with
+    \a reduceFunction, in an undefined order.
+
+    \note This function will block until all items have been processed.
+
+    \sa mappedReducedBlocks(), {Concurrent Map and Map-Reduce}
+*/
@@ -813,6 +813,135 @@ auto blockingMapped(Iterator begin, Iterator end, MapFunctor &&map)
                                                  QtPrivate::PushBackWrapper(), OrderedReduce);
 }
 
+// mapBlocks() on sequences
+template <typename Sequence, typename BlockFunctor>
+QFuture<void> mapBlocks(QThreadPool *pool, Sequence &&sequence, BlockFunctor &&function,
+                        int grainSize = 0)
+{
+    return startMapBlocks(pool, sequence.begin(), sequence.end(),
+                          std::forward<BlockFunctor>(function), grainSize);
+}
+
+template <typename Sequence, typename BlockFunctor>
+QFuture<void> mapBlocks(Sequence &&sequence, BlockFunctor &&function, int grainSize = 0)
+{
+    return startMapBlocks(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                          std::forward<BlockFunctor>(function), grainSize);
+}
+
+// mapBlocks() on iterators
+template <typename Iterator, typename BlockFunctor>
+QFuture<void> mapBlocks(QThreadPool *pool, Iterator begin, Iterator end, BlockFunctor &&function,
+                        int grainSize = 0)
+{
+    return startMapBlocks(pool, begin, end, std::forward<BlockFunctor>(function), grainSize);
+}
+
+template <typename Iterator, typename BlockFunctor>
+QFuture<void> mapBlocks(Iterator begin, Iterator end, BlockFunctor &&function, int grainSize = 0)
+{
+    return startMapBlocks(QThreadPool::globalInstance(), begin, end,
+                          std::forward<BlockFunctor>(function), grainSize);
+}
+
+// blockingMapBlocks() on sequences
+template <typename Sequence, typename BlockFunctor>
+void blockingMapBlocks(QThreadPool *pool, Sequence &&sequence, BlockFunctor &&function,
+                       int grainSize = 0)
+{
+    QFuture<void> future = startMapBlocks(pool, sequence.begin(), sequence.end(),
+                                          std::forward<BlockFunctor>(function), grainSize);
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename BlockFunctor>
+void blockingMapBlocks(Sequence &&sequence, BlockFunctor &&function, int grainSize = 0)
+{
+    QFuture<void> future = startMapBlocks(QThreadPool::globalInstance(), sequence.begin(),
+                                          sequence.end(), std::forward<BlockFunctor>(function),
+                                          grainSize);
+    future.waitForFinished();
+}
+
+// blockingMapBlocks() on iterators
+template <typename Iterator, typename BlockFunctor>
+void blockingMapBlocks(QThreadPool *pool, Iterator begin, Iterator end, BlockFunctor &&function,
+                       int grainSize = 0)
+{
+    QFuture<void> future = startMapBlocks(pool, begin, end, std::forward<BlockFunctor>(function),
+                                          grainSize);
+    future.waitForFinished();
+}
+
+template <typename Iterator, typename BlockFunctor>
+void blockingMapBlocks(Iterator begin, Iterator end, BlockFunctor &&function, int grainSize = 0)
+{
+    QFuture<void> future = startMapBlocks(QThreadPool::globalInstance(), begin, end,
+                                          std::forward<BlockFunctor>(function), grainSize);
+    future.waitForFinished();
+}
+
+// mappedReducedBlocks() on iterators
+template <typename Iterator, typename BlockFunctor, typename ReduceFunctor,
+          typename ResultType = std::decay_t<std::invoke_result_t<BlockFunctor, Iterator, Iterator>>>
+QFuture<ResultType> mappedReducedBlocks(QThreadPool *pool,
+                                        Iterator begin,
+                                        Iterator end,
+                                        BlockFunctor &&blockFunction,
+                                        ReduceFunctor &&reduceFunction,
+                                        int grainSize = 0)
+{
+    return startMappedReducedBlocks<ResultType>(pool, begin, end,
+                                                std::forward<BlockFunctor>(blockFunction),
+                                                std::forward<ReduceFunctor>(reduceFunction),
+                                                grainSize);
+}
+
+template <typename Iterator, typename BlockFunctor, typename ReduceFunctor,
+          typename ResultType = std::decay_t<std::invoke_result_t<BlockFunctor, Iterator, Iterator>>>
+QFuture<ResultType> mappedReducedBlocks(Iterator begin,
+                                        Iterator end,
+                                        BlockFunctor &&blockFunction,
+                                        ReduceFunctor &&reduceFunction,
+                                        int grainSize = 0)
+{
+    return startMappedReducedBlocks<ResultType>(QThreadPool::globalInstance(), begin, end,
+                                                std::forward<BlockFunctor>(blockFunction),
+                                                std::forward<ReduceFunctor>(reduceFunction),
+                                                grainSize);
+}
+
+// blockingMappedReducedBlocks() on iterators
+template <typename Iterator, typename BlockFunctor, typename ReduceFunctor,
+          typename ResultType = std::decay_t<std::invoke_result_t<BlockFunctor, Iterator, Iterator>>>
+ResultType blockingMappedReducedBlocks(QThreadPool *pool,
+                                       Iterator begin,
+                                       Iterator end,
+                                       BlockFunctor &&blockFunction,
+                                       ReduceFunctor &&reduceFunction,
+                                       int grainSize = 0)
+{
+    QFuture<ResultType> future =
+            mappedReducedBlocks(pool, begin, end, std::forward<BlockFunctor>(blockFunction),
+                                std::forward<ReduceFunctor>(reduceFunction), grainSize);
+    return future.takeResult();
+}
+
+template <typename Iterator, typename BlockFunctor, typename ReduceFunctor,
+          typename ResultType = std::decay_t<std::invoke_result_t<BlockFunctor, Iterator, Iterator>>>
+ResultType blockingMappedReducedBlocks(Iterator begin,
+                                       Iterator end,
+                                       BlockFunctor &&blockFunction,
+                                       ReduceFunctor &&reduceFunction,
+                                       int grainSize = 0)
+{
+    QFuture<ResultType> future =
+            mappedReducedBlocks(QThreadPool::globalInstance(), begin, end,
+                                std::forward<BlockFunctor>(blockFunction),
+                                std::forward<ReduceFunctor>(reduceFunction), grainSize);
+    return future.takeResult();
+}
+
 } // namespace QtConcurrent
 
 
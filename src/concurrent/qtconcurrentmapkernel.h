@@ -12,6 +12,8 @@
 #include <QtConcurrent/qtconcurrentreducekernel.h>
 #include <QtConcurrent/qtconcurrentfunctionwrappers.h>
 
+#include <optional>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -171,6 +173,170 @@ public:
     }
 };
 
+/*
+    The BlockIterateKernel class runs a functor on contiguous blocks of a
+    random access range, so that the functor can process a whole block at
+    once instead of being called for each item. The block size is either
+    the fixed grain size, or adapted by the BlockSizeManager if the grain
+    size is 0.
+*/
+template <typename Iterator, typename T>
+class BlockIterateKernel : public ThreadEngine<T>
+{
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<Iterator>::iterator_category>,
+                  "Block iteration requires random access iterators");
+
+public:
+    BlockIterateKernel(QThreadPool *pool, Iterator _begin, Iterator _end, int _grainSize)
+        : ThreadEngine<T>(pool),
+          begin(_begin),
+          iterationCount(int(std::distance(_begin, _end))),
+          grainSize(qMax(_grainSize, 0)),
+          progressReportingEnabled(true)
+    {
+    }
+
+    void start() override
+    {
+        progressReportingEnabled = this->isProgressReportingEnabled();
+        if (progressReportingEnabled && iterationCount > 0)
+            this->setProgressRange(0, iterationCount);
+    }
+
+    bool shouldStartThread() override
+    {
+        return currentIndex.loadRelaxed() < iterationCount && !this->shouldThrottleThread();
+    }
+
+protected:
+    template <typename BlockFunction>
+    ThreadFunctionResult iterateBlocks(BlockFunction &&runBlock)
+    {
+        BlockSizeManager blockSizeManager(ThreadEngineBase::threadPool, iterationCount);
+
+        for (;;) {
+            if (this->isCanceled())
+                break;
+
+            const int currentBlockSize = grainSize > 0 ? grainSize : blockSizeManager.blockSize();
+
+            if (currentIndex.loadRelaxed() >= iterationCount)
+                break;
+
+            const int beginIndex = currentIndex.fetchAndAddRelaxed(currentBlockSize);
+            if (beginIndex >= iterationCount)
+                break;
+            const int endIndex = beginIndex + qMin(currentBlockSize, iterationCount - beginIndex);
+
+            this->waitForResume(); // (only waits if the qfuture is paused.)
+
+            if (shouldStartThread())
+                this->startThread();
+
+            blockSizeManager.timeBeforeUser();
+            runBlock(begin + beginIndex, begin + endIndex);
+            blockSizeManager.timeAfterUser();
+
+            if (progressReportingEnabled) {
+                completed.fetchAndAddAcquire(endIndex - beginIndex);
+                this->setProgressValue(completed.loadRelaxed());
+            }
+
+            if (this->shouldThrottleThread())
+                return ThrottleThread;
+        }
+        return ThreadFinished;
+    }
+
+    const Iterator begin;
+    QAtomicInt currentIndex;
+    QAtomicInt completed;
+    const int iterationCount;
+    const int grainSize;
+    bool progressReportingEnabled;
+};
+
+// calls the functor once for each block of the range
+template <typename Iterator, typename BlockFunctor>
+class BlockMapKernel : public BlockIterateKernel<Iterator, void>
+{
+    BlockFunctor map;
+
+public:
+    typedef void ReturnType;
+    template <typename F = BlockFunctor>
+    BlockMapKernel(QThreadPool *pool, Iterator begin, Iterator end, F &&_map, int grainSize)
+        : BlockIterateKernel<Iterator, void>(pool, begin, end, grainSize),
+          map(std::forward<F>(_map))
+    { }
+
+    ThreadFunctionResult threadFunction() override
+    {
+        return this->iterateBlocks([this](Iterator first, Iterator last) {
+            std::invoke(map, first, last);
+        });
+    }
+};
+
+/*
+    Reduces the results of the functor for each block into an accumulator
+    local to the calling thread, and only merges that accumulator into the
+    final result when the thread stops iterating. This avoids taking a lock
+    for each block, at the cost of reducing in an arbitrary order.
+*/
+template <typename ResultType, typename Iterator, typename BlockFunctor, typename ReduceFunctor>
+class BlockMappedReducedKernel : public BlockIterateKernel<Iterator, ResultType>
+{
+    BlockFunctor map;
+    ReduceFunctor reduce;
+    QMutex mutex;
+    std::optional<ResultType> reducedResult;
+
+public:
+    typedef ResultType ReturnType;
+
+    template <typename F1 = BlockFunctor, typename F2 = ReduceFunctor>
+    BlockMappedReducedKernel(QThreadPool *pool, Iterator begin, Iterator end, F1 &&_map,
+                             F2 &&_reduce, int grainSize)
+        : BlockIterateKernel<Iterator, ResultType>(pool, begin, end, grainSize),
+          map(std::forward<F1>(_map)),
+          reduce(std::forward<F2>(_reduce))
+    { }
+
+    ThreadFunctionResult threadFunction() override
+    {
+        std::optional<ResultType> threadResult;
+        const ThreadFunctionResult result =
+                this->iterateBlocks([this, &threadResult](Iterator first, Iterator last) {
+                    if (threadResult)
+                        std::invoke(reduce, *threadResult, std::invoke(map, first, last));
+                    else
+                        threadResult.emplace(std::invoke(map, first, last));
+                });
+
+        if (threadResult) {
+            std::lock_guard<QMutex> locker(mutex);
+            if (reducedResult)
+                std::invoke(reduce, *reducedResult, std::as_const(*threadResult));
+            else
+                reducedResult.emplace(std::move(*threadResult));
+        }
+        return result;
+    }
+
+    void finish() override
+    {
+        if (!reducedResult)
+            reducedResult.emplace();
+    }
+
+    ResultType *result() override
+    {
+        return &*reducedResult;
+    }
+};
+
 //! [qtconcurrentmapkernel-1]
 template <typename Iterator, typename Functor>
 inline ThreadEngineStarter<void> startMap(QThreadPool *pool, Iterator begin,
@@ -317,6 +483,32 @@ inline ThreadEngineStarter<ResultType> startMappedReduced(QThreadPool *pool,
                                                   std::forward<ResultType>(initialValue), options));
 }
 
+//! [qtconcurrentmapkernel-8]
+template <typename Iterator, typename BlockFunctor>
+inline ThreadEngineStarter<void> startMapBlocks(QThreadPool *pool, Iterator begin, Iterator end,
+                                                BlockFunctor &&functor, int grainSize)
+{
+    return startThreadEngine(new BlockMapKernel<Iterator, std::decay_t<BlockFunctor>>(
+            pool, begin, end, std::forward<BlockFunctor>(functor), grainSize));
+}
+
+//! [qtconcurrentmapkernel-9]
+template <typename ResultType, typename Iterator, typename BlockFunctor, typename ReduceFunctor>
+inline ThreadEngineStarter<ResultType> startMappedReducedBlocks(QThreadPool *pool,
+                                                                Iterator begin,
+                                                                Iterator end,
+                                                                BlockFunctor &&blockFunctor,
+                                                                ReduceFunctor &&reduceFunctor,
+                                                                int grainSize)
+{
+    using KernelType = BlockMappedReducedKernel<ResultType, Iterator, std::decay_t<BlockFunctor>,
+                                                std::decay_t<ReduceFunctor>>;
+    return startThreadEngine(new KernelType(pool, begin, end,
+                                            std::forward<BlockFunctor>(blockFunctor),
+                                            std::forward<ReduceFunctor>(reduceFunctor),
+                                            grainSize));
+}
+
 } // namespace QtConcurrent
 
 
@@ -26,3 +26,15 @@ while (it.hasNext()) {
 //! [2]
 QDirIterator audioFileIt(audioPath, {"*.mp3", "*.wav"}, QDir::Files);
 //! [2]
+
+//! [3]
+auto *watcher = new QFutureWatcher<QFileInfoList>(this);
+connect(watcher, &QFutureWatcher<QFileInfoList>::resultsReadyAt, this, [watcher](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        for (const QFileInfo &info : watcher->resultAt(i))
+            qDebug() << info.filePath() << info.size();
+    }
+});
+connect(watcher, &QFutureWatcher<QFileInfoList>::finished, watcher, &QObject::deleteLater);
+watcher->setFuture(QDirIterator::walkParallel(sourcePath, {"*.cpp", "*.h"}, QDir::Files));
+//! [3]
@@ -60,3 +60,16 @@ bool isExeFile(QFile *file)
     return file->peek(2) == "MZ";
 }
 //! [5]
+
+
+//! [6]
+void forward(QIODevice *source, QIODevice *sink)
+{
+    for (;;) {
+        const QList<QByteArrayView> chunks = source->readableChunks();
+        if (chunks.isEmpty())
+            break;
+        sink->write(source->read(chunks.first().size()));
+    }
+}
+//! [6]
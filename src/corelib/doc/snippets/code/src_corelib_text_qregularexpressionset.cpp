@@ -0,0 +1,14 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+QRegularExpressionSet rules({
+    "^ERROR: disk (\\w+) full",
+    "timeout after (\\d+) ms",
+    "user (\\w+) logged (in|out)"
+});
+
+QRegularExpressionSetMatch match = rules.match(line);
+for (qsizetype rule : match.matchedPatterns())
+    route(rule, match.match(rule).captured(1));
+//! [0]
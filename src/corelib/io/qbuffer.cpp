@@ -22,6 +22,7 @@ public:
 
     qint64 peek(char *data, qint64 maxSize) override;
     QByteArray peek(qint64 maxSize) override;
+    QList<QByteArrayView> readableChunks() override;
 
 #ifndef QT_NO_QOBJECT
     // private slots
@@ -59,6 +60,13 @@ QByteArray QBufferPrivate::peek(qint64 maxSize)
     return QByteArray(buf->constData() + pos, readBytes);
 }
 
+QList<QByteArrayView> QBufferPrivate::readableChunks()
+{
+    if (pos >= buf->size())
+        return QList<QByteArrayView>();
+    return { QByteArrayView(*buf).sliced(qsizetype(pos)) };
+}
+
 /*!
     \class QBuffer
     \inmodule QtCore
@@ -395,17 +403,23 @@ qint64 QBuffer::writeData(const char *data, qint64 len)
     Q_D(QBuffer);
     const quint64 required = quint64(pos()) + quint64(len); // cannot overflow (pos() ≥ 0, len ≥ 0)
 
-    if (required > quint64(d->buf->size())) { // capacity exceeded
-        // The following must hold, since qsizetype covers half the virtual address space:
-        Q_ASSUME(required <= quint64((std::numeric_limits<qsizetype>::max)()));
-        d->buf->resize(qsizetype(required));
-        if (quint64(d->buf->size()) != required) { // could not resize
-            qWarning("QBuffer::writeData: Memory allocation error");
-            return -1;
+    if (d->isWriteChunkCached(data, len) && d->buf->isEmpty()) {
+        // We are called from write(const QByteArray &) on an empty buffer,
+        // so we can make a shallow copy of the chunk.
+        *d->buf = *d->currentWriteChunk;
+    } else {
+        if (required > quint64(d->buf->size())) { // capacity exceeded
+            // The following must hold, since qsizetype covers half the virtual address space:
+            Q_ASSUME(required <= quint64((std::numeric_limits<qsizetype>::max)()));
+            d->buf->resize(qsizetype(required));
+            if (quint64(d->buf->size()) != required) { // could not resize
+                qWarning("QBuffer::writeData: Memory allocation error");
+                return -1;
+            }
         }
-    }
 
-    memcpy(d->buf->data() + pos(), data, size_t(len));
+        memcpy(d->buf->data() + pos(), data, size_t(len));
+    }
 
 #ifndef QT_NO_QOBJECT
     d->writtenSinceLastEmit += len;
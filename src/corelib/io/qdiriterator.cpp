@@ -34,6 +34,9 @@
     you cannot iterate directories in reverse order) and does not allow random
     access.
 
+    To list a large directory tree, walkParallel() reads several directories
+    at the same time in a thread pool, and reports their entries in batches.
+
     \sa QDir, QDir::entryList()
 */
 
@@ -63,6 +66,13 @@
 #if QT_CONFIG(regularexpression)
 #include <QtCore/qregularexpression.h>
 #endif
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#include <QtCore/qfutureinterface.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qthreadpool.h>
+#endif
 
 #include <QtCore/private/qfilesystemiterator_p.h>
 #include <QtCore/private/qfilesystementry_p.h>
@@ -87,12 +97,16 @@ public:
     }
 };
 
+class QDirParallelWalk;
+
 class QDirIteratorPrivate
 {
 public:
     QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
-                        QDir::Filters _filters, QDirIterator::IteratorFlags flags, bool resolveEngine = true);
+                        QDir::Filters _filters, QDirIterator::IteratorFlags flags, bool resolveEngine = true,
+                        QDirParallelWalk *parallelWalk = nullptr);
 
+    bool hasNext() const;
     void advance();
 
     bool entryMatches(const QString & fileName, const QFileInfo &fileInfo);
@@ -121,17 +135,67 @@ public:
 
     // Loop protection
     QDuplicateTracker<QString> visitedLinks;
+
+    // Receives the subdirectories when walking in parallel
+    QDirParallelWalk *const parallelWalk;
+};
+
+#if QT_CONFIG(future)
+/*!
+    \internal
+
+    Shared state of a QDirIterator::walkParallel() call. Each directory is
+    listed by a QDirIteratorPrivate of its own, which hands the
+    subdirectories it finds back to enqueue() instead of descending into
+    them. At most as many directories as the pool has threads are read at
+    the same time.
+*/
+class QDirParallelWalk : public std::enable_shared_from_this<QDirParallelWalk>
+{
+public:
+    QDirParallelWalk(const QStringList &nameFilters, QDir::Filters filters,
+                     QDirIterator::IteratorFlags flags, QThreadPool *pool)
+        : nameFilters(nameFilters),
+          filters(filters),
+          flags(flags | QDirIterator::Subdirectories),
+          pool(pool),
+          maxWorkers(qMax(1, pool->maxThreadCount()))
+    {
+    }
+
+    void start(const QFileSystemEntry &root);
+    void enqueue(const QFileSystemEntry &dir, const QString &canonicalPath);
+
+    QFutureInterface<QFileInfoList> futureInterface;
+
+private:
+    void run();
+    void readDirectory(const QFileSystemEntry &dir);
+
+    const QStringList nameFilters;
+    const QDir::Filters filters;
+    const QDirIterator::IteratorFlags flags;
+    QThreadPool *const pool;
+    const int maxWorkers;
+
+    QMutex mutex;
+    QQueue<QFileSystemEntry> pending;
+    int workers = 0;
+    QDuplicateTracker<QString> visitedLinks;
 };
+#endif
 
 /*!
     \internal
 */
 QDirIteratorPrivate::QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
-                                         QDir::Filters _filters, QDirIterator::IteratorFlags flags, bool resolveEngine)
+                                         QDir::Filters _filters, QDirIterator::IteratorFlags flags, bool resolveEngine,
+                                         QDirParallelWalk *parallelWalk)
     : dirEntry(entry)
       , nameFilters(nameFilters.contains("*"_L1) ? QStringList() : nameFilters)
       , filters(QDir::NoFilter == _filters ? QDir::AllEntries : _filters)
       , iteratorFlags(flags)
+      , parallelWalk(parallelWalk)
 {
 #if QT_CONFIG(regularexpression)
     nameRegExps.reserve(nameFilters.size());
@@ -163,7 +227,8 @@ void QDirIteratorPrivate::pushDirectory(const QFileInfo &fileInfo)
         path = fileInfo.canonicalFilePath();
 #endif
 
-    if ((iteratorFlags & QDirIterator::FollowSymlinks)) {
+    // A parallel walk checks the directories when they are enqueued
+    if ((iteratorFlags & QDirIterator::FollowSymlinks) && !parallelWalk) {
         // Stop link loops
         if (visitedLinks.hasSeen(fileInfo.canonicalFilePath()))
             return;
@@ -180,8 +245,11 @@ void QDirIteratorPrivate::pushDirectory(const QFileInfo &fileInfo)
         }
     } else {
 #ifndef QT_NO_FILESYSTEMITERATOR
+        // Let the iterator open the directory relative to the one listing it
+        const QFileSystemIterator *parent = nativeIterators.isEmpty() ? nullptr
+                                                                      : nativeIterators.top();
         QFileSystemIterator *it = new QFileSystemIterator(fileInfo.d_ptr->fileEntry,
-            filters, nameFilters, iteratorFlags);
+            filters, nameFilters, iteratorFlags, parent);
         nativeIterators << it;
 #else
         qWarning("Qt was built with -no-feature-filesystemiterator: no files/plugins will be found!");
@@ -204,6 +272,21 @@ inline bool QDirIteratorPrivate::entryMatches(const QString & fileName, const QF
     return false;
 }
 
+/*!
+    \internal
+*/
+bool QDirIteratorPrivate::hasNext() const
+{
+    if (engine)
+        return !fileEngineIterators.isEmpty();
+    else
+#ifndef QT_NO_FILESYSTEMITERATOR
+        return !nativeIterators.isEmpty();
+#else
+        return false;
+#endif
+}
+
 /*!
     \internal
 */
@@ -274,9 +357,101 @@ void QDirIteratorPrivate::checkAndPushDirectory(const QFileInfo &fileInfo)
     if (!(filters & QDir::AllDirs) && !(filters & QDir::Hidden) && fileInfo.isHidden())
         return;
 
+#if QT_CONFIG(future)
+    if (parallelWalk) {
+        const bool followSymlinks = iteratorFlags.testAnyFlag(QDirIterator::FollowSymlinks);
+        parallelWalk->enqueue(fileInfo.d_ptr->fileEntry,
+                              followSymlinks ? fileInfo.canonicalFilePath() : QString());
+        return;
+    }
+#endif
+
     pushDirectory(fileInfo);
 }
 
+#if QT_CONFIG(future)
+/*!
+    \internal
+*/
+void QDirParallelWalk::start(const QFileSystemEntry &root)
+{
+    futureInterface.reportStarted();
+
+    QString canonicalPath;
+    if (flags.testAnyFlag(QDirIterator::FollowSymlinks))
+        canonicalPath = QFileInfo(root.filePath()).canonicalFilePath();
+    enqueue(root, canonicalPath);
+}
+
+/*!
+    \internal
+
+    Queues \a dir to be read, unless \a canonicalPath has been visited
+    already, and starts a new worker if the limit is not reached.
+*/
+void QDirParallelWalk::enqueue(const QFileSystemEntry &dir, const QString &canonicalPath)
+{
+    QMutexLocker locker(&mutex);
+    // Stop link loops
+    if (!canonicalPath.isEmpty() && visitedLinks.hasSeen(canonicalPath))
+        return;
+
+    pending.enqueue(dir);
+    if (workers < maxWorkers) {
+        ++workers;
+        locker.unlock();
+        pool->start([self = shared_from_this()] { self->run(); });
+    }
+}
+
+/*!
+    \internal
+
+    Reads directories until none is left. Only workers enqueue directories,
+    so the walk is over when the last one runs out of them.
+*/
+void QDirParallelWalk::run()
+{
+    for (;;) {
+        QMutexLocker locker(&mutex);
+        if (pending.isEmpty() || futureInterface.isCanceled()) {
+            pending.clear();
+            const bool finished = --workers == 0;
+            locker.unlock();
+            if (finished)
+                futureInterface.reportFinished();
+            return;
+        }
+        const QFileSystemEntry dir = pending.dequeue();
+        locker.unlock();
+
+        readDirectory(dir);
+    }
+}
+
+/*!
+    \internal
+*/
+void QDirParallelWalk::readDirectory(const QFileSystemEntry &dir)
+{
+    // Keeps the results of very large directories from piling up
+    constexpr qsizetype MaxBatchSize = 1024;
+
+    QDirIteratorPrivate it(dir, nameFilters, filters, flags, true, this);
+    QFileInfoList batch;
+    while (it.hasNext() && !futureInterface.isCanceled()) {
+        it.advance();
+        batch.append(it.currentFileInfo);
+        if (batch.size() == MaxBatchSize) {
+            futureInterface.reportResult(std::move(batch));
+            batch = QFileInfoList();
+        }
+    }
+    if (!batch.isEmpty())
+        futureInterface.reportResult(std::move(batch));
+}
+#endif
+
 /*!
     \internal
 
@@ -497,14 +672,7 @@ QFileInfo QDirIterator::nextFileInfo()
 */
 bool QDirIterator::hasNext() const
 {
-    if (d->engine)
-        return !d->fileEngineIterators.isEmpty();
-    else
-#ifndef QT_NO_FILESYSTEMITERATOR
-        return !d->nativeIterators.isEmpty();
-#else
-        return false;
-#endif
+    return d->hasNext();
 }
 
 /*!
@@ -550,4 +718,63 @@ QString QDirIterator::path() const
     return d->dirEntry.filePath();
 }
 
+#if QT_CONFIG(future)
+/*!
+    \since 6.5
+    \overload
+
+    Lists the entries of \a path and of all its subdirectories that match
+    \a filters, reading several directories at the same time in \a pool, or
+    in QThreadPool::globalInstance() if \a pool is \nullptr.
+
+    \sa hasNext(), next(), IteratorFlags
+*/
+QFuture<QFileInfoList> QDirIterator::walkParallel(const QString &path, QDir::Filters filters,
+                                                  IteratorFlags flags, QThreadPool *pool)
+{
+    return walkParallel(path, QStringList(), filters, flags, pool);
+}
+
+/*!
+    \since 6.5
+
+    Lists the entries of \a path and of all its subdirectories that match
+    \a nameFilters and \a filters, reading several directories at the same
+    time in \a pool, or in QThreadPool::globalInstance() if \a pool is
+    \nullptr.
+
+    The entries are the ones that a QDirIterator constructed with the same
+    arguments and the Subdirectories flag would list, which is implied. If
+    \a flags contains FollowSymlinks, symbolic link loops are detected and
+    ignored in the same way.
+
+    Each result of the returned future is a batch of entries from the same
+    directory. The order of the batches, and of the directories, is not
+    specified. Use a QFutureWatcher to process the batches as they become
+    available:
+
+    \snippet code/src_corelib_io_qdiriterator.cpp 3
+
+    At most as many directories as \a pool has threads are read at the same
+    time; pass a pool with a lower QThreadPool::maxThreadCount() to limit the
+    load on the file system. Canceling the returned future stops the walk;
+    no entries are reported after that.
+
+    \sa QFuture, QFutureWatcher
+*/
+QFuture<QFileInfoList> QDirIterator::walkParallel(const QString &path,
+                                                  const QStringList &nameFilters,
+                                                  QDir::Filters filters, IteratorFlags flags,
+                                                  QThreadPool *pool)
+{
+    if (!pool)
+        pool = QThreadPool::globalInstance();
+
+    auto walk = std::make_shared<QDirParallelWalk>(nameFilters, filters, flags, pool);
+    QFuture<QFileInfoList> future = walk->futureInterface.future();
+    walk->start(QFileSystemEntry(path));
+    return future;
+}
+#endif
+
 QT_END_NAMESPACE
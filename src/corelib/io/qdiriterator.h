@@ -8,6 +8,11 @@
 
 QT_BEGIN_NAMESPACE
 
+#if QT_CONFIG(future)
+template <typename T> class QFuture;
+class QThreadPool;
+#endif
+
 class QDirIteratorPrivate;
 class Q_CORE_EXPORT QDirIterator
 {
@@ -41,6 +46,18 @@ public:
     QFileInfo fileInfo() const;
     QString path() const;
 
+#if QT_CONFIG(future)
+    static QFuture<QFileInfoList> walkParallel(const QString &path,
+                                               QDir::Filters filters = QDir::NoFilter,
+                                               IteratorFlags flags = NoIteratorFlags,
+                                               QThreadPool *pool = nullptr);
+    static QFuture<QFileInfoList> walkParallel(const QString &path,
+                                               const QStringList &nameFilters,
+                                               QDir::Filters filters = QDir::NoFilter,
+                                               IteratorFlags flags = NoIteratorFlags,
+                                               QThreadPool *pool = nullptr);
+#endif
+
 private:
     Q_DISABLE_COPY(QDirIterator)
 
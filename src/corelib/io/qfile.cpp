@@ -15,6 +15,13 @@
 #include "private/qfilesystemengine_p.h"
 #include "private/qsystemerror_p.h"
 #include "private/qtemporaryfile_p.h"
+#include "private/qbytearray_p.h"
+#if QT_CONFIG(future)
+# include "private/qfileasyncio_p.h"
+#endif
+#ifdef Q_OS_UNIX
+# include "private/qcore_unix_p.h"
+#endif
 #if defined(QT_BUILD_CORE_LIB)
 # include "qcoreapplication.h"
 #endif
@@ -1092,6 +1099,99 @@ QFile::resize(const QString &fileName, qint64 sz)
     return QFile(fileName).resize(sz);
 }
 
+#if QT_CONFIG(future)
+/*!
+    \internal
+
+    Returns a descriptor of the open file for asynchronous I/O, which the
+    caller owns, or -1 if the file has to be opened again by name.
+*/
+static int asyncIoHandle(const QFile *file)
+{
+#ifdef Q_OS_UNIX
+    if (const int fd = file->handle(); fd >= 0)
+        return qt_safe_dup(fd);
+#else
+    Q_UNUSED(file);
+#endif
+    return -1;
+}
+
+/*!
+    \since 6.5
+
+    Reads at most \a size bytes from the file, starting at \a offset, without
+    blocking. Returns a future that holds the data that was read once the read
+    has finished, which is less than \a size bytes if the end of the file is
+    reached. If the read fails, the future holds a \c std::system_error with
+    the \c errno value of the failure, which QFuture::result() rethrows; in
+    builds without exception support, the future is canceled instead.
+
+    The read does not use nor change the current position of the file, and
+    can run concurrently with other reads and writes of the file. Use
+    QFuture::then() with a context object to handle the data in the thread
+    of that object. The file can be closed before the read has finished.
+
+    On Linux, the read is submitted to the kernel with io_uring if it is
+    available. Otherwise, it runs in a thread of QThreadPool::globalInstance().
+
+    \sa writeAsync(), QIODevice::read()
+*/
+QFuture<QByteArray> QFile::readAsync(qint64 offset, qint64 size)
+{
+    if (!isReadable() || isSequential()) {
+        qWarning("QFile::readAsync: File (%ls) is not open for reading, or is sequential",
+                 qUtf16Printable(fileName()));
+        return QFuture<QByteArray>();
+    }
+    if (offset < 0 || size < 0) {
+        qWarning("QFile::readAsync: Called with a negative offset or size");
+        return QFuture<QByteArray>();
+    }
+    if (size >= MaxByteArraySize) {
+        qWarning("QFile::readAsync: size argument exceeds QByteArray size limit");
+        size = MaxByteArraySize - 1;
+    }
+    if (isWritable())
+        flush();
+    return QFileAsyncIo::read(asyncIoHandle(this), fileName(), offset, size);
+}
+
+/*!
+    \since 6.5
+
+    Writes \a data to the file at \a offset, without blocking. Returns a future
+    that holds the number of bytes written once the write has finished. If the
+    write fails, the future holds a \c std::system_error with the \c errno
+    value of the failure, which QFuture::result() rethrows; in builds without
+    exception support, the future is canceled instead.
+
+    The write does not use nor change the current position of the file. Data
+    that was buffered by previous calls to write() is flushed first. Writes
+    that overlap each other, or a write that overlaps a concurrent read, have
+    an undefined result.
+
+    On Linux, the write is submitted to the kernel with io_uring if it is
+    available. Otherwise, it runs in a thread of QThreadPool::globalInstance().
+
+    \sa readAsync(), QIODevice::write()
+*/
+QFuture<qint64> QFile::writeAsync(qint64 offset, const QByteArray &data)
+{
+    if (!isWritable() || isSequential()) {
+        qWarning("QFile::writeAsync: File (%ls) is not open for writing, or is sequential",
+                 qUtf16Printable(fileName()));
+        return QFuture<qint64>();
+    }
+    if (offset < 0) {
+        qWarning("QFile::writeAsync: Called with a negative offset");
+        return QFuture<qint64>();
+    }
+    flush();
+    return QFileAsyncIo::write(asyncIoHandle(this), fileName(), offset, data);
+}
+#endif // QT_CONFIG(future)
+
 /*!
     \reimp
 */
@@ -26,6 +26,10 @@ namespace std {
 
 QT_BEGIN_NAMESPACE
 
+#if QT_CONFIG(future)
+template <typename T> class QFuture;
+#endif
+
 #if QT_CONFIG(cxx17_filesystem)
 namespace QtPrivate {
 inline QString fromFilesystemPath(const std::filesystem::path &path)
@@ -264,6 +268,11 @@ public:
     bool resize(qint64 sz) override;
     static bool resize(const QString &filename, qint64 sz);
 
+#if QT_CONFIG(future)
+    QFuture<QByteArray> readAsync(qint64 offset, qint64 size);
+    QFuture<qint64> writeAsync(qint64 offset, const QByteArray &data);
+#endif
+
     Permissions permissions() const override;
     static Permissions permissions(const QString &filename);
     bool setPermissions(Permissions permissionSpec) override;
@@ -0,0 +1,569 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qfileasyncio_p.h"
+
+#include <QtCore/qfile.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qpromise.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qset.h>
+#include <QtCore/qvarlengtharray.h>
+
+#ifndef QT_NO_EXCEPTIONS
+#include <system_error>
+#endif
+
+#ifdef Q_OS_UNIX
+#include "private/qcore_unix_p.h"
+#endif
+
+#if QT_CONFIG(io_uring)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+/*
+    A read or write of a range of a file. The transfer may need several
+    system calls, since both pread() and io_uring may transfer fewer bytes
+    than requested.
+*/
+class FileRequest
+{
+public:
+    FileRequest(int fd, const QString &fileName, qint64 offset)
+        : fd(fd), fileName(fileName), offset(offset)
+    {
+    }
+    virtual ~FileRequest()
+    {
+#ifdef Q_OS_UNIX
+        if (fd >= 0)
+            qt_safe_close(fd);
+#endif
+    }
+
+    virtual bool isWrite() const = 0;
+    virtual bool isCanceled() const = 0;
+    virtual void finish() = 0;
+
+    // Accounts for a transfer that returned result, which is the number of
+    // bytes transferred or a negated errno value. Returns true if the
+    // request is complete.
+    bool advance(qint64 result)
+    {
+        if (result < 0 || (result == 0 && isWrite())) {
+            fail(result < 0 ? int(-result) : EIO);
+            return true;
+        }
+        transferred += result;
+        return result == 0 || remaining() == 0 || isCanceled();
+    }
+
+    void fail(int errorCode, const QString &message = QString())
+    {
+        error = errorCode;
+        errorString = message.isEmpty() ? qt_error_string(errorCode) : message;
+    }
+
+    // Sizes the buffer of a read for the part of the file that exists, so
+    // that reading past the end does not allocate what was asked for
+    void allocate(qint64 fileSize)
+    {
+        if (isWrite())
+            return;
+        if (fileSize > 0)
+            length = qBound(qint64(0), fileSize - offset, length);
+        buffer.resize(length);
+    }
+
+    // Not data(): a write must not detach the buffer it shares with the caller,
+    // and the buffer of a read is never shared.
+    char *position() { return const_cast<char *>(buffer.constData()) + transferred; }
+    qint64 remaining() const { return length - transferred; }
+    qint64 currentOffset() const { return offset + transferred; }
+
+    void runSynchronously();
+
+    const int fd;
+    const QString fileName;
+    const qint64 offset;
+    QByteArray buffer;
+    qint64 length = 0;
+    qint64 transferred = 0;
+    int error = 0;
+    QString errorString;
+#if QT_CONFIG(io_uring)
+    iovec vector;
+#endif
+};
+
+// Reports the failure of a request as a std::system_error with the errno
+// value, so that it can be told apart from a canceled request
+template <typename T>
+void reportError(QPromise<T> &promise, int error, const QString &errorString)
+{
+#ifndef QT_NO_EXCEPTIONS
+    promise.setException(std::make_exception_ptr(
+            std::system_error(error, std::generic_category(), errorString.toStdString())));
+#else
+    Q_UNUSED(error);
+    Q_UNUSED(errorString);
+    promise.future().cancel();
+#endif
+}
+
+class ReadRequest : public FileRequest
+{
+public:
+    ReadRequest(int fd, const QString &fileName, qint64 offset, qint64 size)
+        : FileRequest(fd, fileName, offset)
+    {
+        length = size;
+#ifdef Q_OS_UNIX
+        // Files that are opened again by name are sized in runSynchronously().
+        // Some special files, like those in /proc, report a size of 0.
+        QT_STATBUF st;
+        if (fd >= 0)
+            allocate(QT_FSTAT(fd, &st) == 0 && S_ISREG(st.st_mode) ? qint64(st.st_size) : 0);
+#endif
+        promise.start();
+    }
+
+    bool isWrite() const override { return false; }
+    bool isCanceled() const override { return promise.isCanceled(); }
+
+    void finish() override
+    {
+        if (error) {
+            reportError(promise, error, errorString);
+        } else {
+            buffer.truncate(transferred);
+            promise.addResult(std::move(buffer));
+        }
+        promise.finish();
+    }
+
+    QPromise<QByteArray> promise;
+};
+
+class WriteRequest : public FileRequest
+{
+public:
+    WriteRequest(int fd, const QString &fileName, qint64 offset, const QByteArray &data)
+        : FileRequest(fd, fileName, offset)
+    {
+        buffer = data;
+        length = data.size();
+        promise.start();
+    }
+
+    bool isWrite() const override { return true; }
+    bool isCanceled() const override { return promise.isCanceled(); }
+
+    void finish() override
+    {
+        if (error)
+            reportError(promise, error, errorString);
+        else
+            promise.addResult(transferred);
+        promise.finish();
+    }
+
+    QPromise<qint64> promise;
+};
+
+void FileRequest::runSynchronously()
+{
+#ifdef Q_OS_UNIX
+    if (fd >= 0) {
+        while (remaining() > 0) {
+            qint64 result;
+            if (isWrite())
+                EINTR_LOOP(result, ::pwrite(fd, position(), size_t(remaining()), currentOffset()));
+            else
+                EINTR_LOOP(result, ::pread(fd, position(), size_t(remaining()), currentOffset()));
+            if (advance(result < 0 ? -qint64(errno) : result))
+                break;
+        }
+        return;
+    }
+#endif
+
+    QFile file(fileName);
+    if (!file.open((isWrite() ? QIODevice::ReadWrite : QIODevice::ReadOnly) | QIODevice::Unbuffered)
+            || !file.seek(offset)) {
+        fail(EIO, file.errorString());
+        return;
+    }
+    allocate(file.size());
+    while (remaining() > 0) {
+        const qint64 result = isWrite() ? file.write(position(), remaining())
+                                        : file.read(position(), remaining());
+        if (result < 0 || (result == 0 && isWrite())) {
+            fail(EIO, file.errorString());
+            break;
+        }
+        if (advance(result))
+            break;
+    }
+}
+
+void runInThreadPool(FileRequest *request)
+{
+    QThreadPool::globalInstance()->start([request] {
+        request->runSynchronously();
+        request->finish();
+        delete request;
+    });
+}
+
+// Finishes a request in the thread pool, so that continuations without a
+// context object never run in the thread that reaps io_uring completions
+void finishInThreadPool(FileRequest *request)
+{
+    QThreadPool::globalInstance()->start([request] {
+        request->finish();
+        delete request;
+    });
+}
+
+#if QT_CONFIG(io_uring)
+/*
+    A process-wide io_uring instance. Requests are submitted by the thread
+    calling QFile::readAsync() or QFile::writeAsync(), and their completions
+    are reaped by a dedicated thread, which resubmits short transfers and
+    hands the complete ones to the thread pool to finish their futures. The
+    results reach the threads that need them through the usual QFuture
+    continuations, e.g. QFuture::then() with a context object.
+
+    If the kernel fails a call for another reason than a transient one, the
+    ring is abandoned: the requests in flight fail, and later requests are
+    served by the thread pool.
+*/
+class IoUring
+{
+public:
+    IoUring();
+    ~IoUring();
+
+    bool isValid()
+    {
+        QMutexLocker locker(&mutex);
+        return completionThread != nullptr && !abandoned;
+    }
+    bool submit(FileRequest *request);
+
+private:
+    class CompletionThread : public QThread
+    {
+    public:
+        explicit CompletionThread(IoUring *ring) : ring(ring) { }
+        void run() override { ring->reapCompletions(); }
+
+    private:
+        IoUring *const ring;
+    };
+
+    bool enqueue(quint8 opcode, FileRequest *request);
+    void reapCompletions();
+    void abandon(int error);
+
+    enum { RingEntries = 256 };
+
+    int ringFd = -1;
+    void *sqRing = MAP_FAILED;
+    void *cqRing = MAP_FAILED;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    io_uring_cqe *cqes = nullptr;
+    unsigned cqMask = 0;
+    unsigned cqEntries = 0;
+
+    QMutex mutex;
+    // guarded by mutex
+    unsigned inFlight = 0;  // never more than cqEntries
+    QSet<FileRequest *> requests;
+    bool abandoned = false;
+
+    CompletionThread *completionThread = nullptr;
+};
+
+IoUring::IoUring()
+{
+    if (qEnvironmentVariableIsSet("QT_NO_IO_URING"))
+        return;
+
+    io_uring_params params = {};
+    ringFd = int(syscall(__NR_io_uring_setup, unsigned(RingEntries), &params));
+    if (ringFd < 0)
+        return; // ENOSYS on old kernels, EPERM if disabled by seccomp or sysctl
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMap)
+        sqRingSize = cqRingSize = qMax(sqRingSize, cqRingSize);
+
+    sqRing = ::mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED)
+        return;
+    if (singleMap) {
+        cqRing = sqRing;
+    } else {
+        cqRing = ::mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED)
+            return;
+    }
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe *>(::mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                              MAP_SHARED | MAP_POPULATE, ringFd,
+                                              IORING_OFF_SQES));
+    if (sqes == MAP_FAILED)
+        return;
+
+    auto at = [](void *ring, quint32 offset) {
+        return reinterpret_cast<unsigned *>(static_cast<char *>(ring) + offset);
+    };
+    sqHead = at(sqRing, params.sq_off.head);
+    sqTail = at(sqRing, params.sq_off.tail);
+    sqArray = at(sqRing, params.sq_off.array);
+    sqMask = *at(sqRing, params.sq_off.ring_mask);
+    sqEntries = params.sq_entries;
+    cqHead = at(cqRing, params.cq_off.head);
+    cqTail = at(cqRing, params.cq_off.tail);
+    cqes = reinterpret_cast<io_uring_cqe *>(at(cqRing, params.cq_off.cqes));
+    cqMask = *at(cqRing, params.cq_off.ring_mask);
+    cqEntries = params.cq_entries;
+
+    completionThread = new CompletionThread(this);
+    completionThread->setObjectName(QStringLiteral("QFile io_uring"));
+    completionThread->start();
+}
+
+IoUring::~IoUring()
+{
+    if (completionThread) {
+        // a no-op request without a FileRequest tells the thread to exit,
+        // unless it has already exited after abandoning the ring
+        while (!completionThread->isFinished() && !enqueue(IORING_OP_NOP, nullptr))
+            QThread::yieldCurrentThread();
+        completionThread->wait();
+        delete completionThread;
+    }
+    if (sqes != MAP_FAILED)
+        ::munmap(sqes, sqesSize);
+    if (cqRing != MAP_FAILED && cqRing != sqRing)
+        ::munmap(cqRing, cqRingSize);
+    if (sqRing != MAP_FAILED)
+        ::munmap(sqRing, sqRingSize);
+    if (ringFd >= 0)
+        qt_safe_close(ringFd);
+}
+
+bool IoUring::submit(FileRequest *request)
+{
+    request->vector.iov_base = request->position();
+    request->vector.iov_len = size_t(request->remaining());
+    return enqueue(request->isWrite() ? IORING_OP_WRITEV : IORING_OP_READV, request);
+}
+
+bool IoUring::enqueue(quint8 opcode, FileRequest *request)
+{
+    QMutexLocker locker(&mutex);
+
+    // Bound the number of requests in flight, so that the completion queue
+    // cannot overflow; the caller falls back to the thread pool instead.
+    if (abandoned || inFlight == cqEntries)
+        return false;
+
+    const unsigned tail = *sqTail;
+    const unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    if (tail - head == sqEntries)
+        return false;
+
+    const unsigned index = tail & sqMask;
+    io_uring_sqe *sqe = sqes + index;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    if (request) {
+        sqe->fd = request->fd;
+        sqe->off = quint64(request->currentOffset());
+        sqe->addr = quintptr(&request->vector);
+        sqe->len = 1;
+    } else {
+        sqe->fd = -1;
+    }
+    sqe->user_data = quintptr(request);
+    sqArray[index] = index;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    // Only this function submits entries, with the mutex held, so the entry
+    // is the only one in the queue. If the kernel did not consume it, take
+    // it back: the caller falls back to the thread pool instead.
+    int ret;
+    EINTR_LOOP(ret, int(syscall(__NR_io_uring_enter, ringFd, 1u, 0u, 0u, nullptr, 0)));
+    if (ret <= 0) {
+        if (ret < 0 && errno != EAGAIN && errno != EBUSY) {
+            qErrnoWarning("QFile: io_uring_enter failed");
+            abandoned = true;
+        }
+        __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+        return false;
+    }
+    ++inFlight;
+    if (request)
+        requests.insert(request);
+    return true;
+}
+
+void IoUring::abandon(int error)
+{
+    QSet<FileRequest *> failed;
+    {
+        QMutexLocker locker(&mutex);
+        abandoned = true;
+        failed.swap(requests);
+    }
+    for (FileRequest *request : std::as_const(failed)) {
+        request->fail(error);
+        finishInThreadPool(request);
+    }
+}
+
+void IoUring::reapCompletions()
+{
+    struct Completion
+    {
+        FileRequest *request;
+        qint64 result;
+    };
+    QVarLengthArray<Completion, RingEntries> completions;
+    bool done = false;
+
+    while (!done) {
+        const int ret = int(syscall(__NR_io_uring_enter, ringFd, 0u, 1u,
+                                    unsigned(IORING_ENTER_GETEVENTS), nullptr, 0));
+        if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            const int error = errno;
+            qErrnoWarning("QFile: io_uring_enter failed");
+            abandon(error);
+            break;
+        }
+
+        completions.clear();
+        unsigned head = *cqHead;
+        const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            const io_uring_cqe &cqe = cqes[head & cqMask];
+            completions.append({ reinterpret_cast<FileRequest *>(quintptr(cqe.user_data)),
+                                 qint64(cqe.res) });
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        if (completions.isEmpty())
+            continue;
+
+        {
+            QMutexLocker locker(&mutex);
+            inFlight -= unsigned(completions.size());
+            for (const Completion &completion : std::as_const(completions))
+                requests.remove(completion.request);
+        }
+
+        for (const Completion &completion : std::as_const(completions)) {
+            FileRequest *request = completion.request;
+            if (!request) {
+                done = true;
+                continue;
+            }
+            if (!request->advance(completion.result)) {
+                if (!submit(request))
+                    runInThreadPool(request);
+                continue;
+            }
+            finishInThreadPool(request);
+        }
+    }
+}
+
+Q_GLOBAL_STATIC(IoUring, ioUring)
+
+IoUring *validIoUring()
+{
+    IoUring *ring = ioUring();
+    return ring && ring->isValid() ? ring : nullptr;
+}
+#endif // QT_CONFIG(io_uring)
+
+void startRequest(FileRequest *request)
+{
+#if QT_CONFIG(io_uring)
+    if (request->fd >= 0) {
+        if (IoUring *ring = validIoUring(); ring && ring->submit(request))
+            return;
+    }
+#endif
+    runInThreadPool(request);
+}
+
+} // unnamed namespace
+
+namespace QFileAsyncIo {
+
+QFuture<QByteArray> read(int fd, const QString &fileName, qint64 offset, qint64 size)
+{
+    auto request = new ReadRequest(fd, fileName, offset, size);
+    QFuture<QByteArray> future = request->promise.future();
+    if (request->length == 0) {
+        request->finish();
+        delete request;
+    } else {
+        startRequest(request);
+    }
+    return future;
+}
+
+QFuture<qint64> write(int fd, const QString &fileName, qint64 offset, const QByteArray &data)
+{
+    auto request = new WriteRequest(fd, fileName, offset, data);
+    QFuture<qint64> future = request->promise.future();
+    if (data.isEmpty()) {
+        request->finish();
+        delete request;
+    } else {
+        startRequest(request);
+    }
+    return future;
+}
+
+bool usesIoUring()
+{
+#if QT_CONFIG(io_uring)
+    return validIoUring() != nullptr;
+#else
+    return false;
+#endif
+}
+
+} // namespace QFileAsyncIo
+
+QT_END_NAMESPACE
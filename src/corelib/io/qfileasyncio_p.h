@@ -0,0 +1,44 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFILEASYNCIO_P_H
+#define QFILEASYNCIO_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qfuture.h>
+#include <QtCore/qstring.h>
+
+QT_REQUIRE_CONFIG(future);
+
+QT_BEGIN_NAMESPACE
+
+namespace QFileAsyncIo {
+
+// Both functions take ownership of fd, a descriptor of the file that is
+// not shared with any QFile. If fd is -1, the file is opened again by name.
+Q_AUTOTEST_EXPORT QFuture<QByteArray> read(int fd, const QString &fileName, qint64 offset,
+                                           qint64 size);
+Q_AUTOTEST_EXPORT QFuture<qint64> write(int fd, const QString &fileName, qint64 offset,
+                                        const QByteArray &data);
+
+// Returns true if the requests are served by io_uring rather than by
+// synchronous I/O in the global thread pool.
+Q_AUTOTEST_EXPORT bool usesIoUring();
+
+} // namespace QFileAsyncIo
+
+QT_END_NAMESPACE
+
+#endif // QFILEASYNCIO_P_H
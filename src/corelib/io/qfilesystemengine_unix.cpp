@@ -548,6 +548,14 @@ void QFileSystemMetaData::fillFromDirEnt(const QT_DIRENT &entry)
 #else
     Q_UNUSED(entry);
 #endif
+
+#if !defined(Q_OS_DARWIN) && !defined(UF_HIDDEN)
+    // Without file flags, whether the entry is hidden only depends on its
+    // name; record it so that filtering hidden entries needs no lookup
+    knownFlagsMask |= QFileSystemMetaData::HiddenAttribute;
+    if (entry.d_name[0] == '.')
+        entryFlags |= QFileSystemMetaData::HiddenAttribute;
+#endif
 }
 
 //static
@@ -30,6 +30,9 @@
 #if !defined(Q_OS_WIN)
 #include <QtCore/qscopedpointer.h>
 #endif
+#if defined(Q_OS_LINUX)
+#include <memory>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -38,7 +41,8 @@ class QFileSystemIterator
 public:
     QFileSystemIterator(const QFileSystemEntry &entry, QDir::Filters filters,
             const QStringList &nameFilters, QDirIterator::IteratorFlags flags
-                = QDirIterator::FollowSymlinks | QDirIterator::Subdirectories);
+                = QDirIterator::FollowSymlinks | QDirIterator::Subdirectories,
+            const QFileSystemIterator *parent = nullptr);
     ~QFileSystemIterator();
 
     bool advance(QFileSystemEntry &fileEntry, QFileSystemMetaData &metaData);
@@ -54,6 +58,15 @@ private:
     bool uncFallback;
     int uncShareIndex;
     bool onlyDirs;
+#elif defined(Q_OS_LINUX)
+    int dirFd;
+    std::unique_ptr<char[]> buffer;
+    qsizetype bufferSize;
+    qsizetype bufferOffset;
+    QT_DIRENT *dirEntry;
+    int lastError;
+
+    bool readEntries();
 #else
     QT_DIR *dir;
     QT_DIRENT *dirEntry;
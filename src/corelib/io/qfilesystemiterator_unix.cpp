@@ -4,6 +4,7 @@
 #include "qplatformdefs.h"
 #include "qfilesystemiterator_p.h"
 
+#include <private/qcore_unix_p.h>
 #include <private/qstringconverter_p.h>
 
 #ifndef QT_NO_FILESYSTEMITERATOR
@@ -13,8 +14,32 @@
 #include <stdlib.h>
 #include <errno.h>
 
+#if defined(Q_OS_LINUX)
+#include <stddef.h>
+#include <sys/syscall.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
+#if defined(Q_OS_LINUX)
+// getdents64(2) fills the buffer with records in the layout of the kernel's
+// struct linux_dirent64, which is the one of the C library's struct dirent64
+static_assert(offsetof(QT_DIRENT, d_reclen) == 16);
+static_assert(offsetof(QT_DIRENT, d_type) == 18);
+static_assert(offsetof(QT_DIRENT, d_name) == 19);
+
+// Large enough to read a few hundred entries per system call. Unlike the
+// buffer of a DIR stream, it is released as soon as the directory has been
+// read, so deep trees do not keep one per level.
+static constexpr qsizetype DirentBufferSize = 32 * 1024;
+
+#if defined(QT_USE_XOPEN_LFS_EXTENSIONS) && defined(QT_LARGEFILE_SUPPORT)
+#  define QT_FSTATAT ::fstatat64
+#else
+#  define QT_FSTATAT ::fstatat
+#endif
+#endif
+
 static bool checkNameDecodable(const char *d_name, qsizetype len)
 {
     // This function is called in a loop from advance() below, but the loop is
@@ -23,10 +48,25 @@ static bool checkNameDecodable(const char *d_name, qsizetype len)
     return QUtf8::isValidUtf8(QByteArrayView(d_name, len)).isValidUtf8;
 }
 
+static QByteArray entryPath(const QByteArray &dirPath, const char *name, qsizetype len)
+{
+    QByteArray path;
+    path.reserve(dirPath.size() + len);
+    path.append(dirPath).append(name, len);
+    return path;
+}
+
 QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDir::Filters filters,
-                                         const QStringList &nameFilters, QDirIterator::IteratorFlags flags)
+                                         const QStringList &nameFilters, QDirIterator::IteratorFlags flags,
+                                         const QFileSystemIterator *parent)
     : nativePath(entry.nativeFilePath())
+#if defined(Q_OS_LINUX)
+    , dirFd(-1)
+    , bufferSize(0)
+    , bufferOffset(0)
+#else
     , dir(nullptr)
+#endif
     , dirEntry(nullptr)
     , lastError(0)
 {
@@ -34,20 +74,99 @@ QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDir::Fi
     Q_UNUSED(nameFilters);
     Q_UNUSED(flags);
 
+#if defined(Q_OS_LINUX)
+    // Open subdirectories relative to the directory that listed them, so
+    // that the kernel does not resolve the whole path again for each of them
+    const qsizetype parentSize = parent ? parent->nativePath.size() : 0;
+    if (parent && parent->dirFd != -1 && nativePath.size() > parentSize
+            && nativePath.startsWith(parent->nativePath)
+            && nativePath.indexOf('/', parentSize) == -1) {
+        const char *name = nativePath.constData() + parentSize;
+        EINTR_LOOP(dirFd, ::openat(parent->dirFd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    } else {
+        dirFd = qt_safe_open(nativePath.constData(), O_RDONLY | O_DIRECTORY);
+    }
+
+    if (dirFd == -1) {
+        lastError = errno;
+    } else {
+        if (!nativePath.endsWith('/'))
+            nativePath.append('/');
+    }
+#else
+    Q_UNUSED(parent);
+
     if ((dir = QT_OPENDIR(nativePath.constData())) == nullptr) {
         lastError = errno;
     } else {
         if (!nativePath.endsWith('/'))
             nativePath.append('/');
     }
+#endif
 }
 
 QFileSystemIterator::~QFileSystemIterator()
 {
+#if defined(Q_OS_LINUX)
+    if (dirFd != -1)
+        qt_safe_close(dirFd);
+#else
     if (dir)
         QT_CLOSEDIR(dir);
+#endif
+}
+
+#if defined(Q_OS_LINUX)
+bool QFileSystemIterator::readEntries()
+{
+    if (!buffer)
+        buffer.reset(new char[DirentBufferSize]);
+
+    ssize_t read;
+    EINTR_LOOP(read, ::syscall(SYS_getdents64, dirFd, buffer.get(), DirentBufferSize));
+    if (read <= 0) {
+        lastError = read < 0 ? errno : 0;
+        buffer.reset();
+        bufferSize = 0;
+        bufferOffset = 0;
+        return false;
+    }
+
+    bufferSize = read;
+    bufferOffset = 0;
+    return true;
 }
 
+bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaData &metaData)
+{
+    if (dirFd == -1)
+        return false;
+
+    for (;;) {
+        if (bufferOffset >= bufferSize && !readEntries())
+            return false;
+
+        dirEntry = reinterpret_cast<QT_DIRENT *>(buffer.get() + bufferOffset);
+        bufferOffset += dirEntry->d_reclen;
+
+        qsizetype len = strlen(dirEntry->d_name);
+        if (checkNameDecodable(dirEntry->d_name, len)) {
+            // Some file systems do not report the type of the entries; ask
+            // for it relative to the directory, rather than by full path later
+            if (dirEntry->d_type == DT_UNKNOWN) {
+                QT_STATBUF statBuffer;
+                if (QT_FSTATAT(dirFd, dirEntry->d_name, &statBuffer, AT_SYMLINK_NOFOLLOW) == 0)
+                    dirEntry->d_type = IFTODT(statBuffer.st_mode);
+            }
+
+            fileEntry = QFileSystemEntry(entryPath(nativePath, dirEntry->d_name, len),
+                                         QFileSystemEntry::FromNativePath());
+            metaData.fillFromDirEnt(*dirEntry);
+            return true;
+        }
+    }
+}
+#else
 bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaData &metaData)
 {
     if (!dir)
@@ -59,7 +178,8 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
         if (dirEntry) {
             qsizetype len = strlen(dirEntry->d_name);
             if (checkNameDecodable(dirEntry->d_name, len)) {
-                fileEntry = QFileSystemEntry(nativePath + QByteArray(dirEntry->d_name, len), QFileSystemEntry::FromNativePath());
+                fileEntry = QFileSystemEntry(entryPath(nativePath, dirEntry->d_name, len),
+                                             QFileSystemEntry::FromNativePath());
                 metaData.fillFromDirEnt(*dirEntry);
                 return true;
             }
@@ -71,6 +191,7 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
     lastError = errno;
     return false;
 }
+#endif
 
 QT_END_NAMESPACE
 
@@ -15,7 +15,8 @@ using namespace Qt::StringLiterals;
 bool done = true;
 
 QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDir::Filters filters,
-                                         const QStringList &nameFilters, QDirIterator::IteratorFlags flags)
+                                         const QStringList &nameFilters, QDirIterator::IteratorFlags flags,
+                                         const QFileSystemIterator *parent)
     : nativePath(entry.nativeFilePath())
     , dirPath(entry.filePath())
     , findFileHandle(INVALID_HANDLE_VALUE)
@@ -25,6 +26,7 @@ QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDir::Fi
 {
     Q_UNUSED(nameFilters);
     Q_UNUSED(flags);
+    Q_UNUSED(parent);
     if (nativePath.endsWith(u".lnk"_s) && !QFileSystemEngine::isDirPath(dirPath, nullptr)) {
         QFileSystemMetaData metaData;
         QFileSystemEntry link = QFileSystemEngine::getLinkTarget(entry, metaData);
@@ -11,6 +11,8 @@
 #include <qset.h>
 #include <qtimer.h>
 
+#include <utility>
+
 #if (defined(Q_OS_LINUX) || defined(Q_OS_QNX)) && QT_CONFIG(inotify)
 #define USE_INOTIFY
 #endif
@@ -71,6 +73,10 @@ void QFileSystemWatcherPrivate::init()
                          SIGNAL(directoryChanged(QString,bool)),
                          q,
                          SLOT(_q_directoryChanged(QString,bool)));
+        QObject::connect(native, &QFileSystemWatcherEngine::recursivePathsChanged,
+                         q, [this](const QStringList &paths, const QStringList &removedRoots) {
+                             _q_recursivePathsChanged(paths, removedRoots);
+                         });
 #if defined(Q_OS_WIN)
         QObject::connect(static_cast<QWindowsFileSystemWatcherEngine *>(native),
                          &QWindowsFileSystemWatcherEngine::driveLockForRemoval,
@@ -128,6 +134,43 @@ void QFileSystemWatcherPrivate::_q_directoryChanged(const QString &path, bool re
     emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
 }
 
+void QFileSystemWatcherPrivate::_q_recursivePathsChanged(const QStringList &paths,
+                                                         const QStringList &removedRoots)
+{
+    Q_Q(QFileSystemWatcher);
+    qCDebug(lcWatcher) << "paths changed" << paths << "removed roots" << removedRoots;
+    for (const QString &root : removedRoots)
+        recursiveDirectories.removeAll(root);
+
+    for (const QString &path : paths) {
+        if (!pendingChangeSet.contains(path)) {
+            pendingChangeSet.insert(path);
+            pendingChanges.append(path);
+        }
+    }
+    if (pendingChanges.isEmpty())
+        return;
+
+    if (!debounceTimer) {
+        debounceTimer = new QTimer(q);
+        debounceTimer->setSingleShot(true);
+        QObject::connect(debounceTimer, &QTimer::timeout, q, [this] { emitPendingChanges(); });
+    }
+    // Collect the changes from the first one on, rather than restarting the
+    // timer on each change, so that a busy tree still reports them
+    if (!debounceTimer->isActive())
+        debounceTimer->start(debounceInterval);
+}
+
+void QFileSystemWatcherPrivate::emitPendingChanges()
+{
+    Q_Q(QFileSystemWatcher);
+    const QStringList changes = std::exchange(pendingChanges, QStringList());
+    pendingChangeSet.clear();
+    if (!changes.isEmpty())
+        emit q->pathsChanged(changes, QFileSystemWatcher::QPrivateSignal());
+}
+
 #if defined(Q_OS_WIN)
 
 void QFileSystemWatcherPrivate::_q_winDriveLockForRemoval(const QString &path)
@@ -195,6 +238,13 @@ void  QFileSystemWatcherPrivate::_q_winDriveRemoved(const QString &path)
     they have been renamed or removed from disk, and directories once
     they have been removed from disk.
 
+    To monitor a whole directory tree, call addRecursivePath(). All
+    directories below the path are watched, including the ones that are
+    created later, and the paths of the entries that change anywhere in the
+    tree are reported in batches by the pathsChanged() signal. The
+    debounceInterval() sets how long changes are collected before they are
+    reported.
+
     \list
     \li \b Notes:
     \list
@@ -292,6 +342,30 @@ static QStringList empty_paths_pruned(const QStringList &paths)
     return p;
 }
 
+// The roots of watched trees are compared with the paths below them, so
+// they are kept in one form: absolute, and without "." or ".." components
+// or a trailing slash. Returns the paths of \a directories in that form.
+static QStringList normalizedRoots(const QStringList &directories)
+{
+    QStringList roots;
+    roots.reserve(directories.size());
+    for (const QString &directory : directories)
+        roots.append(QDir::cleanPath(QFileInfo(directory).absoluteFilePath()));
+    return roots;
+}
+
+// Maps the \a failed roots back to the \a directories they were given as
+static QStringList directoriesOf(const QStringList &failed, const QStringList &directories,
+                                 const QStringList &roots)
+{
+    QStringList result;
+    for (qsizetype i = 0; i < roots.size(); ++i) {
+        if (failed.contains(roots.at(i)))
+            result.append(directories.at(i));
+    }
+    return result;
+}
+
 /*!
     Adds each path in \a paths to the file system watcher. Paths are
     not added if they not exist, or if they are already being
@@ -461,6 +535,177 @@ QStringList QFileSystemWatcher::directories() const
     return d->directories;
 }
 
+/*!
+    \since 6.5
+
+    Adds \a directory and all directories below it to the file system
+    watcher. Directories that are created below \a directory later are
+    watched as well. Changes anywhere in the tree are reported by the
+    pathsChanged() signal.
+
+    The tree is watched under the absolute path of \a directory, without
+    \c{.} or \c{..} components; recursiveDirectories() and pathsChanged()
+    use that form.
+
+    Returns \c true if the tree is watched. Watching trees is currently only
+    supported on Linux, where it uses inotify; on other platforms, this
+    function returns \c false.
+
+    \note inotify needs one watch per directory of the tree. If the system
+    limit of watches is reached, the directories above the limit are not
+    watched, and a warning is printed.
+
+    \sa addRecursivePaths(), removeRecursivePath(), recursiveDirectories()
+*/
+bool QFileSystemWatcher::addRecursivePath(const QString &directory)
+{
+    if (directory.isEmpty()) {
+        qWarning("QFileSystemWatcher::addRecursivePath: path is empty");
+        return true;
+    }
+
+    QStringList paths = addRecursivePaths(QStringList(directory));
+    return paths.isEmpty();
+}
+
+/*!
+    \since 6.5
+
+    Adds each directory in \a directories, with all directories below it,
+    to the file system watcher, and returns the list of the ones that could
+    not be watched.
+
+    \sa addRecursivePath(), removeRecursivePaths()
+*/
+QStringList QFileSystemWatcher::addRecursivePaths(const QStringList &directories)
+{
+    Q_D(QFileSystemWatcher);
+
+    QStringList p = empty_paths_pruned(directories);
+
+    if (p.isEmpty()) {
+        qWarning("QFileSystemWatcher::addRecursivePaths: list is empty");
+        return p;
+    }
+    qCDebug(lcWatcher) << "adding recursively" << directories;
+
+    if (d->native) {
+        const QStringList roots = normalizedRoots(p);
+        p = directoriesOf(d->native->addRecursivePaths(roots, &d->recursiveDirectories), p,
+                          roots);
+    }
+
+    return p;
+}
+
+/*!
+    \since 6.5
+
+    Stops watching the tree of \a directory, which was added with
+    addRecursivePath(). Returns \c true on success.
+
+    \sa removeRecursivePaths(), addRecursivePath()
+*/
+bool QFileSystemWatcher::removeRecursivePath(const QString &directory)
+{
+    if (directory.isEmpty()) {
+        qWarning("QFileSystemWatcher::removeRecursivePath: path is empty");
+        return true;
+    }
+
+    QStringList paths = removeRecursivePaths(QStringList(directory));
+    return paths.isEmpty();
+}
+
+/*!
+    \since 6.5
+
+    Stops watching the trees of \a directories, and returns the list of the
+    ones that were not watched.
+
+    \sa removeRecursivePath(), addRecursivePaths()
+*/
+QStringList QFileSystemWatcher::removeRecursivePaths(const QStringList &directories)
+{
+    Q_D(QFileSystemWatcher);
+
+    QStringList p = empty_paths_pruned(directories);
+
+    if (p.isEmpty()) {
+        qWarning("QFileSystemWatcher::removeRecursivePaths: list is empty");
+        return p;
+    }
+    qCDebug(lcWatcher) << "removing recursively" << directories;
+
+    if (d->native) {
+        const QStringList roots = normalizedRoots(p);
+        p = directoriesOf(d->native->removeRecursivePaths(roots, &d->recursiveDirectories), p,
+                          roots);
+    }
+
+    return p;
+}
+
+/*!
+    \since 6.5
+
+    Returns the list of directories whose trees are being watched.
+
+    \sa addRecursivePath(), directories()
+*/
+QStringList QFileSystemWatcher::recursiveDirectories() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->recursiveDirectories;
+}
+
+/*!
+    \since 6.5
+
+    Returns how long, in milliseconds, changes in the watched trees are
+    collected before pathsChanged() is emitted. The default is 0: the
+    changes that the system reports together are emitted together.
+
+    \sa setDebounceInterval()
+*/
+int QFileSystemWatcher::debounceInterval() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->debounceInterval;
+}
+
+/*!
+    \since 6.5
+
+    Sets how long changes in the watched trees are collected before
+    pathsChanged() is emitted to \a msecs milliseconds. The interval starts
+    with the first change, so that trees that change continuously still
+    report their changes regularly.
+
+    \sa debounceInterval()
+*/
+void QFileSystemWatcher::setDebounceInterval(int msecs)
+{
+    Q_D(QFileSystemWatcher);
+    d->debounceInterval = qMax(0, msecs);
+}
+
+/*!
+    \fn void QFileSystemWatcher::pathsChanged(const QStringList &paths)
+    \since 6.5
+
+    This signal is emitted when entries change in the directory trees added
+    with addRecursivePath(). \a paths contains each changed path once: the
+    entries that were created, modified, renamed or removed, and the
+    directories whose own attributes changed. If a watched tree is removed
+    or renamed, its path is reported and the tree is not watched anymore.
+
+    If the system had to drop some changes, the watched directories
+    themselves are reported, and should be scanned again.
+
+    \sa debounceInterval()
+*/
+
 QStringList QFileSystemWatcher::files() const
 {
     Q_D(const QFileSystemWatcher);
@@ -31,9 +31,19 @@ public:
     QStringList files() const;
     QStringList directories() const;
 
+    bool addRecursivePath(const QString &directory);
+    QStringList addRecursivePaths(const QStringList &directories);
+    bool removeRecursivePath(const QString &directory);
+    QStringList removeRecursivePaths(const QStringList &directories);
+    QStringList recursiveDirectories() const;
+
+    int debounceInterval() const;
+    void setDebounceInterval(int msecs);
+
 Q_SIGNALS:
     void fileChanged(const QString &path, QPrivateSignal);
     void directoryChanged(const QString &path, QPrivateSignal);
+    void pathsChanged(const QStringList &paths, QPrivateSignal);
 
 private:
     Q_PRIVATE_SLOT(d_func(), void _q_fileChanged(const QString &path, bool removed))
@@ -8,6 +8,7 @@
 #include "private/qsystemerror_p.h"
 
 #include <qdebug.h>
+#include <qdiriterator.h>
 #include <qfile.h>
 #include <qfileinfo.h>
 #include <qscopeguard.h>
@@ -173,6 +174,11 @@ struct inotify_event {
 #define IN_Q_OVERFLOW           0x00004000
 #define IN_IGNORED              0x00008000
 
+#define IN_ONLYDIR              0x01000000
+#define IN_DONT_FOLLOW          0x02000000
+#define IN_EXCL_UNLINK          0x04000000
+#define IN_ISDIR                0x40000000
+
 #define IN_CLOSE                (IN_CLOSE_WRITE | IN_CLOSE_NOWRITE)
 #define IN_MOVE                 (IN_MOVED_FROM | IN_MOVED_TO)
 }
@@ -197,7 +203,7 @@ static inline int inotify_init1(int flags)
 
 QT_BEGIN_NAMESPACE
 
-QInotifyFileSystemWatcherEngine *QInotifyFileSystemWatcherEngine::create(QObject *parent)
+static int createInotifyFd()
 {
     int fd = -1;
 #if defined(IN_CLOEXEC)
@@ -205,9 +211,17 @@ QInotifyFileSystemWatcherEngine *QInotifyFileSystemWatcherEngine::create(QObject
 #endif
     if (fd == -1) {
         fd = inotify_init();
-        if (fd == -1)
-            return nullptr;
+        if (fd != -1)
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
     }
+    return fd;
+}
+
+QInotifyFileSystemWatcherEngine *QInotifyFileSystemWatcherEngine::create(QObject *parent)
+{
+    int fd = createInotifyFd();
+    if (fd == -1)
+        return nullptr;
     return new QInotifyFileSystemWatcherEngine(fd, parent);
 }
 
@@ -227,6 +241,11 @@ QInotifyFileSystemWatcherEngine::~QInotifyFileSystemWatcherEngine()
         inotify_rm_watch(inotifyFd, id < 0 ? -id : id);
 
     ::close(inotifyFd);
+
+    if (recursiveFd != -1) {
+        delete recursiveNotifier;
+        ::close(recursiveFd);
+    }
 }
 
 QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
@@ -388,6 +407,250 @@ void QInotifyFileSystemWatcherEngine::readFromInotify()
     }
 }
 
+static QString childPath(const QString &dir, const char *name)
+{
+    if (dir.endsWith(u'/'))
+        return dir + QFile::decodeName(name);
+    return dir + u'/' + QFile::decodeName(name);
+}
+
+/*
+    Recursive watches use an inotify instance of their own: inotify has a
+    single watch per inode and instance, so sharing one with addPaths()
+    would let both replace each other's event masks.
+*/
+QStringList QInotifyFileSystemWatcherEngine::addRecursivePaths(const QStringList &paths,
+                                                               QStringList *recursiveDirectories)
+{
+    if (recursiveFd == -1) {
+        recursiveFd = createInotifyFd();
+        if (recursiveFd == -1) {
+            qErrnoWarning("inotify_init failed:");
+            return paths;
+        }
+        recursiveNotifier = new QSocketNotifier(recursiveFd, QSocketNotifier::Read, this);
+        connect(recursiveNotifier, &QSocketNotifier::activated,
+                this, &QInotifyFileSystemWatcherEngine::readFromRecursiveInotify);
+    }
+
+    QStringList unhandled;
+    for (const QString &path : paths) {
+        if (recursiveDirectories->contains(path)) {
+            unhandled.push_back(path);
+            continue;
+        }
+
+        // A directory inside a tree that is watched already needs no
+        // watches of its own
+        if (!recursivePathToID.contains(path) && !addTree(path, nullptr)) {
+            unhandled.push_back(path);
+            continue;
+        }
+        recursiveDirectories->append(path);
+        recursiveRoots.append(path);
+    }
+
+    return unhandled;
+}
+
+QStringList QInotifyFileSystemWatcherEngine::removeRecursivePaths(const QStringList &paths,
+                                                                  QStringList *recursiveDirectories)
+{
+    QStringList unhandled;
+    for (const QString &path : paths) {
+        if (!recursiveRoots.removeOne(path)) {
+            unhandled.push_back(path);
+            continue;
+        }
+        recursiveDirectories->removeAll(path);
+
+        // Keep watching the trees of the other roots
+        if (!isInWatchedTree(path)) {
+            removeTree(path);
+            for (const QString &root : std::as_const(recursiveRoots)) {
+                if (isInTree(root, path))
+                    addTree(root, nullptr);
+            }
+        }
+    }
+
+    return unhandled;
+}
+
+/*
+    Returns \c true if \a path is \a root or one of its descendants.
+*/
+bool QInotifyFileSystemWatcherEngine::isInTree(const QString &path, const QString &root)
+{
+    if (!path.startsWith(root))
+        return false;
+    return path.size() == root.size() || root.endsWith(u'/') || path.at(root.size()) == u'/';
+}
+
+/*
+    Returns \c true if \a path is in the tree of another watched root.
+*/
+bool QInotifyFileSystemWatcherEngine::isInWatchedTree(const QString &path) const
+{
+    for (const QString &root : recursiveRoots) {
+        if (isInTree(path, root))
+            return true;
+    }
+    return false;
+}
+
+bool QInotifyFileSystemWatcherEngine::addRecursiveWatch(const QString &path)
+{
+    int wd = inotify_add_watch(recursiveFd, QFile::encodeName(path),
+                               IN_ATTRIB
+                               | IN_CLOSE_WRITE
+                               | IN_CREATE
+                               | IN_DELETE
+                               | IN_DELETE_SELF
+                               | IN_MODIFY
+                               | IN_MOVE
+                               | IN_MOVE_SELF
+                               | IN_DONT_FOLLOW
+                               | IN_EXCL_UNLINK
+                               | IN_ONLYDIR);
+    if (wd < 0) {
+        if (errno == ENOSPC) {
+            static bool warned = false;
+            if (!warned) {
+                qWarning("QFileSystemWatcher: The limit of inotify watches is reached, "
+                         "some directories are not watched");
+                warned = true;
+            }
+        } else if (errno != ENOENT && errno != ENOTDIR) {
+            qErrnoWarning("inotify_add_watch(%ls) failed:", qUtf16Printable(path));
+        }
+        return false;
+    }
+
+    // The same directory can be reached twice through bind mounts
+    const auto it = recursiveIdToPath.constFind(wd);
+    if (it != recursiveIdToPath.cend())
+        return it.value() == path;
+
+    recursiveIdToPath.insert(wd, path);
+    recursivePathToID.insert(path, wd);
+    return true;
+}
+
+/*
+    Watches \a root and all directories below it. If \a entries is not
+    \nullptr, appends all paths below \a root to it: they appeared before
+    their directories were watched.
+*/
+bool QInotifyFileSystemWatcherEngine::addTree(const QString &root, QStringList *entries)
+{
+    if (!addRecursiveWatch(root))
+        return false;
+
+    // The directory listing provides the type of the entries, so walking the
+    // tree needs no stat() per directory
+    const QDir::Filters filters = entries
+            ? QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot
+            : QDir::Dirs | QDir::Hidden | QDir::NoDotAndDotDot | QDir::NoSymLinks;
+    QDirIterator it(root, filters, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QFileInfo info = it.nextFileInfo();
+        if (entries)
+            entries->append(info.filePath());
+        if (info.isDir() && !info.isSymLink())
+            addRecursiveWatch(info.filePath());
+    }
+    return true;
+}
+
+void QInotifyFileSystemWatcherEngine::removeTree(const QString &root)
+{
+    for (auto it = recursivePathToID.begin(); it != recursivePathToID.end(); ) {
+        if (isInTree(it.key(), root)) {
+            inotify_rm_watch(recursiveFd, it.value());
+            recursiveIdToPath.remove(it.value());
+            it = recursivePathToID.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void QInotifyFileSystemWatcherEngine::readFromRecursiveInotify()
+{
+    int buffSize = 0;
+    if (ioctl(recursiveFd, FIONREAD, (char *) &buffSize) == -1 || buffSize == 0)
+        return;
+
+    QVarLengthArray<char, 4096> buffer(buffSize);
+    buffSize = read(recursiveFd, buffer.data(), buffSize);
+    if (buffSize <= 0)
+        return;
+
+    QStringList changes;
+    QStringList removedRoots;
+    const auto removeRoot = [&](const QString &root) {
+        removeTree(root);
+        recursiveRoots.removeOne(root);
+        removedRoots.append(root);
+    };
+
+    const char *at = buffer.data();
+    const char * const end = at + buffSize;
+    while (at < end) {
+        const inotify_event *event = reinterpret_cast<const inotify_event *>(at);
+        at += sizeof(inotify_event) + event->len;
+
+        if (event->mask & IN_Q_OVERFLOW) {
+            // Events were lost, let the user scan the trees again
+            changes += recursiveRoots;
+            continue;
+        }
+
+        const QString dir = recursiveIdToPath.value(event->wd);
+        if (dir.isEmpty())
+            continue;
+
+        if (event->mask & IN_IGNORED) {
+            // The directory was removed, or its file system unmounted
+            recursiveIdToPath.remove(event->wd);
+            recursivePathToID.remove(dir);
+            if (recursiveRoots.contains(dir)) {
+                changes.append(dir);
+                removeRoot(dir);
+            }
+            continue;
+        }
+
+        if (event->mask & IN_MOVE_SELF) {
+            // Subdirectories that move are handled with the event of their
+            // parent; a root that moves is no longer where it was watched
+            if (recursiveRoots.contains(dir)) {
+                changes.append(dir);
+                removeRoot(dir);
+            }
+            continue;
+        }
+
+        if (event->len == 0) {
+            changes.append(dir);
+            continue;
+        }
+
+        const QString path = childPath(dir, event->name);
+        changes.append(path);
+        if (event->mask & IN_ISDIR) {
+            if (event->mask & IN_MOVED_FROM)
+                removeTree(path);
+            else if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                addTree(path, &changes);
+        }
+    }
+
+    if (!changes.isEmpty())
+        emit recursivePathsChanged(changes, removedRoots);
+}
+
 template <typename Hash, typename Key>
 typename Hash::const_iterator
 find_last_in_equal_range(const Hash &c, const Key &key)
@@ -36,19 +36,36 @@ public:
 
     QStringList addPaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
     QStringList removePaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
+    QStringList addRecursivePaths(const QStringList &paths,
+                                  QStringList *recursiveDirectories) override;
+    QStringList removeRecursivePaths(const QStringList &paths,
+                                     QStringList *recursiveDirectories) override;
 
 private Q_SLOTS:
     void readFromInotify();
+    void readFromRecursiveInotify();
 
 private:
     QString getPathFromID(int id) const;
 
+    static bool isInTree(const QString &path, const QString &root);
+    bool isInWatchedTree(const QString &path) const;
+    bool addRecursiveWatch(const QString &path);
+    bool addTree(const QString &root, QStringList *entries);
+    void removeTree(const QString &root);
+
 private:
     QInotifyFileSystemWatcherEngine(int fd, QObject *parent);
     int inotifyFd;
     QHash<QString, int> pathToID;
     QMultiHash<int, QString> idToPath;
     QSocketNotifier notifier;
+
+    int recursiveFd = -1;
+    QSocketNotifier *recursiveNotifier = nullptr;
+    QHash<QString, int> recursivePathToID;
+    QHash<int, QString> recursiveIdToPath;
+    QStringList recursiveRoots;
 };
 
 
@@ -23,9 +23,12 @@ QT_REQUIRE_CONFIG(filesystemwatcher);
 
 #include <QtCore/qstringlist.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qset.h>
 
 QT_BEGIN_NAMESPACE
 
+class QTimer;
+
 class QFileSystemWatcherEngine : public QObject
 {
     Q_OBJECT
@@ -48,10 +51,27 @@ public:
     virtual QStringList removePaths(const QStringList &paths,
                                     QStringList *files,
                                     QStringList *directories) = 0;
+    // watches the directories in \a paths and all their subdirectories,
+    // fills \a recursiveDirectories with the ones it could watch, and
+    // returns the other ones; engines that cannot watch trees return all
+    virtual QStringList addRecursivePaths(const QStringList &paths,
+                                          QStringList *recursiveDirectories)
+    {
+        Q_UNUSED(recursiveDirectories);
+        return paths;
+    }
+    virtual QStringList removeRecursivePaths(const QStringList &paths,
+                                             QStringList *recursiveDirectories)
+    {
+        Q_UNUSED(recursiveDirectories);
+        return paths;
+    }
 
 Q_SIGNALS:
     void fileChanged(const QString &path, bool removed);
     void directoryChanged(const QString &path, bool removed);
+    // \a removedRoots are the recursive directories that are not watched anymore
+    void recursivePathsChanged(const QStringList &paths, const QStringList &removedRoots);
 };
 
 class QFileSystemWatcherPrivate : public QObjectPrivate
@@ -67,10 +87,19 @@ public:
 
     QFileSystemWatcherEngine *native, *poller;
     QStringList files, directories;
+    QStringList recursiveDirectories;
+
+    // Changes in the recursive directories, until pathsChanged() is emitted
+    QStringList pendingChanges;
+    QSet<QString> pendingChangeSet;
+    QTimer *debounceTimer = nullptr;
+    int debounceInterval = 0;
 
     // private slots
     void _q_fileChanged(const QString &path, bool removed);
     void _q_directoryChanged(const QString &path, bool removed);
+    void _q_recursivePathsChanged(const QStringList &paths, const QStringList &removedRoots);
+    void emitPendingChanges();
 
 #if defined(Q_OS_WIN)
     void _q_winDriveLockForRemoval(const QString &);
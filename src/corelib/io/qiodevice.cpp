@@ -2028,6 +2028,87 @@ qint64 QIODevicePrivate::skipByReading(qint64 maxSize)
     return readSoFar;
 }
 
+/*!
+    \since 6.5
+
+    Returns views of the data that can be read from the device without
+    copying it, in the order in which read() would return it. The views stay
+    valid until the next call to a function that reads from, writes to or
+    closes the device, or until control returns to the event loop.
+
+    Only the data that the device has already buffered, or keeps in memory
+    otherwise, is returned; this function never reads from the underlying
+    device. It returns an empty list if no such data is available, or if the
+    device is opened in \l{QIODeviceBase::}{Text} mode.
+
+    Call consume() to discard the data once it has been processed. Reading
+    the size of the first chunk with read(qint64) returns it as a QByteArray
+    that shares its memory with the buffer, which lets devices such as
+    QTcpSocket and QProcess queue it for writing without copying it either:
+
+    \snippet code/src_corelib_io_qiodevice.cpp 6
+
+    \sa consume(), peek(), bytesAvailable()
+*/
+QList<QByteArrayView> QIODevice::readableChunks()
+{
+    Q_D(QIODevice);
+    CHECK_READABLE(readableChunks, QList<QByteArrayView>());
+
+    if ((d->openMode & Text) != 0)
+        return QList<QByteArrayView>();
+    return d->readableChunks();
+}
+
+/*!
+    \internal
+*/
+QList<QByteArrayView> QIODevicePrivate::readableChunks()
+{
+    QList<QByteArrayView> chunks;
+    if (isBufferEmpty())
+        return chunks;
+
+    qint64 offset = (transactionStarted && isSequential()) ? transactionPos : 0;
+    qint64 length;
+    while (const char *data = buffer.readPointerAtPosition(offset, length)) {
+        chunks.append(QByteArrayView(data, length));
+        offset += length;
+    }
+    return chunks;
+}
+
+/*!
+    \since 6.5
+
+    Discards the first \a size bytes of the data returned by
+    readableChunks(), and returns the number of bytes discarded, or -1 on
+    error.
+
+    Unlike skip(), this function never reads from the underlying device,
+    and so never blocks: it discards at most the total size of the chunks
+    returned by readableChunks().
+
+    \sa readableChunks(), skip()
+*/
+qint64 QIODevice::consume(qint64 size)
+{
+    Q_D(QIODevice);
+    CHECK_READABLE(consume, qint64(-1));
+    if (size < 0) {
+        checkWarnMessage(this, "consume", "Called with size < 0");
+        return qint64(-1);
+    }
+
+    qint64 available = 0;
+    const QList<QByteArrayView> chunks = readableChunks();
+    for (QByteArrayView chunk : chunks)
+        available += chunk.size();
+
+    size = qMin(size, available);
+    return size ? skip(size) : qint64(0);
+}
+
 /*!
     \since 6.0
 
@@ -93,6 +93,9 @@ public:
     QByteArray peek(qint64 maxlen);
     qint64 skip(qint64 maxSize);
 
+    QList<QByteArrayView> readableChunks();
+    qint64 consume(qint64 size);
+
     virtual bool waitForReadyRead(int msecs);
     virtual bool waitForBytesWritten(int msecs);
 
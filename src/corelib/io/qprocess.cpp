@@ -1595,6 +1595,10 @@ std::function<void(void)> QProcess::childProcessModifier() const
     "async-signal-safe" is advised). Most of the Qt API is unsafe inside this
     callback, including qDebug(), and may lead to deadlocks.
 
+    \note Setting a modifier makes start() create the child process with
+    \c{fork()}. Without one, QProcess uses \c{vfork()} semantics where
+    available, which is faster for processes that use a lot of memory.
+
     \sa childProcessModifier()
 */
 void QProcess::setChildProcessModifier(const std::function<void(void)> &modifier)
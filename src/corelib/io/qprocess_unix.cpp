@@ -469,7 +469,18 @@ void QProcessPrivate::startProcess()
 #endif
 
     pid_t childPid;
-    forkfd = ::vforkfd(ffdflags , &childPid, execChild2, &execChild1);
+    if (childProcessModifier) {
+        // The modifier is arbitrary user code, which must not run in a child
+        // that shares the memory of this process.
+        forkfd = ::forkfd(ffdflags, &childPid);
+        if (forkfd == FFD_CHILD_PROCESS)
+            ::_exit(execChild2(&execChild1));
+    } else {
+        // Nothing but async-signal-safe code runs in the child before
+        // execve(), so avoid copying the page tables of this process, which
+        // is what makes starting children from large processes slow.
+        forkfd = ::vforkfd(ffdflags | FFD_VFORK_SEMANTICS, &childPid, execChild2, &execChild1);
+    }
     int lastForkErrno = errno;
 
     if (forkfd == -1) {
@@ -6,6 +6,7 @@
 #include "qresource_p.h"
 #include "qresource_iterator_p.h"
 #include "qset.h"
+#include "qcache.h"
 #include <private/qlocking_p.h>
 #include "qdebug.h"
 #include "qlocale.h"
@@ -25,6 +26,8 @@
 #include "private/qtools_p.h"
 #include "private/qsystemerror_p.h"
 
+#include <algorithm>
+
 #ifndef QT_NO_COMPRESS
 #  include <zconf.h>
 #  include <zlib.h>
@@ -114,10 +117,12 @@ private:
     short flags(int node) const;
 public:
     mutable QAtomicInt ref;
+    // set, under the cache's mutex, once decompressed data of this root is cached
+    mutable bool hasUncompressedData = false;
 
     inline QResourceRoot(): tree(nullptr), names(nullptr), payloads(nullptr), version(0) {}
     inline QResourceRoot(int version, const uchar *t, const uchar *n, const uchar *d) { setSource(version, t, n, d); }
-    virtual ~QResourceRoot() { }
+    virtual ~QResourceRoot();
     int findNode(const QString &path, const QLocale &locale=QLocale()) const;
     inline bool isContainer(int node) const { return flags(node) & Directory; }
     QResource::Compression compressionAlgo(int node)
@@ -168,6 +173,12 @@ struct QResourceGlobalData
     QRecursiveMutex resourceMutex;
     ResourceList resourceList;
     QStringList resourceSearchPaths;
+
+    // decompressed contents, keyed by the root providing the compressed data
+    // and its address
+    using UncompressedDataKey = std::pair<const QResourceRoot *, const uchar *>;
+    QMutex uncompressedDataCacheMutex;
+    QCache<UncompressedDataKey, QByteArray> uncompressedDataCache{0};
 };
 Q_GLOBAL_STATIC(QResourceGlobalData, resourceGlobalData)
 
@@ -180,6 +191,86 @@ static inline ResourceList *resourceList()
 static inline QStringList *resourceSearchPaths()
 { return &resourceGlobalData->resourceSearchPaths; }
 
+QResourceRoot::~QResourceRoot()
+{
+    // The data may be unmapped once the root is gone, and its address reused
+    // by another resource. Roots that never had data cached, like the
+    // temporaries qUnregisterResourceData() looks up with, skip the lock; the
+    // last deref() orders the flag before this.
+    if (!hasUncompressedData || resourceGlobalData.isDestroyed())
+        return;
+    QResourceGlobalData *global = resourceGlobalData();
+    const auto locker = qt_scoped_lock(global->uncompressedDataCacheMutex);
+    const auto keys = global->uncompressedDataCache.keys();
+    for (const QResourceGlobalData::UncompressedDataKey &key : keys) {
+        if (key.first == this)
+            global->uncompressedDataCache.remove(key);
+    }
+}
+
+#if QT_CONFIG(zstd)
+struct QResourceZstdFrame
+{
+    qint64 offset;              // in the uncompressed data
+    qint64 size;                // uncompressed
+    const uchar *data;
+    qsizetype compressedSize;
+};
+
+/*
+    rcc's --zstd-frame-size option stores files as a sequence of independent
+    zstd frames. Returns the total uncompressed size of the frames in data, or
+    -1 if it is not valid, and appends the frames to the list if one is given.
+*/
+static qint64 parseZstdFrames(const uchar *data, qint64 size,
+                              QList<QResourceZstdFrame> *frames = nullptr)
+{
+#if ZSTD_VERSION_NUMBER < 10400
+    // Older versions only declare ZSTD_findFrameCompressedSize() in their
+    // experimental API, so decode each frame to find where it ends. The
+    // result is cached per resource, see QResourcePrivate::ensureZstdFrames().
+    std::unique_ptr<ZSTD_DStream, decltype(&ZSTD_freeDStream)>
+            stream(ZSTD_createDStream(), &ZSTD_freeDStream);
+    if (!stream)
+        return -1;
+    QByteArray scratch(qsizetype(ZSTD_DStreamOutSize()), Qt::Uninitialized);
+#endif
+
+    qint64 total = 0;
+    while (size > 0) {
+        const unsigned long long contentSize = ZSTD_getFrameContentSize(data, size);
+        if (contentSize == ZSTD_CONTENTSIZE_UNKNOWN || contentSize == ZSTD_CONTENTSIZE_ERROR)
+            return -1;
+#if ZSTD_VERSION_NUMBER >= 10400
+        const size_t compressedSize = ZSTD_findFrameCompressedSize(data, size);
+        if (ZSTD_isError(compressedSize))
+            return -1;
+#else
+        if (ZSTD_isError(ZSTD_initDStream(stream.get())))
+            return -1;
+        ZSTD_inBuffer input = { data, size_t(size), 0 };
+        for (;;) {
+            ZSTD_outBuffer output = { scratch.data(), size_t(scratch.size()), 0 };
+            const size_t ret = ZSTD_decompressStream(stream.get(), &output, &input);
+            if (ZSTD_isError(ret))
+                return -1;
+            if (ret == 0)
+                break;      // end of this frame
+            if (input.pos == input.size && output.pos < output.size)
+                return -1;  // truncated
+        }
+        const size_t compressedSize = input.pos;
+#endif
+        if (frames)
+            frames->append({ total, qint64(contentSize), data, qsizetype(compressedSize) });
+        total += contentSize;
+        data += compressedSize;
+        size -= compressedSize;
+    }
+    return total;
+}
+#endif
+
 /*!
     \class QResource
     \inmodule QtCore
@@ -264,6 +355,9 @@ public:
 
     void ensureInitialized() const;
     void ensureChildren() const;
+#if QT_CONFIG(zstd)
+    void ensureZstdFrames() const;
+#endif
     qint64 uncompressedSize() const Q_DECL_PURE_FUNCTION;
     qsizetype decompress(char *buffer, qsizetype bufferSize) const;
 
@@ -277,6 +371,12 @@ public:
     mutable quint64 lastModified;
     mutable const uchar *data;
     mutable QStringList children;
+#if QT_CONFIG(zstd)
+    // parsed on first use; only filled for resources with several frames
+    mutable QList<QResourceZstdFrame> zstdFrames;
+#endif
+    static constexpr qint64 ZstdNotParsed = -2;
+    mutable qint64 zstdContentSize;
     mutable quint8 compressionAlgo;
     bool container;
     /* 2 or 6 padding bytes */
@@ -291,6 +391,10 @@ void QResourcePrivate::clear()
     compressionAlgo = QResource::NoCompression;
     data = nullptr;
     size = 0;
+#if QT_CONFIG(zstd)
+    zstdFrames.clear();
+#endif
+    zstdContentSize = ZstdNotParsed;
     children.clear();
     lastModified = 0;
     container = 0;
@@ -403,6 +507,17 @@ void QResourcePrivate::ensureChildren() const
     }
 }
 
+#if QT_CONFIG(zstd)
+void QResourcePrivate::ensureZstdFrames() const
+{
+    if (zstdContentSize != ZstdNotParsed)
+        return;
+    zstdContentSize = parseZstdFrames(data, size, &zstdFrames);
+    if (zstdContentSize < 0 || zstdFrames.size() < 2)
+        zstdFrames.clear();
+}
+#endif
+
 qint64 QResourcePrivate::uncompressedSize() const
 {
     switch (compressionAlgo) {
@@ -421,8 +536,8 @@ qint64 QResourcePrivate::uncompressedSize() const
 
     case QResource::ZstdCompression: {
 #if QT_CONFIG(zstd)
-        size_t n = ZSTD_getFrameContentSize(data, size);
-        return ZSTD_isError(n) ? -1 : qint64(n);
+        ensureZstdFrames();
+        return zstdContentSize;
 #else
         // This should not happen because we've refused to load such resource
         Q_ASSERT(!"QResource: Qt built without support for Zstd compression");
@@ -671,7 +786,8 @@ const uchar *QResource::data() const
     decompressing, a null QByteArray is returned.
 
     \note If the data was compressed, this function will decompress every time
-    it is called. The result is not cached between calls.
+    it is called, unless a cache was enabled with
+    setUncompressedDataCacheLimit().
 
     \sa uncompressedSize(), size(), compressionAlgorithm(), isFile()
 */
@@ -689,16 +805,67 @@ QByteArray QResource::uncompressedData() const
     if (d->compressionAlgo == NoCompression)
         return QByteArray::fromRawData(reinterpret_cast<const char *>(d->data), n);
 
+    QResourceGlobalData *global = resourceGlobalData();
+    const QResourceGlobalData::UncompressedDataKey cacheKey(d->related.first(), d->data);
+    {
+        const auto locker = qt_scoped_lock(global->uncompressedDataCacheMutex);
+        if (const QByteArray *cached = global->uncompressedDataCache.object(cacheKey))
+            return *cached;
+    }
+
     // decompress
     QByteArray result(n, Qt::Uninitialized);
     n = d->decompress(result.data(), n);
-    if (n < 0)
+    if (n < 0) {
         result.clear();
-    else
+    } else {
         result.truncate(n);
+        const auto locker = qt_scoped_lock(global->uncompressedDataCacheMutex);
+        if (global->uncompressedDataCache.maxCost() >= n) {
+            global->uncompressedDataCache.insert(cacheKey, new QByteArray(result), n);
+            d->related.first()->hasUncompressedData = true;
+        }
+    }
     return result;
 }
 
+/*!
+    \since 6.5
+
+    Sets the maximum number of bytes of decompressed resource data kept in
+    memory to \a bytes. The default is 0, which disables the cache.
+
+    When the cache is enabled, uncompressedData() and QFile keep the contents
+    of the compressed resources they decompress, so that reading the same
+    resource again does not decompress it again. The resources that were used
+    least recently are evicted first when the limit is reached. The cache is
+    shared by all threads, and emptied when resources are unregistered.
+
+    \sa uncompressedDataCacheLimit(), uncompressedData()
+*/
+void QResource::setUncompressedDataCacheLimit(qint64 bytes)
+{
+    QResourceGlobalData *global = resourceGlobalData();
+    const auto locker = qt_scoped_lock(global->uncompressedDataCacheMutex);
+    global->uncompressedDataCache.setMaxCost(
+            qsizetype(qBound<qint64>(0, bytes, std::numeric_limits<qsizetype>::max())));
+}
+
+/*!
+    \since 6.5
+
+    Returns the maximum number of bytes of decompressed resource data kept in
+    memory.
+
+    \sa setUncompressedDataCacheLimit()
+*/
+qint64 QResource::uncompressedDataCacheLimit()
+{
+    QResourceGlobalData *global = resourceGlobalData();
+    const auto locker = qt_scoped_lock(global->uncompressedDataCacheMutex);
+    return global->uncompressedDataCache.maxCost();
+}
+
 /*!
     \since 5.8
 
@@ -1106,20 +1273,24 @@ class QDynamicFileResourceRoot : public QDynamicBufferResourceRoot
     // for mmap'ed files, this is what needs to be unmapped.
     uchar *unmapPointer;
     qsizetype unmapLength;
+#if !defined(QT_USE_MMAP)
+    QFile mappedFile;
+#endif
 
 public:
     QDynamicFileResourceRoot(const QString &_root)
         : QDynamicBufferResourceRoot(_root), unmapPointer(nullptr), unmapLength(0)
     { }
     ~QDynamicFileResourceRoot() {
-#if defined(QT_USE_MMAP)
         if (unmapPointer) {
+#if defined(QT_USE_MMAP)
             munmap(reinterpret_cast<char *>(unmapPointer), unmapLength);
+#else
+            mappedFile.unmap(unmapPointer);
+#endif
             unmapPointer = nullptr;
             unmapLength = 0;
-        } else
-#endif
-        {
+        } else {
             delete[] mappingBuffer();
         }
     }
@@ -1160,6 +1331,22 @@ bool QDynamicFileResourceRoot::registerSelf(const QString &f)
         }
         QT_CLOSE(fd);
     }
+#else
+    // let the file engine map the file, so that pages are only loaded from
+    // disk when the resources in them are used
+    mappedFile.setFileName(f);
+    if (mappedFile.open(QIODevice::ReadOnly)) {
+        const qint64 fsize = mappedFile.size();
+        if (fsize > 0 && fsize <= std::numeric_limits<qsizetype>::max()) {
+            data = mappedFile.map(0, fsize);
+            if (data) {
+                data_len = fsize;
+                fromMM = true;
+            }
+        }
+        if (!data)
+            mappedFile.close();
+    }
 #endif // QT_USE_MMAP
     if (!data) {
         QFile file(f);
@@ -1346,11 +1533,25 @@ private:
     uchar *map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags);
     bool unmap(uchar *ptr);
     void uncompress() const;
+#if QT_CONFIG(zstd)
+    bool readZstdFrames(char *data, qint64 len);
+#endif
     qint64 offset;
     QResource resource;
     mutable QByteArray uncompressed;
+#if QT_CONFIG(zstd)
+    // for resources stored in several frames, which are decompressed as
+    // they are read instead of all at once
+    QList<QResourceZstdFrame> zstdFrames;
+    QByteArray zstdFrameData;
+    qsizetype zstdCurrentFrame = -1;
+    ZSTD_DCtx *zstdContext = nullptr;
+#endif
 protected:
     QResourceFileEnginePrivate() : offset(0) { }
+#if QT_CONFIG(zstd)
+    ~QResourceFileEnginePrivate() { ZSTD_freeDCtx(zstdContext); }
+#endif
 };
 
 bool QResourceFileEngine::caseSensitive() const
@@ -1387,7 +1588,17 @@ bool QResourceFileEngine::open(QIODevice::OpenMode flags,
     }
     if (flags & QIODevice::WriteOnly)
         return false;
-    if (d->resource.compressionAlgorithm() != QResource::NoCompression) {
+    bool decompressOnRead = false;
+#if QT_CONFIG(zstd)
+    d->zstdFrames.clear();
+    if (d->resource.compressionAlgorithm() == QResource::ZstdCompression && d->uncompressed.isNull()) {
+        const QResourcePrivate *resource = d->resource.d_func();
+        resource->ensureZstdFrames();
+        d->zstdFrames = resource->zstdFrames;
+        decompressOnRead = !d->zstdFrames.isEmpty();
+    }
+#endif
+    if (d->resource.compressionAlgorithm() != QResource::NoCompression && !decompressOnRead) {
         d->uncompress();
         if (d->uncompressed.isNull()) {
             d->errorString = QSystemError::stdString(EIO);
@@ -1405,6 +1616,10 @@ bool QResourceFileEngine::close()
 {
     Q_D(QResourceFileEngine);
     d->offset = 0;
+#if QT_CONFIG(zstd)
+    d->zstdFrameData.clear();
+    d->zstdCurrentFrame = -1;
+#endif
     return true;
 }
 
@@ -1420,10 +1635,16 @@ qint64 QResourceFileEngine::read(char *data, qint64 len)
         len = size() - d->offset;
     if (len <= 0)
         return 0;
-    if (!d->uncompressed.isNull())
+    if (!d->uncompressed.isNull()) {
         memcpy(data, d->uncompressed.constData() + d->offset, len);
-    else
+#if QT_CONFIG(zstd)
+    } else if (!d->zstdFrames.isEmpty()) {
+        if (!d->readZstdFrames(data, len))
+            return -1;
+#endif
+    } else {
         memcpy(data, d->resource.data() + d->offset, len);
+    }
     d->offset += len;
     return len;
 }
@@ -1596,6 +1817,46 @@ bool QResourceFileEnginePrivate::unmap(uchar *ptr)
     return true;
 }
 
+#if QT_CONFIG(zstd)
+bool QResourceFileEnginePrivate::readZstdFrames(char *data, qint64 len)
+{
+    Q_Q(QResourceFileEngine);
+    auto frame = std::upper_bound(zstdFrames.cbegin(), zstdFrames.cend(), offset,
+                                  [](qint64 offset, const QResourceZstdFrame &frame) {
+        return offset < frame.offset;
+    });
+    Q_ASSERT(frame != zstdFrames.cbegin());
+    --frame;
+
+    qint64 pos = offset;
+    while (len > 0) {
+        const qsizetype index = frame - zstdFrames.cbegin();
+        if (index != zstdCurrentFrame) {
+            if (!zstdContext)
+                zstdContext = ZSTD_createDCtx();
+            zstdFrameData.resize(frame->size);
+            const size_t n = ZSTD_decompressDCtx(zstdContext, zstdFrameData.data(), frame->size,
+                                                 frame->data, frame->compressedSize);
+            if (ZSTD_isError(n) || qint64(n) != frame->size) {
+                zstdCurrentFrame = -1;
+                q->setError(QFile::ReadError, QSystemError::stdString(EIO));
+                return false;
+            }
+            zstdCurrentFrame = index;
+        }
+
+        const qint64 inFrame = pos - frame->offset;
+        const qint64 chunk = qMin(len, frame->size - inFrame);
+        memcpy(data, zstdFrameData.constData() + inFrame, chunk);
+        data += chunk;
+        pos += chunk;
+        len -= chunk;
+        ++frame;
+    }
+    return true;
+}
+#endif
+
 void QResourceFileEnginePrivate::uncompress() const
 {
     if (resource.compressionAlgorithm() == QResource::NoCompression
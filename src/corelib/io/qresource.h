@@ -50,6 +50,9 @@ public:
     static bool registerResource(const uchar *rccData, const QString &resourceRoot=QString());
     static bool unregisterResource(const uchar *rccData, const QString &resourceRoot=QString());
 
+    static void setUncompressedDataCacheLimit(qint64 bytes);
+    static qint64 uncompressedDataCacheLimit();
+
 protected:
     friend class QResourceFileEngine;
     friend class QResourceFileEngineIterator;
@@ -113,6 +113,14 @@ QConfFile::~QConfFile()
         usedHashFunc()->remove(name);
 }
 
+void QConfFile::releaseIniData()
+{
+    unparsedIniSections.clear();
+    unparsedIniValues.clear();
+    iniData.clear();
+    indexedIniSections.clear();
+}
+
 ParsedSettingsMap QConfFile::mergedKeyMap() const
 {
     ParsedSettingsMap result = originalKeys;
@@ -1175,6 +1183,15 @@ void QConfFileSettingsPrivate::remove(const QString &key)
     }
     if (confFile->originalKeys.contains(theKey))
         confFile->removedKeys.insert(theKey, QVariant());
+
+    // the values of indexed keys need not be decoded to be removed
+    auto k = std::as_const(confFile->unparsedIniValues).lowerBound(prefix);
+    while (k != confFile->unparsedIniValues.constEnd() && k.key().startsWith(prefix)) {
+        confFile->removedKeys.insert(k.key(), QVariant());
+        ++k;
+    }
+    if (confFile->unparsedIniValues.contains(theKey))
+        confFile->removedKeys.insert(theKey, QVariant());
 }
 
 void QConfFileSettingsPrivate::set(const QString &key, const QVariant &value)
@@ -1205,7 +1222,7 @@ std::optional<QVariant> QConfFileSettingsPrivate::get(const QString &key) const
             found = (j != confFile->addedKeys.constEnd());
         }
         if (!found) {
-            ensureSectionParsed(confFile, theKey);
+            ensureKeyParsed(confFile, theKey);
             j = confFile->originalKeys.constFind(theKey);
             found = (j != confFile->originalKeys.constEnd()
                      && !confFile->removedKeys.contains(theKey));
@@ -1229,10 +1246,23 @@ QStringList QConfFileSettingsPrivate::children(const QString &prefix, ChildSpec
     for (auto confFile : std::as_const(confFiles)) {
         const auto locker = qt_scoped_lock(confFile->mutex);
 
-        if (thePrefix.isEmpty())
+        if (thePrefix.isEmpty() && spec == AllKeys) {
             ensureAllSectionsParsed(confFile);
-        else
+        } else if (thePrefix.isEmpty()) {
+            // The top-level keys are all in the [General] section, and the
+            // other sections are top-level groups if they have keys; there
+            // is no need to parse them.
+            ensureSectionParsed(confFile, thePrefix);
+            if (spec == ChildGroups) {
+                for (auto i = confFile->unparsedIniSections.cbegin(),
+                     end = confFile->unparsedIniSections.cend(); i != end; ++i) {
+                    if (!i.key().isEmpty() && iniSectionHasKeys(i.value()))
+                        processChild(QStringView{i.key().originalCaseKey()}, spec, result);
+                }
+            }
+        } else {
             ensureSectionParsed(confFile, thePrefix);
+        }
 
         auto j = const_cast<const ParsedSettingsMap *>(
                 &confFile->originalKeys)->lowerBound( thePrefix);
@@ -1242,6 +1272,13 @@ QStringList QConfFileSettingsPrivate::children(const QString &prefix, ChildSpec
             ++j;
         }
 
+        auto k = std::as_const(confFile->unparsedIniValues).lowerBound(thePrefix);
+        while (k != confFile->unparsedIniValues.constEnd() && k.key().startsWith(thePrefix)) {
+            if (!confFile->removedKeys.contains(k.key()))
+                processChild(QStringView{k.key().originalCaseKey()}.sliced(startPos), spec, result);
+            ++k;
+        }
+
         j = const_cast<const ParsedSettingsMap *>(
                 &confFile->addedKeys)->lowerBound(thePrefix);
         while (j != confFile->addedKeys.constEnd() && j.key().startsWith(thePrefix)) {
@@ -1364,7 +1401,7 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
                         || (confFile->size != 0 && confFile->timeStamp != fileInfo.lastModified()));
 
     if (mustReadFile) {
-        confFile->unparsedIniSections.clear();
+        confFile->releaseIniData();
         confFile->originalKeys.clear();
 
         QFile file(confFile->name);
@@ -1386,8 +1423,11 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
             } else
 #endif
             if (format <= QSettings::IniFormat) {
-                QByteArray data = file.readAll();
-                ok = readIniFile(data, &confFile->unparsedIniSections);
+                // The sections are only parsed when they are used, directly
+                // from our own copy of the file's contents, which stays valid
+                // whatever other writers do to the file meanwhile.
+                confFile->iniData = file.readAll();
+                ok = readIniFile(confFile->iniData, &confFile->unparsedIniSections);
             } else if (readFunc) {
                 QSettings::SettingsMap tempNewKeys;
                 ok = readFunc(file, tempNewKeys);
@@ -1459,7 +1499,7 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 #endif
 
         if (ok) {
-            confFile->unparsedIniSections.clear();
+            confFile->releaseIniData();
             confFile->originalKeys = mergedKeys;
             confFile->addedKeys.clear();
             confFile->removedKeys.clear();
@@ -1578,6 +1618,9 @@ break_out_of_outer_loop:
     Returns \c false on parse error. However, as many keys are read as
     possible, so if the user doesn't check the status he will get the
     most out of the file anyway.
+
+    The sections usually refer to \a data rather than copy it, so it must
+    outlive them.
 */
 bool QConfFileSettingsPrivate::readIniFile(QByteArrayView data,
                                            UnparsedSettingsMap *unparsedIniSections)
@@ -1587,9 +1630,13 @@ bool QConfFileSettingsPrivate::readIniFile(QByteArrayView data,
         QByteArray &sectionData = (*unparsedIniSections)[QSettingsKey(currentSection, \
                                                                       IniCaseSensitivity, \
                                                                       sectionPosition)]; \
-        if (!sectionData.isEmpty()) \
+        const QByteArrayView section = data.first(lineStart).sliced(currentSectionStart); \
+        if (sectionData.isNull()) { \
+            sectionData = QByteArray::fromRawData(section.data(), section.size()); \
+        } else { \
             sectionData.append('\n'); \
-        sectionData += data.first(lineStart).sliced(currentSectionStart); \
+            sectionData += section; \
+        } \
         sectionPosition = ++position; \
     }
 
@@ -1646,10 +1693,26 @@ bool QConfFileSettingsPrivate::readIniFile(QByteArrayView data,
 #undef FLUSH_CURRENT_SECTION
 }
 
-bool QConfFileSettingsPrivate::readIniSection(const QSettingsKey &section, QByteArrayView data,
-                                              ParsedSettingsMap *settingsMap)
+bool QConfFileSettingsPrivate::iniSectionHasKeys(QByteArrayView data)
+{
+    qsizetype dataPos = 0;
+    qsizetype lineStart;
+    qsizetype lineLen;
+    qsizetype equalsPos;
+    while (readIniLine(data, dataPos, lineStart, lineLen, equalsPos)) {
+        if (equalsPos != -1)
+            return true;
+    }
+    return false;
+}
+
+/*
+    Calls \a insert with the key and the raw value of each line of the
+    section \a section, whose contents are \a data.
+*/
+template <typename Insert>
+static bool readIniSectionKeys(const QSettingsKey &section, QByteArrayView data, Insert insert)
 {
-    QStringList strListValue;
     bool sectionIsLowercase = (section == section.originalCaseKey());
     qsizetype equalsPos;
 
@@ -1659,7 +1722,7 @@ bool QConfFileSettingsPrivate::readIniSection(const QSettingsKey &section, QByte
     qsizetype lineLen;
     qsizetype position = section.originalKeyPosition();
 
-    while (readIniLine(data, dataPos, lineStart, lineLen, equalsPos)) {
+    while (QConfFileSettingsPrivate::readIniLine(data, dataPos, lineStart, lineLen, equalsPos)) {
         QByteArrayView line = data.sliced(lineStart, lineLen);
         Q_ASSERT(!line.startsWith('['));
 
@@ -1677,28 +1740,53 @@ bool QConfFileSettingsPrivate::readIniSection(const QSettingsKey &section, QByte
         QByteArrayView value = line.sliced(equalsPos + 1);
 
         QString strKey = section.originalCaseKey();
-        const Qt::CaseSensitivity casing = iniUnescapedKey(key, strKey) && sectionIsLowercase
-                                           ? Qt::CaseSensitive
-                                           : IniCaseSensitivity;
-
-        QString strValue;
-        strValue.reserve(value.size());
-        QVariant variant = iniUnescapedStringList(value, strValue, strListValue)
-                           ? stringListToVariantList(strListValue)
-                           : stringToVariant(strValue);
+        const Qt::CaseSensitivity casing =
+                QSettingsPrivate::iniUnescapedKey(key, strKey) && sectionIsLowercase
+                ? Qt::CaseSensitive
+                : IniCaseSensitivity;
 
         /*
             We try to avoid the expensive toLower() call in
             QSettingsKey by passing Qt::CaseSensitive when the
             key is already in lowercase.
         */
-        settingsMap->insert(QSettingsKey(strKey, casing, position), std::move(variant));
+        insert(QSettingsKey(strKey, casing, position), value);
         ++position;
     }
 
     return ok;
 }
 
+bool QConfFileSettingsPrivate::readIniSection(const QSettingsKey &section, QByteArrayView data,
+                                              ParsedSettingsMap *settingsMap)
+{
+    return readIniSectionKeys(section, data, [settingsMap](QSettingsKey &&key, QByteArrayView value) {
+        settingsMap->insert(std::move(key), readIniValue(value));
+    });
+}
+
+/*
+    Like readIniSection(), but only unescapes the keys. The values refer to
+    \a data, and are decoded by readIniValue() when they are used.
+*/
+bool QConfFileSettingsPrivate::indexIniSection(const QSettingsKey &section, QByteArrayView data,
+                                               UnparsedValuesMap *valuesMap)
+{
+    return readIniSectionKeys(section, data, [valuesMap](QSettingsKey &&key, QByteArrayView value) {
+        valuesMap->insert(std::move(key), value);
+    });
+}
+
+QVariant QConfFileSettingsPrivate::readIniValue(QByteArrayView value)
+{
+    QString strValue;
+    QStringList strListValue;
+    strValue.reserve(value.size());
+    return iniUnescapedStringList(value, strValue, strListValue)
+            ? stringListToVariantList(strListValue)
+            : stringToVariant(strValue);
+}
+
 class QSettingsIniKey : public QString
 {
 public:
@@ -1831,34 +1919,76 @@ void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) cons
         if (!QConfFileSettingsPrivate::readIniSection(i.key(), i.value(), &confFile->originalKeys))
             setStatus(QSettings::FormatError);
     }
-    confFile->unparsedIniSections.clear();
+    const auto values = std::as_const(confFile->unparsedIniValues).asKeyValueRange();
+    for (const auto &[key, value] : values)
+        confFile->originalKeys.insert(key, readIniValue(value));
+    confFile->releaseIniData();
 }
 
-void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
-                                                   const QSettingsKey &key) const
+/*
+    Returns the unparsed section that \a key would be in, or the end.
+*/
+static UnparsedSettingsMap::iterator findIniSection(UnparsedSettingsMap &sections,
+                                                    const QSettingsKey &key)
 {
-    if (confFile->unparsedIniSections.isEmpty())
-        return;
-
-    UnparsedSettingsMap::iterator i;
-
     qsizetype indexOfSlash = key.indexOf(u'/');
     if (indexOfSlash != -1) {
-        i = confFile->unparsedIniSections.upperBound(key);
-        if (i == confFile->unparsedIniSections.begin())
-            return;
+        auto i = sections.upperBound(key);
+        if (i == sections.begin())
+            return sections.end();
         --i;
         if (i.key().isEmpty() || !key.startsWith(i.key()))
-            return;
-    } else {
-        i = confFile->unparsedIniSections.begin();
-        if (i == confFile->unparsedIniSections.end() || !i.key().isEmpty())
-            return;
+            return sections.end();
+        return i;
     }
+    auto i = sections.begin();
+    if (i == sections.end() || !i.key().isEmpty())
+        return sections.end();
+    return i;
+}
+
+void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
+                                                   const QSettingsKey &key) const
+{
+    if (confFile->unparsedIniSections.isEmpty())
+        return;
+
+    const auto i = findIniSection(confFile->unparsedIniSections, key);
+    if (i == confFile->unparsedIniSections.end())
+        return;
 
     if (!QConfFileSettingsPrivate::readIniSection(i.key(), i.value(), &confFile->originalKeys))
         setStatus(QSettings::FormatError);
     confFile->unparsedIniSections.erase(i);
+    if (confFile->unparsedIniSections.isEmpty() && confFile->unparsedIniValues.isEmpty())
+        confFile->releaseIniData();
+}
+
+/*
+    Makes sure that \a key is in originalKeys if it is in the file. Its
+    section is only indexed, so that the other values of the section are
+    decoded when they are used, if ever.
+*/
+void QConfFileSettingsPrivate::ensureKeyParsed(QConfFile *confFile, const QSettingsKey &key) const
+{
+    if (!confFile->unparsedIniSections.isEmpty()) {
+        const auto i = findIniSection(confFile->unparsedIniSections, key);
+        if (i != confFile->unparsedIniSections.end()) {
+            if (!indexIniSection(i.key(), i.value(), &confFile->unparsedIniValues))
+                setStatus(QSettings::FormatError);
+            // the values refer to the section's data, keep it
+            confFile->indexedIniSections.append(std::move(i.value()));
+            confFile->unparsedIniSections.erase(i);
+        }
+    }
+
+    const auto j = confFile->unparsedIniValues.find(key);
+    if (j == confFile->unparsedIniValues.end())
+        return;
+    confFile->originalKeys.insert(j.key(), readIniValue(j.value()));
+    confFile->unparsedIniValues.erase(j);
+    if (confFile->unparsedIniSections.isEmpty() && confFile->unparsedIniValues.isEmpty())
+        confFile->releaseIniData();
 }
 
 /*!
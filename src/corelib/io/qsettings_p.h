@@ -75,6 +75,7 @@ private:
 Q_DECLARE_TYPEINFO(QSettingsKey, Q_RELOCATABLE_TYPE);
 
 typedef QMap<QSettingsKey, QByteArray> UnparsedSettingsMap;
+typedef QMap<QSettingsKey, QByteArrayView> UnparsedValuesMap;
 typedef QMap<QSettingsKey, QVariant> ParsedSettingsMap;
 
 class QSettingsGroup
@@ -118,6 +119,7 @@ public:
 
     ParsedSettingsMap mergedKeyMap() const;
     bool isWritable() const;
+    void releaseIniData();
 
     static QConfFile *fromName(const QString &name, bool _userPerms);
     Q_AUTOTEST_EXPORT
@@ -127,6 +129,12 @@ public:
     QDateTime timeStamp;
     qint64 size;
     UnparsedSettingsMap unparsedIniSections;
+    // the keys of the sections that were indexed, with values still to decode
+    UnparsedValuesMap unparsedIniValues;
+    // what the unparsed sections and values refer to: the contents of the
+    // file, and the indexed sections that were put together from parts
+    QByteArray iniData;
+    QList<QByteArray> indexedIniSections;
     ParsedSettingsMap originalKeys;
     ParsedSettingsMap addedKeys;
     ParsedSettingsMap removedKeys;
@@ -239,6 +247,10 @@ public:
     bool readIniFile(QByteArrayView data, UnparsedSettingsMap *unparsedIniSections);
     static bool readIniSection(const QSettingsKey &section, QByteArrayView data,
                                ParsedSettingsMap *settingsMap);
+    static bool indexIniSection(const QSettingsKey &section, QByteArrayView data,
+                                UnparsedValuesMap *valuesMap);
+    static QVariant readIniValue(QByteArrayView value);
+    static bool iniSectionHasKeys(QByteArrayView data);
     static bool readIniLine(QByteArrayView data, qsizetype &dataPos,
                             qsizetype &lineStart, qsizetype &lineLen,
                             qsizetype &equalsPos);
@@ -254,6 +266,7 @@ private:
 #endif
     void ensureAllSectionsParsed(QConfFile *confFile) const;
     void ensureSectionParsed(QConfFile *confFile, const QSettingsKey &key) const;
+    void ensureKeyParsed(QConfFile *confFile, const QSettingsKey &key) const;
 
     QList<QConfFile *> confFiles;
     QSettings::ReadFunc readFunc;
@@ -472,7 +472,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
         for (const QPostEvent &pe : std::as_const(thisThreadData->postEventList)) {
             if (pe.event) {
                 --pe.receiver->d_func()->postedEvents;
-                pe.event->m_posted = false;
+                unpostEvent(pe.event);
                 delete pe.event;
             }
         }
@@ -1543,6 +1543,14 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     QThreadData *data = locker.threadData;
 
+    // a queued call of a Qt::CoalescedConnection that has not been delivered
+    // yet takes the arguments of this one
+    if (event->type() == QEvent::MetaCall
+        && static_cast<QAbstractMetaCallEvent *>(event)->coalesce()) {
+        delete event;
+        return;
+    }
+
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
@@ -1582,6 +1590,8 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     data->postEventList.addEvent(QPostEvent(receiver, event, priority));
     Q_UNUSED(eventDeleter.release());
     event->m_posted = true;
+    if (event->type() == QEvent::MetaCall)
+        static_cast<QAbstractMetaCallEvent *>(event)->setPosted(true);
     ++receiver->d_func()->postedEvents;
     data->canWait = false;
     locker.unlock();
@@ -1790,9 +1800,9 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
 
         // first, we diddle the event so that we can deliver
         // it, and that no one will try to touch it later.
-        pe.event->m_posted = false;
         QEvent *e = pe.event;
         QObject * r = pe.receiver;
+        QCoreApplicationPrivate::unpostEvent(e);
 
         --r->d_func()->postedEvents;
         Q_ASSERT(r->d_func()->postedEvents >= 0);
@@ -1860,7 +1870,7 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
         if ((!receiver || pe.receiver == receiver)
             && (pe.event && (eventType == 0 || pe.event->type() == eventType))) {
             --pe.receiver->d_func()->postedEvents;
-            pe.event->m_posted = false;
+            QCoreApplicationPrivate::unpostEvent(pe.event);
             events.append(pe.event);
             const_cast<QPostEvent &>(pe).event = nullptr;
         } else if (!data->postEventList.recursion) {
@@ -1921,7 +1931,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
                      pe.receiver->objectName().toLocal8Bit().data());
 #endif
             --pe.receiver->d_func()->postedEvents;
-            pe.event->m_posted = false;
+            unpostEvent(pe.event);
             delete pe.event;
             const_cast<QPostEvent &>(pe).event = nullptr;
             return;
@@ -1929,6 +1939,20 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     }
 }
 
+/*!
+    \internal
+
+    Marks \a event as taken out of the posted event list, whose mutex must be
+    locked. A queued call of a Qt::CoalescedConnection stops taking over the
+    arguments of later calls.
+*/
+void QCoreApplicationPrivate::unpostEvent(QEvent *event)
+{
+    event->m_posted = false;
+    if (event->type() == QEvent::MetaCall)
+        static_cast<QAbstractMetaCallEvent *>(event)->setPosted(false);
+}
+
 /*!\reimp
 
 */
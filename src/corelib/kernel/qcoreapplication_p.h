@@ -90,6 +90,7 @@ public:
     virtual void createEventDispatcher();
     virtual void eventDispatcherReady();
     static void removePostedEvent(QEvent *);
+    static void unpostEvent(QEvent *event);
 #ifdef Q_OS_WIN
     static void removePostedTimerEvent(QObject *object, int timerId);
 #endif
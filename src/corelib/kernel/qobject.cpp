@@ -304,6 +304,7 @@ inline void QObjectPrivate::addConnection(int signal, Connection *c)
     c->id = ++cd->currentConnectionId;
     c->prevConnectionList = connectionList.last.loadRelaxed();
     connectionList.last.storeRelaxed(c);
+    cd->invalidateSnapshot(connectionList);
 
     QObjectPrivate *rd = QObjectPrivate::get(c->receiver.loadRelaxed());
     rd->ensureConnectionData();
@@ -349,6 +350,8 @@ void QObjectPrivate::ConnectionData::removeConnection(QObjectPrivate::Connection
     Q_ASSERT(signalVector.loadRelaxed()->at(c->signal_index).first.loadRelaxed() != c);
     Q_ASSERT(signalVector.loadRelaxed()->at(c->signal_index).last.loadRelaxed() != c);
 
+    invalidateSnapshot(connections);
+
     // keep c->nextConnectionList intact, as it might still get accessed by activate
     Connection *n = c->nextConnectionList.loadRelaxed();
     if (n)
@@ -416,6 +419,9 @@ inline void QObjectPrivate::ConnectionData::deleteOrphaned(QObjectPrivate::Conne
         if (SignalVector *v = ConnectionOrSignalVector::asSignalVector(o)) {
             next = v->nextInOrphanList;
             free(v);
+        } else if (ConnectionSnapshot *s = ConnectionOrSignalVector::asConnectionSnapshot(o)) {
+            next = s->nextInOrphanList;
+            free(s);
         } else {
             QObjectPrivate::Connection *c = static_cast<Connection *>(o);
             next = c->nextInOrphanList;
@@ -428,6 +434,35 @@ inline void QObjectPrivate::ConnectionData::deleteOrphaned(QObjectPrivate::Conne
     }
 }
 
+/*! \internal
+
+  Returns the snapshot of the connections to \a signal, building it if needed,
+  or \nullptr if the sender's lock is contended. In that case, the caller needs
+  to walk the list itself.
+
+  The snapshot always comes from the current signal vector, so it can include
+  connections made after an activation started; those have a higher id.
+*/
+const QObjectPrivate::ConnectionSnapshot *
+QObjectPrivate::ConnectionData::snapshotForActivation(QObject *sender, int signal)
+{
+    if (const ConnectionSnapshot *snapshot = connectionsForSignal(signal).snapshot.loadAcquire())
+        return snapshot;
+
+    // Never block here: activate() may be called with the lock already held.
+    QBasicMutex *senderMutex = signalSlotLock(sender);
+    if (!senderMutex->tryLock())
+        return nullptr;
+    ConnectionList &list = connectionsForSignal(signal);
+    ConnectionSnapshot *snapshot = list.snapshot.loadRelaxed();
+    if (!snapshot) {
+        snapshot = ConnectionSnapshot::create(list);
+        list.snapshot.storeRelease(snapshot);
+    }
+    senderMutex->unlock();
+    return snapshot;
+}
+
 /*! \internal
 
   Returns \c true if the signal with index \a signal_index from object \a sender is connected.
@@ -495,6 +530,58 @@ QAbstractMetaCallEvent::~QAbstractMetaCallEvent()
     if (semaphore_)
         semaphore_->release();
 #endif
+    if (coalescingConnection_) {
+        // Only a call deleted while it is still posted is pending here. Like
+        // QCoreApplicationPrivate::removePostedEvent(), assume that it is
+        // deleted by the receiver's thread.
+        if (coalescingConnection_->pendingCall.loadRelaxed() == this) {
+            QMutexLocker locker(&QThreadData::current()->postEventList.mutex);
+            coalescingConnection_->pendingCall.testAndSetRelaxed(this, nullptr);
+        }
+        coalescingConnection_->deref();
+    }
+}
+
+/*!
+    \internal
+
+    Makes this call one of the Qt::CoalescedConnection \a c, which is kept
+    alive as long as this event exists.
+ */
+void QAbstractMetaCallEvent::setCoalescingConnection(QObjectPrivate::Connection *c)
+{
+    Q_ASSERT(!coalescingConnection_);
+    c->ref();
+    coalescingConnection_ = c;
+}
+
+/*!
+    \internal
+
+    Hands the arguments of this call over to the call of the same connection
+    that is still waiting in the posted event list, if there is one. Returns
+    \c true if this event is not needed anymore.
+ */
+bool QAbstractMetaCallEvent::mergeIntoPendingCall()
+{
+    QAbstractMetaCallEvent *pending = coalescingConnection_->pendingCall.loadRelaxed();
+    return pending && static_cast<QMetaCallEvent *>(pending)->takeArguments(
+                static_cast<QMetaCallEvent *>(this));
+}
+
+/*!
+    \internal
+
+    Records whether this call is waiting in the posted event list. It stops
+    waiting whenever it is taken out of the list, with the list's mutex
+    locked, see QCoreApplicationPrivate::unpostEvent().
+ */
+void QAbstractMetaCallEvent::setPendingCall(bool pending)
+{
+    if (pending)
+        coalescingConnection_->pendingCall.storeRelaxed(this);
+    else
+        coalescingConnection_->pendingCall.testAndSetRelaxed(this, nullptr);
 }
 
 /*!
@@ -614,6 +701,28 @@ void QMetaCallEvent::placeMetaCall(QObject *object)
     }
 }
 
+/*!
+    \internal
+
+    Replaces the arguments of this event with those of \a other, if they have
+    the same types, and hands the old arguments over to \a other. Returns \c
+    false if the arguments are not compatible.
+ */
+bool QMetaCallEvent::takeArguments(QMetaCallEvent *other)
+{
+    if (d.nargs_ != other->d.nargs_)
+        return false;
+    const QMetaType *t = types();
+    const QMetaType *otherTypes = other->types();
+    for (int i = 0; i < d.nargs_; ++i) {
+        if (t[i] != otherTypes[i])
+            return false;
+    }
+    for (int i = 0; i < d.nargs_; ++i)
+        std::swap(d.args_[i], other->d.args_[i]);
+    return true;
+}
+
 /*!
     \class QSignalBlocker
     \brief Exception-safe wrapper around QObject::blockSignals().
@@ -3471,6 +3580,8 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
 
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
+    const bool isCoalesced = type & Qt::CoalescedConnection;
+    type &= ~Qt::CoalescedConnection;
 
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
@@ -3489,6 +3600,7 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->argumentTypes.storeRelaxed(types);
     c->callFunction = callFunction;
     c->isSingleShot = isSingleShot;
+    c->isCoalesced = isCoalesced;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
 
@@ -3844,6 +3956,9 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         return;
     }
 
+    if (c->isCoalesced)
+        ev->setCoalescingConnection(c);
+
     locker.relock();
     if (!c->isSingleShot && !c->receiver.loadRelaxed()) {
         // the connection has been disconnected while we were unlocked
@@ -3904,16 +4019,40 @@ void doActivate(QObject *sender, int signal_index, void **argv)
 
     Qt::HANDLE currentThreadId = QThread::currentThreadId();
     bool inSenderThread = currentThreadId == QObjectPrivate::get(sender)->threadData.loadRelaxed()->threadId.loadRelaxed();
+    // Receivers usually share a thread, so only look at its id when the thread data changes
+    QThreadData *lastReceiverThreadData = nullptr;
+    bool lastReceiverInSameThread = false;
 
     // We need to check against the highest connection id to ensure that signals added
     // during the signal emission are not emitted in this emission.
     uint highestConnectionId = connections->currentConnectionId.loadRelaxed();
     do {
-        QObjectPrivate::Connection *c = list->first.loadRelaxed();
-        if (!c)
+        QObjectPrivate::Connection *first = list->first.loadRelaxed();
+        if (!first)
             continue;
 
-        do {
+        // Iterate over the flattened connections, unless there is only one
+        QObjectPrivate::Connection *const *it = &first;
+        QObjectPrivate::Connection *const *end = it + 1;
+        QVarLengthArray<QObjectPrivate::Connection *, 16> walked;
+        if (first != list->last.loadRelaxed()) {
+            const int listIndex = list == &signalVector->at(-1) ? -1 : signal_index;
+            if (const auto *snapshot = connections->snapshotForActivation(sender, listIndex)) {
+                it = snapshot->begin();
+                end = snapshot->end();
+            } else {
+                for (auto *c = first; c; c = c->nextConnectionList.loadRelaxed())
+                    walked.append(c);
+                it = walked.cbegin();
+                end = walked.cend();
+            }
+        }
+
+        for (; it != end; ++it) {
+            QObjectPrivate::Connection *c = *it;
+            if (c->id > highestConnectionId)
+                break;
+
             QObject * const receiver = c->receiver.loadRelaxed();
             if (!receiver)
                 continue;
@@ -3924,7 +4063,11 @@ void doActivate(QObject *sender, int signal_index, void **argv)
 
             bool receiverInSameThread;
             if (inSenderThread) {
-                receiverInSameThread = currentThreadId == td->threadId.loadRelaxed();
+                if (td != lastReceiverThreadData) {
+                    lastReceiverThreadData = td;
+                    lastReceiverInSameThread = currentThreadId == td->threadId.loadRelaxed();
+                }
+                receiverInSameThread = lastReceiverInSameThread;
             } else {
                 // need to lock before reading the threadId, because moveToThread() could interfere
                 QMutexLocker lock(signalSlotLock(receiver));
@@ -4008,7 +4151,7 @@ void doActivate(QObject *sender, int signal_index, void **argv)
                 if (callbacks_enabled && signal_spy_set->slot_end_callback != nullptr)
                     signal_spy_set->slot_end_callback(receiver, method);
             }
-        } while ((c = c->nextConnectionList.loadRelaxed()) != nullptr && c->id <= highestConnectionId);
+        }
 
     } while (list != &signalVector->at(-1) &&
         //start over for all signals;
@@ -5102,6 +5245,8 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
 
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
+    const bool isCoalesced = type & Qt::CoalescedConnection;
+    type &= ~Qt::CoalescedConnection;
 
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
@@ -5121,6 +5266,7 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
         c->ownArgumentTypes = false;
     }
     c->isSingleShot = isSingleShot;
+    c->isCoalesced = isCoalesced;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
     QMetaObject::Connection ret(c.release());
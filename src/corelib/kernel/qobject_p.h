@@ -101,6 +101,7 @@ public:
     struct ConnectionData;
     struct ConnectionList;
     struct ConnectionOrSignalVector;
+    struct ConnectionSnapshot;
     struct SignalVector;
     struct Sender;
 
@@ -358,9 +359,25 @@ public:
     inline const QObject *sender() const { return sender_; }
     inline int signalId() const { return signalId_; }
 
+    // Calls through a Qt::CoalescedConnection are always QMetaCallEvents. The
+    // connection points to such a call while it is in the posted event list,
+    // so that later calls can hand their arguments over to it. coalesce() and
+    // setPosted() must be called with the list's mutex locked.
+    void setCoalescingConnection(QObjectPrivate::Connection *c);
+    inline bool coalesce() { return coalescingConnection_ && mergeIntoPendingCall(); }
+    inline void setPosted(bool posted)
+    {
+        if (coalescingConnection_)
+            setPendingCall(posted);
+    }
+
 private:
+    bool mergeIntoPendingCall();
+    void setPendingCall(bool pending);
+
     int signalId_;
     const QObject *sender_;
+    QObjectPrivate::Connection *coalescingConnection_ = nullptr;
 #if QT_CONFIG(thread)
     QSemaphore *semaphore_;
 #endif
@@ -397,6 +414,8 @@ public:
 
     virtual void placeMetaCall(QObject *object) override;
 
+    bool takeArguments(QMetaCallEvent *other);
+
 private:
     inline void allocArgs();
 
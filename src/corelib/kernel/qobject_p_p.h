@@ -25,11 +25,13 @@
 
 QT_BEGIN_NAMESPACE
 
-// ConnectionList is a singly-linked list
+// ConnectionList is a singly-linked list. Emission iterates over snapshot, a
+// flattened copy of the list that is built lazily and dropped on every change.
 struct QObjectPrivate::ConnectionList
 {
     QAtomicPointer<Connection> first;
     QAtomicPointer<Connection> last;
+    QAtomicPointer<ConnectionSnapshot> snapshot;
 };
 static_assert(std::is_trivially_destructible_v<QObjectPrivate::ConnectionList>);
 Q_DECLARE_TYPEINFO(QObjectPrivate::ConnectionList, Q_RELOCATABLE_TYPE);
@@ -53,6 +55,16 @@ struct QObjectPrivate::ConnectionOrSignalVector
     {
         return reinterpret_cast<Connection *>(reinterpret_cast<quintptr>(v) | quintptr(1u));
     }
+    static ConnectionSnapshot *asConnectionSnapshot(ConnectionOrSignalVector *c)
+    {
+        if (reinterpret_cast<quintptr>(c) & 2)
+            return reinterpret_cast<ConnectionSnapshot *>(reinterpret_cast<quintptr>(c) & ~quintptr(2u));
+        return nullptr;
+    }
+    static Connection *fromConnectionSnapshot(ConnectionSnapshot *s)
+    {
+        return reinterpret_cast<Connection *>(reinterpret_cast<quintptr>(s) | quintptr(2u));
+    }
 };
 static_assert(std::is_trivial_v<QObjectPrivate::ConnectionOrSignalVector>);
 
@@ -72,6 +84,8 @@ struct QObjectPrivate::Connection : public ConnectionOrSignalVector
         QtPrivate::QSlotObjectBase *slotObj;
     };
     QAtomicPointer<const int> argumentTypes;
+    // the queued call of a coalesced connection that has not been delivered yet
+    QAtomicPointer<QAbstractMetaCallEvent> pendingCall;
     QAtomicInt ref_{
         2
     }; // ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
@@ -83,6 +97,7 @@ struct QObjectPrivate::Connection : public ConnectionOrSignalVector
     ushort isSlotObject : 1;
     ushort ownArgumentTypes : 1;
     ushort isSingleShot : 1;
+    ushort isCoalesced : 1;
     Connection() : ownArgumentTypes(true) { }
     ~Connection();
     int method() const
@@ -123,6 +138,34 @@ struct QObjectPrivate::SignalVector : public ConnectionOrSignalVector
 static_assert(
         std::is_trivial_v<QObjectPrivate::SignalVector>); // it doesn't need to be, but it helps
 
+// ConnectionSnapshot is an immutable array of the connections of one ConnectionList,
+// in connection order. Disconnecting invalidates the snapshot, but the connections
+// stay alive (with a null receiver) until the orphans are cleaned up, so an emission
+// already iterating over it simply skips them.
+struct QObjectPrivate::ConnectionSnapshot : public ConnectionOrSignalVector
+{
+    quintptr count;
+    // Connection *connections[]
+    Connection *const *begin() const { return reinterpret_cast<Connection *const *>(this + 1); }
+    Connection *const *end() const { return begin() + count; }
+
+    static ConnectionSnapshot *create(const ConnectionList &list)
+    {
+        quintptr count = 0;
+        for (Connection *c = list.first.loadRelaxed(); c; c = c->nextConnectionList.loadRelaxed())
+            ++count;
+        void *ptr = malloc(sizeof(ConnectionSnapshot) + count * sizeof(Connection *));
+        auto snapshot = new (ptr) ConnectionSnapshot;
+        snapshot->nextInOrphanList = nullptr;
+        snapshot->count = count;
+        Connection **connections = reinterpret_cast<Connection **>(snapshot + 1);
+        for (Connection *c = list.first.loadRelaxed(); c; c = c->nextConnectionList.loadRelaxed())
+            *connections++ = c;
+        return snapshot;
+    }
+};
+static_assert(std::is_trivial_v<QObjectPrivate::ConnectionSnapshot>);
+
 struct QObjectPrivate::ConnectionData
 {
     // the id below is used to avoid activating new connections. When the object gets
@@ -142,6 +185,8 @@ struct QObjectPrivate::ConnectionData
             deleteOrphaned(c);
         SignalVector *v = signalVector.loadRelaxed();
         if (v) {
+            for (int i = -1; i < v->count(); ++i)
+                free(v->at(i).snapshot.loadRelaxed());
             v->~SignalVector();
             free(v);
         }
@@ -169,6 +214,22 @@ struct QObjectPrivate::ConnectionData
         return signalVector.loadRelaxed()->at(signal);
     }
 
+    // must be called with the senders lock held whenever the list changes
+    void invalidateSnapshot(ConnectionList &list)
+    {
+        ConnectionSnapshot *snapshot = list.snapshot.fetchAndStoreRelaxed(nullptr);
+        if (!snapshot)
+            return;
+        // an activate() in progress might still iterate over it
+        Connection *o = nullptr;
+        do {
+            o = orphaned.loadRelaxed();
+            snapshot->nextInOrphanList = o;
+        } while (!orphaned.testAndSetRelease(
+                o, ConnectionOrSignalVector::fromConnectionSnapshot(snapshot)));
+    }
+    const ConnectionSnapshot *snapshotForActivation(QObject *sender, int signal);
+
     void resizeSignalVector(uint size)
     {
         SignalVector *vector = this->signalVector.loadRelaxed();
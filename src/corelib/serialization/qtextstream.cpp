@@ -198,7 +198,9 @@ static const int QTEXTSTREAM_BUFFERSIZE = 16384;
 
 #include <locale.h>
 #include "private/qlocale_p.h"
+#include "private/qlocale_tools_p.h"
 #include "private/qstringconverter_p.h"
+#include "private/qsimd_p.h"
 
 #include <stdlib.h>
 #include <limits.h>
@@ -376,8 +378,13 @@ bool QTextStreamPrivate::fillReadBuffer(qint64 maxBytes)
            QtDebugUtils::toPrintable(buf, bytesRead, 32).constData(), int(sizeof(buf)), int(bytesRead));
 #endif
 
+    // decode straight into the read buffer, rather than into a temporary
+    // string that would then be appended to it
     int oldReadBufferSize = readBuffer.size();
-    readBuffer += toUtf16(QByteArrayView(buf, bytesRead));
+    readBuffer.resize(oldReadBufferSize + toUtf16.requiredSpace(bytesRead));
+    QChar *decodedEnd = toUtf16.appendToBuffer(readBuffer.data() + oldReadBufferSize,
+                                               QByteArrayView(buf, bytesRead));
+    readBuffer.truncate(decodedEnd - readBuffer.constData());
 
     // remove all '\r\n' in the string.
     if (readBuffer.size() > oldReadBufferSize && textModeEnabled) {
@@ -510,6 +517,63 @@ QString QTextStreamPrivate::read(int maxlen)
     return ret;
 }
 
+/*!
+    \internal
+
+    Returns a pointer to the first space character in [\a ptr, \a end), or
+    \a end if there is none.
+*/
+static const QChar *findSpace(const QChar *ptr, const QChar *end)
+{
+#ifdef __SSE2__
+    // Printable ASCII characters are never spaces, so only the blocks that
+    // contain something else need to be looked at more closely. The signed
+    // comparison counts characters from U+8000 up as below '!'.
+    const __m128i firstPrintable = _mm_set1_epi16('!');
+    const __m128i lastPrintable = _mm_set1_epi16('~');
+    while (end - ptr >= 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        const __m128i other = _mm_or_si128(_mm_cmplt_epi16(data, firstPrintable),
+                                           _mm_cmpgt_epi16(data, lastPrintable));
+        if (_mm_movemask_epi8(other)) {
+            for (const QChar *blockEnd = ptr + 8; ptr != blockEnd; ++ptr) {
+                if (ptr->isSpace())
+                    return ptr;
+            }
+        } else {
+            ptr += 8;
+        }
+    }
+#endif
+    for (; ptr != end; ++ptr) {
+        if (ptr->isSpace())
+            return ptr;
+    }
+    return end;
+}
+
+/*!
+    \internal
+
+    Returns a pointer to the first character in [\a ptr, \a end) that ends
+    a token separated by \a delimiter, or \a end if there is none.
+*/
+static const QChar *findDelimiter(const QChar *ptr, const QChar *end,
+                                  QTextStreamPrivate::TokenDelimiter delimiter)
+{
+    switch (delimiter) {
+    case QTextStreamPrivate::Space:
+        return findSpace(ptr, end);
+    case QTextStreamPrivate::NotSpace:
+        while (ptr != end && ptr->isSpace())
+            ++ptr;
+        return ptr;
+    case QTextStreamPrivate::EndOfLine:
+        return reinterpret_cast<const QChar *>(QtPrivate::qustrchr(QStringView(ptr, end), u'\n'));
+    }
+    Q_UNREACHABLE_RETURN(end);
+}
+
 /*!
     \internal
 
@@ -536,35 +600,27 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
             chPtr = string->constData();
             endOffset = string->size();
         }
-        chPtr += startOffset;
-
-        for (; !foundToken && startOffset < endOffset && (!maxlen || totalSize < maxlen); ++startOffset) {
-            const QChar ch = *chPtr++;
-            ++totalSize;
-
-            switch (delimiter) {
-            case Space:
-                if (ch.isSpace()) {
-                    foundToken = true;
-                    delimSize = 1;
-                }
-                break;
-            case NotSpace:
-                if (!ch.isSpace()) {
-                    foundToken = true;
-                    delimSize = 1;
-                }
-                break;
-            case EndOfLine:
-                if (ch == u'\n') {
-                    foundToken = true;
-                    delimSize = (lastChar == u'\r') ? 2 : 1;
-                    consumeDelimiter = true;
-                }
-                lastChar = ch;
-                break;
+        if (maxlen)
+            endOffset = qMin(endOffset, startOffset + (maxlen - totalSize));
+
+        const QChar *begin = chPtr + startOffset;
+        const QChar *end = chPtr + endOffset;
+        const QChar *found = findDelimiter(begin, end, delimiter);
+        if (found != end) {
+            foundToken = true;
+            delimSize = 1;
+            if (delimiter == EndOfLine) {
+                if ((found == begin ? lastChar : found[-1]) == u'\r')
+                    delimSize = 2;
+                consumeDelimiter = true;
             }
+            ++found;
         }
+        if (found != begin)
+            lastChar = found[-1];
+
+        totalSize += int(found - begin);
+        startOffset += int(found - begin);
     } while (!foundToken
              && (!maxlen || totalSize < maxlen)
              && device && fillReadBuffer());
@@ -642,7 +698,8 @@ inline void QTextStreamPrivate::consume(int size)
         readBufferOffset += size;
         if (readBufferOffset >= readBuffer.size()) {
             readBufferOffset = 0;
-            readBuffer.clear();
+            // keep the allocation for the next fillReadBuffer()
+            readBuffer.resize(0);
             saveConverterState(device->pos());
         } else if (readBufferOffset > QTEXTSTREAM_BUFFERSIZE) {
             readBuffer = readBuffer.remove(0,readBufferOffset);
@@ -740,8 +797,12 @@ void QTextStreamPrivate::writePadding(qsizetype len)
 */
 inline bool QTextStreamPrivate::getChar(QChar *ch)
 {
-    if ((string && stringOffset == string->size())
-        || (device && readBuffer.isEmpty() && !fillReadBuffer())) {
+    // Data read from the device may decode to nothing, such as the first
+    // bytes of a multi-byte character, so keep reading until it does not
+    bool atEnd = string && stringOffset == string->size();
+    while (!atEnd && device && readBuffer.isEmpty())
+        atEnd = !fillReadBuffer();
+    if (atEnd) {
         if (ch)
             *ch = QChar();
         return false;
@@ -1598,6 +1659,81 @@ QString QTextStream::read(qint64 maxlen)
     return d->read(int(maxlen));
 }
 
+/*!
+    \internal
+
+    Returns the decoded data that can be read without refilling the buffer.
+*/
+inline QStringView QTextStreamPrivate::bufferedData() const
+{
+    if (string)
+        return QStringView(*string).sliced(stringOffset);
+    return QStringView(readBuffer).sliced(readBufferOffset);
+}
+
+static inline bool isAsciiDigit(QChar ch)
+{
+    return ch.unicode() >= '0' && ch.unicode() <= '9';
+}
+
+/*!
+    \internal
+
+    Returns \c true if the number at the beginning of \a data certainly
+    ends at \a end: it is followed by a character that cannot continue it,
+    rather than by data that has not been read yet.
+*/
+bool QTextStreamPrivate::isCompleteNumber(QStringView data, qsizetype end) const
+{
+    if (end == data.size())
+        return string != nullptr;
+    // non-ASCII digits, separators and signs are left to the slow path
+    const QChar next = data.at(end);
+    return next.unicode() < 0x80 && !next.isLetterOrNumber() && next != u'.' && next != u'+'
+            && next != u'-';
+}
+
+/*!
+    \internal
+
+    Parses a decimal integer in the C locale directly from the buffered
+    data, rather than character by character with getChar() and ungetChar().
+    Returns \c false, without consuming anything, for input that needs the
+    general rules of getNumber().
+*/
+bool QTextStreamPrivate::getDecimalFromBuffer(qulonglong *ret)
+{
+    const QStringView data = bufferedData();
+    qsizetype i = 0;
+    bool negative = false;
+    if (!data.isEmpty() && (data.front() == u'-' || data.front() == u'+')) {
+        negative = data.front() == u'-';
+        ++i;
+    }
+    const qsizetype firstDigit = i;
+    qulonglong val = 0;
+    for (; i < data.size() && isAsciiDigit(data.at(i)); ++i)
+        val = val * 10 + (data.at(i).unicode() - '0');
+    if (i == firstDigit || !isCompleteNumber(data, i))
+        return false;
+    // automatic base detection reads a leading 0 as the octal prefix
+    if (params.integerBase == 0 && firstDigit == 0 && i > 1 && data.front() == u'0'
+            && data.at(1) <= u'7') {
+        return false;
+    }
+
+    if (negative) {
+        qlonglong ival = qlonglong(val);
+        if (ival > 0)
+            ival = -ival;
+        val = qulonglong(ival);
+    }
+    consume(int(i));
+    if (ret)
+        *ret = val;
+    return true;
+}
+
 /*!
     \internal
 */
@@ -1606,6 +1742,11 @@ QTextStreamPrivate::NumberParsingStatus QTextStreamPrivate::getNumber(qulonglong
     scan(nullptr, nullptr, 0, NotSpace);
     consumeLastToken();
 
+    if ((params.integerBase == 0 || params.integerBase == 10) && locale == QLocale::c()
+            && getDecimalFromBuffer(ret)) {
+        return npsOk;
+    }
+
     // detect int encoding
     int base = params.integerBase;
     if (base == 0) {
@@ -1836,6 +1977,50 @@ bool QTextStreamPrivate::getReal(double *f)
     consumeLastToken();
 
     const int BufferSize = 128;
+
+    // Plain numbers in the C locale are converted straight from the buffer;
+    // the state machine below deals with everything else.
+    if (locale == QLocale::c()) {
+        const QStringView data = bufferedData();
+        const auto skipDigits = [&data](qsizetype i) {
+            while (i < data.size() && isAsciiDigit(data.at(i)))
+                ++i;
+            return i;
+        };
+        qsizetype i = 0;
+        if (!data.isEmpty() && (data.front() == u'-' || data.front() == u'+'))
+            ++i;
+        qsizetype end = skipDigits(i);
+        bool valid = end > i;
+        if (end < data.size() && data.at(end) == u'.') {
+            i = end + 1;
+            end = skipDigits(i);
+            valid = end > i;
+        }
+        if (valid && end < data.size() && (data.at(end) == u'e' || data.at(end) == u'E')) {
+            i = end + 1;
+            if (i < data.size() && (data.at(i) == u'-' || data.at(i) == u'+'))
+                ++i;
+            end = skipDigits(i);
+            valid = end > i;
+        }
+        if (valid && end <= BufferSize - 5 && isCompleteNumber(data, end)) {
+            // The token is already in the form that QLocale::toDouble() would
+            // convert it to for the C locale, so skip that step
+            bool ok = true;
+            if (f) {
+                char buf[BufferSize];
+                for (qsizetype j = 0; j < end; ++j)
+                    buf[j] = char(data.at(j).unicode());
+                const auto r = qt_asciiToDouble(buf, end);
+                *f = r.result;
+                ok = r.ok();
+            }
+            consume(int(end));
+            return ok;
+        }
+    }
+
     char buf[BufferSize];
     int i = 0;
 
@@ -138,6 +138,9 @@ public:
     inline void ungetChar(QChar ch);
     NumberParsingStatus getNumber(qulonglong *l);
     bool getReal(double *f);
+    inline QStringView bufferedData() const;
+    bool isCompleteNumber(QStringView data, qsizetype end) const;
+    bool getDecimalFromBuffer(qulonglong *l);
 
     inline void write(QStringView data) { write(data.begin(), data.size()); }
     inline void write(QChar ch);
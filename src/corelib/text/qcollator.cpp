@@ -9,6 +9,15 @@
 #include "qdebug.h"
 #include "qlocale_p.h"
 #include "qthreadstorage.h"
+#if QT_CONFIG(thread)
+#include "qatomic.h"
+#include "qsemaphore.h"
+#include "qthreadpool.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -372,6 +381,309 @@ QCollatorSortKey QCollator::defaultSortKey(QStringView key)
     \note Not supported with the C (a.k.a. POSIX) locale on Darwin.
 */
 
+/*!
+    \since 6.5
+
+    Returns a binary sort key for \a string.
+
+    Binary sort keys compare byte by byte, for example with the comparison
+    operators of QByteArray or with \c memcmp(), in the same order as
+    compare() compares the strings they were made from; when one key is a
+    prefix of another, it sorts first. Unlike a QCollatorSortKey, a binary
+    sort key is plain data: it can be stored, for example in a database
+    index, and compared without a QCollator.
+
+    Keys are only comparable to keys from a collator with the same locale
+    and options. Their content depends on the collation library and its
+    version, so keys that have been stored need to be made again when those
+    change.
+
+    \sa sort(), sortKey(), compare()
+*/
+QByteArray QCollator::binarySortKey(QStringView string) const
+{
+    QByteArray key;
+    d->appendBinarySortKey(key, string);
+    return key;
+}
+
+void QCollatorPrivate::appendPlainSortKey(QByteArray &key, QStringView string,
+                                          Qt::CaseSensitivity cs)
+{
+    const qsizetype start = key.size();
+    uchar *out;
+    if (cs == Qt::CaseSensitive) {
+        // QStringView::compare() compares UTF-16 code units:
+        key.resize(start + 2 * string.size());
+        out = reinterpret_cast<uchar *>(key.data() + start);
+        for (QChar ch : string) {
+            *out++ = uchar(ch.unicode() >> 8);
+            *out++ = uchar(ch.unicode());
+        }
+        return;
+    }
+
+    // Without case sensitivity, it compares the case folded code units,
+    // except that the low surrogate of a pair stands for the case folded
+    // code point. That takes 21 bits.
+    key.resize(start + 3 * string.size());
+    out = reinterpret_cast<uchar *>(key.data() + start);
+    char16_t last = 0;
+    for (QChar ch : string) {
+        char32_t folded = ch.unicode();
+        if (ch.isLowSurrogate() && QChar::isHighSurrogate(last))
+            folded = QChar::surrogateToUcs4(last, ch.unicode());
+        folded = QChar::toCaseFolded(folded);
+        last = ch.unicode();
+        *out++ = uchar(folded >> 16);
+        *out++ = uchar(folded >> 8);
+        *out++ = uchar(folded);
+    }
+}
+
+namespace {
+// A string to sort, by its binary sort key, and then by its position in the
+// list, which makes the sorting stable.
+struct SortEntry
+{
+    const uchar *key;
+    qsizetype size;
+    qsizetype index;
+};
+
+// Compares the keys after their first depth bytes, which are the same
+bool sortsBefore(const SortEntry &lhs, const SortEntry &rhs, qsizetype depth)
+{
+    const qsizetype common = qMin(lhs.size, rhs.size) - depth;
+    if (common > 0) {
+        if (int cmp = std::memcmp(lhs.key + depth, rhs.key + depth, size_t(common)))
+            return cmp < 0;
+    }
+    if (lhs.size != rhs.size)
+        return lhs.size < rhs.size;
+    return lhs.index < rhs.index;
+}
+
+/*
+    Sorts [first, last), whose keys share their first depth bytes, with a
+    most significant digit first radix sort on the bytes of the keys.
+    scratch has room for as many entries.
+
+    The distribution into buckets keeps the order of the entries within each
+    bucket, so that those whose keys have ended remain in the order of their
+    indexes; small buckets are left to std::sort().
+*/
+void radixSort(SortEntry *first, SortEntry *last, SortEntry *scratch, qsizetype depth)
+{
+    constexpr qsizetype SmallBucket = 32;
+    for (;;) {
+        const qsizetype count = last - first;
+        if (count < SmallBucket) {
+            std::sort(first, last, [depth](const SortEntry &lhs, const SortEntry &rhs) {
+                return sortsBefore(lhs, rhs, depth);
+            });
+            return;
+        }
+
+        // Bucket 0 is for the keys that end here, 1 + b for those with byte b
+        qsizetype counts[257] = {};
+        for (const SortEntry *e = first; e != last; ++e)
+            ++counts[e->size > depth ? e->key[depth] + 1 : 0];
+
+        const auto whole = std::find(std::begin(counts), std::end(counts), count);
+        if (whole == std::begin(counts))
+            return;
+        if (whole != std::end(counts)) {
+            // All keys have the same byte here: no need to move them
+            ++depth;
+            continue;
+        }
+
+        qsizetype offsets[257];
+        qsizetype offset = 0;
+        for (int b = 0; b < 257; ++b) {
+            offsets[b] = offset;
+            offset += counts[b];
+        }
+        for (const SortEntry *e = first; e != last; ++e)
+            scratch[offsets[e->size > depth ? e->key[depth] + 1 : 0]++] = *e;
+        std::copy(scratch, scratch + count, first);
+
+        // Recursing only into the buckets other than the largest one, each of
+        // which holds at most half of the entries, bounds the depth of the
+        // recursion by log2(count) even for keys that are prefixes of each other
+        const auto largest = std::max_element(std::begin(counts) + 1, std::end(counts));
+        qsizetype largestOffset = 0;
+        offset = counts[0];
+        for (auto b = std::begin(counts) + 1; b != std::end(counts); ++b) {
+            if (b == largest)
+                largestOffset = offset;
+            else if (*b > 1)
+                radixSort(first + offset, first + offset + *b, scratch + offset, depth + 1);
+            offset += *b;
+        }
+        last = first + largestOffset + *largest;
+        first += largestOffset;
+        scratch += largestOffset;
+        ++depth;
+    }
+}
+
+// Makes the binary sort keys of list's entries in [from, to) in keys, with an
+// entry for each in entries
+void makeSortEntries(QCollatorPrivate *d, const QStringList &list, qsizetype from, qsizetype to,
+                     QByteArray &keys, SortEntry *entries)
+{
+    QVarLengthArray<qsizetype, 256> ends;
+    ends.reserve(to - from);
+    for (qsizetype i = from; i < to; ++i) {
+        d->appendBinarySortKey(keys, list.at(i));
+        ends.append(keys.size());
+    }
+    // Only now that keys won't move any more:
+    const uchar *data = reinterpret_cast<const uchar *>(keys.constData());
+    qsizetype start = 0;
+    for (qsizetype i = from; i < to; ++i) {
+        const qsizetype end = ends.at(i - from);
+        entries[i - from] = SortEntry{ data + start, end - start, i };
+        start = end;
+    }
+}
+
+void applySortOrder(QStringList &list, const SortEntry *entries)
+{
+    QStringList sorted;
+    sorted.reserve(list.size());
+    for (qsizetype i = 0; i < list.size(); ++i)
+        sorted.append(std::move(list[entries[i].index]));
+    list = std::move(sorted);
+}
+} // unnamed namespace
+
+/*!
+    \since 6.5
+
+    Sorts \a list according to this collator.
+
+    This makes the binary sort key of each string once, and sorts the
+    strings by their keys. For more than a few strings, this is much faster
+    than sorting with compare() as comparison, which has to collate the
+    strings anew each time it compares them. Strings that compare equal
+    keep their relative order.
+
+    \sa parallelSort(), binarySortKey()
+*/
+void QCollator::sort(QStringList &list) const
+{
+    const qsizetype count = list.size();
+    if (count < 2)
+        return;
+
+    QByteArray keys;
+    std::unique_ptr<SortEntry[]> entries(new SortEntry[2 * count]);
+    makeSortEntries(d, list, 0, count, keys, entries.get());
+    radixSort(entries.get(), entries.get() + count, entries.get() + count, 0);
+    applySortOrder(list, entries.get());
+}
+
+/*!
+    \since 6.5
+
+    Sorts \a list according to this collator, as sort() does, but makes the
+    sort keys and sorts parts of the list in the threads of the global
+    QThreadPool. Use this for large lists, with many thousands of strings;
+    for shorter lists, and when Qt is built without thread support, it does
+    the same as sort().
+
+    \sa sort(), QThreadPool::globalInstance()
+*/
+void QCollator::parallelSort(QStringList &list) const
+{
+#if QT_CONFIG(thread)
+    const qsizetype count = list.size();
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int threads = pool->maxThreadCount();
+    constexpr qsizetype MinimumChunk = 4096;
+    if (threads < 2 || count < 2 * MinimumChunk) {
+        sort(list);
+        return;
+    }
+
+    // More chunks than threads, to even out their work:
+    const qsizetype chunks = qMin(qsizetype(threads) * 4, count / MinimumChunk);
+    const qsizetype chunkSize = (count + chunks - 1) / chunks;
+
+    struct Work
+    {
+        const QStringList *list;
+        QCollatorPrivate *collator;
+        qsizetype count;
+        qsizetype chunks;
+        qsizetype chunkSize;
+        std::unique_ptr<QByteArray[]> keys;
+        std::unique_ptr<SortEntry[]> entries;
+        QAtomicInteger<qsizetype> next = 0;
+        QSemaphore done;
+
+        // Takes chunks until there are none left. Each thread uses a
+        // collator of its own, as QCollator is not thread-safe.
+        void run()
+        {
+            std::unique_ptr<QCollator> own;
+            for (qsizetype chunk = next.fetchAndAddRelaxed(1); chunk < chunks;
+                 chunk = next.fetchAndAddRelaxed(1)) {
+                if (!own) {
+                    own.reset(new QCollator(collator->locale));
+                    own->setCaseSensitivity(collator->caseSensitivity);
+                    own->setNumericMode(collator->numericMode);
+                    own->setIgnorePunctuation(collator->ignorePunctuation);
+                }
+                const qsizetype from = chunk * chunkSize;
+                const qsizetype to = qMin(from + chunkSize, count);
+                SortEntry *first = entries.get() + from;
+                makeSortEntries(own->d, *list, from, to, keys[chunk], first);
+                radixSort(first, first + (to - from), first + count, 0);
+                done.release();
+            }
+        }
+    };
+
+    // Tasks the pool only gets round to after the work is done find no chunk
+    // left; they only need the counter, which they keep alive.
+    d->ensureInitialized();
+    auto work = std::make_shared<Work>();
+    work->list = &list;
+    work->collator = d;
+    work->count = count;
+    work->chunks = chunks;
+    work->chunkSize = chunkSize;
+    work->keys.reset(new QByteArray[chunks]);
+    work->entries.reset(new SortEntry[2 * count]);
+    for (int i = 1; i < threads && i < chunks; ++i)
+        pool->start([work]() { work->run(); });
+    work->run();
+    work->done.acquire(int(chunks));
+
+    // Merge the sorted chunks, in pairs, back and forth with the scratch space
+    SortEntry *from = work->entries.get();
+    SortEntry *to = from + count;
+    const auto less = [](const SortEntry &lhs, const SortEntry &rhs) {
+        return sortsBefore(lhs, rhs, 0);
+    };
+    for (qsizetype width = chunkSize; width < count; width *= 2) {
+        for (qsizetype start = 0; start < count; start += 2 * width) {
+            const qsizetype middle = qMin(start + width, count);
+            const qsizetype end = qMin(start + 2 * width, count);
+            std::merge(from + start, from + middle, from + middle, from + end, to + start, less);
+        }
+        std::swap(from, to);
+    }
+    applySortOrder(list, from);
+#else
+    sort(list);
+#endif
+}
+
 /*!
     \class QCollatorSortKey
     \inmodule QtCore
@@ -82,6 +82,10 @@ public:
     { return compare(s1, s2) < 0; }
 
     QCollatorSortKey sortKey(const QString &string) const;
+    QByteArray binarySortKey(QStringView string) const;
+
+    void sort(QStringList &list) const;
+    void parallelSort(QStringList &list) const;
 
     static int defaultCompare(QStringView s1, QStringView s2);
     static QCollatorSortKey defaultSortKey(QStringView key);
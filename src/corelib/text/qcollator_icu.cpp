@@ -114,6 +114,36 @@ QCollatorSortKey QCollator::sortKey(const QString &string) const
     return QCollatorSortKey(new QCollatorSortKeyPrivate(QByteArray()));
 }
 
+void QCollatorPrivate::appendBinarySortKey(QByteArray &key, QStringView string)
+{
+    if (string.isEmpty())
+        return;
+
+    ensureInitialized();
+    if (!collator) {
+        appendPlainSortKey(key, string, caseSensitivity);
+        return;
+    }
+
+    const qsizetype start = key.size();
+    qsizetype room = 16 + string.size() + (string.size() >> 2);
+    key.resize(start + room);
+    // truncating sizes (QTBUG-105038)
+    int size = ucol_getSortKey(collator, reinterpret_cast<const UChar *>(string.data()),
+                               string.size(), reinterpret_cast<uint8_t *>(key.data() + start),
+                               room);
+    if (size > room) {
+        room = size;
+        key.resize(start + room);
+        size = ucol_getSortKey(collator, reinterpret_cast<const UChar *>(string.data()),
+                               string.size(), reinterpret_cast<uint8_t *>(key.data() + start),
+                               room);
+    }
+    // ICU terminates the key with a '\0', which we don't need: the key is
+    // never empty, so it still sorts after that of an empty string.
+    key.truncate(start + qMax(size - 1, 0));
+}
+
 int QCollatorSortKey::compare(const QCollatorSortKey &otherKey) const
 {
     return qstrcmp(d->m_key, otherKey.d->m_key);
@@ -2,9 +2,11 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qcollator_p.h"
+#include "qendian.h"
 #include "qlocale_p.h"
 #include "qstringlist.h"
 #include "qstring.h"
+#include "qvarlengtharray.h"
 
 #include <QtCore/private/qcore_mac_p.h>
 
@@ -108,6 +110,40 @@ QCollatorSortKey QCollator::sortKey(const QString &string) const
     return QCollatorSortKey(new QCollatorSortKeyPrivate(std::move(ret)));
 }
 
+void QCollatorPrivate::appendBinarySortKey(QByteArray &key, QStringView string)
+{
+    if (string.isEmpty())
+        return;
+
+    ensureInitialized();
+    if (!collator) {
+        appendPlainSortKey(key, string, caseSensitivity);
+        return;
+    }
+
+    auto text = reinterpret_cast<const UniChar *>(string.data());
+    // Documentation recommends having it 5 times as big as the input
+    QVarLengthArray<UCCollationValue> values(string.size() * 5);
+    ItemCount actualSize;
+    int status = UCGetCollationKey(collator, text, string.size(),
+                                   values.size(), &actualSize, values.data());
+    if (status == kUCOutputBufferTooSmall) {
+        values.resize(actualSize);
+        status = UCGetCollationKey(collator, text, string.size(),
+                                   values.size(), &actualSize, values.data());
+    }
+    if (status != 0)
+        return;
+
+    // UCCompareCollationKeys() compares the values in order, so written
+    // big-endian they sort the same way as bytes.
+    const qsizetype start = key.size();
+    key.resize(start + qsizetype(actualSize) * 4);
+    uchar *out = reinterpret_cast<uchar *>(key.data() + start);
+    for (ItemCount i = 0; i < actualSize; ++i, out += 4)
+        qToBigEndian(quint32(values[i]), out);
+}
+
 int QCollatorSortKey::compare(const QCollatorSortKey &key) const
 {
     if (!d.data())
@@ -83,6 +83,12 @@ public:
     // Implemented by each back-end, in its own way:
     void init();
     void cleanup();
+    void appendBinarySortKey(QByteArray &key, QStringView string);
+
+    // The binary sort key for QStringView::compare()'s ordering, used for the
+    // C locale and when the back-end has no collator:
+    static void appendPlainSortKey(QByteArray &key, QStringView string,
+                                   Qt::CaseSensitivity cs);
 
 private:
     Q_DISABLE_COPY_MOVE(QCollatorPrivate)
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qcollator_p.h"
+#include "qendian.h"
 #include "qstringlist.h"
 #include "qstring.h"
 #include "qvarlengtharray.h"
@@ -80,6 +81,35 @@ QCollatorSortKey QCollator::sortKey(const QString &string) const
     return QCollatorSortKey(new QCollatorSortKeyPrivate(std::move(result)));
 }
 
+void QCollatorPrivate::appendBinarySortKey(QByteArray &key, QStringView string)
+{
+    if (string.isEmpty())
+        return;
+
+    ensureInitialized();
+    if (isC()) {
+        appendPlainSortKey(key, string, caseSensitivity);
+        return;
+    }
+
+    QVarLengthArray<wchar_t> original;
+    stringToWCharArray(original, string);
+    QVarLengthArray<wchar_t> transformed(original.size());
+    size_t size = std::wcsxfrm(transformed.data(), original.constData(), transformed.size());
+    if (size >= size_t(transformed.size())) {
+        transformed.resize(size + 1);
+        size = std::wcsxfrm(transformed.data(), original.constData(), transformed.size());
+    }
+
+    // wcscmp() orders the transformed strings; their (non-negative) elements,
+    // written big-endian, sort the same way as bytes.
+    const qsizetype start = key.size();
+    key.resize(start + qsizetype(size) * 4);
+    uchar *out = reinterpret_cast<uchar *>(key.data() + start);
+    for (size_t i = 0; i < size; ++i, out += 4)
+        qToBigEndian(quint32(transformed[i]), out);
+}
+
 int QCollatorSortKey::compare(const QCollatorSortKey &otherKey) const
 {
     return std::wcscmp(d->m_key.constData(), otherKey.d->m_key.constData());
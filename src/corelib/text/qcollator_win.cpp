@@ -113,6 +113,35 @@ QCollatorSortKey QCollator::sortKey(const QString &string) const
     return QCollatorSortKey(new QCollatorSortKeyPrivate(std::move(ret)));
 }
 
+void QCollatorPrivate::appendBinarySortKey(QByteArray &key, QStringView string)
+{
+    if (string.isEmpty())
+        return;
+
+    ensureInitialized();
+    if (isC()) {
+        appendPlainSortKey(key, string, caseSensitivity);
+        return;
+    }
+
+    // With LCMAP_SORTKEY, the destination is an array of bytes, which
+    // compare with memcmp() as CompareString() compares the strings.
+    // truncating sizes (QTBUG-105038)
+    const int size = LCMapStringW(localeID, LCMAP_SORTKEY | collator,
+                                  reinterpret_cast<const wchar_t *>(string.data()),
+                                  string.size(), 0, 0);
+    if (size <= 0)
+        return;
+    const qsizetype start = key.size();
+    key.resize(start + size);
+    const int finalSize = LCMapStringW(localeID, LCMAP_SORTKEY | collator,
+                                       reinterpret_cast<const wchar_t *>(string.data()),
+                                       string.size(),
+                                       reinterpret_cast<wchar_t *>(key.data() + start), size);
+    // Drop the terminating '\0':
+    key.truncate(start + qMax(finalSize - 1, 0));
+}
+
 int QCollatorSortKey::compare(const QCollatorSortKey &otherKey) const
 {
     return d->m_key.compare(otherKey.d->m_key);
@@ -22,6 +22,7 @@ QT_WARNING_DISABLE_GCC("-Wfree-nonheap-object") // false positive tracking
 #include "qlocale.h"
 #include "qlocale_p.h"
 #include "qlocale_tools_p.h"
+#include "qnumberformatter_p.h"
 #if QT_CONFIG(datetimeparser)
 #include "private/qdatetimeparser_p.h"
 #endif
@@ -37,6 +38,7 @@ QT_WARNING_DISABLE_GCC("-Wfree-nonheap-object") // false positive tracking
 #include "private/qnumeric_p.h"
 #include "private/qtools_p.h"
 #include <cmath>
+#include <optional>
 #ifndef QT_NO_SYSTEMLOCALE
 #   include "qmutex.h"
 #endif
@@ -3549,8 +3551,127 @@ QString QCalendarBackend::dateTimeToString(QStringView format, const QDateTime &
 
 // End of QCalendar intrustions
 
-QString QLocaleData::doubleToString(double d, int precision, DoubleForm form,
-                                    int width, unsigned flags) const
+QLocaleNumberSymbols::QLocaleNumberSymbols(const QLocaleData *data, uint which)
+    : groupingTop(data->m_grouping_top),
+      groupingHigher(data->m_grouping_higher),
+      groupingLeast(data->m_grouping_least)
+{
+    if (which & DecimalPoint)
+        decimal = data->decimalPoint();
+    if (which & GroupSeparator)
+        group = data->groupSeparator();
+    if (which & NegativeSign)
+        minus = data->negativeSign();
+    if (which & PositiveSign)
+        plus = data->positiveSign();
+    if (which & ExponentSeparator)
+        exponent = data->exponentSeparator();
+    if (!(which & ZeroDigit))
+        return;
+
+    zero = data->zeroDigit();
+    Q_ASSERT(!zero.isEmpty());
+    if (zero.size() == 2 && zero.at(0).isHighSurrogate()) {
+        zeroUcs = QChar::surrogateToUcs4(zero.at(0), zero.at(1));
+        digitWidth = 2;
+    } else {
+        Q_ASSERT(zero.size() == 1);
+        Q_ASSERT(!zero.at(0).isSurrogate());
+        zeroUcs = zero.at(0).unicode();
+        digitWidth = 1;
+    }
+}
+
+QLocaleNumberSymbols QLocaleNumberSymbols::toUpper() const
+{
+    // Digits have no case, so zero can stay as it is:
+    QLocaleNumberSymbols result = *this;
+    result.decimal = decimal.toUpper();
+    result.group = group.toUpper();
+    result.minus = minus.toUpper();
+    result.plus = plus.toUpper();
+    result.exponent = exponent.toUpper();
+    return result;
+}
+
+void QLocaleNumberSymbols::appendInteger(QFormatterOutput &out, qulonglong magnitude,
+                                         bool negative, int precision, int base, int width,
+                                         uint flags, const QLocaleNumberSymbols *upper) const
+{
+    const bool capital = flags & QLocaleData::CapitalEorX;
+
+    // Least significant first; digits other than the locale's are ASCII:
+    uchar digits[std::numeric_limits<qulonglong>::digits];
+    qsizetype count = 0;
+    do {
+        digits[count++] = uchar(magnitude % base);
+        magnitude /= base;
+    } while (magnitude);
+    const bool localeDigits = base == 10;
+    const qsizetype width1 = localeDigits ? digitWidth : 1;
+
+    const QStringView sign = negative ? QStringView(minus)
+            : flags & QLocaleData::AlwaysShowSign ? QStringView(plus)
+            : flags & QLocaleData::BlankBeforePositive ? QStringView(u" ")
+            : QStringView();
+    QStringView basePrefix;
+    if (flags & QLocaleData::ShowBase) {
+        const bool upperBase = flags & QLocaleData::UppercaseBase;
+        if (base == 16)
+            basePrefix = upperBase ? u"0X" : u"0x";
+        else if (base == 2)
+            basePrefix = upperBase ? u"0B" : u"0b";
+        else if (base == 8 && (count > 1 || digits[0] != 0))
+            basePrefix = u"0";
+    }
+
+    const qsizetype firstGroup = count - groupingLeast;
+    qsizetype groups = 0;
+    QString upperGroup;
+    QStringView groupText = group;
+    if (localeDigits && flags & QLocaleData::GroupDigits && firstGroup >= groupingTop) {
+        groups = 1 + (firstGroup - groupingTop) / groupingHigher;
+        if (capital)
+            groupText = upper ? QStringView(upper->group) : QStringView(upperGroup = group.toUpper());
+    }
+
+    // Each digit and separator counts as one towards width, but precision
+    // is compared with the size of the text.
+    qsizetype usedWidth = count + groups + sign.size() + basePrefix.size();
+    const qsizetype textSize = count * width1 + groups * group.size();
+    const bool noPrecision = precision == -1;
+    if (noPrecision)
+        precision = 1;
+    qsizetype padding = qMax(qsizetype(0), precision - textSize);
+    usedWidth += padding;
+    // LeftAdjusted overrides ZeroPadded; and sprintf() only pads when
+    // precision is not specified in the format string.
+    if (noPrecision && flags & QLocaleData::ZeroPadded && !(flags & QLocaleData::LeftAdjusted))
+        padding += qMax(qsizetype(0), width - usedWidth);
+
+    out.append(sign);
+    out.append(basePrefix);
+    const auto appendAnyDigit = [&](uint digit) {
+        if (localeDigits)
+            appendDigit(out, digit);
+        else if (digit < 10)
+            out.append(QLatin1Char(char('0' + digit)));
+        else
+            out.append(QLatin1Char(char((capital ? 'A' : 'a') + digit - 10)));
+    };
+    for (; padding > 0; --padding)
+        appendAnyDigit(0);
+    for (qsizetype k = 0; k < count; ++k) {
+        if (groups && k >= groupingTop && k <= firstGroup && (firstGroup - k) % groupingHigher == 0)
+            out.append(groupText);
+        appendAnyDigit(digits[count - 1 - k]);
+    }
+}
+
+QLocaleNumberSymbols::DoubleDigits::DoubleDigits(double d, int precision,
+                                                 QLocaleData::DoubleForm form, uint flags,
+                                                 int groupingTop, int groupingHigher,
+                                                 int groupingLeast)
 {
     // Although the special handling of F.P.Shortest below is limited to
     // DFSignificantDigits, the double-conversion library does treat it
@@ -3559,237 +3680,266 @@ QString QLocaleData::doubleToString(double d, int precision, DoubleForm form,
     // DFExponent.
     if (precision != QLocale::FloatingPointShortest && precision < 0)
         precision = 6;
-    if (width < 0)
-        width = 0;
+    this->precision = precision;
 
-    int decpt;
     qsizetype bufSize = 1;
     if (precision == QLocale::FloatingPointShortest)
         bufSize += std::numeric_limits<double>::max_digits10;
-    else if (form == DFDecimal && qIsFinite(d))
+    else if (form == QLocaleData::DFDecimal && qIsFinite(d))
         bufSize += wholePartSpace(qAbs(d)) + precision;
     else // Add extra digit due to different interpretations of precision.
         bufSize += qMax(2, precision) + 1; // Must also be big enough for "nan" or "inf"
 
-    QVarLengthArray<char> buf(bufSize);
-    int length;
-    bool negative = false;
-    qt_doubleToAscii(d, form, precision, buf.data(), bufSize, negative, length, decpt);
-
-    const QString prefix = signPrefix(negative && !isZero(d), flags);
-    QString numStr;
-
+    buffer.resize(bufSize);
+    qt_doubleToAscii(d, form, precision, buffer.data(), bufSize, negative, length, decpt);
+    negative = negative && !isZero(d);
     if (length == 3
-        && (qstrncmp(buf.data(), "inf", 3) == 0 || qstrncmp(buf.data(), "nan", 3) == 0)) {
-        numStr = QString::fromLatin1(buf.data(), length);
-    } else { // Handle finite values
-        const QString zero = zeroDigit();
-        QString digits = QString::fromLatin1(buf.data(), length);
-
-        if (zero == u"0") {
-            // No need to convert digits.
-            Q_ASSERT(std::all_of(buf.cbegin(), buf.cbegin() + length, [](char ch)
-                                 { return '0' <= ch && ch <= '9'; }));
-            // That check is taken care of in unicodeForDigits, below.
-        } else if (zero.size() == 2 && zero.at(0).isHighSurrogate()) {
-            const char32_t zeroUcs4 = QChar::surrogateToUcs4(zero.at(0), zero.at(1));
-            QString converted;
-            converted.reserve(2 * digits.size());
-            for (QChar ch : std::as_const(digits)) {
-                const char32_t digit = unicodeForDigit(ch.unicode() - '0', zeroUcs4);
-                Q_ASSERT(QChar::requiresSurrogates(digit));
-                converted.append(QChar::highSurrogate(digit));
-                converted.append(QChar::lowSurrogate(digit));
+        && (qstrncmp(buffer.data(), "inf", 3) == 0 || qstrncmp(buffer.data(), "nan", 3) == 0)) {
+        nonFinite = true;
+        return;
+    }
+
+    const bool mustMarkDecimal = flags & QLocaleData::ForcePoint;
+    const bool groupDigits = flags & QLocaleData::GroupDigits;
+    const int minExponentDigits = flags & QLocaleData::ZeroPadExponent ? 2 : 1;
+    useDecimal = form == QLocaleData::DFDecimal;
+    if (form == QLocaleData::DFSignificantDigits) {
+        mode = flags & QLocaleData::AddTrailingZeroes ? SignificantDigits : ChopTrailingZeros;
+
+        /* POSIX specifies sprintf() to follow fprintf(), whose 'g/G'
+           format says; with P = 6 if precision unspecified else 1 if
+           precision is 0 else precision; when 'e/E' would have exponent
+           X, use:
+             * 'f/F' if P > X >= -4, with precision P-1-X
+             * 'e/E' otherwise, with precision P-1
+           Helpfully, we already have mapped precision < 0 to 6 - except
+           for F.P.Shortest mode, which is its own story - and those of
+           our callers with unspecified precision either used 6 or -1
+           for it.
+        */
+        if (precision == QLocale::FloatingPointShortest) {
+            // Find out which representation is shorter.
+            // Set bias to everything added to exponent form but not
+            // decimal, minus the converse.
+
+            // Exponent adds separator, sign and digits:
+            int bias = 2 + minExponentDigits;
+            // Decimal form may get grouping separators inserted:
+            if (groupDigits && decpt >= groupingTop + groupingLeast)
+                bias -= (decpt - groupingTop - groupingLeast) / groupingHigher + 1;
+            // X = decpt - 1 needs two digits if decpt > 10:
+            if (decpt > 10 && minExponentDigits == 1)
+                ++bias;
+            // Assume digitCount < 95, so we can ignore the 3-digit
+            // exponent case (we'll set useDecimal false anyway).
+
+            if (!mustMarkDecimal) {
+                // Decimal separator is skipped if at end; adjust if
+                // that happens for only one form:
+                if (length <= decpt && length > 1)
+                    ++bias; // decimal but not exponent
+                else if (length == 1 && decpt <= 0)
+                    --bias; // exponent but not decimal
             }
-            digits = converted;
+            // When 0 < decpt <= length, the forms have equal digit
+            // counts, plus things bias has taken into account;
+            // otherwise decimal form's digit count is right-padded with
+            // zeros to decpt, when decpt is positive, otherwise it's
+            // left-padded with 1 - decpt zeros.
+            useDecimal = (decpt <= 0 ? 1 - decpt <= bias
+                          : decpt <= length ? 0 <= bias
+                          : decpt <= length + bias);
         } else {
-            Q_ASSERT(zero.size() == 1);
-            Q_ASSERT(!zero.at(0).isSurrogate());
-            char16_t z = zero.at(0).unicode();
-            char16_t *const value = reinterpret_cast<char16_t *>(digits.data());
-            for (qsizetype i = 0; i < digits.size(); ++i)
-                value[i] = unicodeForDigit(value[i] - '0', z);
+            // X == decpt - 1, POSIX's P; -4 <= X < P iff -4 < decpt <= P
+            Q_ASSERT(precision >= 0);
+            useDecimal = decpt > -4 && decpt <= (precision ? precision : 1);
         }
+    }
+}
 
-        const bool mustMarkDecimal = flags & ForcePoint;
-        const bool groupDigits = flags & GroupDigits;
-        const int minExponentDigits = flags & ZeroPadExponent ? 2 : 1;
-        switch (form) {
-            case DFExponent:
-                numStr = exponentForm(std::move(digits), decpt, precision, PMDecimalDigits,
-                                      mustMarkDecimal, minExponentDigits);
-                break;
-            case DFDecimal:
-                numStr = decimalForm(std::move(digits), decpt, precision, PMDecimalDigits,
-                                     mustMarkDecimal, groupDigits);
-                break;
-            case DFSignificantDigits: {
-                PrecisionMode mode = (flags & AddTrailingZeroes) ?
-                            PMSignificantDigits : PMChopTrailingZeros;
-
-                /* POSIX specifies sprintf() to follow fprintf(), whose 'g/G'
-                   format says; with P = 6 if precision unspecified else 1 if
-                   precision is 0 else precision; when 'e/E' would have exponent
-                   X, use:
-                     * 'f/F' if P > X >= -4, with precision P-1-X
-                     * 'e/E' otherwise, with precision P-1
-                   Helpfully, we already have mapped precision < 0 to 6 - except
-                   for F.P.Shortest mode, which is its own story - and those of
-                   our callers with unspecified precision either used 6 or -1
-                   for it.
-                */
-                bool useDecimal;
-                if (precision == QLocale::FloatingPointShortest) {
-                    // Find out which representation is shorter.
-                    // Set bias to everything added to exponent form but not
-                    // decimal, minus the converse.
-
-                    // Exponent adds separator, sign and digits:
-                    int bias = 2 + minExponentDigits;
-                    // Decimal form may get grouping separators inserted:
-                    if (groupDigits && decpt >= m_grouping_top + m_grouping_least)
-                        bias -= (decpt - m_grouping_top - m_grouping_least) / m_grouping_higher + 1;
-                    // X = decpt - 1 needs two digits if decpt > 10:
-                    if (decpt > 10 && minExponentDigits == 1)
-                        ++bias;
-                    // Assume digitCount < 95, so we can ignore the 3-digit
-                    // exponent case (we'll set useDecimal false anyway).
-
-                    const qsizetype digitCount = digits.size() / zero.size();
-                    if (!mustMarkDecimal) {
-                        // Decimal separator is skipped if at end; adjust if
-                        // that happens for only one form:
-                        if (digitCount <= decpt && digitCount > 1)
-                            ++bias; // decimal but not exponent
-                        else if (digitCount == 1 && decpt <= 0)
-                            --bias; // exponent but not decimal
-                    }
-                    // When 0 < decpt <= digitCount, the forms have equal digit
-                    // counts, plus things bias has taken into account;
-                    // otherwise decimal form's digit count is right-padded with
-                    // zeros to decpt, when decpt is positive, otherwise it's
-                    // left-padded with 1 - decpt zeros.
-                    useDecimal = (decpt <= 0 ? 1 - decpt <= bias
-                                  : decpt <= digitCount ? 0 <= bias
-                                  : decpt <= digitCount + bias);
-                } else {
-                    // X == decpt - 1, POSIX's P; -4 <= X < P iff -4 < decpt <= P
-                    Q_ASSERT(precision >= 0);
-                    useDecimal = decpt > -4 && decpt <= (precision ? precision : 1);
-                }
+uint QLocaleNumberSymbols::DoubleDigits::symbols(uint flags) const
+{
+    uint which = 0;
+    if (negative)
+        which |= NegativeSign;
+    else if (flags & QLocaleData::AlwaysShowSign)
+        which |= PositiveSign;
+    if (nonFinite)
+        return which;
+
+    which |= ZeroDigit | DecimalPoint;
+    if (useDecimal) {
+        if (flags & QLocaleData::GroupDigits)
+            which |= GroupSeparator;
+    } else {
+        // The exponent always has a sign
+        which |= ExponentSeparator | (decpt - 1 < 0 ? NegativeSign : PositiveSign);
+    }
+    return which;
+}
 
-                numStr = useDecimal
-                    ? decimalForm(std::move(digits), decpt, precision, mode,
-                                  mustMarkDecimal, groupDigits)
-                    : exponentForm(std::move(digits), decpt, precision, mode,
-                                   mustMarkDecimal, minExponentDigits);
-                break;
-            }
-        }
+qsizetype QLocaleNumberSymbols::DoubleDigits::sizeHint(int width,
+                                                      const QLocaleNumberSymbols &symbols) const
+{
+    const qsizetype sign = qMax(symbols.minus.size(), symbols.plus.size());
+    if (nonFinite)
+        return sign + length;
 
-        // Pad with zeros. LeftAdjusted overrides ZeroPadded.
-        if (flags & ZeroPadded && !(flags & LeftAdjusted)) {
-            for (qsizetype i = numStr.size() / zero.size() + prefix.size(); i < width; ++i)
-                numStr.prepend(zero);
-        }
-    }
+    // Digits, including the zeros needed to reach the decimal point or the
+    // precision:
+    qsizetype digits = qMax(length, useDecimal ? qAbs(decpt) : 0) + 1;
+    if (mode != ChopTrailingZeros)
+        digits += qMax(precision, 0);
+    qsizetype size = sign + symbols.decimal.size();
+    if (!useDecimal)
+        size += symbols.exponent.size() + sign + 3;
+    else if (decpt > 0 && !symbols.group.isEmpty())
+        size += (decpt / symbols.groupingHigher + 1) * symbols.group.size();
+    return size + qMax(digits, qsizetype(width)) * symbols.digitWidth;
+}
 
-    return prefix + (flags & CapitalEorX ? std::move(numStr).toUpper() : numStr);
+void QLocaleNumberSymbols::appendDouble(QFormatterOutput &out, double d, int precision,
+                                        QLocaleData::DoubleForm form, int width, uint flags,
+                                        const QLocaleNumberSymbols *upper) const
+{
+    appendDouble(out, DoubleDigits(d, precision, form, flags, groupingTop, groupingHigher,
+                                   groupingLeast),
+                 width, flags, upper);
 }
 
-QString QLocaleData::decimalForm(QString &&digits, int decpt, int precision,
-                                 PrecisionMode pm, bool mustMarkDecimal,
-                                 bool groupDigits) const
+void QLocaleNumberSymbols::appendDouble(QFormatterOutput &out, const DoubleDigits &number,
+                                        int width, uint flags,
+                                        const QLocaleNumberSymbols *upper) const
 {
-    const QString zero = zeroDigit();
-    const auto digitWidth = zero.size();
-    Q_ASSERT(digitWidth == 1 || digitWidth == 2);
-    Q_ASSERT(digits.size() % digitWidth == 0);
+    if (width < 0)
+        width = 0;
 
-    // Separator needs to go at index decpt: so add zeros before or after the
-    // given digits, if they don't reach that position already:
-    if (decpt < 0) {
-        for (; decpt < 0; ++decpt)
-            digits.prepend(zero);
-    } else {
-        for (qsizetype i = digits.size() / digitWidth; i < decpt; ++i)
-            digits.append(zero);
+    // The sign is not subject to CapitalEorX, all the rest is:
+    const QStringView sign = number.negative ? QStringView(minus)
+            : flags & QLocaleData::AlwaysShowSign ? QStringView(plus)
+            : flags & QLocaleData::BlankBeforePositive ? QStringView(u" ")
+            : QStringView();
+    out.append(sign);
+
+    const char *const digits = number.buffer.data();
+    const int length = number.length;
+    const bool capital = flags & QLocaleData::CapitalEorX;
+    if (number.nonFinite) {
+        for (int i = 0; i < length; ++i)
+            out.append(QLatin1Char(capital ? QtMiscUtils::toAsciiUpper(digits[i]) : digits[i]));
+        return;
     }
 
-    switch (pm) {
-    case PMDecimalDigits:
-        for (qsizetype i = digits.size() / digitWidth - decpt; i < precision; ++i)
-            digits.append(zero);
+    std::optional<QLocaleNumberSymbols> ownUpper;
+    const QLocaleNumberSymbols &body = !capital ? *this
+            : upper ? *upper : ownUpper.emplace(toUpper());
+
+    const bool mustMarkDecimal = flags & QLocaleData::ForcePoint;
+    const bool groupDigits = flags & QLocaleData::GroupDigits;
+    const int minExponentDigits = flags & QLocaleData::ZeroPadExponent ? 2 : 1;
+    const auto appendNumber = [&](QFormatterOutput &o) {
+        if (number.useDecimal) {
+            body.appendDecimalForm(o, digits, length, number.decpt, number.precision,
+                                   number.mode, mustMarkDecimal, groupDigits);
+        } else {
+            body.appendExponentForm(o, digits, length, number.decpt, number.precision,
+                                    number.mode, mustMarkDecimal, minExponentDigits);
+        }
+    };
+
+    // Pad with zeros. LeftAdjusted overrides ZeroPadded.
+    if (flags & QLocaleData::ZeroPadded && !(flags & QLocaleData::LeftAdjusted) && width > 0) {
+        QFormatterOutput counter(nullptr, 0);
+        appendNumber(counter);
+        for (qsizetype i = counter.size() / digitWidth + sign.size(); i < width; ++i)
+            appendDigit(out, 0);
+    }
+    appendNumber(out);
+}
+
+void QLocaleNumberSymbols::appendDecimalForm(QFormatterOutput &out, const char *digits,
+                                             qsizetype count, int decpt, int precision,
+                                             PrecisionMode mode, bool mustMarkDecimal,
+                                             bool groupDigits) const
+{
+    // Separator needs to go at index decpt: so add zeros before or after the
+    // given digits, if they don't reach that position already. The leading
+    // ones come first, and the separator goes at index point:
+    const qsizetype lead = decpt < 0 ? -qsizetype(decpt) : 0;
+    const qsizetype point = decpt < 0 ? 0 : decpt;
+    qsizetype total = lead + qMax(count, point);
+    switch (mode) {
+    case DecimalDigits:
+        total = qMax(total, point + precision);
         break;
-    case  PMSignificantDigits:
-        for (qsizetype i = digits.size() / digitWidth; i < precision; ++i)
-            digits.append(zero);
+    case SignificantDigits:
+        total = qMax(total, qsizetype(precision));
         break;
-    case PMChopTrailingZeros:
-        Q_ASSERT(digits.size() / digitWidth <= qMax(decpt, 1) || !digits.endsWith(zero));
+    case ChopTrailingZeros:
+        Q_ASSERT(count <= qMax(decpt, 1) || digits[count - 1] != '0');
         break;
     }
+    const auto digitAt = [=](qsizetype k) -> uint {
+        k -= lead;
+        return k >= 0 && k < count ? uint(digits[k] - '0') : 0;
+    };
 
-    if (mustMarkDecimal || decpt < digits.size() / digitWidth)
-        digits.insert(decpt * digitWidth, decimalPoint());
-
-    if (groupDigits) {
-        const QString group = groupSeparator();
-        qsizetype i = decpt - m_grouping_least;
-        if (i >= m_grouping_top) {
-            digits.insert(i * digitWidth, group);
-            while ((i -= m_grouping_higher) >= m_grouping_top)
-                digits.insert(i * digitWidth, group);
+    if (point == 0)
+        appendDigit(out, 0);
+    const qsizetype firstGroup = groupDigits ? point - groupingLeast : -1;
+    for (qsizetype k = 0; k < point; ++k) {
+        if (firstGroup >= groupingTop && k >= groupingTop && k <= firstGroup
+                && (firstGroup - k) % groupingHigher == 0) {
+            out.append(group);
         }
+        appendDigit(out, digitAt(k));
+    }
+    if (mustMarkDecimal || point < total) {
+        out.append(decimal);
+        for (qsizetype k = point; k < total; ++k)
+            appendDigit(out, digitAt(k));
     }
-
-    if (decpt == 0)
-        digits.prepend(zero);
-
-    return std::move(digits);
 }
 
-QString QLocaleData::exponentForm(QString &&digits, int decpt, int precision,
-                                  PrecisionMode pm, bool mustMarkDecimal,
-                                  int minExponentDigits) const
+void QLocaleNumberSymbols::appendExponentForm(QFormatterOutput &out, const char *digits,
+                                              qsizetype count, int decpt, int precision,
+                                              PrecisionMode mode, bool mustMarkDecimal,
+                                              int minExponentDigits) const
 {
-    const QString zero = zeroDigit();
-    const auto digitWidth = zero.size();
-    Q_ASSERT(digitWidth == 1 || digitWidth == 2);
-    Q_ASSERT(digits.size() % digitWidth == 0);
-
-    switch (pm) {
-    case PMDecimalDigits:
-        for (qsizetype i = digits.size() / digitWidth; i < precision + 1; ++i)
-            digits.append(zero);
+    qsizetype total = count;
+    switch (mode) {
+    case DecimalDigits:
+        total = qMax(total, qsizetype(precision) + 1);
         break;
-    case PMSignificantDigits:
-        for (qsizetype i = digits.size() / digitWidth; i < precision; ++i)
-            digits.append(zero);
+    case SignificantDigits:
+        total = qMax(total, qsizetype(precision));
         break;
-    case PMChopTrailingZeros:
-        Q_ASSERT(digits.size() / digitWidth <= 1 || !digits.endsWith(zero));
+    case ChopTrailingZeros:
+        Q_ASSERT(count <= 1 || digits[count - 1] != '0');
         break;
     }
 
-    if (mustMarkDecimal || digits.size() > digitWidth)
-        digits.insert(digitWidth, decimalPoint());
-
-    digits.append(exponentSeparator());
-    digits.append(longLongToString(decpt - 1, minExponentDigits, 10, -1, AlwaysShowSign));
-
-    return std::move(digits);
+    for (qsizetype k = 0; k < total; ++k) {
+        appendDigit(out, k < count ? uint(digits[k] - '0') : 0);
+        if (k == 0 && (mustMarkDecimal || total > 1))
+            out.append(decimal);
+    }
+    out.append(exponent);
+    const int exp = decpt - 1;
+    appendInteger(out, exp < 0 ? -qlonglong(exp) : exp, exp < 0, minExponentDigits, 10, -1,
+                  QLocaleData::AlwaysShowSign);
 }
 
-QString QLocaleData::signPrefix(bool negative, unsigned flags) const
+QString QLocaleData::doubleToString(double d, int precision, DoubleForm form,
+                                    int width, unsigned flags) const
 {
-    if (negative)
-        return negativeSign();
-    if (flags & AlwaysShowSign)
-        return positiveSign();
-    if (flags & BlankBeforePositive)
-        return QStringView(u" ").toString();
-    return {};
+    // Convert first, to only fetch the symbols the chosen form needs
+    const QLocaleNumberSymbols::DoubleDigits number(d, precision, form, flags, m_grouping_top,
+                                                    m_grouping_higher, m_grouping_least);
+    const QLocaleNumberSymbols symbols(this, number.symbols(flags));
+    QFormatterOutput out(number.sizeHint(width, symbols));
+    symbols.appendDouble(out, number, width, flags);
+    return out.takeString();
 }
 
 QString QLocaleData::longLongToString(qlonglong n, int precision,
@@ -3801,79 +3951,30 @@ QString QLocaleData::longLongToString(qlonglong n, int precision,
       Negating std::numeric_limits<qlonglong>::min() hits undefined behavior, so
       taking an absolute value has to take a slight detour.
      */
-    QString numStr = qulltoa(negative ? 1u + qulonglong(-(n + 1)) : qulonglong(n),
-                             base, zeroDigit());
-
-    return applyIntegerFormatting(std::move(numStr), negative, precision, base, width, flags);
+    return integerToString(negative ? 1u + qulonglong(-(n + 1)) : qulonglong(n), negative,
+                           precision, base, width, flags);
 }
 
 QString QLocaleData::unsLongLongToString(qulonglong l, int precision,
                                          int base, int width, unsigned flags) const
 {
-    const QString zero = zeroDigit();
-    QString resultZero = base == 10 ? zero : QStringLiteral("0");
-    return applyIntegerFormatting(l ? qulltoa(l, base, zero) : resultZero,
-                                  false, precision, base, width, flags);
+    return integerToString(l, false, precision, base, width, flags);
 }
 
-QString QLocaleData::applyIntegerFormatting(QString &&numStr, bool negative, int precision,
-                                            int base, int width, unsigned flags) const
+QString QLocaleData::integerToString(qulonglong magnitude, bool negative, int precision,
+                                     int base, int width, unsigned flags) const
 {
-    const QString zero = base == 10 ? zeroDigit() : QStringLiteral("0");
-    const auto digitWidth = zero.size();
-    const auto digitCount = numStr.size() / digitWidth;
-
-    const auto basePrefix = [&] () -> QStringView {
-        if (flags & ShowBase) {
-            const bool upper = flags & UppercaseBase;
-            if (base == 16)
-                return upper ? u"0X" : u"0x";
-            if (base == 2)
-                return upper ? u"0B" : u"0b";
-            if (base == 8 && !numStr.startsWith(zero))
-                return zero;
-        }
-        return {};
-    }();
-
-    const QString prefix = signPrefix(negative, flags) + basePrefix;
-    // Count how much of width we've used up.  Each digit counts as one
-    qsizetype usedWidth = digitCount + prefix.size();
-
-    if (base == 10 && flags & GroupDigits) {
-        const QString group = groupSeparator();
-        qsizetype i = digitCount - m_grouping_least;
-        if (i >= m_grouping_top) {
-            numStr.insert(i * digitWidth, group);
-            ++usedWidth;
-            while ((i -= m_grouping_higher) >= m_grouping_top) {
-                numStr.insert(i * digitWidth, group);
-                ++usedWidth;
-            }
-        }
-        // TODO: should we group any zero-padding we add later ?
-    }
-
-    const bool noPrecision = precision == -1;
-    if (noPrecision)
-        precision = 1;
-
-    for (qsizetype i = numStr.size(); i < precision; ++i) {
-        numStr.prepend(zero);
-        usedWidth++;
-    }
-
-    // LeftAdjusted overrides ZeroPadded; and sprintf() only pads when
-    // precision is not specified in the format string.
-    if (noPrecision && flags & ZeroPadded && !(flags & LeftAdjusted)) {
-        for (qsizetype i = usedWidth; i < width; ++i)
-            numStr.prepend(zero);
-    }
-
-    QString result(flags & CapitalEorX ? std::move(numStr).toUpper() : std::move(numStr));
-    if (prefix.size())
-        result.prepend(prefix);
-    return result;
+    uint which = QLocaleNumberSymbols::ZeroDigit;
+    if (negative)
+        which |= QLocaleNumberSymbols::NegativeSign;
+    else if (flags & AlwaysShowSign)
+        which |= QLocaleNumberSymbols::PositiveSign;
+    if (base == 10 && flags & GroupDigits)
+        which |= QLocaleNumberSymbols::GroupSeparator;
+    const QLocaleNumberSymbols symbols(this, which);
+    QFormatterOutput out(qMax(width, precision) + 24);
+    symbols.appendInteger(out, magnitude, negative, precision, base, width, flags);
+    return out.takeString();
 }
 
 /*
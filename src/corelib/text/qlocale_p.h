@@ -188,21 +188,8 @@ public:
     typedef QVarLengthArray<char, 256> CharBuff;
 
 private:
-    enum PrecisionMode {
-        PMDecimalDigits =       0x01,
-        PMSignificantDigits =   0x02,
-        PMChopTrailingZeros =   0x03
-    };
-
-    [[nodiscard]] QString decimalForm(QString &&digits, int decpt, int precision,
-                                      PrecisionMode pm, bool mustMarkDecimal,
-                                      bool groupDigits) const;
-    [[nodiscard]] QString exponentForm(QString &&digits, int decpt, int precision,
-                                       PrecisionMode pm, bool mustMarkDecimal,
-                                       int minExponentDigits) const;
-    [[nodiscard]] QString signPrefix(bool negative, unsigned flags) const;
-    [[nodiscard]] QString applyIntegerFormatting(QString &&numStr, bool negative, int precision,
-                                                 int base, int width, unsigned flags) const;
+    [[nodiscard]] QString integerToString(qulonglong magnitude, bool negative, int precision,
+                                          int base, int width, unsigned flags) const;
 
 public:
     [[nodiscard]] QString doubleToString(double d,
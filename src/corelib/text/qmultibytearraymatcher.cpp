@@ -0,0 +1,574 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qmultibytearraymatcher.h"
+#include "qmultimatcher_p.h"
+
+#include <private/qsimd_p.h>
+#include <private/qtools_p.h>
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The Teddy kernels. For each block of positions of the string, they look
+    up the buckets allowed by the low and the high nibble of the code unit at
+    each position of the fingerprint, and keep the buckets allowed by all of
+    them. The caller verifies the patterns of the buckets that remain.
+*/
+
+static uint teddyBuckets(const QMultiMatcherTeddyMasks &masks, uchar byte, int position) noexcept
+{
+    return masks.low[position][byte & 0xf] & masks.high[position][byte >> 4];
+}
+
+template <typename Char>
+static qsizetype teddyFindCandidateScalar(const QMultiMatcherTeddyMasks &masks, const Char *str,
+                                          qsizetype length, qsizetype from, uint *buckets) noexcept
+{
+    const int fingerprintLength = masks.fingerprintLength;
+    for (qsizetype i = from; i <= length - fingerprintLength; ++i) {
+        uint b = teddyBuckets(masks, uchar(str[i]), 0);
+        for (int k = 1; b && k < fingerprintLength; ++k)
+            b &= teddyBuckets(masks, uchar(str[i + k]), k);
+        if (b) {
+            *buckets = b;
+            return i;
+        }
+    }
+    return -1;
+}
+
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+static QT_FUNCTION_TARGET(SSSE3) __m128i teddyLoadSsse3(const uchar *str) noexcept
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(str));
+}
+
+static QT_FUNCTION_TARGET(SSSE3) __m128i teddyLoadSsse3(const char16_t *str) noexcept
+{
+    // keep the low byte of each of the 16 code units
+    const __m128i lowBytes = _mm_set1_epi16(0x00ff);
+    const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str));
+    const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + 8));
+    return _mm_packus_epi16(_mm_and_si128(first, lowBytes), _mm_and_si128(second, lowBytes));
+}
+
+template <typename Char>
+static QT_FUNCTION_TARGET(SSSE3)
+qsizetype teddyFindCandidateSsse3(const QMultiMatcherTeddyMasks &masks, const Char *str,
+                                  qsizetype length, qsizetype from, uint *buckets) noexcept
+{
+    constexpr qsizetype BlockSize = 16;
+    const int fingerprintLength = masks.fingerprintLength;
+    const __m128i nibble = _mm_set1_epi8(0xf);
+    __m128i low[QMultiMatcherTeddyMasks::MaximumFingerprintLength];
+    __m128i high[QMultiMatcherTeddyMasks::MaximumFingerprintLength];
+    for (int k = 0; k < fingerprintLength; ++k) {
+        low[k] = _mm_load_si128(reinterpret_cast<const __m128i *>(masks.low[k]));
+        high[k] = _mm_load_si128(reinterpret_cast<const __m128i *>(masks.high[k]));
+    }
+
+    qsizetype i = from;
+    for ( ; i + BlockSize + fingerprintLength - 1 <= length; i += BlockSize) {
+        __m128i result = _mm_set1_epi8(-1);
+        for (int k = 0; k < fingerprintLength; ++k) {
+            const __m128i data = teddyLoadSsse3(str + i + k);
+            const __m128i lowNibbles = _mm_and_si128(data, nibble);
+            const __m128i highNibbles = _mm_and_si128(_mm_srli_epi16(data, 4), nibble);
+            result = _mm_and_si128(result, _mm_and_si128(_mm_shuffle_epi8(low[k], lowNibbles),
+                                                         _mm_shuffle_epi8(high[k], highNibbles)));
+        }
+        const uint found =
+                ~uint(_mm_movemask_epi8(_mm_cmpeq_epi8(result, _mm_setzero_si128()))) & 0xffffu;
+        if (found) {
+            alignas(16) uchar bucketsAt[BlockSize];
+            _mm_store_si128(reinterpret_cast<__m128i *>(bucketsAt), result);
+            const int offset = qCountTrailingZeroBits(found);
+            *buckets = bucketsAt[offset];
+            return i + offset;
+        }
+    }
+    return teddyFindCandidateScalar(masks, str, length, i, buckets);
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+static QT_FUNCTION_TARGET(AVX2) __m256i teddyLoadAvx2(const uchar *str) noexcept
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str));
+}
+
+static QT_FUNCTION_TARGET(AVX2) __m256i teddyLoadAvx2(const char16_t *str) noexcept
+{
+    // keep the low byte of each of the 32 code units; packing works within
+    // each 128-bit lane, so the 64-bit quarters need to be put back in order
+    const __m256i lowBytes = _mm256_set1_epi16(0x00ff);
+    const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str));
+    const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str + 16));
+    const __m256i packed = _mm256_packus_epi16(_mm256_and_si256(first, lowBytes),
+                                               _mm256_and_si256(second, lowBytes));
+    return _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+template <typename Char>
+static QT_FUNCTION_TARGET(AVX2)
+qsizetype teddyFindCandidateAvx2(const QMultiMatcherTeddyMasks &masks, const Char *str,
+                                 qsizetype length, qsizetype from, uint *buckets) noexcept
+{
+    constexpr qsizetype BlockSize = 32;
+    const int fingerprintLength = masks.fingerprintLength;
+    const __m256i nibble = _mm256_set1_epi8(0xf);
+    __m256i low[QMultiMatcherTeddyMasks::MaximumFingerprintLength];
+    __m256i high[QMultiMatcherTeddyMasks::MaximumFingerprintLength];
+    for (int k = 0; k < fingerprintLength; ++k) {
+        low[k] = _mm256_broadcastsi128_si256(
+                    _mm_load_si128(reinterpret_cast<const __m128i *>(masks.low[k])));
+        high[k] = _mm256_broadcastsi128_si256(
+                    _mm_load_si128(reinterpret_cast<const __m128i *>(masks.high[k])));
+    }
+
+    qsizetype i = from;
+    for ( ; i + BlockSize + fingerprintLength - 1 <= length; i += BlockSize) {
+        __m256i result = _mm256_set1_epi8(-1);
+        for (int k = 0; k < fingerprintLength; ++k) {
+            const __m256i data = teddyLoadAvx2(str + i + k);
+            const __m256i lowNibbles = _mm256_and_si256(data, nibble);
+            const __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi16(data, 4), nibble);
+            result = _mm256_and_si256(result,
+                                      _mm256_and_si256(_mm256_shuffle_epi8(low[k], lowNibbles),
+                                                       _mm256_shuffle_epi8(high[k], highNibbles)));
+        }
+        const uint found =
+                ~uint(_mm256_movemask_epi8(_mm256_cmpeq_epi8(result, _mm256_setzero_si256())));
+        if (found) {
+            alignas(32) uchar bucketsAt[BlockSize];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(bucketsAt), result);
+            const int offset = qCountTrailingZeroBits(found);
+            *buckets = bucketsAt[offset];
+            return i + offset;
+        }
+    }
+    return teddyFindCandidateScalar(masks, str, length, i, buckets);
+}
+#endif
+
+#if defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+static uint8x16_t teddyLoadNeon(const uchar *str) noexcept
+{
+    return vld1q_u8(str);
+}
+
+static uint8x16_t teddyLoadNeon(const char16_t *str) noexcept
+{
+    // narrowing keeps the low byte of each of the 16 code units
+    const uint16_t *data = reinterpret_cast<const uint16_t *>(str);
+    return vcombine_u8(vmovn_u16(vld1q_u16(data)), vmovn_u16(vld1q_u16(data + 8)));
+}
+
+template <typename Char>
+static qsizetype teddyFindCandidateNeon(const QMultiMatcherTeddyMasks &masks, const Char *str,
+                                        qsizetype length, qsizetype from, uint *buckets) noexcept
+{
+    constexpr qsizetype BlockSize = 16;
+    const int fingerprintLength = masks.fingerprintLength;
+    const uint8x16_t nibble = vdupq_n_u8(0xf);
+    uint8x16_t low[QMultiMatcherTeddyMasks::MaximumFingerprintLength];
+    uint8x16_t high[QMultiMatcherTeddyMasks::MaximumFingerprintLength];
+    for (int k = 0; k < fingerprintLength; ++k) {
+        low[k] = vld1q_u8(masks.low[k]);
+        high[k] = vld1q_u8(masks.high[k]);
+    }
+
+    qsizetype i = from;
+    for ( ; i + BlockSize + fingerprintLength - 1 <= length; i += BlockSize) {
+        uint8x16_t result = vdupq_n_u8(0xff);
+        for (int k = 0; k < fingerprintLength; ++k) {
+            const uint8x16_t data = teddyLoadNeon(str + i + k);
+            result = vandq_u8(result, vandq_u8(vqtbl1q_u8(low[k], vandq_u8(data, nibble)),
+                                               vqtbl1q_u8(high[k], vshrq_n_u8(data, 4))));
+        }
+        if (vmaxvq_u8(result)) {
+            uchar bucketsAt[BlockSize];
+            vst1q_u8(bucketsAt, result);
+            const auto it = std::find_if(std::begin(bucketsAt), std::end(bucketsAt),
+                                         [](uchar b) { return b != 0; });
+            *buckets = *it;
+            return i + (it - std::begin(bucketsAt));
+        }
+    }
+    return teddyFindCandidateScalar(masks, str, length, i, buckets);
+}
+#endif
+
+bool qt_teddyAvailable() noexcept
+{
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    if (qCpuHasFeature(SSSE3))
+        return true;
+#endif
+#if defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    return true;
+#else
+    return false;
+#endif
+}
+
+template <typename Char>
+static qsizetype teddyFindCandidate(const QMultiMatcherTeddyMasks &masks, const Char *str,
+                                    qsizetype length, qsizetype from, uint *buckets) noexcept
+{
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        return teddyFindCandidateAvx2(masks, str, length, from, buckets);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    if (qCpuHasFeature(SSSE3))
+        return teddyFindCandidateSsse3(masks, str, length, from, buckets);
+#endif
+#if defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    return teddyFindCandidateNeon(masks, str, length, from, buckets);
+#else
+    return teddyFindCandidateScalar(masks, str, length, from, buckets);
+#endif
+}
+
+qsizetype qt_teddyFindCandidate(const QMultiMatcherTeddyMasks &masks, const uchar *str,
+                                qsizetype length, qsizetype from, uint *buckets) noexcept
+{
+    return teddyFindCandidate(masks, str, length, from, buckets);
+}
+
+qsizetype qt_teddyFindCandidate(const QMultiMatcherTeddyMasks &masks, const char16_t *str,
+                                qsizetype length, qsizetype from, uint *buckets) noexcept
+{
+    return teddyFindCandidate(masks, str, length, from, buckets);
+}
+
+class QMultiByteArrayMatcherPrivate : public QSharedData
+{
+public:
+    void build();
+
+    bool patternAt(QByteArrayView data, qsizetype position, qsizetype pattern) const
+    {
+        const QByteArray &p = patterns.at(pattern);
+        return data.size() - position >= p.size()
+                && data.sliced(position, p.size()).compare(p, cs) == 0;
+    }
+
+    template <typename Callback>
+    void forEachTeddyMatch(QByteArrayView data, qsizetype from, Callback callback) const;
+
+    QByteArrayList patterns;
+    Qt::CaseSensitivity cs = Qt::CaseSensitive;
+    QMultiMatcherAutomaton<uchar> automaton;
+    QMultiMatcherTeddyMasks teddy;
+};
+
+void QMultiByteArrayMatcherPrivate::build()
+{
+    automaton.clear();
+    teddy = {};
+
+    qsizetype minimumLength = std::numeric_limits<qsizetype>::max();
+    for (const QByteArray &pattern : std::as_const(patterns))
+        minimumLength = qMin(minimumLength, pattern.size());
+
+    if (!patterns.isEmpty() && patterns.size() <= QMultiMatcherTeddyMasks::MaximumBuckets
+            && minimumLength > 0 && qt_teddyAvailable()) {
+        teddy.fingerprintLength = int(qMin(minimumLength,
+                                           qsizetype(QMultiMatcherTeddyMasks::MaximumFingerprintLength)));
+        for (qsizetype i = 0; i < patterns.size(); ++i) {
+            for (int k = 0; k < teddy.fingerprintLength; ++k) {
+                const char c = patterns.at(i).at(k);
+                teddy.add(int(i), k, uchar(c));
+                if (cs == Qt::CaseInsensitive) {
+                    teddy.add(int(i), k, uchar(QtMiscUtils::toAsciiLower(c)));
+                    teddy.add(int(i), k, uchar(QtMiscUtils::toAsciiUpper(c)));
+                }
+            }
+        }
+        return;
+    }
+
+    QVarLengthArray<uchar, 256> folded;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QByteArray &pattern = patterns.at(i);
+        folded.resize(pattern.size());
+        for (qsizetype k = 0; k < pattern.size(); ++k) {
+            const char c = pattern.at(k);
+            folded[k] = uchar(cs == Qt::CaseSensitive ? c : QtMiscUtils::toAsciiLower(c));
+        }
+        automaton.addPattern(folded.constData(), folded.size(), i);
+    }
+    automaton.build();
+}
+
+/*
+    Calls \a callback with the position and the index of every pattern that
+    occurs in \a data at or after \a from, in this order, until it returns
+    false.
+*/
+template <typename Callback>
+void QMultiByteArrayMatcherPrivate::forEachTeddyMatch(QByteArrayView data, qsizetype from,
+                                                      Callback callback) const
+{
+    const uchar *str = reinterpret_cast<const uchar *>(data.data());
+    uint buckets = 0;
+    for (qsizetype position = from;
+         (position = qt_teddyFindCandidate(teddy, str, data.size(), position, &buckets)) >= 0;
+         ++position) {
+        for ( ; buckets; buckets &= buckets - 1) {
+            const qsizetype pattern = qCountTrailingZeroBits(buckets);
+            if (patternAt(data, position, pattern) && !callback(position, pattern))
+                return;
+        }
+    }
+}
+
+/*!
+    \class QMultiByteArrayMatcher
+    \inmodule QtCore
+    \brief The QMultiByteArrayMatcher class holds a set of sequences of bytes
+    that can be quickly found in a byte array.
+
+    \since 6.5
+
+    \ingroup tools
+    \ingroup string-processing
+    \ingroup shared
+
+    Searching a byte array for any of several patterns, such as a list of
+    header names or keywords, with a QByteArrayMatcher or
+    QByteArray::indexOf() for each of them takes one pass over the data per
+    pattern. QMultiByteArrayMatcher looks for all of them in a single pass.
+
+    Create the QMultiByteArrayMatcher with the list of patterns you want to
+    search for. Then call indexIn() to find the first place where any of
+    them occurs, or findAll() to find all their occurrences. The patterns
+    can be matched without case sensitivity, in which case ASCII letters
+    match their lower and upper case forms.
+
+    For a small number of patterns, the positions at which one of them may
+    start are found with SIMD instructions, when the processor supports
+    them; for more patterns, or when it does not, they are searched with an
+    Aho-Corasick automaton.
+
+    \sa QByteArrayMatcher, QMultiStringMatcher
+*/
+
+/*!
+    \class QMultiByteArrayMatcher::Match
+    \inmodule QtCore
+
+    \brief The Match struct describes an occurrence of one of the patterns
+    of a QMultiByteArrayMatcher.
+
+    \variable QMultiByteArrayMatcher::Match::position
+    \brief the position of the first byte of the occurrence
+
+    \variable QMultiByteArrayMatcher::Match::length
+    \brief the length of the occurrence, that of its pattern
+
+    \variable QMultiByteArrayMatcher::Match::pattern
+    \brief the index of the pattern in patterns()
+*/
+
+/*!
+    Constructs an empty multi byte array matcher that won't match anything.
+    Call setPatterns() to give it the patterns to match.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher()
+    : d(new QMultiByteArrayMatcherPrivate)
+{
+    d->build();
+}
+
+/*!
+    Constructs a multi byte array matcher that will search for \a patterns,
+    with case sensitivity \a cs.
+
+    Call indexIn() or findAll() to perform a search.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QByteArrayList &patterns,
+                                               Qt::CaseSensitivity cs)
+    : d(new QMultiByteArrayMatcherPrivate)
+{
+    d->patterns = patterns;
+    d->cs = cs;
+    d->build();
+}
+
+/*!
+    Copies the \a other multi byte array matcher to this one.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other) = default;
+
+/*!
+    \fn QMultiByteArrayMatcher::QMultiByteArrayMatcher(QMultiByteArrayMatcher &&other)
+
+    Move-constructs a multi byte array matcher from \a other.
+
+    \note The moved-from object \a other is placed in a partially-formed
+    state, in which the only valid operations are destruction and assignment
+    of a new value.
+*/
+
+/*!
+    Destroys the multi byte array matcher.
+*/
+QMultiByteArrayMatcher::~QMultiByteArrayMatcher() = default;
+
+QT_DEFINE_QSDP_SPECIALIZATION_DTOR(QMultiByteArrayMatcherPrivate)
+
+/*!
+    Assigns the \a other multi byte array matcher to this one.
+*/
+QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(const QMultiByteArrayMatcher &other) = default;
+
+/*!
+    \fn QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(QMultiByteArrayMatcher &&other)
+
+    Move-assigns \a other to this multi byte array matcher.
+*/
+
+/*!
+    \fn void QMultiByteArrayMatcher::swap(QMultiByteArrayMatcher &other)
+
+    Swaps the multi byte array matcher \a other with this one. This operation
+    is very fast and never fails.
+*/
+
+/*!
+    Sets the byte arrays that this matcher will search for to \a patterns.
+
+    \sa patterns(), indexIn(), findAll()
+*/
+void QMultiByteArrayMatcher::setPatterns(const QByteArrayList &patterns)
+{
+    d->patterns = patterns;
+    d->build();
+}
+
+/*!
+    Returns the byte arrays that this matcher will search for.
+
+    \sa setPatterns()
+*/
+QByteArrayList QMultiByteArrayMatcher::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Sets the case sensitivity of the searches to \a cs.
+
+    \sa caseSensitivity()
+*/
+void QMultiByteArrayMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (d->cs == cs)
+        return;
+    d->cs = cs;
+    d->build();
+}
+
+/*!
+    Returns the case sensitivity of the searches.
+
+    \sa setCaseSensitivity()
+*/
+Qt::CaseSensitivity QMultiByteArrayMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Searches the byte array \a data, from byte position \a from (default
+    0, i.e. from the first byte), for the patterns(). Returns the first
+    position where one of them occurs, or -1 if none was found.
+
+    If \a patternIndex is not \nullptr, the index in patterns() of the
+    pattern that occurs there is stored in it; if several do, it is the
+    lowest index among them.
+
+    \sa findAll()
+*/
+qsizetype QMultiByteArrayMatcher::indexIn(QByteArrayView data, qsizetype from,
+                                          qsizetype *patternIndex) const
+{
+    if (from < 0)
+        from = 0;
+
+    qsizetype position = -1;
+    qsizetype pattern = -1;
+    if (d->teddy.fingerprintLength) {
+        d->forEachTeddyMatch(data, from, [&](qsizetype p, qsizetype index) {
+            position = p;
+            pattern = index;
+            return false;
+        });
+    } else if (d->cs == Qt::CaseSensitive) {
+        position = d->automaton.indexIn(reinterpret_cast<const uchar *>(data.data()), data.size(),
+                                        from, [](const uchar *c) { return *c; }, &pattern);
+    } else {
+        position = d->automaton.indexIn(reinterpret_cast<const uchar *>(data.data()), data.size(),
+                                        from, [](const uchar *c) {
+                                            return uchar(QtMiscUtils::toAsciiLower(char(*c)));
+                                        }, &pattern);
+    }
+
+    if (patternIndex)
+        *patternIndex = pattern;
+    return position;
+}
+
+/*!
+    Searches the byte array \a data, from byte position \a from (default
+    0, i.e. from the first byte), for the patterns(), and returns all their
+    occurrences, ordered by position and, at the same position, by the
+    index of their pattern. Occurrences may overlap.
+
+    \sa indexIn()
+*/
+QList<QMultiByteArrayMatcher::Match> QMultiByteArrayMatcher::findAll(QByteArrayView data,
+                                                                     qsizetype from) const
+{
+    if (from < 0)
+        from = 0;
+
+    QList<Match> matches;
+    const auto append = [&](qsizetype position, qsizetype pattern) {
+        matches.append(Match{ position, d->patterns.at(pattern).size(), pattern });
+        return true;
+    };
+
+    if (d->teddy.fingerprintLength) {
+        // already in order
+        d->forEachTeddyMatch(data, from, append);
+        return matches;
+    }
+
+    if (d->cs == Qt::CaseSensitive) {
+        d->automaton.forEachMatch(reinterpret_cast<const uchar *>(data.data()), data.size(), from,
+                                  [](const uchar *c) { return *c; }, append);
+    } else {
+        d->automaton.forEachMatch(reinterpret_cast<const uchar *>(data.data()), data.size(), from,
+                                  [](const uchar *c) {
+                                      return uchar(QtMiscUtils::toAsciiLower(char(*c)));
+                                  }, append);
+    }
+    std::sort(matches.begin(), matches.end(), [](const Match &lhs, const Match &rhs) {
+        return lhs.position != rhs.position ? lhs.position < rhs.position
+                                            : lhs.pattern < rhs.pattern;
+    });
+    return matches;
+}
+
+QT_END_NAMESPACE
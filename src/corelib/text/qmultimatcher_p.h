@@ -0,0 +1,306 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QMULTIMATCHER_P_H
+#define QMULTIMATCHER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qlist.h>
+
+#include <algorithm>
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    An Aho-Corasick automaton over code units of type Char, which finds the
+    occurrences of many patterns in a single pass over a string.
+
+    The patterns are added already folded; the search functions take a
+    function that returns the folded code unit at a given position of the
+    searched string, so that the same automaton serves for case sensitive
+    and case insensitive searches.
+*/
+template <typename Char>
+class QMultiMatcherAutomaton
+{
+public:
+    void clear()
+    {
+        nodes.clear();
+        edges.clear();
+        outputs.clear();
+        emptyPatterns.clear();
+        pendingEdges.clear();
+        pendingOutputs.clear();
+        std::fill(std::begin(rootTransitions), std::end(rootTransitions), 0);
+    }
+
+    bool isEmpty() const { return nodes.size() <= 1 && emptyPatterns.isEmpty(); }
+
+    void addPattern(const Char *pattern, qsizetype length, qsizetype index)
+    {
+        if (length == 0) {
+            emptyPatterns.append(index);
+            return;
+        }
+        if (pendingEdges.isEmpty()) {
+            pendingEdges.resize(1);
+            pendingOutputs.resize(1);
+        }
+
+        qint32 node = 0;
+        for (const Char *end = pattern + length; pattern != end; ++pattern) {
+            const Char c = *pattern;
+            auto &nodeEdges = pendingEdges[node];
+            const auto it = std::find_if(nodeEdges.cbegin(), nodeEdges.cend(),
+                                         [c](const Edge &edge) { return edge.character == c; });
+            if (it != nodeEdges.cend()) {
+                node = it->target;
+            } else {
+                const qint32 target = qint32(pendingEdges.size());
+                nodeEdges.append(Edge{ c, target });
+                pendingEdges.emplace_back();
+                pendingOutputs.emplace_back();
+                node = target;
+            }
+        }
+        pendingOutputs[node].append(index);
+    }
+
+    void build();
+
+    /*
+        Returns the position of the leftmost occurrence of any of the
+        patterns in \a str at or after \a from, and stores the lowest index
+        of the patterns that occur there in \a patternIndex.
+    */
+    template <typename Fold>
+    qsizetype indexIn(const Char *str, qsizetype length, qsizetype from, Fold fold,
+                      qsizetype *patternIndex) const
+    {
+        if (from > length)
+            return -1;
+
+        qsizetype bestPosition = -1;
+        qsizetype bestPattern = -1;
+        if (!emptyPatterns.isEmpty()) {
+            bestPosition = from;
+            bestPattern = emptyPatterns.first();
+        }
+
+        qint32 node = 0;
+        for (qsizetype i = from; i < length; ++i) {
+            // Occurrences that end further on start at or after the start of
+            // the longest prefix of a pattern that we are in
+            if (bestPosition >= 0 && i - nodes.at(node).depth > bestPosition)
+                break;
+            node = step(node, fold(str + i));
+            for (qint32 n = nodes.at(node).outputCount ? node : nodes.at(node).nextOutput; n != 0;
+                 n = nodes.at(n).nextOutput) {
+                const Node &match = nodes.at(n);
+                const qsizetype position = i + 1 - match.depth;
+                const qsizetype pattern = outputs.at(match.firstOutput);
+                if (bestPosition < 0 || position < bestPosition
+                        || (position == bestPosition && pattern < bestPattern)) {
+                    bestPosition = position;
+                    bestPattern = pattern;
+                }
+            }
+        }
+
+        if (patternIndex)
+            *patternIndex = bestPattern;
+        return bestPosition;
+    }
+
+    /*
+        Calls \a callback with the position and the index of the pattern of
+        every occurrence of the patterns in \a str at or after \a from,
+        ordered by the position at which they end.
+    */
+    template <typename Fold, typename Callback>
+    void forEachMatch(const Char *str, qsizetype length, qsizetype from, Fold fold,
+                      Callback callback) const
+    {
+        if (from > length)
+            return;
+
+        for (qsizetype pattern : emptyPatterns)
+            callback(from, pattern);
+
+        qint32 node = 0;
+        for (qsizetype i = from; i < length; ++i) {
+            node = step(node, fold(str + i));
+            for (qint32 n = nodes.at(node).outputCount ? node : nodes.at(node).nextOutput; n != 0;
+                 n = nodes.at(n).nextOutput) {
+                const Node &match = nodes.at(n);
+                const qsizetype position = i + 1 - match.depth;
+                for (qsizetype o = match.firstOutput; o < match.firstOutput + match.outputCount; ++o)
+                    callback(position, outputs.at(o));
+            }
+            for (qsizetype pattern : emptyPatterns)
+                callback(i + 1, pattern);
+        }
+    }
+
+private:
+    struct Edge
+    {
+        Char character;
+        qint32 target;
+        bool operator<(const Edge &other) const { return character < other.character; }
+    };
+
+    struct Node
+    {
+        qint32 firstEdge = 0;
+        qint32 edgeCount = 0;
+        qint32 failure = 0;
+        // the next node along the failure links that has outputs
+        qint32 nextOutput = 0;
+        qint32 firstOutput = 0;
+        qint32 outputCount = 0;
+        // the length of the prefix that leads to this node
+        qint32 depth = 0;
+    };
+
+    // Returns the node reached from \a node by \a c, or -1 if there is no
+    // edge for it; the root has an implicit edge to itself for every Char
+    qint32 transition(qint32 node, Char c) const
+    {
+        if (node == 0 && size_t(c) < std::size(rootTransitions))
+            return rootTransitions[c];
+        const Node &n = nodes.at(node);
+        const auto begin = edges.cbegin() + n.firstEdge;
+        const auto end = begin + n.edgeCount;
+        const auto it = std::lower_bound(begin, end, Edge{ c, 0 });
+        if (it != end && it->character == c)
+            return it->target;
+        return node == 0 ? 0 : -1;
+    }
+
+    qint32 step(qint32 node, Char c) const
+    {
+        qint32 next = transition(node, c);
+        while (next < 0) {
+            node = nodes.at(node).failure;
+            next = transition(node, c);
+        }
+        return next;
+    }
+
+    // During construction, the edges and outputs of each node are collected
+    // in these lists; build() then packs them into edges and outputs.
+    QList<QList<Edge>> pendingEdges;
+    QList<QList<qsizetype>> pendingOutputs;
+
+    QList<Node> nodes;
+    QList<Edge> edges;
+    QList<qsizetype> outputs;
+    QList<qsizetype> emptyPatterns;
+    // transitions of the root for the lowest code units
+    qint32 rootTransitions[sizeof(Char) == 1 ? 256 : 128] = {};
+};
+
+template <typename Char>
+void QMultiMatcherAutomaton<Char>::build()
+{
+    const qsizetype nodeCount = pendingEdges.size();
+    nodes.resize(nodeCount);
+    for (qsizetype i = 0; i < nodeCount; ++i) {
+        auto &nodeEdges = pendingEdges[i];
+        std::sort(nodeEdges.begin(), nodeEdges.end());
+        nodes[i].firstEdge = qint32(edges.size());
+        nodes[i].edgeCount = qint32(nodeEdges.size());
+        edges.append(nodeEdges);
+        nodes[i].firstOutput = qint32(outputs.size());
+        nodes[i].outputCount = qint32(pendingOutputs.at(i).size());
+        outputs.append(pendingOutputs.at(i));
+    }
+    pendingEdges.clear();
+    pendingOutputs.clear();
+    if (nodes.isEmpty())
+        nodes.resize(1);
+
+    const auto rootEdges = edges.first(nodes.at(0).edgeCount);
+    for (const Edge &edge : rootEdges) {
+        if (size_t(edge.character) < std::size(rootTransitions))
+            rootTransitions[edge.character] = edge.target;
+    }
+
+    // Compute the failure links breadth-first, so that the ones of shorter
+    // prefixes are known when they are needed
+    QList<qint32> queue;
+    queue.reserve(nodeCount);
+    for (const Edge &edge : rootEdges) {
+        nodes[edge.target].depth = 1;
+        queue.append(edge.target);
+    }
+    for (qsizetype i = 0; i < queue.size(); ++i) {
+        const qint32 parent = queue.at(i);
+        const Node &p = nodes.at(parent);
+        for (qint32 e = p.firstEdge; e < p.firstEdge + p.edgeCount; ++e) {
+            const Edge edge = edges.at(e);
+            Node &child = nodes[edge.target];
+            child.depth = p.depth + 1;
+            child.failure = step(p.failure, edge.character);
+            const Node &f = nodes.at(child.failure);
+            child.nextOutput = f.outputCount ? child.failure : f.nextOutput;
+            queue.append(edge.target);
+        }
+    }
+}
+
+/*
+    Nibble masks for the Teddy algorithm, which finds the positions at which
+    one of up to eight patterns may start with a few SIMD shuffles per block
+    of the string.
+
+    Every pattern is assigned a bucket, one bit of a byte. For each of the
+    first fingerprintLength positions of the patterns, low[k][n] has the bits
+    of the buckets of the patterns that may have a code unit whose low nibble
+    is n at position k, and high[k][n] the same for the high nibble. Only the
+    low byte of a code unit is considered.
+*/
+struct QMultiMatcherTeddyMasks
+{
+    static constexpr int MaximumBuckets = 8;
+    static constexpr int MaximumFingerprintLength = 3;
+
+    alignas(16) uchar low[MaximumFingerprintLength][16] = {};
+    alignas(16) uchar high[MaximumFingerprintLength][16] = {};
+    // 0 if the patterns are searched with the automaton instead
+    int fingerprintLength = 0;
+
+    void add(int bucket, int position, uchar byte)
+    {
+        low[position][byte & 0xf] |= uchar(1u << bucket);
+        high[position][byte >> 4] |= uchar(1u << bucket);
+    }
+};
+
+// Whether qt_teddyFindCandidate() has a SIMD implementation on this machine
+bool qt_teddyAvailable() noexcept;
+
+// Returns the first position at or after from at which one of the patterns
+// may start, and stores the bits of their buckets in buckets; -1 if none
+qsizetype qt_teddyFindCandidate(const QMultiMatcherTeddyMasks &masks, const uchar *str,
+                                qsizetype length, qsizetype from, uint *buckets) noexcept;
+qsizetype qt_teddyFindCandidate(const QMultiMatcherTeddyMasks &masks, const char16_t *str,
+                                qsizetype length, qsizetype from, uint *buckets) noexcept;
+
+QT_END_NAMESPACE
+
+#endif // QMULTIMATCHER_P_H
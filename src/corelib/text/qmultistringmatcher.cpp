@@ -0,0 +1,375 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qmultistringmatcher.h"
+#include "qmultimatcher_p.h"
+
+#include <private/qtools_p.h>
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Returns the case folded code unit at \a p, in the string that spans
+    [\a begin, \a end). The code units of surrogate pairs are folded as a
+    whole; case folding never moves a character to another plane.
+*/
+static char16_t foldedCodeUnit(const char16_t *p, const char16_t *begin, const char16_t *end)
+{
+    const char16_t c = *p;
+    if (c < 0x80)
+        return char16_t(QtMiscUtils::toAsciiLower(char(c)));
+    if (!QChar::isSurrogate(c))
+        return char16_t(QChar::toCaseFolded(char32_t(c)));
+    if (QChar::isHighSurrogate(c) && p + 1 != end && QChar::isLowSurrogate(p[1]))
+        return QChar::highSurrogate(QChar::toCaseFolded(QChar::surrogateToUcs4(c, p[1])));
+    if (QChar::isLowSurrogate(c) && p != begin && QChar::isHighSurrogate(p[-1]))
+        return QChar::lowSurrogate(QChar::toCaseFolded(QChar::surrogateToUcs4(p[-1], c)));
+    return c;
+}
+
+class QMultiStringMatcherPrivate : public QSharedData
+{
+public:
+    void build();
+
+    bool patternAt(QStringView str, qsizetype position, qsizetype pattern) const
+    {
+        const QString &p = patterns.at(pattern);
+        return str.size() - position >= p.size()
+                && str.sliced(position, p.size()).compare(p, cs) == 0;
+    }
+
+    template <typename Callback>
+    void forEachTeddyMatch(QStringView str, qsizetype from, Callback callback) const;
+
+    QStringList patterns;
+    Qt::CaseSensitivity cs = Qt::CaseSensitive;
+    QMultiMatcherAutomaton<char16_t> automaton;
+    QMultiMatcherTeddyMasks teddy;
+};
+
+void QMultiStringMatcherPrivate::build()
+{
+    automaton.clear();
+    teddy = {};
+
+    qsizetype minimumLength = std::numeric_limits<qsizetype>::max();
+    for (const QString &pattern : std::as_const(patterns))
+        minimumLength = qMin(minimumLength, pattern.size());
+
+    if (!patterns.isEmpty() && patterns.size() <= QMultiMatcherTeddyMasks::MaximumBuckets
+            && minimumLength > 0 && qt_teddyAvailable()) {
+        const int fingerprintLength =
+                int(qMin(minimumLength, qsizetype(QMultiMatcherTeddyMasks::MaximumFingerprintLength)));
+        bool usable = true;
+        for (qsizetype i = 0; usable && i < patterns.size(); ++i) {
+            for (int k = 0; k < fingerprintLength; ++k) {
+                const char16_t c = patterns.at(i).at(k).unicode();
+                if (cs == Qt::CaseSensitive) {
+                    teddy.add(int(i), k, uchar(c));
+                    continue;
+                }
+                // Every code unit that folds to the same as an ASCII one needs
+                // to pass the filter; for other characters, there are too many
+                // to bother
+                if (c >= 0x80) {
+                    usable = false;
+                    break;
+                }
+                teddy.add(int(i), k, uchar(QtMiscUtils::toAsciiLower(char(c))));
+                teddy.add(int(i), k, uchar(QtMiscUtils::toAsciiUpper(char(c))));
+                // LATIN SMALL LETTER LONG S and KELVIN SIGN
+                if (QtMiscUtils::toAsciiLower(char(c)) == 's')
+                    teddy.add(int(i), k, uchar(0x017f & 0xff));
+                else if (QtMiscUtils::toAsciiLower(char(c)) == 'k')
+                    teddy.add(int(i), k, uchar(0x212a & 0xff));
+            }
+        }
+        if (usable) {
+            teddy.fingerprintLength = fingerprintLength;
+            return;
+        }
+        teddy = {};
+    }
+
+    QVarLengthArray<char16_t, 256> folded;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QString &pattern = patterns.at(i);
+        const char16_t *begin = QStringView(pattern).utf16();
+        const char16_t *end = begin + pattern.size();
+        folded.resize(pattern.size());
+        for (const char16_t *p = begin; p != end; ++p)
+            folded[p - begin] = cs == Qt::CaseSensitive ? *p : foldedCodeUnit(p, begin, end);
+        automaton.addPattern(folded.constData(), folded.size(), i);
+    }
+    automaton.build();
+}
+
+/*
+    Calls \a callback with the position and the index of every pattern that
+    occurs in \a str at or after \a from, in this order, until it returns
+    false.
+*/
+template <typename Callback>
+void QMultiStringMatcherPrivate::forEachTeddyMatch(QStringView str, qsizetype from,
+                                                   Callback callback) const
+{
+    uint buckets = 0;
+    for (qsizetype position = from;
+         (position = qt_teddyFindCandidate(teddy, str.utf16(), str.size(), position, &buckets)) >= 0;
+         ++position) {
+        for ( ; buckets; buckets &= buckets - 1) {
+            const qsizetype pattern = qCountTrailingZeroBits(buckets);
+            if (patternAt(str, position, pattern) && !callback(position, pattern))
+                return;
+        }
+    }
+}
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \brief The QMultiStringMatcher class holds a set of sequences of
+    characters that can be quickly found in a Unicode string.
+
+    \since 6.5
+
+    \ingroup tools
+    \ingroup string-processing
+    \ingroup shared
+
+    Searching a string for any of several patterns, such as a list of
+    keywords or of words to filter, with a QStringMatcher or
+    QString::indexOf() for each of them takes one pass over the string per
+    pattern. QMultiStringMatcher looks for all of them in a single pass.
+
+    Create the QMultiStringMatcher with the list of patterns you want to
+    search for. Then call indexIn() to find the first place where any of
+    them occurs, or findAll() to find all their occurrences. Without case
+    sensitivity, the characters are compared by their case folded forms,
+    like QString::compare() does.
+
+    For a small number of patterns, the positions at which one of them may
+    start are found with SIMD instructions, when the processor supports
+    them; for more patterns, or when it does not, they are searched with an
+    Aho-Corasick automaton.
+
+    \sa QStringMatcher, QMultiByteArrayMatcher
+*/
+
+/*!
+    \class QMultiStringMatcher::Match
+    \inmodule QtCore
+
+    \brief The Match struct describes an occurrence of one of the patterns
+    of a QMultiStringMatcher.
+
+    \variable QMultiStringMatcher::Match::position
+    \brief the position of the first character of the occurrence
+
+    \variable QMultiStringMatcher::Match::length
+    \brief the length of the occurrence, that of its pattern
+
+    \variable QMultiStringMatcher::Match::pattern
+    \brief the index of the pattern in patterns()
+*/
+
+/*!
+    Constructs an empty multi string matcher that won't match anything.
+    Call setPatterns() to give it the patterns to match.
+*/
+QMultiStringMatcher::QMultiStringMatcher()
+    : d(new QMultiStringMatcherPrivate)
+{
+    d->build();
+}
+
+/*!
+    Constructs a multi string matcher that will search for \a patterns,
+    with case sensitivity \a cs.
+
+    Call indexIn() or findAll() to perform a search.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QStringList &patterns, Qt::CaseSensitivity cs)
+    : d(new QMultiStringMatcherPrivate)
+{
+    d->patterns = patterns;
+    d->cs = cs;
+    d->build();
+}
+
+/*!
+    Copies the \a other multi string matcher to this one.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other) = default;
+
+/*!
+    \fn QMultiStringMatcher::QMultiStringMatcher(QMultiStringMatcher &&other)
+
+    Move-constructs a multi string matcher from \a other.
+
+    \note The moved-from object \a other is placed in a partially-formed
+    state, in which the only valid operations are destruction and assignment
+    of a new value.
+*/
+
+/*!
+    Destroys the multi string matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher() = default;
+
+QT_DEFINE_QSDP_SPECIALIZATION_DTOR(QMultiStringMatcherPrivate)
+
+/*!
+    Assigns the \a other multi string matcher to this one.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other) = default;
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other)
+
+    Move-assigns \a other to this multi string matcher.
+*/
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+
+    Swaps the multi string matcher \a other with this one. This operation is
+    very fast and never fails.
+*/
+
+/*!
+    Sets the strings that this matcher will search for to \a patterns.
+
+    \sa patterns(), indexIn(), findAll()
+*/
+void QMultiStringMatcher::setPatterns(const QStringList &patterns)
+{
+    d->patterns = patterns;
+    d->build();
+}
+
+/*!
+    Returns the strings that this matcher will search for.
+
+    \sa setPatterns()
+*/
+QStringList QMultiStringMatcher::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Sets the case sensitivity of the searches to \a cs.
+
+    \sa caseSensitivity()
+*/
+void QMultiStringMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (d->cs == cs)
+        return;
+    d->cs = cs;
+    d->build();
+}
+
+/*!
+    Returns the case sensitivity of the searches.
+
+    \sa setCaseSensitivity()
+*/
+Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Searches the string \a str, from character position \a from (default 0,
+    i.e. from the first character), for the patterns(). Returns the first
+    position where one of them occurs, or -1 if none was found.
+
+    If \a patternIndex is not \nullptr, the index in patterns() of the
+    pattern that occurs there is stored in it; if several do, it is the
+    lowest index among them.
+
+    \sa findAll()
+*/
+qsizetype QMultiStringMatcher::indexIn(QStringView str, qsizetype from,
+                                       qsizetype *patternIndex) const
+{
+    if (from < 0)
+        from = 0;
+
+    qsizetype position = -1;
+    qsizetype pattern = -1;
+    if (d->teddy.fingerprintLength) {
+        d->forEachTeddyMatch(str, from, [&](qsizetype p, qsizetype index) {
+            position = p;
+            pattern = index;
+            return false;
+        });
+    } else if (d->cs == Qt::CaseSensitive) {
+        position = d->automaton.indexIn(str.utf16(), str.size(), from,
+                                        [](const char16_t *c) { return *c; }, &pattern);
+    } else {
+        const char16_t *begin = str.utf16();
+        const char16_t *end = begin + str.size();
+        position = d->automaton.indexIn(begin, str.size(), from, [=](const char16_t *c) {
+            return foldedCodeUnit(c, begin, end);
+        }, &pattern);
+    }
+
+    if (patternIndex)
+        *patternIndex = pattern;
+    return position;
+}
+
+/*!
+    Searches the string \a str, from character position \a from (default 0,
+    i.e. from the first character), for the patterns(), and returns all
+    their occurrences, ordered by position and, at the same position, by the
+    index of their pattern. Occurrences may overlap.
+
+    \sa indexIn()
+*/
+QList<QMultiStringMatcher::Match> QMultiStringMatcher::findAll(QStringView str,
+                                                               qsizetype from) const
+{
+    if (from < 0)
+        from = 0;
+
+    QList<Match> matches;
+    const auto append = [&](qsizetype position, qsizetype pattern) {
+        matches.append(Match{ position, d->patterns.at(pattern).size(), pattern });
+        return true;
+    };
+
+    if (d->teddy.fingerprintLength) {
+        // already in order
+        d->forEachTeddyMatch(str, from, append);
+        return matches;
+    }
+
+    if (d->cs == Qt::CaseSensitive) {
+        d->automaton.forEachMatch(str.utf16(), str.size(), from,
+                                  [](const char16_t *c) { return *c; }, append);
+    } else {
+        const char16_t *begin = str.utf16();
+        const char16_t *end = begin + str.size();
+        d->automaton.forEachMatch(begin, str.size(), from, [=](const char16_t *c) {
+            return foldedCodeUnit(c, begin, end);
+        }, append);
+    }
+    std::sort(matches.begin(), matches.end(), [](const Match &lhs, const Match &rhs) {
+        return lhs.position != rhs.position ? lhs.position < rhs.position
+                                            : lhs.pattern < rhs.pattern;
+    });
+    return matches;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,290 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qnumberformatter.h"
+#include "qnumberformatter_p.h"
+
+#include "qlocale_p.h"
+
+#include <private/qtools_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QNumberFormatterPrivate : public QSharedData
+{
+public:
+    explicit QNumberFormatterPrivate(const QLocale &locale);
+
+    void formatInteger(QFormatterOutput &out, qlonglong i) const
+    {
+        // Negating the minimum qlonglong would overflow; take a detour:
+        symbols.appendInteger(out, i < 0 ? 1u + qulonglong(-(i + 1)) : qulonglong(i), i < 0,
+                              -1, 10, -1, integerFlags);
+    }
+    void formatInteger(QFormatterOutput &out, qulonglong i) const
+    {
+        symbols.appendInteger(out, i, false, -1, 10, -1, integerFlags);
+    }
+    void formatDouble(QFormatterOutput &out, double d, char format, int precision) const;
+
+    QLocale locale;
+    QLocaleNumberSymbols symbols;
+    QLocaleNumberSymbols upperSymbols;
+    uint integerFlags = 0;
+    uint doubleFlags = 0;
+};
+
+QNumberFormatterPrivate::QNumberFormatterPrivate(const QLocale &locale)
+    : locale(locale),
+      symbols(QLocalePrivate::get(locale)->m_data),
+      upperSymbols(symbols.toUpper())
+{
+    // As QLocale::toString() for the respective types:
+    const QLocale::NumberOptions options = locale.numberOptions();
+    if (!(options & QLocale::OmitGroupSeparator)) {
+        integerFlags |= QLocaleData::GroupDigits;
+        doubleFlags |= QLocaleData::GroupDigits;
+    }
+    if (!(options & QLocale::OmitLeadingZeroInExponent))
+        doubleFlags |= QLocaleData::ZeroPadExponent;
+    if (options & QLocale::IncludeTrailingZeroesAfterDot)
+        doubleFlags |= QLocaleData::AddTrailingZeroes;
+}
+
+// As QLocale::toString(double, char, int)
+void QNumberFormatterPrivate::formatDouble(QFormatterOutput &out, double d, char format,
+                                           int precision) const
+{
+    QLocaleData::DoubleForm form = QLocaleData::DFDecimal;
+    uint flags = doubleFlags;
+    if (format >= 'A' && format <= 'Z')
+        flags |= QLocaleData::CapitalEorX;
+    switch (QtMiscUtils::toAsciiLower(format)) {
+    case 'e':
+        form = QLocaleData::DFExponent;
+        break;
+    case 'g':
+        form = QLocaleData::DFSignificantDigits;
+        break;
+    default:
+        break;
+    }
+    symbols.appendDouble(out, d, precision, form, -1, flags, &upperSymbols);
+}
+
+/*!
+    \class QNumberFormatter
+    \inmodule QtCore
+    \brief The QNumberFormatter class converts numbers to their localized
+    string representations.
+
+    \since 6.5
+
+    \ingroup i18n
+    \ingroup string-processing
+    \ingroup shared
+
+    QLocale::toString() looks up the digits, signs and separators of its
+    locale, and builds its result out of temporary strings, each time it
+    is called. When many numbers are formatted with the same locale, as
+    when filling a table or writing a report, a QNumberFormatter does the
+    lookup once, when it is constructed, and writes each number directly
+    into its result.
+
+    toString() returns the same strings as the corresponding
+    QLocale::toString() overloads, using the number options the locale had
+    when the formatter was constructed. formatTo() writes the text into a
+    buffer supplied by the caller instead, without allocating any memory.
+
+    \sa QLocale::toString(), QDateTimeFormatter
+*/
+
+/*!
+    Constructs a number formatter for the default locale.
+
+    \sa QLocale::setDefault()
+*/
+QNumberFormatter::QNumberFormatter()
+    : d(new QNumberFormatterPrivate(QLocale()))
+{
+}
+
+/*!
+    Constructs a number formatter that formats numbers as \a locale does,
+    with the number options \a locale has now.
+
+    \sa QLocale::numberOptions()
+*/
+QNumberFormatter::QNumberFormatter(const QLocale &locale)
+    : d(new QNumberFormatterPrivate(locale))
+{
+}
+
+/*!
+    Copies the \a other number formatter to this one.
+*/
+QNumberFormatter::QNumberFormatter(const QNumberFormatter &other) = default;
+
+/*!
+    \fn QNumberFormatter::QNumberFormatter(QNumberFormatter &&other)
+
+    Move-constructs a number formatter from \a other.
+
+    \note The moved-from object \a other is placed in a partially-formed
+    state, in which the only valid operations are destruction and assignment
+    of a new value.
+*/
+
+/*!
+    Destroys the number formatter.
+*/
+QNumberFormatter::~QNumberFormatter() = default;
+
+QT_DEFINE_QSDP_SPECIALIZATION_DTOR(QNumberFormatterPrivate)
+
+/*!
+    Assigns the \a other number formatter to this one.
+*/
+QNumberFormatter &QNumberFormatter::operator=(const QNumberFormatter &other) = default;
+
+/*!
+    \fn QNumberFormatter &QNumberFormatter::operator=(QNumberFormatter &&other)
+
+    Move-assigns \a other to this number formatter.
+*/
+
+/*!
+    \fn void QNumberFormatter::swap(QNumberFormatter &other)
+
+    Swaps the number formatter \a other with this one. This operation is
+    very fast and never fails.
+*/
+
+/*!
+    Returns the locale whose conventions this formatter follows.
+*/
+QLocale QNumberFormatter::locale() const
+{
+    return d->locale;
+}
+
+/*!
+    Returns a localized string representation of \a i, the same as
+    QLocale::toString() does.
+*/
+QString QNumberFormatter::toString(qlonglong i) const
+{
+    QFormatterOutput out(32);
+    d->formatInteger(out, i);
+    return out.takeString();
+}
+
+/*!
+    \overload
+*/
+QString QNumberFormatter::toString(qulonglong i) const
+{
+    QFormatterOutput out(32);
+    d->formatInteger(out, i);
+    return out.takeString();
+}
+
+/*!
+    \fn QString QNumberFormatter::toString(long i) const
+    \overload
+*/
+
+/*!
+    \fn QString QNumberFormatter::toString(ulong i) const
+    \overload
+*/
+
+/*!
+    \fn QString QNumberFormatter::toString(int i) const
+    \overload
+*/
+
+/*!
+    \fn QString QNumberFormatter::toString(uint i) const
+    \overload
+*/
+
+/*!
+    \overload
+
+    Returns a localized string representation of the floating-point number
+    \a f, in the given \a format and with the given \a precision, the same as
+    QLocale::toString(double, char, int) does.
+*/
+QString QNumberFormatter::toString(double f, char format, int precision) const
+{
+    QFormatterOutput out(32);
+    d->formatDouble(out, f, format, precision);
+    return out.takeString();
+}
+
+/*!
+    Writes the localized string representation of \a i to \a buffer, which
+    has room for \a size characters, and returns the length of the complete
+    representation.
+
+    If the returned length is greater than \a size, only the first \a size
+    characters were written; call again with a buffer of at least the
+    returned length to get all of it. No terminating null character is
+    written.
+*/
+qsizetype QNumberFormatter::formatTo(QChar *buffer, qsizetype size, qlonglong i) const
+{
+    QFormatterOutput out(buffer, size);
+    d->formatInteger(out, i);
+    return out.size();
+}
+
+/*!
+    \overload
+*/
+qsizetype QNumberFormatter::formatTo(QChar *buffer, qsizetype size, qulonglong i) const
+{
+    QFormatterOutput out(buffer, size);
+    d->formatInteger(out, i);
+    return out.size();
+}
+
+/*!
+    \fn qsizetype QNumberFormatter::formatTo(QChar *buffer, qsizetype size, long i) const
+    \overload
+*/
+
+/*!
+    \fn qsizetype QNumberFormatter::formatTo(QChar *buffer, qsizetype size, ulong i) const
+    \overload
+*/
+
+/*!
+    \fn qsizetype QNumberFormatter::formatTo(QChar *buffer, qsizetype size, int i) const
+    \overload
+*/
+
+/*!
+    \fn qsizetype QNumberFormatter::formatTo(QChar *buffer, qsizetype size, uint i) const
+    \overload
+*/
+
+/*!
+    \overload
+
+    Writes the localized string representation of the floating-point number
+    \a f, in the given \a format and with the given \a precision, to
+    \a buffer.
+
+    \sa toString(double, char, int)
+*/
+qsizetype QNumberFormatter::formatTo(QChar *buffer, qsizetype size, double f, char format,
+                                     int precision) const
+{
+    QFormatterOutput out(buffer, size);
+    d->formatDouble(out, f, format, precision);
+    return out.size();
+}
+
+QT_END_NAMESPACE
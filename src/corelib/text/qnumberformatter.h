@@ -0,0 +1,61 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QNUMBERFORMATTER_H
+#define QNUMBERFORMATTER_H
+
+#include <QtCore/qlocale.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+class QNumberFormatterPrivate;
+QT_DECLARE_QSDP_SPECIALIZATION_DTOR_WITH_EXPORT(QNumberFormatterPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QNumberFormatter
+{
+public:
+    QNumberFormatter();
+    explicit QNumberFormatter(const QLocale &locale);
+    QNumberFormatter(const QNumberFormatter &other);
+    QNumberFormatter(QNumberFormatter &&other) noexcept = default;
+    ~QNumberFormatter();
+
+    QNumberFormatter &operator=(const QNumberFormatter &other);
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QNumberFormatter)
+
+    void swap(QNumberFormatter &other) noexcept { d.swap(other.d); }
+
+    QLocale locale() const;
+
+    QString toString(qlonglong i) const;
+    QString toString(qulonglong i) const;
+    QString toString(long i) const { return toString(qlonglong(i)); }
+    QString toString(ulong i) const { return toString(qulonglong(i)); }
+    QString toString(int i) const { return toString(qlonglong(i)); }
+    QString toString(uint i) const { return toString(qulonglong(i)); }
+    QString toString(double f, char format = 'g', int precision = 6) const;
+
+    qsizetype formatTo(QChar *buffer, qsizetype size, qlonglong i) const;
+    qsizetype formatTo(QChar *buffer, qsizetype size, qulonglong i) const;
+    qsizetype formatTo(QChar *buffer, qsizetype size, long i) const
+    { return formatTo(buffer, size, qlonglong(i)); }
+    qsizetype formatTo(QChar *buffer, qsizetype size, ulong i) const
+    { return formatTo(buffer, size, qulonglong(i)); }
+    qsizetype formatTo(QChar *buffer, qsizetype size, int i) const
+    { return formatTo(buffer, size, qlonglong(i)); }
+    qsizetype formatTo(QChar *buffer, qsizetype size, uint i) const
+    { return formatTo(buffer, size, qulonglong(i)); }
+    qsizetype formatTo(QChar *buffer, qsizetype size, double f,
+                       char format = 'g', int precision = 6) const;
+
+private:
+    QSharedDataPointer<QNumberFormatterPrivate> d;
+};
+
+Q_DECLARE_SHARED(QNumberFormatter)
+
+QT_END_NAMESPACE
+
+#endif // QNUMBERFORMATTER_H
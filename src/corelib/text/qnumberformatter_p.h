@@ -0,0 +1,209 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QNUMBERFORMATTER_P_H
+#define QNUMBERFORMATTER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/private/qlocale_p.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvarlengtharray.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Collects the output of the formatters, either in a caller-supplied buffer
+    of \c size characters or in a string that grows as needed. Whatever does
+    not fit in a buffer is counted but not written, so that size() is the
+    length the complete text needs, as with snprintf().
+*/
+class QFormatterOutput
+{
+public:
+    QFormatterOutput(QChar *buffer, qsizetype size)
+        : m_buffer(buffer), m_capacity(size > 0 ? size : 0)
+    {}
+
+    explicit QFormatterOutput(qsizetype sizeHint)
+        : m_string(qMax(sizeHint, qsizetype(1)), Qt::Uninitialized),
+          m_buffer(m_string.data()), m_capacity(m_string.size()), m_growable(true)
+    {}
+
+    void append(QChar ch)
+    {
+        if (m_size < m_capacity || grow(1))
+            m_buffer[m_size] = ch;
+        ++m_size;
+    }
+
+    void append(QChar ch, qsizetype count)
+    {
+        for (; count > 0; --count)
+            append(ch);
+    }
+
+    void append(QStringView text)
+    {
+        if (m_capacity - m_size < text.size())
+            grow(text.size());
+        const qsizetype room = m_size < m_capacity ? m_capacity - m_size : 0;
+        const qsizetype n = qMin(room, text.size());
+        for (qsizetype i = 0; i < n; ++i)
+            m_buffer[m_size + i] = text[i];
+        m_size += text.size();
+    }
+
+    qsizetype size() const { return m_size; }
+
+    // Only for the growing kind:
+    QString takeString()
+    {
+        Q_ASSERT(m_growable);
+        m_string.truncate(m_size);
+        return std::move(m_string);
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(QFormatterOutput)
+
+    bool grow(qsizetype needed)
+    {
+        if (!m_growable)
+            return false;
+        m_string.resize(qMax(2 * m_capacity, m_size + needed));
+        m_buffer = m_string.data();
+        m_capacity = m_string.size();
+        return true;
+    }
+
+    QString m_string;
+    QChar *m_buffer;
+    qsizetype m_capacity;
+    qsizetype m_size = 0;
+    bool m_growable = false;
+};
+
+/*
+    The symbols a locale uses to write numbers, and the code that writes them
+    for QLocaleData::longLongToString(), unsLongLongToString() and
+    doubleToString(). QNumberFormatter and QDateTimeFormatter fetch the
+    symbols once, so that formatting many numbers does not have to look them
+    up (and, for the system locale, ask the system for them) each time.
+*/
+struct QLocaleNumberSymbols
+{
+    enum Symbol : uint {
+        ZeroDigit         = 0x01,
+        DecimalPoint      = 0x02,
+        GroupSeparator    = 0x04,
+        NegativeSign      = 0x08,
+        PositiveSign      = 0x10,
+        ExponentSeparator = 0x20,
+        AllSymbols        = 0x3f
+    };
+    enum PrecisionMode { DecimalDigits, SignificantDigits, ChopTrailingZeros };
+
+    // A double converted to digits, and the form appendDouble() writes it in;
+    // symbols() tells which symbols that needs.
+    struct DoubleDigits
+    {
+        DoubleDigits(double d, int precision, QLocaleData::DoubleForm form, uint flags,
+                     int groupingTop, int groupingHigher, int groupingLeast);
+
+        uint symbols(uint flags) const;
+        qsizetype sizeHint(int width, const QLocaleNumberSymbols &symbols) const;
+
+        QVarLengthArray<char> buffer;
+        int length = 0;
+        int decpt = 0;
+        int precision;
+        PrecisionMode mode = DecimalDigits;
+        bool negative = false;
+        bool nonFinite = false; // buffer holds "inf" or "nan"
+        bool useDecimal = false;
+    };
+
+    QLocaleNumberSymbols() = default;
+    // Symbols not in \a which are left empty
+    explicit QLocaleNumberSymbols(const QLocaleData *data, uint which = AllSymbols);
+
+    // The same symbols, as they appear in a number formatted with CapitalEorX:
+    QLocaleNumberSymbols toUpper() const;
+
+    void appendDigit(QFormatterOutput &out, uint digit) const
+    {
+        Q_ASSERT(digit < 10);
+        if (digitWidth == 1) {
+            out.append(QChar(char16_t(zeroUcs + digit)));
+        } else {
+            out.append(QChar::highSurrogate(zeroUcs + digit));
+            out.append(QChar::lowSurrogate(zeroUcs + digit));
+        }
+    }
+
+    // These take the QLocaleData::Flags. With CapitalEorX, all but the sign
+    // is written using \a upper, which must then be toUpper() of these
+    // symbols, if not null.
+    void appendInteger(QFormatterOutput &out, qulonglong magnitude, bool negative,
+                       int precision = -1, int base = 10, int width = -1, uint flags = 0,
+                       const QLocaleNumberSymbols *upper = nullptr) const;
+    void appendDouble(QFormatterOutput &out, double d, int precision = -1,
+                      QLocaleData::DoubleForm form = QLocaleData::DFSignificantDigits,
+                      int width = -1, uint flags = 0,
+                      const QLocaleNumberSymbols *upper = nullptr) const;
+    void appendDouble(QFormatterOutput &out, const DoubleDigits &number, int width = -1,
+                      uint flags = 0, const QLocaleNumberSymbols *upper = nullptr) const;
+
+    QString zero;
+    QString decimal;
+    QString group;
+    QString minus;
+    QString plus;
+    QString exponent;
+    char32_t zeroUcs = U'0';
+    qsizetype digitWidth = 1;
+    int groupingTop = 1;
+    int groupingHigher = 3;
+    int groupingLeast = 3;
+
+private:
+    void appendDecimalForm(QFormatterOutput &out, const char *digits, qsizetype count,
+                           int decpt, int precision, PrecisionMode mode, bool mustMarkDecimal,
+                           bool groupDigits) const;
+    void appendExponentForm(QFormatterOutput &out, const char *digits, qsizetype count,
+                            int decpt, int precision, PrecisionMode mode, bool mustMarkDecimal,
+                            int minExponentDigits) const;
+};
+
+/*
+    Runs \a write, which formats into a buffer and returns the length of the
+    complete text, straight into the storage of the returned string, retrying
+    once with the exact size if \a sizeHint was too small.
+*/
+template <typename Writer>
+QString qFormatToString(qsizetype sizeHint, Writer write)
+{
+    QString result(sizeHint, Qt::Uninitialized);
+    qsizetype size = write(result.data(), result.size());
+    if (size > result.size()) {
+        result.resize(size);
+        size = write(result.data(), size);
+    }
+    result.truncate(size);
+    return result;
+}
+
+QT_END_NAMESPACE
+
+#endif // QNUMBERFORMATTER_P_H
@@ -0,0 +1,925 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qregularexpressionset.h"
+
+#include "qmultimatcher_p.h"
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+/*!
+    \class QRegularExpressionSet
+    \inmodule QtCore
+    \reentrant
+
+    \brief The QRegularExpressionSet class matches a string against many
+    regular expressions at once.
+
+    \since 6.5
+
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+
+    \keyword regular expression set
+
+    A QRegularExpressionSet holds a list of patterns, all compiled with the
+    same pattern options. match() reports which of them match a subject
+    string:
+
+    \snippet code/src_corelib_text_qregularexpressionset.cpp 0
+
+    Matching every pattern of a large set against a string one after the
+    other is slow, even though usually only a few of them match. Before
+    running the patterns, QRegularExpressionSet therefore looks for the
+    literal strings that any match of each pattern must contain, and
+    searches for all of them in a single pass over the subject. Only the
+    patterns whose literals were found, and the ones for which no such
+    literal could be determined, are then matched with PCRE2. Patterns
+    that start with a fixed string, or contain one, are therefore much
+    cheaper in a set than patterns that consist only of character classes
+    and groups.
+
+    The patterns are compiled, and the literals extracted, the first time a
+    set is used for matching after a change, or by optimize().
+
+    \sa QRegularExpression, QRegularExpressionSetMatch
+*/
+
+/*!
+    \class QRegularExpressionSetMatch
+    \inmodule QtCore
+    \reentrant
+
+    \brief The QRegularExpressionSetMatch class provides the results of
+    matching a QRegularExpressionSet against a string.
+
+    \since 6.5
+
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+
+    A QRegularExpressionSetMatch object is returned by
+    QRegularExpressionSet::match(). matchedPatterns() returns the indexes of
+    the patterns that matched, and match() returns the
+    QRegularExpressionMatch of one of them, with the captured substrings.
+
+    \sa QRegularExpressionSet, QRegularExpressionMatch
+*/
+
+/*
+    Folds the characters of the literals of the patterns, and of the
+    subjects, for the automaton that finds the literals.
+
+    ASCII letters are folded to lower case, so that the literals of case
+    insensitive patterns are found as well. The literals of case sensitive
+    patterns may then be found where they do not occur; that is fine, as
+    every candidate is matched by PCRE2 afterwards.
+*/
+static char16_t foldLiteralCharacter(char16_t c)
+{
+    if (c >= 'A' && c <= 'Z')
+        return c | 0x20;
+    // the only characters that match an ASCII letter without case
+    // sensitivity: LATIN SMALL LETTER LONG S and KELVIN SIGN
+    if (c == 0x017f)
+        return u's';
+    if (c == 0x212a)
+        return u'k';
+    return c;
+}
+
+namespace {
+
+static bool isAsciiDigit(QChar c)
+{
+    return c.unicode() >= '0' && c.unicode() <= '9';
+}
+
+static bool isAsciiHexDigit(QChar c)
+{
+    const char16_t lower = c.unicode() | 0x20;
+    return isAsciiDigit(c) || (lower >= 'a' && lower <= 'f');
+}
+
+/*
+    Returns the position of the ']' that closes the character class that
+    starts at position \a start of \a pattern, or -1 if it cannot be told.
+*/
+static qsizetype endOfCharacterClass(QStringView pattern, qsizetype start)
+{
+    qsizetype i = start + 1;
+    if (i < pattern.size() && pattern.at(i) == u'^')
+        ++i;
+    // a ']' right at the start is part of the class
+    if (i < pattern.size() && pattern.at(i) == u']')
+        ++i;
+    while (i < pattern.size()) {
+        const QChar c = pattern.at(i);
+        if (c == u'\\') {
+            // quoting may hide the end of the class
+            if (i + 1 < pattern.size() && pattern.at(i + 1) == u'Q')
+                return -1;
+            i += 2;
+        } else if (c == u'[' && i + 1 < pattern.size() && pattern.at(i + 1) == u':') {
+            const qsizetype end = pattern.indexOf(":]"_L1, i + 2);
+            if (end < 0)
+                return -1;
+            i = end + 2;
+        } else if (c == u']') {
+            return i;
+        } else {
+            ++i;
+        }
+    }
+    return -1;
+}
+
+/*
+    Returns the position of the last character of the quantifier that
+    starts with the '{' at position \a start of \a pattern, or -1 if the
+    brace does not start a quantifier. Stores whether the quantifier allows
+    zero repetitions in \a optional.
+*/
+static qsizetype endOfBraceQuantifier(QStringView pattern, qsizetype start, bool *optional)
+{
+    qsizetype i = start + 1;
+    qsizetype minimum = 0;
+    qsizetype digits = 0;
+    for (; i < pattern.size() && isAsciiDigit(pattern.at(i)); ++i, ++digits)
+        minimum = qMin(minimum * 10 + pattern.at(i).digitValue(), qsizetype(1) << 20);
+    if (digits == 0)
+        return -1;
+    if (i < pattern.size() && pattern.at(i) == u',') {
+        ++i;
+        while (i < pattern.size() && isAsciiDigit(pattern.at(i)))
+            ++i;
+    }
+    if (i == pattern.size() || pattern.at(i) != u'}')
+        return -1;
+    *optional = minimum == 0;
+    return i;
+}
+
+/*
+    Returns a list of literal strings, at least one of which occurs in every
+    match of \a pattern: the longest fixed string at the top level of each
+    alternative. Returns an empty list if there is an alternative without
+    one, or if the pattern uses syntax that makes this too hard to tell.
+
+    Strings inside groups are not considered, as the group may be optional,
+    part of an alternation or a lookaround assertion.
+*/
+static QStringList requiredLiterals(QStringView pattern,
+                                    QRegularExpression::PatternOptions options)
+{
+    // comments and insignificant white space are not worth the trouble
+    if (options & QRegularExpression::ExtendedPatternSyntaxOption)
+        return {};
+    const bool caseInsensitive = options.testFlag(QRegularExpression::CaseInsensitiveOption);
+
+    QStringList literals;
+    QString longest;
+    QString current;
+    int depth = 0;
+    // whether the last atom is the last character of current
+    bool lastIsLiteral = false;
+
+    const auto endLiteral = [&]() {
+        if (current.size() > longest.size())
+            longest = current;
+        current.clear();
+        lastIsLiteral = false;
+    };
+    const auto endAlternative = [&]() {
+        endLiteral();
+        if (longest.isEmpty())
+            return false;
+        literals.append(longest);
+        longest.clear();
+        return true;
+    };
+    const auto appendLiteral = [&](QChar c) {
+        if (depth > 0) {
+            lastIsLiteral = false;
+        } else if (caseInsensitive && c.unicode() >= 0x80) {
+            // only ASCII letters are folded by foldLiteralCharacter()
+            endLiteral();
+        } else {
+            current.append(c);
+            lastIsLiteral = true;
+        }
+    };
+    // the atom just before a quantifier may not occur at all
+    const auto dropOptionalLiteral = [&]() {
+        if (lastIsLiteral) {
+            current.chop(1);
+            if (!current.isEmpty() && current.back().isHighSurrogate())
+                current.chop(1);
+        }
+        endLiteral();
+    };
+
+    const qsizetype size = pattern.size();
+    for (qsizetype i = 0; i < size; ++i) {
+        const QChar c = pattern.at(i);
+        switch (c.unicode()) {
+        case '\\': {
+            if (++i == size)
+                return {};
+            const QChar escaped = pattern.at(i);
+            if (escaped == u'Q') {
+                qsizetype end = pattern.indexOf("\\E"_L1, i + 1);
+                if (end < 0)
+                    end = size;
+                for (QChar quoted : pattern.sliced(i + 1, end - i - 1))
+                    appendLiteral(quoted);
+                i = end + 1;
+            } else if (escaped == u'E') {
+                // PCRE2 ignores a lone \E, so a quantifier after it still
+                // applies to the atom before it
+            } else if (escaped == u'c') {
+                // a control character
+                ++i;
+                endLiteral();
+            } else if (escaped.isLetterOrNumber()) {
+                // Character types, assertions, back references and escaped
+                // code points; skip the arguments of the ones that have some
+                endLiteral();
+                const auto next = [&]() { return i + 1 < size ? pattern.at(i + 1) : QChar(); };
+                switch (escaped.unicode()) {
+                case 'g': case 'k': case 'N': case 'o': case 'p': case 'P': case 'x': {
+                    const QChar open = next();
+                    const QChar close = open == u'{' ? u'}' : open == u'<' ? u'>'
+                                      : open == u'\'' ? u'\'' : QChar();
+                    if (!close.isNull()) {
+                        i = pattern.indexOf(close, i + 2);
+                        if (i < 0)
+                            return {};
+                    } else if (escaped == u'x') {
+                        for (int digits = 0; digits < 2 && isAsciiHexDigit(next()); ++digits)
+                            ++i;
+                    } else if (escaped == u'p' || escaped == u'P') {
+                        ++i;
+                    } else if (escaped == u'g') {
+                        if (next() == u'-' || next() == u'+')
+                            ++i;
+                        while (isAsciiDigit(next()))
+                            ++i;
+                    }
+                    break;
+                }
+                default:
+                    while (escaped.isDigit() && isAsciiDigit(next()))
+                        ++i;
+                    break;
+                }
+            } else {
+                appendLiteral(escaped);
+            }
+            break;
+        }
+        case '[': {
+            i = endOfCharacterClass(pattern, i);
+            if (i < 0)
+                return {};
+            endLiteral();
+            break;
+        }
+        case '(':
+            // Verbs such as (*ACCEPT) or (*SKIP) can end a match early or
+            // change where it may start
+            if (i + 1 < size && pattern.at(i + 1) == u'*')
+                return {};
+            // A comment is ignored like a lone \E; it ends at the first ')'
+            if (pattern.sliced(i + 1).startsWith("?#"_L1)) {
+                i = pattern.indexOf(u')', i + 3);
+                if (i < 0)
+                    return {};
+                break;
+            }
+            if (i + 1 < size && pattern.at(i + 1) == u'?') {
+                // Inline options may change the case sensitivity, and
+                // conditions and recursion are rare enough to give up on
+                const QStringView rest = pattern.sliced(i + 2);
+                const bool known = rest.startsWith(u':') || rest.startsWith(u'=')
+                        || rest.startsWith(u'!') || rest.startsWith(u'>') || rest.startsWith(u'|')
+                        || rest.startsWith(u'<') || rest.startsWith(u'\'')
+                        || rest.startsWith("P<"_L1);
+                if (!known)
+                    return {};
+            }
+            ++depth;
+            endLiteral();
+            break;
+        case ')':
+            if (--depth < 0)
+                return {};
+            endLiteral();
+            break;
+        case '|':
+            if (depth == 0 && !endAlternative())
+                return {};
+            endLiteral();
+            break;
+        case '*':
+        case '?':
+            dropOptionalLiteral();
+            break;
+        case '+':
+            // the last atom occurs at least once, but may be repeated
+            endLiteral();
+            break;
+        case '{': {
+            bool optional = false;
+            const qsizetype end = endOfBraceQuantifier(pattern, i, &optional);
+            // Whether any other brace is a literal depends on the PCRE2
+            // version: 10.43 and later also read {,n} and { n } as quantifiers
+            if (end < 0)
+                return {};
+            if (optional)
+                dropOptionalLiteral();
+            else
+                endLiteral();
+            i = end;
+            break;
+        }
+        case '.':
+        case '^':
+        case '$':
+            endLiteral();
+            break;
+        default:
+            appendLiteral(c);
+            break;
+        }
+    }
+
+    if (depth != 0 || !endAlternative())
+        return {};
+    return literals;
+}
+
+} // unnamed namespace
+
+struct QRegularExpressionSetPrivate : QSharedData
+{
+    QRegularExpressionSetPrivate() = default;
+    QRegularExpressionSetPrivate(const QRegularExpressionSetPrivate &other);
+
+    void compile();
+    void doMatch(QRegularExpressionSetMatchPrivate *priv, const QString *subjectStorage,
+                 QStringView subject, qsizetype offset, const char *where) const;
+
+    // sizeof(QSharedData) == 4, so start our members with an enum
+    QRegularExpression::PatternOptions patternOptions;
+    QList<QRegularExpression> regularExpressions;
+
+    // *All* of the following members are managed while holding this mutex,
+    // except for isDirty which is set to true by QRegularExpressionSet
+    // setters (right after a detach happened).
+    mutable QMutex mutex;
+    QMultiMatcherAutomaton<char16_t> literals;
+    // the patterns for which no literal could be found
+    QList<qsizetype> unfilteredPatterns;
+    bool isValid = true;
+    bool isDirty = true;
+};
+
+QRegularExpressionSetPrivate::QRegularExpressionSetPrivate(const QRegularExpressionSetPrivate &other)
+    : QSharedData(other),
+      patternOptions(other.patternOptions),
+      regularExpressions(other.regularExpressions)
+{
+}
+
+/*!
+    \internal
+
+    Compiles the patterns, and builds the matcher for their literals.
+*/
+void QRegularExpressionSetPrivate::compile()
+{
+    const QMutexLocker lock(&mutex);
+    if (!isDirty)
+        return;
+
+    isDirty = false;
+    literals.clear();
+    unfilteredPatterns.clear();
+    isValid = true;
+    QVarLengthArray<char16_t, 64> folded;
+    for (qsizetype i = 0; i < regularExpressions.size(); ++i) {
+        const QRegularExpression &re = regularExpressions.at(i);
+        re.optimize();
+        if (!re.isValid())
+            isValid = false;
+
+        const QStringList required = requiredLiterals(re.pattern(), patternOptions);
+        if (required.isEmpty()) {
+            unfilteredPatterns.append(i);
+            continue;
+        }
+        for (const QString &literal : required) {
+            folded.resize(literal.size());
+            std::transform(literal.cbegin(), literal.cend(), folded.begin(),
+                           [](QChar c) { return foldLiteralCharacter(c.unicode()); });
+            literals.addPattern(folded.constData(), folded.size(), i);
+        }
+    }
+    literals.build();
+}
+
+struct QRegularExpressionSetMatchPrivate : QSharedData
+{
+    QRegularExpressionSetMatchPrivate(const QRegularExpressionSet &set,
+                                      QRegularExpression::MatchType matchType,
+                                      QRegularExpression::MatchOptions matchOptions)
+        : regularExpressionSet(set), matchType(matchType), matchOptions(matchOptions)
+    {
+    }
+
+    const QRegularExpressionSet regularExpressionSet;
+    const QRegularExpression::MatchType matchType;
+    const QRegularExpression::MatchOptions matchOptions;
+
+    // the matches of the patterns in matchedPatterns, in the same order
+    QList<qsizetype> matchedPatterns;
+    QList<QRegularExpressionMatch> matches;
+
+    bool hasMatch = false;
+    bool hasPartialMatch = false;
+    bool isValid = false;
+};
+
+/*!
+    \internal
+
+    Matches the candidate patterns against \a subject and stores the results
+    in \a priv. \a subjectStorage is the string that \a subject refers to,
+    if the set is matched against a QString. \a where is the name of the
+    calling function.
+*/
+void QRegularExpressionSetPrivate::doMatch(QRegularExpressionSetMatchPrivate *priv,
+                                           const QString *subjectStorage, QStringView subject,
+                                           qsizetype offset, const char *where) const
+{
+    if (!isValid) {
+        qWarning("%s(): called on a set with an invalid pattern", where);
+        return;
+    }
+    priv->isValid = true;
+    if (priv->matchType == QRegularExpression::NoMatch)
+        return;
+
+    const qsizetype count = regularExpressions.size();
+    QVarLengthArray<bool, 256> candidates(count);
+    if (priv->matchType == QRegularExpression::NormalMatch) {
+        std::fill(candidates.begin(), candidates.end(), false);
+        for (qsizetype i : unfilteredPatterns)
+            candidates[i] = true;
+        // a match cannot contain the characters in front of the offset
+        const qsizetype start = offset < 0 ? offset + subject.size() : offset;
+        if (!literals.isEmpty()) {
+            literals.forEachMatch(subject.utf16(), subject.size(), qMax(start, qsizetype(0)),
+                                  [](const char16_t *c) { return foldLiteralCharacter(*c); },
+                                  [&](qsizetype, qsizetype pattern) { candidates[pattern] = true; });
+        }
+    } else {
+        // a partial match need not contain any literal
+        std::fill(candidates.begin(), candidates.end(), true);
+    }
+
+    for (qsizetype i = 0; i < count; ++i) {
+        if (!candidates[i])
+            continue;
+        const QRegularExpression &re = regularExpressions.at(i);
+        QRegularExpressionMatch m = subjectStorage
+                ? re.match(*subjectStorage, offset, priv->matchType, priv->matchOptions)
+                : re.matchView(subject, offset, priv->matchType, priv->matchOptions);
+        if (m.hasMatch())
+            priv->hasMatch = true;
+        else if (m.hasPartialMatch())
+            priv->hasPartialMatch = true;
+        else
+            continue;
+        priv->matchedPatterns.append(i);
+        priv->matches.append(std::move(m));
+    }
+}
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QRegularExpressionSetPrivate)
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QRegularExpressionSetMatchPrivate)
+
+/*!
+    Constructs an empty regular expression set.
+
+    \sa setPatterns(), addPattern()
+*/
+QRegularExpressionSet::QRegularExpressionSet()
+    : d(new QRegularExpressionSetPrivate)
+{
+}
+
+/*!
+    Constructs a regular expression set of the given \a patterns, all of
+    which use the pattern options \a options.
+
+    \sa setPatterns(), setPatternOptions()
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QStringList &patterns,
+                                             QRegularExpression::PatternOptions options)
+    : d(new QRegularExpressionSetPrivate)
+{
+    d->patternOptions = options;
+    setPatterns(patterns);
+}
+
+/*!
+    Constructs a regular expression set as a copy of \a other.
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QRegularExpressionSet &other) noexcept = default;
+
+/*!
+    \fn QRegularExpressionSet::QRegularExpressionSet(QRegularExpressionSet &&other)
+
+    Constructs a regular expression set by moving from \a other.
+
+    \note The moved-from object \a other is placed in a
+    partially-formed state, in which the only valid operations are
+    destruction and assignment of a new value.
+*/
+
+/*!
+    Destroys the regular expression set.
+*/
+QRegularExpressionSet::~QRegularExpressionSet() = default;
+
+/*!
+    Assigns \a other to this regular expression set and returns a reference
+    to it.
+*/
+QRegularExpressionSet &QRegularExpressionSet::operator=(const QRegularExpressionSet &other) noexcept = default;
+
+/*!
+    \fn QRegularExpressionSet &QRegularExpressionSet::operator=(QRegularExpressionSet &&other)
+
+    Move-assigns \a other to this regular expression set.
+*/
+
+/*!
+    \fn void QRegularExpressionSet::swap(QRegularExpressionSet &other)
+
+    Swaps this regular expression set with \a other. This operation is very
+    fast and never fails.
+*/
+
+/*!
+    Returns the patterns of the set.
+
+    \sa setPatterns(), regularExpression()
+*/
+QStringList QRegularExpressionSet::patterns() const
+{
+    QStringList result;
+    result.reserve(d->regularExpressions.size());
+    for (const QRegularExpression &re : std::as_const(d->regularExpressions))
+        result.append(re.pattern());
+    return result;
+}
+
+/*!
+    Replaces the patterns of the set with \a patterns. The index of each
+    pattern in the list identifies it in the results of match().
+
+    \sa patterns(), addPattern()
+*/
+void QRegularExpressionSet::setPatterns(const QStringList &patterns)
+{
+    d.detach();
+    d->isDirty = true;
+    d->regularExpressions.clear();
+    d->regularExpressions.reserve(patterns.size());
+    for (const QString &pattern : patterns)
+        d->regularExpressions.append(QRegularExpression(pattern, d->patternOptions));
+}
+
+/*!
+    Adds \a pattern to the set and returns its index.
+
+    \sa setPatterns()
+*/
+qsizetype QRegularExpressionSet::addPattern(const QString &pattern)
+{
+    d.detach();
+    d->isDirty = true;
+    d->regularExpressions.append(QRegularExpression(pattern, d->patternOptions));
+    return d->regularExpressions.size() - 1;
+}
+
+/*!
+    Returns the pattern options of the set.
+
+    \sa setPatternOptions()
+*/
+QRegularExpression::PatternOptions QRegularExpressionSet::patternOptions() const
+{
+    return d->patternOptions;
+}
+
+/*!
+    Sets the pattern options of all patterns of the set to \a options.
+
+    \sa patternOptions(), QRegularExpression::setPatternOptions()
+*/
+void QRegularExpressionSet::setPatternOptions(QRegularExpression::PatternOptions options)
+{
+    if (d->patternOptions == options)
+        return;
+    d.detach();
+    d->isDirty = true;
+    d->patternOptions = options;
+    for (QRegularExpression &re : d->regularExpressions)
+        re.setPatternOptions(options);
+}
+
+/*!
+    Returns the number of patterns in the set.
+
+    \sa isEmpty()
+*/
+qsizetype QRegularExpressionSet::size() const
+{
+    return d->regularExpressions.size();
+}
+
+/*!
+    \fn bool QRegularExpressionSet::isEmpty() const
+
+    Returns \c true if the set has no patterns.
+
+    \sa size()
+*/
+
+/*!
+    Returns the regular expression for the pattern with the given \a index,
+    which can be used to check whether it is valid and why not.
+
+    \a index must be a valid index in the set (i.e., 0 <= \a index < size()).
+*/
+QRegularExpression QRegularExpressionSet::regularExpression(qsizetype index) const
+{
+    Q_ASSERT_X(index >= 0 && index < size(), "QRegularExpressionSet::regularExpression",
+               "index out of range");
+    return d->regularExpressions.at(index);
+}
+
+/*!
+    Returns \c true if all patterns of the set are valid regular
+    expressions. Use regularExpression() to find out which of them is not,
+    and why.
+
+    \sa QRegularExpression::isValid()
+*/
+bool QRegularExpressionSet::isValid() const
+{
+    d.data()->compile();
+    return d->isValid;
+}
+
+/*!
+    Matches all patterns of the set against the string \a subject, starting
+    at the position \a offset inside it, and returns the result. Each
+    pattern is matched as QRegularExpression::match() would with the same
+    arguments; \a matchType and \a matchOptions apply to all of them.
+
+    Only a NormalMatch can make use of the literals of the patterns; with
+    the partial match types, all patterns are matched one after the other.
+
+    \sa QRegularExpressionSetMatch, QRegularExpression::match()
+*/
+QRegularExpressionSetMatch QRegularExpressionSet::match(const QString &subject,
+                                                        qsizetype offset,
+                                                        QRegularExpression::MatchType matchType,
+                                                        QRegularExpression::MatchOptions matchOptions) const
+{
+    d.data()->compile();
+
+    auto priv = new QRegularExpressionSetMatchPrivate(*this, matchType, matchOptions);
+    d->doMatch(priv, &subject, subject, offset, "QRegularExpressionSet::match");
+    return QRegularExpressionSetMatch(*priv);
+}
+
+/*!
+    \overload
+
+    Matches all patterns of the set against the string view \a subjectView,
+    starting at the position \a offset inside it, and returns the result.
+
+    \note The data referenced by \a subjectView must remain valid as long
+    as there are QRegularExpressionSetMatch or QRegularExpressionMatch
+    objects using it.
+
+    \sa match()
+*/
+QRegularExpressionSetMatch QRegularExpressionSet::matchView(QStringView subjectView,
+                                                            qsizetype offset,
+                                                            QRegularExpression::MatchType matchType,
+                                                            QRegularExpression::MatchOptions matchOptions) const
+{
+    d.data()->compile();
+
+    auto priv = new QRegularExpressionSetMatchPrivate(*this, matchType, matchOptions);
+    d->doMatch(priv, nullptr, subjectView, offset, "QRegularExpressionSet::matchView");
+    return QRegularExpressionSetMatch(*priv);
+}
+
+/*!
+    Compiles all patterns of the set and prepares the search for their
+    literals, if that has not been done yet. Otherwise, this happens the
+    first time the set is used for matching.
+
+    \sa QRegularExpression::optimize()
+*/
+void QRegularExpressionSet::optimize() const
+{
+    d.data()->compile();
+}
+
+/*!
+    \internal
+*/
+QRegularExpressionSetMatch::QRegularExpressionSetMatch(QRegularExpressionSetMatchPrivate &dd)
+    : d(&dd)
+{
+}
+
+/*!
+    Constructs a valid, empty QRegularExpressionSetMatch object, in which
+    no pattern matched.
+
+    \sa isValid(), hasMatch()
+*/
+QRegularExpressionSetMatch::QRegularExpressionSetMatch()
+    : d(new QRegularExpressionSetMatchPrivate(QRegularExpressionSet(),
+                                              QRegularExpression::NoMatch,
+                                              QRegularExpression::NoMatchOption))
+{
+    d->isValid = true;
+}
+
+/*!
+    Destroys the match result.
+*/
+QRegularExpressionSetMatch::~QRegularExpressionSetMatch() = default;
+
+/*!
+    Constructs a match result by copying the result of the given \a match.
+*/
+QRegularExpressionSetMatch::QRegularExpressionSetMatch(const QRegularExpressionSetMatch &match) = default;
+
+/*!
+    \fn QRegularExpressionSetMatch::QRegularExpressionSetMatch(QRegularExpressionSetMatch &&match)
+
+    Constructs a match result by moving the result from the given \a match.
+
+    \note The moved-from object \a match is placed in a
+    partially-formed state, in which the only valid operations are
+    destruction and assignment of a new value.
+*/
+
+/*!
+    Assigns the match result \a match to this object, and returns a
+    reference to the copy.
+*/
+QRegularExpressionSetMatch &QRegularExpressionSetMatch::operator=(const QRegularExpressionSetMatch &match) = default;
+
+/*!
+    \fn QRegularExpressionSetMatch &QRegularExpressionSetMatch::operator=(QRegularExpressionSetMatch &&match)
+
+    Move-assigns the match result \a match to this object, and returns a
+    reference to the result.
+*/
+
+/*!
+    \fn void QRegularExpressionSetMatch::swap(QRegularExpressionSetMatch &other)
+
+    Swaps the match result \a other with this match result. This operation
+    is very fast and never fails.
+*/
+
+/*!
+    Returns the QRegularExpressionSet object whose match() function returned
+    this object.
+
+    \sa QRegularExpressionSet::match()
+*/
+QRegularExpressionSet QRegularExpressionSetMatch::regularExpressionSet() const
+{
+    return d->regularExpressionSet;
+}
+
+/*!
+    Returns the match type that was used to get this object from a
+    QRegularExpressionSet.
+
+    \sa QRegularExpressionSet::match()
+*/
+QRegularExpression::MatchType QRegularExpressionSetMatch::matchType() const
+{
+    return d->matchType;
+}
+
+/*!
+    Returns the match options that were used to get this object from a
+    QRegularExpressionSet.
+
+    \sa QRegularExpressionSet::match()
+*/
+QRegularExpression::MatchOptions QRegularExpressionSetMatch::matchOptions() const
+{
+    return d->matchOptions;
+}
+
+/*!
+    Returns \c true if at least one pattern of the set matched the subject.
+
+    \sa matchedPatterns(), hasPartialMatch()
+*/
+bool QRegularExpressionSetMatch::hasMatch() const
+{
+    return d->hasMatch;
+}
+
+/*!
+    Returns \c true if at least one pattern of the set matched the subject
+    partially, and no pattern matched it completely.
+
+    \sa hasMatch(), QRegularExpressionMatch::hasPartialMatch()
+*/
+bool QRegularExpressionSetMatch::hasPartialMatch() const
+{
+    return !d->hasMatch && d->hasPartialMatch;
+}
+
+/*!
+    Returns \c true if the match object was obtained as a result from the
+    QRegularExpressionSet::match() function invoked on a set of valid
+    patterns; returns \c false if one of the patterns was invalid.
+
+    \sa QRegularExpressionSet::isValid()
+*/
+bool QRegularExpressionSetMatch::isValid() const
+{
+    return d->isValid;
+}
+
+/*!
+    Returns the indexes of the patterns of the set that matched the subject,
+    either completely or partially, in ascending order.
+
+    \sa hasMatch(), match()
+*/
+QList<qsizetype> QRegularExpressionSetMatch::matchedPatterns() const
+{
+    return d->matchedPatterns;
+}
+
+/*!
+    \overload
+
+    Returns \c true if the pattern with the given \a index matched the
+    subject, either completely or partially.
+
+    \sa matchedPatterns()
+*/
+bool QRegularExpressionSetMatch::hasMatch(qsizetype index) const
+{
+    return std::binary_search(d->matchedPatterns.cbegin(), d->matchedPatterns.cend(), index);
+}
+
+/*!
+    Returns the result of matching the pattern with the given \a index
+    against the subject, which gives access to the captured substrings. If
+    the pattern did not match, the returned QRegularExpressionMatch has no
+    match.
+
+    \sa hasMatch(), matchedPatterns()
+*/
+QRegularExpressionMatch QRegularExpressionSetMatch::match(qsizetype index) const
+{
+    const auto it = std::lower_bound(d->matchedPatterns.cbegin(), d->matchedPatterns.cend(), index);
+    if (it == d->matchedPatterns.cend() || *it != index)
+        return QRegularExpressionMatch();
+    return d->matches.at(it - d->matchedPatterns.cbegin());
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,114 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QREGULAREXPRESSIONSET_H
+#define QREGULAREXPRESSIONSET_H
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qregularexpression.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstringlist.h>
+
+QT_REQUIRE_CONFIG(regularexpression);
+
+QT_BEGIN_NAMESPACE
+
+class QRegularExpressionSetMatch;
+
+struct QRegularExpressionSetPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QRegularExpressionSetPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QRegularExpressionSet
+{
+public:
+    QRegularExpressionSet();
+    explicit QRegularExpressionSet(const QStringList &patterns,
+                                   QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption);
+    QRegularExpressionSet(const QRegularExpressionSet &other) noexcept;
+    QRegularExpressionSet(QRegularExpressionSet &&other) = default;
+    ~QRegularExpressionSet();
+
+    QRegularExpressionSet &operator=(const QRegularExpressionSet &other) noexcept;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QRegularExpressionSet)
+
+    void swap(QRegularExpressionSet &other) noexcept { d.swap(other.d); }
+
+    QStringList patterns() const;
+    void setPatterns(const QStringList &patterns);
+    qsizetype addPattern(const QString &pattern);
+
+    QRegularExpression::PatternOptions patternOptions() const;
+    void setPatternOptions(QRegularExpression::PatternOptions options);
+
+    qsizetype size() const;
+    bool isEmpty() const { return size() == 0; }
+    QRegularExpression regularExpression(qsizetype index) const;
+
+    [[nodiscard]]
+    bool isValid() const;
+
+    [[nodiscard]]
+    QRegularExpressionSetMatch match(const QString &subject,
+                                     qsizetype offset = 0,
+                                     QRegularExpression::MatchType matchType = QRegularExpression::NormalMatch,
+                                     QRegularExpression::MatchOptions matchOptions = QRegularExpression::NoMatchOption) const;
+
+    [[nodiscard]]
+    QRegularExpressionSetMatch matchView(QStringView subjectView,
+                                         qsizetype offset = 0,
+                                         QRegularExpression::MatchType matchType = QRegularExpression::NormalMatch,
+                                         QRegularExpression::MatchOptions matchOptions = QRegularExpression::NoMatchOption) const;
+
+    void optimize() const;
+
+private:
+    friend struct QRegularExpressionSetPrivate;
+    friend class QRegularExpressionSetMatch;
+
+    QExplicitlySharedDataPointer<QRegularExpressionSetPrivate> d;
+};
+
+Q_DECLARE_SHARED(QRegularExpressionSet)
+
+struct QRegularExpressionSetMatchPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QRegularExpressionSetMatchPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QRegularExpressionSetMatch
+{
+public:
+    QRegularExpressionSetMatch();
+    ~QRegularExpressionSetMatch();
+    QRegularExpressionSetMatch(const QRegularExpressionSetMatch &match);
+    QRegularExpressionSetMatch(QRegularExpressionSetMatch &&match) = default;
+    QRegularExpressionSetMatch &operator=(const QRegularExpressionSetMatch &match);
+    QRegularExpressionSetMatch &operator=(QRegularExpressionSetMatch &&match) noexcept
+    { d.swap(match.d); return *this; }
+    void swap(QRegularExpressionSetMatch &other) noexcept { d.swap(other.d); }
+
+    QRegularExpressionSet regularExpressionSet() const;
+    QRegularExpression::MatchType matchType() const;
+    QRegularExpression::MatchOptions matchOptions() const;
+
+    bool hasMatch() const;
+    bool hasPartialMatch() const;
+
+    bool isValid() const;
+
+    QList<qsizetype> matchedPatterns() const;
+    bool hasMatch(qsizetype index) const;
+    QRegularExpressionMatch match(qsizetype index) const;
+
+private:
+    friend class QRegularExpressionSet;
+    friend struct QRegularExpressionSetMatchPrivate;
+
+    QRegularExpressionSetMatch(QRegularExpressionSetMatchPrivate &dd);
+    QExplicitlySharedDataPointer<QRegularExpressionSetMatchPrivate> d;
+};
+
+Q_DECLARE_SHARED(QRegularExpressionSetMatch)
+
+QT_END_NAMESPACE
+
+#endif // QREGULAREXPRESSIONSET_H
@@ -461,6 +461,684 @@ static void simdCompareAscii(const qchar8_t *&, const qchar8_t *, const char16_t
 }
 #endif
 
+/*
+    Validation and transcoding of UTF-8 beyond US-ASCII, for the runs of text
+    the ASCII functions above give up on. The validation is the lookup
+    algorithm of Keiser and Lemire, "Validating UTF-8 In Less Than One
+    Instruction Per Byte": it classifies the errors each pair of consecutive
+    bytes could be part of by three table lookups, and checks separately that
+    the two bytes after a three or four byte lead are continuation bytes.
+
+    The decoding works on UTF-8 that has been validated, so that the ends of
+    the characters are where the next byte is not a continuation byte. Those
+    ends, in a window of twelve bytes, select a shuffle that gathers the
+    bytes of the first six characters (if they all have one or two bytes) or
+    of the first four (if they have up to three) into one lane each, after
+    which shifts and masks make the UTF-16 code units. Four byte sequences are
+    left to the scalar code, as is anything invalid, so the results, the
+    replacement characters and the state of a QStringDecoder are the same as
+    without SIMD.
+*/
+namespace {
+struct Utf8Validation
+{
+    const uchar *validEnd;  // end of the blocks that had no error
+    bool error;             // whether the block at validEnd has an error
+    bool nonAscii;          // whether there was non-ASCII before validEnd
+};
+
+} // unnamed namespace
+
+// Returns the start of the character that [start, p), which is valid UTF-8
+// except maybe for that, ends in the middle of; otherwise returns p.
+static const uchar *lastCharacterBoundary(const uchar *start, const uchar *p) noexcept
+{
+    for (int i = 1; i <= 3 && i <= p - start; ++i) {
+        const uchar b = p[-i];
+        if (b < 0x80)
+            break;
+        if (b >= 0xc0) {
+            const int length = b >= 0xf0 ? 4 : b >= 0xe0 ? 3 : 2;
+            return length > i ? p - i : p;
+        }
+    }
+    return p;
+}
+
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3) || (defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64))
+namespace {
+// The error classes of a pair of bytes. The second byte's high nibble, and
+// the first byte's high and low nibbles each allow a set of classes; the
+// pair has the errors all three allow.
+enum : uchar {
+    Utf8TooShort = 1 << 0,      // 11______ 0_______, 11______ 11______
+    Utf8TooLong = 1 << 1,       // 0_______ 10______
+    Utf8Overlong3 = 1 << 2,     // 11100000 100_____
+    Utf8TooLarge = 1 << 3,      // 11110100 1001____, 11110100 101_____, 111101__ 10______ ...
+    Utf8Surrogate = 1 << 4,     // 11101101 101_____
+    Utf8Overlong2 = 1 << 5,     // 1100000_ 10______
+    Utf8TooLarge1000 = 1 << 6,  // 11110101 1000____ ...
+    Utf8Overlong4 = 1 << 6,     // 11110000 1000____
+    Utf8TwoContinuations = 1 << 7, // 10______ 10______
+    Utf8Carry = Utf8TooShort | Utf8TooLong | Utf8TwoContinuations
+};
+
+alignas(16) constexpr uchar utf8FirstHighNibble[16] = {
+    // 0_______: ASCII
+    Utf8TooLong, Utf8TooLong, Utf8TooLong, Utf8TooLong,
+    Utf8TooLong, Utf8TooLong, Utf8TooLong, Utf8TooLong,
+    // 10______: continuation
+    Utf8TwoContinuations, Utf8TwoContinuations, Utf8TwoContinuations, Utf8TwoContinuations,
+    // 1100____, 1101____: two byte lead
+    Utf8TooShort | Utf8Overlong2,
+    Utf8TooShort,
+    // 1110____: three byte lead
+    Utf8TooShort | Utf8Overlong3 | Utf8Surrogate,
+    // 1111____: four byte lead
+    Utf8TooShort | Utf8TooLarge | Utf8TooLarge1000 | Utf8Overlong4
+};
+
+alignas(16) constexpr uchar utf8FirstLowNibble[16] = {
+    Utf8Carry | Utf8Overlong3 | Utf8Overlong2 | Utf8Overlong4,     // ____0000
+    Utf8Carry | Utf8Overlong2,                                     // ____0001
+    Utf8Carry,                                                     // ____001_
+    Utf8Carry,
+    Utf8Carry | Utf8TooLarge,                                      // ____0100
+    Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,                   // ____0101 and up
+    Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+    Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+    Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+    Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+    Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+    Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+    Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+    Utf8Carry | Utf8TooLarge | Utf8TooLarge1000 | Utf8Surrogate,   // ____1101
+    Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+    Utf8Carry | Utf8TooLarge | Utf8TooLarge1000
+};
+
+alignas(16) constexpr uchar utf8SecondHighNibble[16] = {
+    // 0_______: ASCII
+    Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort,
+    Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort,
+    // 1000____
+    Utf8TooLong | Utf8Overlong2 | Utf8TwoContinuations | Utf8Overlong3 | Utf8TooLarge1000 | Utf8Overlong4,
+    // 1001____
+    Utf8TooLong | Utf8Overlong2 | Utf8TwoContinuations | Utf8Overlong3 | Utf8TooLarge,
+    // 101_____
+    Utf8TooLong | Utf8Overlong2 | Utf8TwoContinuations | Utf8Surrogate | Utf8TooLarge,
+    Utf8TooLong | Utf8Overlong2 | Utf8TwoContinuations | Utf8Surrogate | Utf8TooLarge,
+    // 11______: lead byte
+    Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort
+};
+
+struct Utf8ShufflePattern
+{
+    uchar shuffle;
+    uchar consumed;
+};
+
+struct Utf8DecodeTables
+{
+    static constexpr uchar NoShuffle = 0xff;
+    static constexpr int TwoByteShuffles = 64;          // 2^6 for six characters
+    static constexpr int ThreeByteShuffles = 81;        // 3^4 for four characters
+
+    // The byte indexes of the characters' bytes in their lanes, last byte
+    // first, and 0x80 where a lane has no byte
+    uchar shuffles[TwoByteShuffles + ThreeByteShuffles][16];
+    // By the character ends in the first twelve bytes
+    Utf8ShufflePattern patterns[4096];
+};
+
+constexpr Utf8DecodeTables makeUtf8DecodeTables()
+{
+    Utf8DecodeTables tables = {};
+    for (int lengths = 0; lengths < Utf8DecodeTables::TwoByteShuffles; ++lengths) {
+        // bit i of lengths is set if character i has two bytes
+        uchar *shuffle = tables.shuffles[lengths];
+        int pos = 0;
+        for (int i = 0; i < 6; ++i) {
+            const bool twoBytes = lengths & (1 << i);
+            shuffle[2 * i] = uchar(pos + twoBytes);
+            shuffle[2 * i + 1] = twoBytes ? uchar(pos) : 0x80;
+            pos += 1 + twoBytes;
+        }
+        shuffle[12] = shuffle[13] = shuffle[14] = shuffle[15] = 0x80;
+    }
+    for (int lengths = 0; lengths < Utf8DecodeTables::ThreeByteShuffles; ++lengths) {
+        // digit i of lengths, in base 3, is the length of character i less one
+        uchar *shuffle = tables.shuffles[Utf8DecodeTables::TwoByteShuffles + lengths];
+        int pos = 0;
+        int digits = lengths;
+        for (int i = 0; i < 4; ++i) {
+            const int length = digits % 3 + 1;
+            digits /= 3;
+            shuffle[4 * i] = uchar(pos + length - 1);
+            shuffle[4 * i + 1] = length >= 2 ? uchar(pos + length - 2) : 0x80;
+            shuffle[4 * i + 2] = length == 3 ? uchar(pos) : 0x80;
+            shuffle[4 * i + 3] = 0x80;
+            pos += length;
+        }
+    }
+
+    for (int ends = 0; ends < 4096; ++ends) {
+        int lengths[12] = {};
+        int count = 0;
+        int start = 0;
+        for (int i = 0; i < 12; ++i) {
+            if (ends & (1 << i)) {
+                lengths[count++] = i - start + 1;
+                start = i + 1;
+            }
+        }
+
+        Utf8ShufflePattern &pattern = tables.patterns[ends];
+        pattern = { Utf8DecodeTables::NoShuffle, 0 };
+        bool fits = count >= 6;
+        for (int i = 0; fits && i < 6; ++i)
+            fits = lengths[i] <= 2;
+        if (fits) {
+            int shuffle = 0;
+            int consumed = 0;
+            for (int i = 0; i < 6; ++i) {
+                shuffle |= (lengths[i] - 1) << i;
+                consumed += lengths[i];
+            }
+            pattern = { uchar(shuffle), uchar(consumed) };
+            continue;
+        }
+
+        fits = count >= 4;
+        for (int i = 0; fits && i < 4; ++i)
+            fits = lengths[i] <= 3;
+        if (fits) {
+            int shuffle = 0;
+            int consumed = 0;
+            for (int i = 3; i >= 0; --i) {
+                shuffle = shuffle * 3 + lengths[i] - 1;
+                consumed += lengths[i];
+            }
+            pattern = { uchar(Utf8DecodeTables::TwoByteShuffles + shuffle), uchar(consumed) };
+        }
+    }
+    return tables;
+}
+
+constexpr Utf8DecodeTables utf8DecodeTables = makeUtf8DecodeTables();
+
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+struct Utf8EncodePattern
+{
+    uchar shuffle[16];
+    uchar length;
+};
+
+struct Utf8EncodeTables
+{
+    // Eight code units below U+0800, in 16-bit lanes holding the lead and the
+    // continuation byte, or the US-ASCII character; by the mask of the latter
+    Utf8EncodePattern twoBytes[256];
+    // Four code units in 32-bit lanes holding up to three bytes; by the mask
+    // of those needing two bytes or more (low nibble) and three (high nibble)
+    Utf8EncodePattern threeBytes[256];
+};
+
+constexpr Utf8EncodeTables makeUtf8EncodeTables()
+{
+    Utf8EncodeTables tables = {};
+    for (int ascii = 0; ascii < 256; ++ascii) {
+        Utf8EncodePattern &pattern = tables.twoBytes[ascii];
+        int length = 0;
+        for (int i = 0; i < 8; ++i) {
+            pattern.shuffle[length++] = uchar(2 * i);
+            if (!(ascii & (1 << i)))
+                pattern.shuffle[length++] = uchar(2 * i + 1);
+        }
+        pattern.length = uchar(length);
+        for (int i = length; i < 16; ++i)
+            pattern.shuffle[i] = 0x80;
+    }
+    for (int lengths = 0; lengths < 256; ++lengths) {
+        Utf8EncodePattern &pattern = tables.threeBytes[lengths];
+        int length = 0;
+        for (int i = 0; i < 4; ++i) {
+            const int bytes = 1 + ((lengths >> i) & 1) + ((lengths >> (i + 4)) & 1);
+            for (int j = 0; j < bytes; ++j)
+                pattern.shuffle[length++] = uchar(4 * i + j);
+        }
+        pattern.length = uchar(length);
+        for (int i = length; i < 16; ++i)
+            pattern.shuffle[i] = 0x80;
+    }
+    return tables;
+}
+
+constexpr Utf8EncodeTables utf8EncodeTables = makeUtf8EncodeTables();
+#endif
+} // unnamed namespace
+
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+static QT_FUNCTION_TARGET(SSSE3)
+Utf8Validation validateUtf8Ssse3(const uchar *src, const uchar *end) noexcept
+{
+    const __m128i firstHigh = _mm_load_si128(reinterpret_cast<const __m128i *>(utf8FirstHighNibble));
+    const __m128i firstLow = _mm_load_si128(reinterpret_cast<const __m128i *>(utf8FirstLowNibble));
+    const __m128i secondHigh = _mm_load_si128(reinterpret_cast<const __m128i *>(utf8SecondHighNibble));
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    // subtracted, with saturation, from the last bytes of a block, leave
+    // something where a character is still incomplete
+    const __m128i incomplete = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                             char(0xf0 - 1), char(0xe0 - 1), char(0xc0 - 1));
+    __m128i previous = _mm_setzero_si128();
+    bool nonAscii = false;
+    for ( ; end - src >= 16; src += 16) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        __m128i error;
+        if (!_mm_movemask_epi8(input)) {
+            // US-ASCII: only a character left incomplete before is an error
+            error = _mm_subs_epu8(previous, incomplete);
+        } else {
+            nonAscii = true;
+            const __m128i prev1 = _mm_alignr_epi8(input, previous, 15);
+            const __m128i prev2 = _mm_alignr_epi8(input, previous, 14);
+            const __m128i prev3 = _mm_alignr_epi8(input, previous, 13);
+            __m128i special = _mm_shuffle_epi8(firstHigh, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+            special = _mm_and_si128(special, _mm_shuffle_epi8(firstLow, _mm_and_si128(prev1, nibble)));
+            special = _mm_and_si128(special, _mm_shuffle_epi8(secondHigh,
+                                                              _mm_and_si128(_mm_srli_epi16(input, 4), nibble)));
+            // Two continuation bytes in a row are only right after a three
+            // or four byte lead, where they are required
+            const __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(char(0xe0 - 0x80)));
+            const __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(char(0xf0 - 0x80)));
+            const __m128i required = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(char(0x80)));
+            error = _mm_xor_si128(required, special);
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xffff)
+            return { src, true, nonAscii };
+        previous = input;
+    }
+    return { src, false, nonAscii };
+}
+
+static QT_FUNCTION_TARGET(SSSE3)
+void decodeValidUtf8Ssse3(char16_t *&dst, const uchar *&src, const uchar *end) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+    while (end - src >= 16) {
+        // The non-ASCII and the continuation bytes of up to 64 bytes, so that
+        // each window only needs a shift to find its character ends
+        const int blocks = int(qMin<qptrdiff>((end - src) / 16, 4));
+        quint64 nonAscii = 0;
+        quint64 continuations = 0;
+        for (int i = 0; i < blocks; ++i) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16 * i));
+            nonAscii |= quint64(uint(_mm_movemask_epi8(block))) << (16 * i);
+            continuations |= quint64(uint(_mm_movemask_epi8(_mm_cmplt_epi8(block, _mm_set1_epi8(-64)))))
+                    << (16 * i);
+        }
+        // Bit i is set if byte i ends a character
+        const quint64 ends = ~continuations >> 1;
+
+        // Windows of sixteen bytes within the blocks
+        qptrdiff pos = 0;
+        while (pos <= 16 * blocks - 16) {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + pos));
+            const uint asciiPrefix = qCountTrailingZeroBits(nonAscii >> pos);
+            if (asciiPrefix > 6) {
+                const uint count = qMin(asciiPrefix, 16U);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_unpacklo_epi8(input, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 8), _mm_unpackhi_epi8(input, zero));
+                pos += count;
+                dst += count;
+                continue;
+            }
+
+            const Utf8ShufflePattern pattern = utf8DecodeTables.patterns[(ends >> pos) & 0xfff];
+            if (pattern.shuffle == Utf8DecodeTables::NoShuffle) {
+                // a four byte sequence: decode a character at a time
+                const uchar *next = src + pos;
+                const uchar b = *next++;
+                QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, next, end);
+                pos = next - src;
+                continue;
+            }
+
+            const __m128i shuffle =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(utf8DecodeTables.shuffles[pattern.shuffle]));
+            const __m128i lanes = _mm_shuffle_epi8(input, shuffle);
+            if (pattern.shuffle < Utf8DecodeTables::TwoByteShuffles) {
+                // 16-bit lanes: lead byte (if any) in the high byte
+                const __m128i low = _mm_and_si128(lanes, _mm_set1_epi16(0x7f));
+                const __m128i high = _mm_and_si128(_mm_srli_epi16(lanes, 2), _mm_set1_epi16(0x07c0));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_or_si128(low, high));
+                dst += 6;
+            } else {
+                // 32-bit lanes: last, middle and lead byte
+                const __m128i low = _mm_and_si128(lanes, _mm_set1_epi32(0x7f));
+                const __m128i middle = _mm_and_si128(_mm_srli_epi32(lanes, 2), _mm_set1_epi32(0x0fc0));
+                const __m128i high = _mm_and_si128(_mm_srli_epi32(lanes, 4), _mm_set1_epi32(0xf000));
+                const __m128i units = _mm_or_si128(_mm_or_si128(low, middle), high);
+                const __m128i packed = _mm_shuffle_epi8(units, _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13,
+                                                                             -1, -1, -1, -1, -1, -1, -1, -1));
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), packed);
+                dst += 4;
+            }
+            pos += pattern.consumed;
+        }
+        src += pos;
+    }
+}
+
+// Encodes code units as long as there are at least sixteen left and no
+// surrogates among the next eight
+static QT_FUNCTION_TARGET(SSSE3)
+void encodeUtf8Ssse3(uchar *&dst, const char16_t *&src, const char16_t *end) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; end - src >= 16; src += 8) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        const __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(input, _mm_set1_epi16(short(0xff80))), zero);
+        const uint asciiMask = _mm_movemask_epi8(_mm_packs_epi16(ascii, zero));
+        if (asciiMask == 0xff) {
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_packus_epi16(input, input));
+            dst += 8;
+            continue;
+        }
+
+        const __m128i above7ff = _mm_and_si128(input, _mm_set1_epi16(short(0xf800)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(above7ff, zero)) == 0xffff) {
+            // 16-bit lanes with the lead byte first, or just US-ASCII
+            const __m128i lead = _mm_or_si128(_mm_srli_epi16(input, 6), _mm_set1_epi16(0xc0));
+            const __m128i continuation = _mm_slli_epi16(_mm_and_si128(input, _mm_set1_epi16(0x3f)), 8);
+            const __m128i twoBytes = _mm_or_si128(_mm_or_si128(lead, continuation),
+                                                  _mm_set1_epi16(short(0x8000)));
+            const __m128i lanes = _mm_or_si128(_mm_and_si128(ascii, input), _mm_andnot_si128(ascii, twoBytes));
+            const Utf8EncodePattern &pattern = utf8EncodeTables.twoBytes[asciiMask];
+            const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern.shuffle));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(lanes, shuffle));
+            dst += pattern.length;
+            continue;
+        }
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(above7ff, _mm_set1_epi16(short(0xd800)))))
+            return;
+
+        // 32-bit lanes with up to three bytes, four code units at a time
+        const __m128i halves[2] = { _mm_unpacklo_epi16(input, zero), _mm_unpackhi_epi16(input, zero) };
+        for (__m128i units : halves) {
+            const __m128i twoOrMore = _mm_cmpgt_epi32(units, _mm_set1_epi32(0x7f));
+            const __m128i three = _mm_cmpgt_epi32(units, _mm_set1_epi32(0x7ff));
+            const __m128i last = _mm_or_si128(_mm_and_si128(units, _mm_set1_epi32(0x3f)), _mm_set1_epi32(0x80));
+            const __m128i middle = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(units, 6), _mm_set1_epi32(0x3f)),
+                                                _mm_set1_epi32(0x80));
+            const __m128i twoBytes = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(units, 6), _mm_set1_epi32(0xc0)),
+                                                  _mm_slli_epi32(last, 8));
+            const __m128i threeBytes = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(units, 12), _mm_set1_epi32(0xe0)),
+                                                    _mm_or_si128(_mm_slli_epi32(middle, 8), _mm_slli_epi32(last, 16)));
+            __m128i lanes = _mm_or_si128(_mm_and_si128(twoOrMore, twoBytes), _mm_andnot_si128(twoOrMore, units));
+            lanes = _mm_or_si128(_mm_and_si128(three, threeBytes), _mm_andnot_si128(three, lanes));
+
+            const uint lengths = _mm_movemask_ps(_mm_castsi128_ps(twoOrMore))
+                    | _mm_movemask_ps(_mm_castsi128_ps(three)) << 4;
+            const Utf8EncodePattern &pattern = utf8EncodeTables.threeBytes[lengths];
+            const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern.shuffle));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(lanes, shuffle));
+            dst += pattern.length;
+        }
+    }
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+static QT_FUNCTION_TARGET(AVX2)
+Utf8Validation validateUtf8Avx2(const uchar *src, const uchar *end) noexcept
+{
+    const __m256i firstHigh =
+            _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(utf8FirstHighNibble)));
+    const __m256i firstLow =
+            _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(utf8FirstLowNibble)));
+    const __m256i secondHigh =
+            _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(utf8SecondHighNibble)));
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i incomplete = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                char(0xf0 - 1), char(0xe0 - 1), char(0xc0 - 1));
+    __m256i previous = _mm256_setzero_si256();
+    bool nonAscii = false;
+    for ( ; end - src >= 32; src += 32) {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+        __m256i error;
+        if (!_mm256_movemask_epi8(input)) {
+            error = _mm256_subs_epu8(previous, incomplete);
+        } else {
+            nonAscii = true;
+            // the previous block's high half, followed by this one's low half
+            const __m256i shifted = _mm256_permute2x128_si256(previous, input, 0x21);
+            const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+            const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+            const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+            __m256i special = _mm256_shuffle_epi8(firstHigh, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+            special = _mm256_and_si256(special, _mm256_shuffle_epi8(firstLow, _mm256_and_si256(prev1, nibble)));
+            special = _mm256_and_si256(special, _mm256_shuffle_epi8(secondHigh,
+                                                                    _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+            const __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xe0 - 0x80)));
+            const __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xf0 - 0x80)));
+            const __m256i required = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(char(0x80)));
+            error = _mm256_xor_si256(required, special);
+        }
+        if (!_mm256_testz_si256(error, error))
+            return { src, true, nonAscii };
+        previous = input;
+    }
+    return { src, false, nonAscii };
+}
+#endif
+
+#if defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+static Utf8Validation validateUtf8Neon(const uchar *src, const uchar *end) noexcept
+{
+    const uint8x16_t firstHigh = vld1q_u8(utf8FirstHighNibble);
+    const uint8x16_t firstLow = vld1q_u8(utf8FirstLowNibble);
+    const uint8x16_t secondHigh = vld1q_u8(utf8SecondHighNibble);
+    const uint8x16_t nibble = vdupq_n_u8(0x0f);
+    static const uchar incompleteBytes[16] = {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xf0 - 1, 0xe0 - 1, 0xc0 - 1
+    };
+    const uint8x16_t incomplete = vld1q_u8(incompleteBytes);
+    uint8x16_t previous = vdupq_n_u8(0);
+    bool nonAscii = false;
+    for ( ; end - src >= 16; src += 16) {
+        const uint8x16_t input = vld1q_u8(src);
+        uint8x16_t error;
+        if (vmaxvq_u8(input) < 0x80) {
+            error = vqsubq_u8(previous, incomplete);
+        } else {
+            nonAscii = true;
+            const uint8x16_t prev1 = vextq_u8(previous, input, 15);
+            const uint8x16_t prev2 = vextq_u8(previous, input, 14);
+            const uint8x16_t prev3 = vextq_u8(previous, input, 13);
+            uint8x16_t special = vqtbl1q_u8(firstHigh, vshrq_n_u8(prev1, 4));
+            special = vandq_u8(special, vqtbl1q_u8(firstLow, vandq_u8(prev1, nibble)));
+            special = vandq_u8(special, vqtbl1q_u8(secondHigh, vshrq_n_u8(input, 4)));
+            const uint8x16_t third = vqsubq_u8(prev2, vdupq_n_u8(0xe0 - 0x80));
+            const uint8x16_t fourth = vqsubq_u8(prev3, vdupq_n_u8(0xf0 - 0x80));
+            const uint8x16_t required = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+            error = veorq_u8(required, special);
+        }
+        if (vmaxvq_u8(error))
+            return { src, true, nonAscii };
+        previous = input;
+    }
+    return { src, false, nonAscii };
+}
+
+static void decodeValidUtf8Neon(char16_t *&dst, const uchar *&src, const uchar *end) noexcept
+{
+    static const uchar bitsBytes[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint8x16_t bits = vld1q_u8(bitsBytes);
+    while (end - src >= 16) {
+        const uint8x16_t input = vld1q_u8(src);
+        if (vmaxvq_u8(input) < 0x80) {
+            vst1q_u16(reinterpret_cast<uint16_t *>(dst), vmovl_u8(vget_low_u8(input)));
+            vst1q_u16(reinterpret_cast<uint16_t *>(dst + 8), vmovl_u8(vget_high_u8(input)));
+            src += 16;
+            dst += 16;
+            continue;
+        }
+
+        // Bit i is set if byte i ends a character
+        const uint8x16_t isContinuation = vandq_u8(vcltq_s8(vreinterpretq_s8_u8(input), vdupq_n_s8(-64)), bits);
+        const uint continuations = vaddv_u8(vget_low_u8(isContinuation))
+                | uint(vaddv_u8(vget_high_u8(isContinuation))) << 8;
+        const Utf8ShufflePattern pattern = utf8DecodeTables.patterns[(~continuations >> 1) & 0xfff];
+        if (pattern.shuffle == Utf8DecodeTables::NoShuffle) {
+            const uchar b = *src++;
+            QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, src, end);
+            continue;
+        }
+
+        const uint8x16_t lanes = vqtbl1q_u8(input, vld1q_u8(utf8DecodeTables.shuffles[pattern.shuffle]));
+        if (pattern.shuffle < Utf8DecodeTables::TwoByteShuffles) {
+            const uint16x8_t pairs = vreinterpretq_u16_u8(lanes);
+            const uint16x8_t low = vandq_u16(pairs, vdupq_n_u16(0x7f));
+            const uint16x8_t high = vandq_u16(vshrq_n_u16(pairs, 2), vdupq_n_u16(0x07c0));
+            vst1q_u16(reinterpret_cast<uint16_t *>(dst), vorrq_u16(low, high));
+            dst += 6;
+        } else {
+            const uint32x4_t triples = vreinterpretq_u32_u8(lanes);
+            const uint32x4_t low = vandq_u32(triples, vdupq_n_u32(0x7f));
+            const uint32x4_t middle = vandq_u32(vshrq_n_u32(triples, 2), vdupq_n_u32(0x0fc0));
+            const uint32x4_t high = vandq_u32(vshrq_n_u32(triples, 4), vdupq_n_u32(0xf000));
+            vst1_u16(reinterpret_cast<uint16_t *>(dst), vmovn_u32(vorrq_u32(vorrq_u32(low, middle), high)));
+            dst += 4;
+        }
+        src += pattern.consumed;
+    }
+}
+#endif
+
+static bool simdUtf8Available() noexcept
+{
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    if (qCpuHasFeature(SSSE3))
+        return true;
+#endif
+#if defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Validates the UTF-8 in [src, end), which starts at a character boundary,
+// in whole blocks, until the first block with an error. The last character
+// before the returned validEnd may be incomplete. Requires simdUtf8Available().
+static Utf8Validation simdValidateUtf8(const uchar *src, const uchar *end) noexcept
+{
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2)) {
+        const Utf8Validation validation = validateUtf8Avx2(src, end);
+        if (validation.error || end - validation.validEnd < 16)
+            return validation;
+        // finish with a shorter block
+        const Utf8Validation rest = validateUtf8Ssse3(lastCharacterBoundary(src, validation.validEnd), end);
+        return { rest.validEnd, rest.error, validation.nonAscii || rest.nonAscii };
+    }
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    if (qCpuHasFeature(SSSE3))
+        return validateUtf8Ssse3(src, end);
+#endif
+#if defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    return validateUtf8Neon(src, end);
+#else
+    Q_UNREACHABLE_RETURN(Utf8Validation{ src, false, false });
+#endif
+}
+
+static void simdDecodeValidUtf8(char16_t *&dst, const uchar *&src, const uchar *end) noexcept
+{
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    if (qCpuHasFeature(SSSE3))
+        decodeValidUtf8Ssse3(dst, src, end);
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    decodeValidUtf8Neon(dst, src, end);
+#endif
+    // the rest, which is too short for SIMD
+    while (src < end) {
+        const uchar b = *src++;
+        QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, src, end);
+    }
+}
+
+/*
+    Decodes [src, end), which starts at a character boundary, as far as it is
+    valid UTF-8 and long enough for SIMD, and sets nextAscii to where the
+    caller's scalar decoding should go on to (including any invalid sequence)
+    before trying SIMD again. Returns true if it decoded everything.
+*/
+static bool simdDecodeUtf8(char16_t *&dst, const uchar *&nextAscii, const uchar *&src, const uchar *end) noexcept
+{
+    if (!simdUtf8Available())
+        return false;
+
+    // validate a chunk at a time, so the decoding finds it in the cache
+    constexpr qsizetype ChunkSize = 1024;
+    while (end - src >= 16) {
+        const Utf8Validation validation = simdValidateUtf8(src, src + qMin(end - src, ChunkSize));
+        simdDecodeValidUtf8(dst, src, lastCharacterBoundary(src, validation.validEnd));
+        if (validation.error) {
+            // the block with the error, at most 32 bytes
+            nextAscii = qMin(validation.validEnd + 32, end);
+            return false;
+        }
+    }
+    nextAscii = end;
+    return src == end;
+}
+
+// Encodes [src, end) as far as it has no surrogates and is long enough for
+// SIMD, and sets nextAscii to where the caller's scalar encoding should go on
+// to before trying SIMD again.
+static void simdEncodeUtf8(uchar *&dst, const char16_t *&nextAscii, const char16_t *&src,
+                           const char16_t *end) noexcept
+{
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    if (qCpuHasFeature(SSSE3)) {
+        encodeUtf8Ssse3(dst, src, end);
+        // stopped at a surrogate, or near the end
+        nextAscii = end - src >= 16 ? src + 8 : end;
+    }
+#else
+    Q_UNUSED(dst);
+    Q_UNUSED(nextAscii);
+    Q_UNUSED(src);
+    Q_UNUSED(end);
+#endif
+}
+#else
+static bool simdUtf8Available() noexcept
+{
+    return false;
+}
+
+static Utf8Validation simdValidateUtf8(const uchar *src, const uchar *) noexcept
+{
+    return { src, false, false };
+}
+
+static bool simdDecodeUtf8(char16_t *&, const uchar *&, const uchar *&, const uchar *) noexcept
+{
+    return false;
+}
+
+static void simdEncodeUtf8(uchar *&, const char16_t *&, const char16_t *&, const char16_t *) noexcept
+{
+}
+#endif
+
 enum { HeaderDone = 1 };
 
 QByteArray QUtf8::convertFromUnicode(QStringView in)
@@ -477,6 +1155,7 @@ QByteArray QUtf8::convertFromUnicode(QStringView in)
         const char16_t *nextAscii = end;
         if (simdEncodeAscii(dst, nextAscii, src, end))
             break;
+        simdEncodeUtf8(dst, nextAscii, src, end);
 
         do {
             char16_t u = *src++;
@@ -544,6 +1223,7 @@ char *QUtf8::convertFromUnicode(char *out, QStringView in, QStringConverter::Sta
         const char16_t *nextAscii = end;
         if (simdEncodeAscii(cursor, nextAscii, src, end))
             break;
+        simdEncodeUtf8(cursor, nextAscii, src, end);
 
         do {
             char16_t uc = *src++;
@@ -644,8 +1324,10 @@ QChar *QUtf8::convertToUnicode(QChar *buffer, QByteArrayView in) noexcept
 
         while (src < end) {
             nextAscii = end;
-            if (simdDecodeAscii(dst, nextAscii, src, end))
+            if (simdDecodeAscii(dst, nextAscii, src, end)
+                    || simdDecodeUtf8(dst, nextAscii, src, end)) {
                 break;
+            }
 
             do {
                 uchar b = *src++;
@@ -748,8 +1430,10 @@ QChar *QUtf8::convertToUnicode(QChar *out, QByteArrayView in, QStringConverter::
     res = 0;
     const uchar *nextAscii = src;
     while (res >= 0 && src < end) {
-        if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
+        if (src >= nextAscii && (simdDecodeAscii(dst, nextAscii, src, end)
+                                 || simdDecodeUtf8(dst, nextAscii, src, end))) {
             break;
+        }
 
         ch = *src++;
         res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end);
@@ -796,6 +1480,15 @@ QUtf8::ValidUtf8Result QUtf8::isValidUtf8(QByteArrayView in)
     const uchar *nextAscii = src;
     bool isValidAscii = true;
 
+    if (simdUtf8Available()) {
+        const Utf8Validation validation = simdValidateUtf8(src, end);
+        if (validation.error)
+            return { false, false };
+        isValidAscii = !validation.nonAscii;
+        // the rest, and any character the blocks ended in the middle of
+        src = nextAscii = lastCharacterBoundary(src, validation.validEnd);
+    }
+
     while (src < end) {
         if (src >= nextAscii)
             src = simdFindNonAscii(src, end, nextAscii);
@@ -6,6 +6,7 @@
 #include "qmutex.h"
 #include "qunicodetables_p.h"
 #include "qvarlengtharray.h"
+#include "private/qsimd_p.h"
 #if QT_CONFIG(library)
 #include "qlibrary.h"
 #endif
@@ -36,6 +37,119 @@ namespace QUnicodeTools {
 //
 // -----------------------------------------------------------------------------------------------------
 
+// Runs of Latin-1 characters are common, and the break algorithms treat
+// them in the same way character after character: once the state allows
+// it, the algorithms below skip a run found eight characters at a time.
+
+namespace {
+
+#if defined(__SSE2__)
+// (v - first) <= (last - first) as unsigned, with the signed comparison SSE2 has
+inline __m128i inRange(__m128i v, char16_t first, char16_t last) noexcept
+{
+    const __m128i offset = _mm_add_epi16(v, _mm_set1_epi16(short(0x8000 - first)));
+    return _mm_cmplt_epi16(offset, _mm_set1_epi16(short(last - first + 1 - 0x8000)));
+}
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+inline uint16x8_t inRange(uint16x8_t v, char16_t first, char16_t last) noexcept
+{
+    return vcleq_u16(vsubq_u16(v, vdupq_n_u16(first)), vdupq_n_u16(last - first));
+}
+#endif
+
+// Grapheme break class Any: not the soft hyphen (Control), nor the
+// copyright and registered signs (Extended_Pictographic)
+struct PrintableLatin1
+{
+    static bool matches(char16_t c) noexcept
+    {
+        return (c >= 0x20 && c < 0x7f)
+                || (c >= 0xa0 && c <= 0xff && c != 0xa9 && c != 0xad && c != 0xae);
+    }
+#if defined(__SSE2__)
+    static __m128i matches(__m128i v) noexcept
+    {
+        const __m128i excluded = _mm_or_si128(_mm_cmpeq_epi16(v, _mm_set1_epi16(0xa9)),
+                                              inRange(v, 0xad, 0xae));
+        const __m128i latin1 = _mm_andnot_si128(excluded, inRange(v, 0xa0, 0xff));
+        return _mm_or_si128(inRange(v, 0x20, 0x7e), latin1);
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    static uint16x8_t matches(uint16x8_t v) noexcept
+    {
+        const uint16x8_t excluded = vorrq_u16(vceqq_u16(v, vdupq_n_u16(0xa9)), inRange(v, 0xad, 0xae));
+        const uint16x8_t latin1 = vbicq_u16(inRange(v, 0xa0, 0xff), excluded);
+        return vorrq_u16(inRange(v, 0x20, 0x7e), latin1);
+    }
+#endif
+};
+
+// Word break class ALetter, line break class AL
+struct AsciiLetter
+{
+    static bool matches(char16_t c) noexcept
+    {
+        return char16_t(c | 0x20) >= u'a' && char16_t(c | 0x20) <= u'z';
+    }
+#if defined(__SSE2__)
+    static __m128i matches(__m128i v) noexcept
+    {
+        return inRange(_mm_or_si128(v, _mm_set1_epi16(0x20)), u'a', u'z');
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    static uint16x8_t matches(uint16x8_t v) noexcept
+    {
+        return inRange(vorrq_u16(v, vdupq_n_u16(0x20)), u'a', u'z');
+    }
+#endif
+};
+
+// Word break classes ALetter and Numeric
+struct AsciiLetterOrDigit
+{
+    static bool matches(char16_t c) noexcept
+    {
+        return AsciiLetter::matches(c) || (c >= u'0' && c <= u'9');
+    }
+#if defined(__SSE2__)
+    static __m128i matches(__m128i v) noexcept
+    {
+        return _mm_or_si128(AsciiLetter::matches(v), inRange(v, u'0', u'9'));
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    static uint16x8_t matches(uint16x8_t v) noexcept
+    {
+        return vorrq_u16(AsciiLetter::matches(v), inRange(v, u'0', u'9'));
+    }
+#endif
+};
+
+// Returns the number of characters at the start of [ptr, end) that match Run
+template <typename Run>
+qsizetype runLength(const char16_t *ptr, const char16_t *end) noexcept
+{
+    const char16_t *p = ptr;
+#if defined(__SSE2__)
+    for ( ; end - p >= 8; p += 8) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const uint mismatches = ~uint(_mm_movemask_epi8(Run::matches(chunk))) & 0xffffU;
+        if (mismatches)
+            return p - ptr + qCountTrailingZeroBits(mismatches) / 2;
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    for ( ; end - p >= 8; p += 8) {
+        const uint16x8_t chunk = vld1q_u16(reinterpret_cast<const uint16_t *>(p));
+        if (vminvq_u16(Run::matches(chunk)) == 0)
+            break;
+    }
+#endif
+    while (p != end && Run::matches(*p))
+        ++p;
+    return p - ptr;
+}
+
+} // unnamed namespace
+
 namespace GB {
 
 // This table is indexed by the grapheme break classes of two
@@ -200,6 +314,14 @@ static void getGraphemeBreaks(const char16_t *string, qsizetype len, QCharAttrib
             attributes[pos].graphemeBoundary = true;
 
         lcls = cls;
+
+        if (cls == QUnicodeTables::GraphemeBreak_Any && state == GB::State::Normal && ucs4 < 0x100) {
+            // GB999: break before every character of a run of printable Latin-1
+            const qsizetype run = runLength<PrintableLatin1>(string + i + 1, string + len);
+            for (qsizetype j = i + 1; j <= i + run; ++j)
+                attributes[j].graphemeBoundary = true;
+            i += run;
+        }
     }
 
     attributes[len].graphemeBoundary = true; // GB2
@@ -358,6 +480,18 @@ static void getWordBreaks(const char16_t *string, qsizetype len, QCharAttributes
                 break;
             }
         }
+
+        if ((cls == QUnicodeTables::WordBreak_ALetter || cls == QUnicodeTables::WordBreak_Numeric)
+                && string[i] < 0x80) {
+            // WB5, WB8, WB9, WB10: no breaks within a run of ASCII letters and digits
+            const qsizetype run = runLength<AsciiLetterOrDigit>(string + i + 1, string + len);
+            if (run) {
+                i += run;
+                cls = string[i] <= u'9' ? QUnicodeTables::WordBreak_Numeric
+                                        : QUnicodeTables::WordBreak_ALetter;
+                real_cls = cls;
+            }
+        }
     }
 
     if (currentWordType != WordTypeNone)
@@ -778,6 +912,16 @@ static void getLineBreaks(const char16_t *string, qsizetype len, QCharAttributes
         lastProp = prop;
     next_no_cls_update:
         lcls = ncls;
+
+        if (cls == QUnicodeTables::LineBreak_AL && lcls == QUnicodeTables::LineBreak_AL
+                && nelast == LB::NS::XX && string[i] < 0x80) {
+            // LB28: no breaks within a run of ASCII letters
+            const qsizetype run = runLength<AsciiLetter>(string + i + 1, string + len);
+            if (run) {
+                i += run;
+                lastProp = QUnicodeTables::properties(string[i]);
+            }
+        }
     }
 
     if (Q_UNLIKELY(LB::NS::actionTable[nelast][LB::NS::XX] == LB::NS::Break)) {
@@ -2324,6 +2468,120 @@ Q_CORE_EXPORT void initCharAttributes(QStringView string,
     }
 }
 
+// Whether the algorithms above process c like a letter, without looking
+// behind or ahead of it; and whether it has a script of its own, so that
+// the script items after it do not depend on what precedes it
+static bool isPlainLetter(QChar c)
+{
+    if (AsciiLetter::matches(c.unicode()))
+        return true;
+    if (c.isSurrogate())
+        return false;
+    const QUnicodeTables::Properties *prop = QUnicodeTables::properties(c.unicode());
+    return prop->script > QChar::Script_Common
+            && prop->category >= QChar::Letter_Uppercase && prop->category <= QChar::Letter_Other
+            && prop->graphemeBreakClass == QUnicodeTables::GraphemeBreak_Any
+            && (prop->sentenceBreakClass == QUnicodeTables::SentenceBreak_Lower
+                || prop->sentenceBreakClass == QUnicodeTables::SentenceBreak_Upper
+                || prop->sentenceBreakClass == QUnicodeTables::SentenceBreak_OLetter)
+            && (prop->lineBreakClass == QUnicodeTables::LineBreak_AL
+                || prop->lineBreakClass == QUnicodeTables::LineBreak_HL
+                || prop->lineBreakClass == QUnicodeTables::LineBreak_ID);
+}
+
+// Two letters followed by a space, or a letter followed by one that always
+// starts a word (like an ideograph), leave all the algorithms above in the
+// same state whatever came before them; so the attributes after such a
+// restart point only depend on the text that follows it.
+static bool isRestartPoint(QStringView string, qsizetype pos)
+{
+    if (pos < 3 || pos > string.size())
+        return false;
+    const QChar last = string[pos - 1];
+    if (last == u' ')
+        return isPlainLetter(string[pos - 2]) && isPlainLetter(string[pos - 3]);
+    return isPlainLetter(last) && isPlainLetter(string[pos - 2])
+            && QUnicodeTables::wordBreakClass(last.unicode()) == QUnicodeTables::WordBreak_Any;
+}
+
+Q_CORE_EXPORT void updateCharAttributes(QStringView string, qsizetype from, qsizetype length,
+                                        const ScriptItem *items, qsizetype numItems,
+                                        QCharAttributes *attributes, CharAttributeOptions options)
+{
+    Q_ASSERT(from >= 0 && length >= 0 && from + length <= string.size());
+    if (string.size() <= 0)
+        return;
+
+    const bool tailored = !qt_initcharattributes_default_algorithm_only && items && numItems > 0;
+    const auto itemEnd = [&](qsizetype i) {
+        return i < numItems - 1 ? items[i + 1].position : string.size();
+    };
+
+    // Widen [from, from + length) to the restart points around it, and to
+    // the whole of the items with tailored attributes that it overlaps
+    qsizetype start = from;
+    qsizetype end = qMin(from + length + 3, string.size());
+    forever {
+        while (start > 0 && !isRestartPoint(string, start))
+            --start;
+        while (end < string.size() && !isRestartPoint(string, end))
+            ++end;
+
+        if (!tailored)
+            break;
+        bool widened = false;
+        for (qsizetype i = 0; i < numItems; ++i) {
+            QChar::Script script = items[i].script;
+            if (script > QChar::Script_Khmer)
+                script = QChar::Script_Common;
+            if (!Tailored::charAttributeFunction[script])
+                continue;
+            // the tailoring may set the attributes after the item's last character
+            const qsizetype itemStart = items[i].position;
+            const qsizetype itemStop = qMin(itemEnd(i) + 1, string.size());
+            if (itemStart >= end || itemStop < start)
+                continue;
+            if (itemStart < start) {
+                start = itemStart;
+                widened = true;
+            }
+            if (itemStop > end) {
+                end = itemStop;
+                widened = true;
+            }
+        }
+        if (!widened)
+            break;
+    }
+
+    // Analyze the window from the letters before the restart point on, and
+    // keep what follows the restart point. At the end of the string, the
+    // attributes after the last character are part of the window too.
+    const qsizetype analyzed = start > 0 ? start - 3 : 0;
+    const qsizetype windowEnd = end < string.size() ? end : end + 1;
+    const QStringView window = string.sliced(analyzed, end - analyzed);
+
+    // The attributes in the window are those of the old text, so they are
+    // recomputed from scratch whether DontClearAttributes is set or not
+    QVarLengthArray<QCharAttributes, 256> buffer(window.size() + 1);
+    ::memset(buffer.data(), 0, buffer.size() * sizeof(QCharAttributes));
+
+    ScriptItemArray windowItems;
+    if (tailored) {
+        for (qsizetype i = 0; i < numItems; ++i) {
+            if (items[i].position >= end || itemEnd(i) <= analyzed)
+                continue;
+            windowItems.append(ScriptItem{ qMax(items[i].position, analyzed) - analyzed,
+                                           items[i].script });
+        }
+    }
+    initCharAttributes(window, windowItems.data(), windowItems.size(), buffer.data(),
+                       options | DontClearAttributes);
+
+    ::memcpy(attributes + start, buffer.data() + (start - analyzed),
+             (windowEnd - start) * sizeof(QCharAttributes));
+}
+
 
 // ----------------------------------------------------------------------------
 //
@@ -65,6 +65,13 @@ Q_CORE_EXPORT void initCharAttributes(QStringView str,
                                       const ScriptItem *items, qsizetype numItems,
                                       QCharAttributes *attributes, CharAttributeOptions options);
 
+// recomputes the attributes after the characters in [from, from + length) were
+// changed; those of the other characters must be the ones of the string before
+// the change, moved along with their characters. DontClearAttributes is not
+// supported: all attributes of the recomputed characters are replaced
+Q_CORE_EXPORT void updateCharAttributes(QStringView str, qsizetype from, qsizetype length,
+                                        const ScriptItem *items, qsizetype numItems,
+                                        QCharAttributes *attributes, CharAttributeOptions options);
 
 Q_CORE_EXPORT void initScripts(QStringView str, ScriptItemArray *scripts);
 
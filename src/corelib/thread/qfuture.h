@@ -289,6 +289,9 @@ private:
     template<typename ResultType>
     friend struct QtPrivate::WhenAnyContext;
 
+    template<class ResultType, class Promise>
+    friend class QtPrivate::FutureAwaiter;
+
     friend struct QtPrivate::UnwrapHandler;
 
     using QFuturePrivate =
@@ -522,6 +525,18 @@ QFuture<std::variant<std::decay_t<Futures>...>> whenAny(Futures &&... futures);
 
 #endif // Q_QDOC
 
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+template<class T>
+class Coroutine : public QFuture<T>
+{
+public:
+    using promise_type = QtPrivate::FutureCoroutinePromise<T>;
+
+    Coroutine() = default;
+    Coroutine(QFuture<T> &&future) : QFuture<T>(std::move(future)) { }
+};
+#endif
+
 } // namespace QtFuture
 
 Q_DECLARE_SEQUENTIAL_ITERATOR(Future)
@@ -17,6 +17,10 @@
 #include <QtCore/qpointer.h>
 #include <QtCore/qpromise.h>
 
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 //
@@ -43,6 +47,11 @@ struct WhenAnyResult
 // Deduction guide
 template<class T>
 WhenAnyResult(qsizetype, const QFuture<T> &) -> WhenAnyResult<T>;
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+template<class T>
+class Coroutine;
+#endif
 }
 
 namespace QtPrivate {
@@ -1155,6 +1164,209 @@ QFuture<std::variant<std::decay_t<Futures>...>> whenAnyImpl(Futures &&... future
     return context->promise.future();
 }
 
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+template<class T>
+class FutureCoroutinePromise;
+
+template<class T>
+inline constexpr bool isFutureCoroutineV = false;
+
+template<class T>
+inline constexpr bool isFutureCoroutineV<QtFuture::Coroutine<T>> = true;
+
+// Resumes a coroutine suspended on a future. If the future was canceled, or the
+// coroutine's own future was canceled meanwhile, the coroutine is destroyed instead;
+// that cancels its QPromise, which propagates the cancellation to its awaiters.
+template<class Promise>
+class FutureCoroutineResumer
+{
+public:
+    FutureCoroutineResumer(std::coroutine_handle<Promise> h, bool awaitedCanceled)
+        : handle(h), canceled(awaitedCanceled)
+    {
+    }
+    FutureCoroutineResumer(FutureCoroutineResumer &&other) noexcept
+        : handle(std::exchange(other.handle, nullptr)), canceled(other.canceled)
+    {
+    }
+    Q_DISABLE_COPY(FutureCoroutineResumer)
+    ~FutureCoroutineResumer()
+    {
+        // Never ran, because the context object got destroyed
+        if (handle)
+            handle.destroy();
+    }
+
+    void operator()()
+    {
+        auto h = std::exchange(handle, nullptr);
+        if (canceled || h.promise().isCanceled())
+            h.destroy();
+        else
+            h.resume();
+    }
+
+private:
+    std::coroutine_handle<Promise> handle;
+    bool canceled;
+};
+
+template<class ResultType, class Promise>
+class FutureAwaiter
+{
+public:
+    FutureAwaiter(QFuture<ResultType> &&f, const Promise &p) : future(std::move(f)), awaiting(p)
+    {
+    }
+
+    bool await_ready() const
+    {
+        return future.isFinished() && !isCanceledWithoutResult(future.d)
+                && !awaiting.isCanceled();
+    }
+
+    void await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        using Resumer = FutureCoroutineResumer<Promise>;
+
+        // The continuation may run right away and resume or destroy the coroutine,
+        // together with this awaiter, so don't go through our own copy of the future.
+        auto awaited = future.d;
+        if (!awaiting.hasContext) {
+            awaited.setContinuation([handle](const QFutureInterfaceBase &parentData) {
+                Resumer(handle, isCanceledWithoutResult(parentData))();
+            });
+            return;
+        }
+
+        // If the context object is destroyed before the posted call runs, the call
+        // is dropped along with the resumer, which destroys the coroutine.
+        awaited.setContinuation([handle, context = awaiting.context](
+                                        const QFutureInterfaceBase &parentData) {
+            Resumer resumer(handle, isCanceledWithoutResult(parentData));
+            if (QObject *receiver = context.data()) {
+                QMetaObject::invokeMethod(receiver, [resumer = std::move(resumer)]() mutable {
+                    resumer();
+                });
+            } // else the resumer destroys the coroutine
+        });
+    }
+
+    ResultType await_resume()
+    {
+        if constexpr (std::is_void_v<ResultType>)
+            future.waitForFinished(); // rethrows a possible exception
+        else if constexpr (std::is_copy_constructible_v<ResultType>)
+            return future.result();
+        else
+            return future.takeResult();
+    }
+
+private:
+    static bool isCanceledWithoutResult(const QFutureInterfaceBase &awaited)
+    {
+        return awaited.isCanceled() && !awaited.hasException();
+    }
+
+    QFuture<ResultType> future;
+    const Promise &awaiting;
+};
+
+template<class T>
+class FutureCoroutinePromiseBase
+{
+public:
+    FutureCoroutinePromiseBase() = default;
+
+    // A coroutine that is a member of a QObject, or that takes a QObject as first
+    // argument, resumes in the thread of that object.
+    template<class First, class... Rest>
+    explicit FutureCoroutinePromiseBase(First &&first, Rest &&...)
+    {
+        using Arg = std::remove_cv_t<std::remove_reference_t<First>>;
+        using Object = std::remove_cv_t<std::remove_pointer_t<Arg>>;
+        if constexpr (std::is_class_v<Object> && std::is_base_of_v<QObject, Object>) {
+            hasContext = true;
+            if constexpr (std::is_pointer_v<Arg>)
+                context = const_cast<Object *>(first);
+            else
+                context = const_cast<Object *>(&first);
+        }
+    }
+
+    QFuture<T> get_return_object()
+    {
+        promise.start();
+        return promise.future();
+    }
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception()
+    {
+#ifndef QT_NO_EXCEPTIONS
+        promise.setException(std::current_exception());
+        promise.finish();
+#endif
+    }
+
+    template<class U>
+    auto await_transform(QFuture<U> future)
+    {
+        return FutureAwaiter<U, FutureCoroutinePromise<T>>(
+                std::move(future), static_cast<const FutureCoroutinePromise<T> &>(*this));
+    }
+
+    template<class U>
+    auto await_transform(QtFuture::Coroutine<U> future)
+    {
+        return await_transform(QFuture<U>(std::move(future)));
+    }
+
+    template<class Awaitable,
+             std::enable_if_t<!isQFutureV<std::decay_t<Awaitable>>
+                                      && !isFutureCoroutineV<std::decay_t<Awaitable>>,
+                              int> = 0>
+    Awaitable &&await_transform(Awaitable &&awaitable)
+    {
+        return std::forward<Awaitable>(awaitable);
+    }
+
+    bool isCanceled() const { return promise.isCanceled(); }
+
+    QPointer<QObject> context;
+    bool hasContext = false;
+
+protected:
+    QPromise<T> promise;
+};
+
+template<class T>
+class FutureCoroutinePromise : public FutureCoroutinePromiseBase<T>
+{
+public:
+    using FutureCoroutinePromiseBase<T>::FutureCoroutinePromiseBase;
+
+    template<class U = T>
+    void return_value(U &&value)
+    {
+        this->promise.addResult(std::forward<U>(value));
+        this->promise.finish();
+    }
+};
+
+template<>
+class FutureCoroutinePromise<void> : public FutureCoroutinePromiseBase<void>
+{
+public:
+    using FutureCoroutinePromiseBase<void>::FutureCoroutinePromiseBase;
+
+    void return_void() { promise.finish(); }
+};
+
+#endif // __cpp_impl_coroutine
+
 } // namespace QtPrivate
 
 QT_END_NAMESPACE
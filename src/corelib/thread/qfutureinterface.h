@@ -38,6 +38,9 @@ class CanceledHandler;
 template<class Function, class ResultType>
 class FailureHandler;
 #endif
+
+template<class ResultType, class Promise>
+class FutureAwaiter;
 }
 
 class Q_CORE_EXPORT QFutureInterfaceBase
@@ -179,6 +182,9 @@ private:
     template<class T>
     friend class QPromise;
 
+    template<class ResultType, class Promise>
+    friend class QtPrivate::FutureAwaiter;
+
 protected:
     void setContinuation(std::function<void(const QFutureInterfaceBase &)> func);
     void setContinuation(std::function<void(const QFutureInterfaceBase &)> func,
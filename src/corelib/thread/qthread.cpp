@@ -81,14 +81,19 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
-    for (int i = 0; i < postEventList.size(); ++i) {
-        const QPostEvent &pe = postEventList.at(i);
-        if (pe.event) {
-            --pe.receiver->d_func()->postedEvents;
-            pe.event->m_posted = false;
-            delete pe.event;
+    {
+        // other threads may still look at the queued calls of coalesced
+        // connections, which must stop waiting with the mutex locked
+        QMutexLocker locker(&postEventList.mutex);
+        for (const QPostEvent &pe : std::as_const(postEventList)) {
+            if (pe.event) {
+                --pe.receiver->d_func()->postedEvents;
+                QCoreApplicationPrivate::unpostEvent(pe.event);
+            }
         }
     }
+    for (const QPostEvent &pe : std::as_const(postEventList))
+        delete pe.event;
 
     // fprintf(stderr, "QThreadData %p destroyed\n", this);
 }
@@ -103,12 +103,283 @@ static int shortDayFromName(QStringView name)
     return 0;
 }
 
+/*
+    Fast paths for the common, strictly formed shapes of ISO 8601 (and RFC 3339)
+    and RFC 2822 date-times: "yyyy-MM-ddTHH:mm[:ss[.z...]][Z|±HH[[:]mm]]" and
+    "[ddd, ]d MMM yyyy HH:mm[:ss][ ±hhmm]". They only read ASCII and report
+    failure for anything they don't recognize, without saying whether it is
+    invalid, so that callers can fall back to the general parsers; they never
+    accept anything the general parsers would reject or read it differently.
+    They work directly on Latin-1, UTF-8 or UTF-16 data and don't allocate.
+*/
+struct FastParsedDateTime
+{
+    qint64 julianDay;
+    int msecsOfDay; // MSECS_PER_DAY for ISO 8601's 24:00, the end of the day
+    Qt::TimeSpec spec;
+    int offset;
+};
+
+// Returns the value of exactly count ASCII digits, or -1
+template <typename Char>
+static int readAsciiDigits(const Char *s, qsizetype count) noexcept
+{
+    int result = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const unsigned digit = unsigned(s[i]) - '0';
+        if (digit > 9)
+            return -1;
+        result = result * 10 + int(digit);
+    }
+    return result;
+}
+
+// Reads ±HH, ±HHmm or ±HH:mm, with hours and minutes in the ranges that
+// fromOffsetString() accepts
+template <typename Char>
+static bool readFastOffset(const Char *s, qsizetype size, bool allowColon, int *offset) noexcept
+{
+    if (size < 3 || (s[0] != '+' && s[0] != '-'))
+        return false;
+    const int hours = readAsciiDigits(s + 1, 2);
+    int minutes = 0;
+    if (size == 6 && allowColon && s[3] == ':')
+        minutes = readAsciiDigits(s + 4, 2);
+    else if (size == 5)
+        minutes = readAsciiDigits(s + 3, 2);
+    else if (size != 3)
+        return false;
+    if (hours < 0 || hours > 23 || minutes < 0 || minutes > 59)
+        return false;
+    *offset = (hours * 60 + minutes) * 60 * (s[0] == '-' ? -1 : 1);
+    return true;
+}
+
+template <typename Char>
+static bool fastIsoDateTime(const Char *s, qsizetype size, FastParsedDateTime *result) noexcept
+{
+    if (size < 16 || s[4] != '-' || s[7] != '-' || s[13] != ':'
+        || !(s[10] == 'T' || s[10] == 't' || s[10] == ' ')) {
+        return false;
+    }
+    const int year = readAsciiDigits(s, 4);
+    const int month = readAsciiDigits(s + 5, 2);
+    const int day = readAsciiDigits(s + 8, 2);
+    const int hour = readAsciiDigits(s + 11, 2);
+    const int minute = readAsciiDigits(s + 14, 2);
+    if (year <= 0 || month < 0 || day < 0 || hour < 0 || hour > 24
+        || minute < 0 || minute >= MINS_PER_HOUR
+        || !QGregorianCalendar::julianFromParts(year, month, day, &result->julianDay)) {
+        return false;
+    }
+
+    qsizetype pos = 16;
+    int second = 0;
+    int msec = 0;
+    if (pos < size && s[pos] == ':') {
+        if (size - pos < 3)
+            return false;
+        second = readAsciiDigits(s + pos + 1, 2);
+        if (second < 0 || second >= SECS_PER_MIN)
+            return false;
+        pos += 3;
+        if (pos < size && (s[pos] == '.' || s[pos] == ',')) {
+            const qsizetype start = ++pos;
+            quint32 fraction = 0;
+            while (pos < size && pos - start < 10 && unsigned(s[pos]) - '0' <= 9)
+                fraction = fraction * 10 + quint32(s[pos++] - '0');
+            const qsizetype digits = pos - start;
+            if (digits == 0 || digits > 9)
+                return false;
+            constexpr quint32 powersOfTen[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+            if (digits <= 3) {
+                msec = int(fraction * powersOfTen[3 - digits]);
+            } else {
+                // Round to nearest; only an exact half can come out differently
+                // from fromIsoTimeString()'s floating-point arithmetic, so use
+                // that then:
+                const quint32 scale = powersOfTen[digits - 3];
+                const quint32 remainder = fraction % scale;
+                msec = int(fraction / scale);
+                if (2 * remainder == scale)
+                    msec = qRound(MSECS_PER_SEC * (fraction * std::pow(0.1, digits)));
+                else if (2 * remainder > scale)
+                    ++msec;
+            }
+        }
+    }
+
+    result->spec = Qt::LocalTime;
+    result->offset = 0;
+    if (pos < size) {
+        if ((s[pos] == 'Z' || s[pos] == 'z') && pos + 1 == size)
+            result->spec = Qt::UTC;
+        else if (readFastOffset(s + pos, size - pos, true, &result->offset))
+            result->spec = Qt::OffsetFromUTC;
+        else
+            return false;
+    }
+
+    // Rounding of the fraction may carry all the way to 24:00, which (like
+    // 24:00 itself) is the end of the day; anything later is invalid.
+    result->msecsOfDay = int(((hour * MINS_PER_HOUR + minute) * SECS_PER_MIN + second)
+                             * MSECS_PER_SEC + msec);
+    return result->msecsOfDay <= MSECS_PER_DAY;
+}
+
+template <typename Char>
+static int fastShortName(const Char *s, const char (*names)[4], int count) noexcept
+{
+    for (int i = 0; i < count; ++i) {
+        if (s[0] == names[i][0] && s[1] == names[i][1] && s[2] == names[i][2])
+            return i + 1;
+    }
+    return 0;
+}
+
+template <typename Char>
+static bool fastRfcDateTime(const Char *s, qsizetype size, FastParsedDateTime *result) noexcept
+{
+    static const char shortDayNames[][4] = { "Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun" };
+    int dayOfWeek = 0;
+    if (size > 5 && s[3] == ',' && s[4] == ' ') {
+        dayOfWeek = fastShortName(s, shortDayNames, 7);
+        if (!dayOfWeek)
+            return false;
+        s += 5;
+        size -= 5;
+    }
+    // d[d] MMM yyyy HH:mm
+    const qsizetype dayLength = size > 1 && s[1] == ' ' ? 1 : 2;
+    if (size < dayLength + 15)
+        return false;
+    const int day = readAsciiDigits(s, dayLength);
+    s += dayLength;
+    size -= dayLength;
+    if (s[0] != ' ' || s[4] != ' ' || s[9] != ' ' || s[12] != ':')
+        return false;
+    const int month = fastShortName(s + 1, qt_shortMonthNames, 12);
+    const int year = readAsciiDigits(s + 5, 4);
+    const int hour = readAsciiDigits(s + 10, 2);
+    const int minute = readAsciiDigits(s + 13, 2);
+    int second = 0;
+    qsizetype pos = 15;
+    if (size > pos && s[pos] == ':') {
+        if (size < pos + 3)
+            return false;
+        second = readAsciiDigits(s + pos + 1, 2);
+        pos += 3;
+    }
+    if (day < 0 || !month || year <= 0 || hour < 0 || hour > 23
+        || minute < 0 || minute >= MINS_PER_HOUR || second < 0 || second >= SECS_PER_MIN
+        || !QGregorianCalendar::julianFromParts(year, month, day, &result->julianDay)
+        || (dayOfWeek && QGregorianCalendar::weekDayOfJulian(result->julianDay) != dayOfWeek)) {
+        return false;
+    }
+
+    result->spec = Qt::OffsetFromUTC;
+    result->offset = 0;
+    if (pos < size
+        && (s[pos] != ' ' || !readFastOffset(s + pos + 1, size - pos - 1, false, &result->offset))) {
+        return false;
+    }
+    result->msecsOfDay = int(((hour * MINS_PER_HOUR + minute) * SECS_PER_MIN + second)
+                             * MSECS_PER_SEC);
+    return true;
+}
+
+static QDateTime dateTimeFromFastParsed(const FastParsedDateTime &parsed)
+{
+    const QDate date = QDate::fromJulianDay(parsed.julianDay);
+    if (parsed.msecsOfDay == MSECS_PER_DAY) // 24:00 is the start of the next day
+        return date.addDays(1).startOfDay(parsed.spec, parsed.offset);
+    return QDateTime(date, QTime::fromMSecsSinceStartOfDay(parsed.msecsOfDay),
+                     parsed.spec, parsed.offset);
+}
+
+// Longest output of fastDateTimeString(): "yyyy-MM-ddTHH:mm:ss.zzz+HH:mm"
+constexpr qsizetype MaxFastDateTimeLength = 29;
+
+/*
+    Formats a date-time as QDateTime::toString() does for Qt::ISODate,
+    Qt::ISODateWithMs ("yyyy-MM-ddTHH:mm:ss[.zzz][Z|±HH:mm]") and
+    Qt::RFC2822Date ("dd MMM yyyy hh:mm:ss ±hhmm"), without allocating. The
+    zone suffix is omitted for Qt::LocalTime, in ISO format. Returns the length
+    written, or 0 for dates outside the years 0 to 9999, where the general code
+    must be used.
+*/
+template <typename Char>
+static qsizetype fastDateTimeString(Char *out, qint64 julianDay, int msecsOfDay,
+                                    Qt::DateFormat format, Qt::TimeSpec spec, int offset) noexcept
+{
+    const auto parts = QGregorianCalendar::partsFromJulian(julianDay);
+    if (!parts.isValid() || parts.year < 0 || parts.year > 9999 || qAbs(offset) >= SECS_PER_DAY)
+        return 0;
+    Q_ASSERT(msecsOfDay >= 0 && msecsOfDay < MSECS_PER_DAY);
+
+    Char *p = out;
+    const auto put = [&p](int value, int digits) {
+        for (int i = digits - 1; i >= 0; --i, value /= 10)
+            p[i] = Char('0' + value % 10);
+        p += digits;
+    };
+    const int seconds = msecsOfDay / MSECS_PER_SEC;
+    const bool iso = format != Qt::RFC2822Date;
+    if (iso) {
+        put(parts.year, 4);
+        *p++ = '-';
+        put(parts.month, 2);
+        *p++ = '-';
+        put(parts.day, 2);
+        *p++ = 'T';
+    } else {
+        put(parts.day, 2);
+        *p++ = ' ';
+        for (int i = 0; i < 3; ++i)
+            *p++ = qt_shortMonthNames[parts.month - 1][i];
+        *p++ = ' ';
+        put(parts.year, 4);
+        *p++ = ' ';
+    }
+    put(seconds / SECS_PER_HOUR, 2);
+    *p++ = ':';
+    put(seconds / SECS_PER_MIN % MINS_PER_HOUR, 2);
+    *p++ = ':';
+    put(seconds % SECS_PER_MIN, 2);
+    if (format == Qt::ISODateWithMs) {
+        *p++ = '.';
+        put(msecsOfDay % MSECS_PER_SEC, 3);
+    }
+
+    if (iso && spec == Qt::UTC) {
+        *p++ = 'Z';
+    } else if (!iso || spec != Qt::LocalTime) {
+        if (!iso)
+            *p++ = ' ';
+        *p++ = offset >= 0 ? '+' : '-';
+        put(qAbs(offset) / SECS_PER_HOUR, 2);
+        if (iso)
+            *p++ = ':';
+        put(qAbs(offset) / SECS_PER_MIN % MINS_PER_HOUR, 2);
+    }
+    Q_ASSERT(p - out <= MaxFastDateTimeLength);
+    return p - out;
+}
+
 static ParsedRfcDateTime rfcDateImpl(QStringView s)
 {
     // Matches "[ddd,] dd MMM yyyy[ hh:mm[:ss]] [±hhmm]" - correct RFC 822, 2822, 5322 format -
     // or           "ddd MMM dd[ hh:mm:ss] yyyy [±hhmm]" - permissive RFC 850, 1036 (read only)
     ParsedRfcDateTime result;
 
+    FastParsedDateTime fast;
+    if (fastRfcDateTime(s.utf16(), s.size(), &fast)) {
+        result.date = QDate::fromJulianDay(fast.julianDay);
+        result.time = QTime::fromMSecsSinceStartOfDay(fast.msecsOfDay);
+        result.utcOffset = fast.offset;
+        return result;
+    }
+
     QVarLengthArray<QStringView, 6> words;
 
     auto tokens = s.tokenize(u' ', Qt::SkipEmptyParts);
@@ -3953,6 +4224,24 @@ QString QDateTime::toString(Qt::DateFormat format) const
     if (!isValid())
         return buf;
 
+    if (format == Qt::ISODate || format == Qt::ISODateWithMs || format == Qt::RFC2822Date) {
+        // Avoid looking up the offset where it isn't shown:
+        const Qt::TimeSpec spec = getSpec(d);
+        const bool showsOffset = spec == Qt::LocalTime ? format == Qt::RFC2822Date
+                                                       : spec != Qt::UTC;
+        const QPair<QDate, QTime> p = getDateTime(d);
+        buf.resize(MaxFastDateTimeLength);
+        const qsizetype length =
+                fastDateTimeString(reinterpret_cast<char16_t *>(buf.data()), p.first.toJulianDay(),
+                                   p.second.msecsSinceStartOfDay(), format, spec,
+                                   showsOffset ? offsetFromUtc() : 0);
+        if (length) {
+            buf.truncate(length);
+            return buf;
+        }
+        buf.clear();
+    }
+
     switch (format) {
     case Qt::RFC2822Date:
         buf = QLocale::c().toString(*this, u"dd MMM yyyy hh:mm:ss ");
@@ -4926,6 +5215,10 @@ QDateTime QDateTime::fromString(QStringView string, Qt::DateFormat format)
     }
     case Qt::ISODate:
     case Qt::ISODateWithMs: {
+        FastParsedDateTime fast;
+        if (fastIsoDateTime(string.utf16(), string.size(), &fast))
+            return dateTimeFromFastParsed(fast);
+
         const int size = string.size();
         if (size < 10)
             return QDateTime();
@@ -5046,6 +5339,153 @@ QDateTime QDateTime::fromString(QStringView string, Qt::DateFormat format)
     return QDateTime();
 }
 
+template <typename View>
+static bool msecsSinceEpochFromStringImpl(View string, Qt::DateFormat format, qint64 *msecs)
+{
+    FastParsedDateTime parsed;
+    bool fast = false;
+    if (format == Qt::ISODate || format == Qt::ISODateWithMs)
+        fast = fastIsoDateTime(string.data(), string.size(), &parsed);
+    else if (format == Qt::RFC2822Date)
+        fast = fastRfcDateTime(string.data(), string.size(), &parsed);
+
+    if (fast && parsed.spec != Qt::LocalTime) {
+        *msecs = (parsed.julianDay - JULIAN_DAY_FOR_EPOCH) * MSECS_PER_DAY + parsed.msecsOfDay
+                 - parsed.offset * MSECS_PER_SEC;
+        return true;
+    }
+    const QDateTime dateTime = fast ? dateTimeFromFastParsed(parsed)
+                                    : QDateTime::fromString(string.toString(), format);
+    if (!dateTime.isValid())
+        return false;
+    *msecs = dateTime.toMSecsSinceEpoch();
+    return true;
+}
+
+/*!
+    \since 6.5
+
+    Returns the number of milliseconds since the start of 1970 (UTC) of the
+    date-time represented by \a string in the given \a format, as
+    \c{fromString(string, format).toMSecsSinceEpoch()} would. If \a ok is not
+    \nullptr, it is set to \c true on success and \c false if \a string is not
+    a valid date-time, in which case 0 is returned.
+
+    For Qt::ISODate and Qt::ISODateWithMs, strings of the form
+    \c{yyyy-MM-ddTHH:mm[:ss[.z]][Z|±HH[[:]mm]]}, with a space or \c t allowed
+    in place of the \c T, which includes all RFC 3339 timestamps, are parsed
+    without allocating any memory. So are RFC 2822 date-times of the form
+    \c{[ddd, ]d MMM yyyy HH:mm[:ss] [±hhmm]}. Other forms, and other formats,
+    are handed on to fromString(). Converting a date-time without an offset or
+    \c Z suffix, that is in local time, needs the system's time zone data.
+
+    \sa msecsSinceEpochFromStrings(), msecsSinceEpochToString(), fromString()
+*/
+qint64 QDateTime::msecsSinceEpochFromString(QLatin1StringView string, Qt::DateFormat format,
+                                            bool *ok)
+{
+    qint64 msecs = 0;
+    const bool valid = msecsSinceEpochFromStringImpl(string, format, &msecs);
+    if (ok)
+        *ok = valid;
+    return valid ? msecs : 0;
+}
+
+/*!
+    \since 6.5
+    \overload
+*/
+qint64 QDateTime::msecsSinceEpochFromString(QUtf8StringView string, Qt::DateFormat format,
+                                            bool *ok)
+{
+    qint64 msecs = 0;
+    const bool valid = msecsSinceEpochFromStringImpl(string, format, &msecs);
+    if (ok)
+        *ok = valid;
+    return valid ? msecs : 0;
+}
+
+template <typename View>
+static qsizetype msecsSinceEpochFromStringsImpl(const View *strings, qint64 *msecs,
+                                                qsizetype count, Qt::DateFormat format)
+{
+    qsizetype valid = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        if (msecsSinceEpochFromStringImpl(strings[i], format, msecs + i))
+            ++valid;
+        else
+            msecs[i] = std::numeric_limits<qint64>::min();
+    }
+    return valid;
+}
+
+/*!
+    \since 6.5
+
+    Parses the \a count date-times in \a strings, in the given \a format, as
+    msecsSinceEpochFromString() does, and stores the results in the array \a
+    msecs, which must have room for \a count values. Strings that are not valid
+    date-times are reported as \c{std::numeric_limits<qint64>::min()}, which no
+    parsed date-time can have. Returns the number of strings that were valid.
+
+    This is convenient for converting the timestamps of large logs: it doesn't
+    allocate any memory for the forms msecsSinceEpochFromString() parses
+    directly.
+*/
+qsizetype QDateTime::msecsSinceEpochFromStrings(const QLatin1StringView *strings, qint64 *msecs,
+                                                qsizetype count, Qt::DateFormat format)
+{
+    return msecsSinceEpochFromStringsImpl(strings, msecs, count, format);
+}
+
+/*!
+    \since 6.5
+    \overload
+*/
+qsizetype QDateTime::msecsSinceEpochFromStrings(const QUtf8StringView *strings, qint64 *msecs,
+                                                qsizetype count, Qt::DateFormat format)
+{
+    return msecsSinceEpochFromStringsImpl(strings, msecs, count, format);
+}
+
+/*!
+    \since 6.5
+
+    Writes the date-time \a msecs milliseconds after the start of 1970 (UTC),
+    as seen at \a offsetSeconds ahead of UTC, to \a buffer in the given \a
+    format, without allocating any memory. The text is what
+    \c{fromMSecsSinceEpoch(msecs, Qt::OffsetFromUTC, offsetSeconds).toString(format)}
+    would produce; it is not '\\0'-terminated. Returns its length, or 0 if it
+    doesn't fit in the \a size bytes of \a buffer or can't be formatted.
+
+    Only Qt::ISODate, Qt::ISODateWithMs and Qt::RFC2822Date are supported, for
+    years from 0 to 9999. A buffer of 32 bytes is always big enough.
+
+    \sa msecsSinceEpochFromString(), toString()
+*/
+qsizetype QDateTime::msecsSinceEpochToString(qint64 msecs, char *buffer, qsizetype size,
+                                             Qt::DateFormat format, int offsetSeconds)
+{
+    if (format != Qt::ISODate && format != Qt::ISODateWithMs && format != Qt::RFC2822Date)
+        return 0;
+    qint64 local;
+    if (qAddOverflow(msecs, offsetSeconds * MSECS_PER_SEC, &local))
+        return 0;
+    // Only go via a local buffer if the text might not fit:
+    char text[MaxFastDateTimeLength];
+    char *out = size < MaxFastDateTimeLength ? text : buffer;
+    const qsizetype length = fastDateTimeString(
+            out, JULIAN_DAY_FOR_EPOCH + QRoundingDown::qDiv(local, MSECS_PER_DAY),
+            int(QRoundingDown::qMod(local, MSECS_PER_DAY)), format,
+            offsetSeconds ? Qt::OffsetFromUTC : Qt::UTC, offsetSeconds);
+    if (out == buffer)
+        return length;
+    if (length > size)
+        return 0;
+    memcpy(buffer, text, length);
+    return length;
+}
+
 /*!
     \fn QDateTime QDateTime::fromString(const QString &string, const QString &format, QCalendar cal)
 
@@ -389,6 +389,22 @@ public:
     static QDateTime fromString(const QString &string, const QString &format,
                                 QCalendar cal = QCalendar())
     { return fromString(string, qToStringViewIgnoringNull(format), cal); }
+
+    static qint64 msecsSinceEpochFromString(QLatin1StringView string,
+                                            Qt::DateFormat format = Qt::ISODate,
+                                            bool *ok = nullptr);
+    static qint64 msecsSinceEpochFromString(QUtf8StringView string,
+                                            Qt::DateFormat format = Qt::ISODate,
+                                            bool *ok = nullptr);
+    static qsizetype msecsSinceEpochFromStrings(const QLatin1StringView *strings, qint64 *msecs,
+                                                qsizetype count,
+                                                Qt::DateFormat format = Qt::ISODate);
+    static qsizetype msecsSinceEpochFromStrings(const QUtf8StringView *strings, qint64 *msecs,
+                                                qsizetype count,
+                                                Qt::DateFormat format = Qt::ISODate);
+    static qsizetype msecsSinceEpochToString(qint64 msecs, char *buffer, qsizetype size,
+                                             Qt::DateFormat format = Qt::ISODateWithMs,
+                                             int offsetSeconds = 0);
 #endif
 
     static QDateTime fromMSecsSinceEpoch(qint64 msecs, Qt::TimeSpec spec = Qt::LocalTime,
@@ -0,0 +1,582 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qdatetimeformatter.h"
+
+#include "private/qlocale_p.h"
+#include "private/qnumberformatter_p.h"
+
+#if QT_CONFIG(timezone)
+#include "qtimezone.h"
+#endif
+
+#include <array>
+
+QT_BEGIN_NAMESPACE
+
+class QDateTimeFormatterPrivate : public QSharedData
+{
+public:
+    // One field of the format, or a run of literal text
+    enum class Field : quint8 {
+        Literal,
+        // Date fields:
+        Year,
+        ShortYear,
+        Month,
+        MonthName,
+        Day,
+        DayName,
+        // Time fields:
+        Hour,
+        Hour12,
+        Minute,
+        Second,
+        AmPm,
+        Millisecond,
+        TimeZone,
+    };
+
+    struct Token
+    {
+        Field field;
+        // How many times the field's letter is repeated, as it is used
+        quint8 repeat;
+        // For a Literal, its text; for AmPm, the AM text
+        QString text;
+        // For AmPm, the PM text
+        QString alternative;
+        // The letters of a field, written instead of it when its date or time
+        // isn't being formatted
+        QString source;
+
+        bool isDateField() const { return field >= Field::Year && field <= Field::DayName; }
+        bool isTimeField() const { return field >= Field::Hour; }
+    };
+
+    QDateTimeFormatterPrivate(QStringView format, const QLocale &locale, QCalendar cal);
+
+    qsizetype format(QChar *buffer, qsizetype size, const QDateTime *dateTime,
+                     QDate date, QTime time) const;
+
+    QString pattern;
+    QLocale locale;
+    QCalendar calendar;
+    QList<Token> tokens;
+    QLocaleNumberSymbols symbols;
+    // Indexed by [isLong][month - 1] and [isLong][dayOfWeek - 1]:
+    std::array<QStringList, 2> monthNames;
+    std::array<QStringList, 2> dayNames;
+    qsizetype sizeHint = 0;
+};
+
+// The same as timeFormatContainsAP() in qlocale.cpp
+static bool formatContainsAmPm(QStringView format)
+{
+    qsizetype i = 0;
+    while (i < format.size()) {
+        if (format.at(i).unicode() == '\'') {
+            qt_readEscapedFormatString(format, &i);
+            continue;
+        }
+
+        if (format.at(i).toLower().unicode() == 'a')
+            return true;
+
+        ++i;
+    }
+    return false;
+}
+
+/*
+    Splits the format into tokens the way QCalendarBackend::dateTimeToString()
+    reads it when formatting both a date and a time. When it is formatting
+    only one of them, the letters of the other's fields come out verbatim,
+    which is what the tokens' sources hold.
+*/
+QDateTimeFormatterPrivate::QDateTimeFormatterPrivate(QStringView format, const QLocale &locale,
+                                                     QCalendar cal)
+    : pattern(format.toString()),
+      locale(locale),
+      calendar(cal),
+      symbols(QLocalePrivate::get(locale)->m_data)
+{
+    const bool twelveHour = formatContainsAmPm(format);
+    bool needMonthNames = false;
+    bool needDayNames = false;
+    QString literal;
+    const auto flushLiteral = [&]() {
+        if (!literal.isEmpty()) {
+            tokens.append(Token{ Field::Literal, 0, std::move(literal), {}, {} });
+            literal.clear();
+        }
+    };
+
+    qsizetype i = 0;
+    while (i < format.size()) {
+        if (format.at(i).unicode() == '\'') {
+            literal += qt_readEscapedFormatString(format, &i);
+            continue;
+        }
+
+        const QChar c = format.at(i);
+        qsizetype repeat = qt_repeatCount(format.sliced(i));
+        Token token{ Field::Literal, 0, {}, {}, {} };
+        switch (c.unicode()) {
+        case 'y':
+            if (repeat >= 4) {
+                repeat = 4;
+                token.field = Field::Year;
+            } else if (repeat >= 2) {
+                repeat = 2;
+                token.field = Field::ShortYear;
+            } else {
+                repeat = 1;
+            }
+            break;
+        case 'M':
+            repeat = qMin(repeat, 4);
+            token.field = repeat > 2 ? Field::MonthName : Field::Month;
+            needMonthNames |= repeat > 2;
+            break;
+        case 'd':
+            repeat = qMin(repeat, 4);
+            token.field = repeat > 2 ? Field::DayName : Field::Day;
+            needDayNames |= repeat > 2;
+            break;
+        case 'h':
+            repeat = qMin(repeat, 2);
+            token.field = twelveHour ? Field::Hour12 : Field::Hour;
+            break;
+        case 'H':
+            repeat = qMin(repeat, 2);
+            token.field = Field::Hour;
+            break;
+        case 'm':
+            repeat = qMin(repeat, 2);
+            token.field = Field::Minute;
+            break;
+        case 's':
+            repeat = qMin(repeat, 2);
+            token.field = Field::Second;
+            break;
+        case 'A':
+        case 'a': {
+            token.field = Field::AmPm;
+            QString am = locale.amText();
+            QString pm = locale.pmText();
+            repeat = 1;
+            if (i + 1 < format.size()
+                    && (format.at(i + 1).unicode() == 'p' || format.at(i + 1).unicode() == 'P')) {
+                ++repeat;
+            }
+            if (c.unicode() == 'A' && (repeat == 1 || format.at(i + 1).unicode() == 'P')) {
+                am = std::move(am).toUpper();
+                pm = std::move(pm).toUpper();
+            } else if (c.unicode() == 'a' && (repeat == 1 || format.at(i + 1).unicode() == 'p')) {
+                am = std::move(am).toLower();
+                pm = std::move(pm).toLower();
+            }
+            // else 'Ap' or 'aP' => use CLDR text verbatim, preserving case
+            token.text = std::move(am);
+            token.alternative = std::move(pm);
+            break;
+        }
+        case 'z':
+            repeat = qMin(repeat, 3);
+            token.field = Field::Millisecond;
+            break;
+        case 't':
+            repeat = qMin(repeat, 4);
+            token.field = Field::TimeZone;
+            break;
+        default:
+            break;
+        }
+
+        if (token.field == Field::Literal) {
+            literal.append(QString(repeat, c));
+        } else {
+            flushLiteral();
+            token.repeat = quint8(repeat);
+            token.source = format.sliced(i, repeat).toString();
+            tokens.append(std::move(token));
+        }
+        i += repeat;
+    }
+    flushLiteral();
+
+    // Month names do not depend on the year, in the calendars Qt provides
+    if (needMonthNames && calendar.isValid()) {
+        const int months = calendar.maximumMonthsInYear();
+        for (int isLong = 0; isLong < 2; ++isLong) {
+            const auto type = isLong ? QLocale::LongFormat : QLocale::ShortFormat;
+            for (int month = 1; month <= months; ++month) {
+                monthNames[isLong].append(calendar.monthName(locale, month,
+                                                             QCalendar::Unspecified, type));
+            }
+        }
+    }
+    if (needDayNames) {
+        for (int isLong = 0; isLong < 2; ++isLong) {
+            const auto type = isLong ? QLocale::LongFormat : QLocale::ShortFormat;
+            for (int day = 1; day <= 7; ++day)
+                dayNames[isLong].append(locale.dayName(day, type));
+        }
+    }
+
+    // Enough room for most results, so that toString() seldom has to retry:
+    const auto longest = [](const QStringList &names) {
+        qsizetype result = 0;
+        for (const QString &name : names)
+            result = qMax(result, name.size());
+        return result;
+    };
+    for (const Token &token : std::as_const(tokens)) {
+        switch (token.field) {
+        case Field::Literal:
+            sizeHint += token.text.size();
+            break;
+        case Field::AmPm:
+            sizeHint += qMax(token.text.size(), token.alternative.size());
+            break;
+        case Field::MonthName:
+            sizeHint += qMax(longest(monthNames[token.repeat == 4]), token.source.size());
+            break;
+        case Field::DayName:
+            sizeHint += qMax(longest(dayNames[token.repeat == 4]), token.source.size());
+            break;
+        case Field::TimeZone:
+            sizeHint += 32;
+            break;
+        default:
+            // Numbers, including a year's sign:
+            sizeHint += 5 * symbols.digitWidth + symbols.minus.size();
+            break;
+        }
+    }
+}
+
+/*
+    Formats date and time, or whichever of them is valid, the way
+    QCalendarBackend::dateTimeToString() does. When both are valid, they
+    are those of dateTime, which time zone fields use.
+*/
+qsizetype QDateTimeFormatterPrivate::format(QChar *buffer, qsizetype size,
+                                            const QDateTime *dateTime,
+                                            QDate date, QTime time) const
+{
+    const bool formatDate = date.isValid();
+    const bool formatTime = time.isValid();
+    if (!calendar.isValid() || (!formatDate && !formatTime))
+        return 0;
+
+    QCalendar::YearMonthDay parts;
+    if (formatDate) {
+        parts = calendar.partsFromDate(date);
+        if (!parts.isValid())
+            return 0;
+    }
+
+    QFormatterOutput out(buffer, size);
+    const auto appendNumber = [&](int value, int width) {
+        symbols.appendInteger(out, value < 0 ? -qlonglong(value) : value, value < 0,
+                              -1, 10, width, width > 0 ? QLocaleData::ZeroPadded : 0);
+    };
+    for (const Token &token : tokens) {
+        if ((token.isDateField() && !formatDate) || (token.isTimeField() && !formatTime)) {
+            out.append(token.source);
+            continue;
+        }
+
+        switch (token.field) {
+        case Field::Literal:
+            out.append(token.text);
+            break;
+        case Field::Year:
+            appendNumber(parts.year, parts.year < 0 ? 5 : 4);
+            break;
+        case Field::ShortYear:
+            appendNumber(parts.year % 100, 2);
+            break;
+        case Field::Month:
+            appendNumber(parts.month, token.repeat == 2 ? 2 : -1);
+            break;
+        case Field::MonthName: {
+            const QStringList &names = monthNames[token.repeat == 4];
+            if (parts.month >= 1 && parts.month <= names.size())
+                out.append(names.at(parts.month - 1));
+            break;
+        }
+        case Field::Day:
+            appendNumber(parts.day, token.repeat == 2 ? 2 : -1);
+            break;
+        case Field::DayName: {
+            const int dayOfWeek = calendar.dayOfWeek(date);
+            if (dayOfWeek >= 1 && dayOfWeek <= 7)
+                out.append(dayNames[token.repeat == 4].at(dayOfWeek - 1));
+            break;
+        }
+        case Field::Hour:
+            appendNumber(time.hour(), token.repeat == 2 ? 2 : -1);
+            break;
+        case Field::Hour12: {
+            int hour = time.hour();
+            if (hour > 12)
+                hour -= 12;
+            else if (hour == 0)
+                hour = 12;
+            appendNumber(hour, token.repeat == 2 ? 2 : -1);
+            break;
+        }
+        case Field::Minute:
+            appendNumber(time.minute(), token.repeat == 2 ? 2 : -1);
+            break;
+        case Field::Second:
+            appendNumber(time.second(), token.repeat == 2 ? 2 : -1);
+            break;
+        case Field::AmPm:
+            out.append(time.hour() < 12 ? token.text : token.alternative);
+            break;
+        case Field::Millisecond: {
+            // Treated like the decimal part of the seconds: unless the field
+            // is "zzz", trailing zeros are dropped, one code unit at a time.
+            QChar digits[6];
+            QFormatterOutput msec(digits, std::size(digits));
+            symbols.appendInteger(msec, time.msec(), false, -1, 10, 3, QLocaleData::ZeroPadded);
+            QStringView text(digits, msec.size());
+            if (token.repeat != 3) {
+                if (text.endsWith(symbols.zero))
+                    text.chop(1);
+                if (text.endsWith(symbols.zero))
+                    text.chop(1);
+            }
+            out.append(text);
+            break;
+        }
+        case Field::TimeZone: {
+            // If we don't have a date-time, use the current system time:
+            const QDateTime when = dateTime ? *dateTime : QDateTime::currentDateTime();
+            QString text;
+            switch (token.repeat) {
+#if QT_CONFIG(timezone)
+            case 4:
+                text = when.timeZone().displayName(when, QTimeZone::LongName);
+                break;
+#endif // timezone
+            case 3:
+            case 2:
+                text = when.toOffsetFromUtc(when.offsetFromUtc()).timeZoneAbbreviation();
+                // The Qt::UTC case omits the zero offset, which we want:
+                text = text.size() == 3 ? QStringLiteral("+00:00") : text.sliced(3);
+                if (token.repeat == 2) // +hhmm format, rather than +hh:mm format
+                    text.remove(u':');
+                break;
+            default:
+                text = when.timeZoneAbbreviation();
+                break;
+            }
+            out.append(text);
+            break;
+        }
+        }
+    }
+    return out.size();
+}
+
+/*!
+    \class QDateTimeFormatter
+    \inmodule QtCore
+    \brief The QDateTimeFormatter class converts dates and times to strings
+    in a format that is prepared once and used many times.
+
+    \since 6.5
+
+    \ingroup i18n
+    \ingroup string-processing
+    \ingroup shared
+
+    QLocale::toString() and the toString() methods of QDateTime, QDate and
+    QTime read their format string anew, and look up the names and digits
+    of their locale, each time they are called. When many dates or times are
+    formatted the same way, as when filling a table or writing a log, a
+    QDateTimeFormatter does that work once, when it is constructed, and then
+    writes each date or time directly into its result.
+
+    The format string has the same syntax as for QLocale::toString(), which
+    describes the expressions it recognizes. toString() returns the same
+    strings as QLocale::toString() would for the formatter's format, locale
+    and calendar; the names of months and days, and the AM and PM texts,
+    are those the locale had when the formatter was constructed. formatTo()
+    writes the text into a buffer supplied by the caller instead; unless
+    the format includes a time zone, it does so without allocating any
+    memory.
+
+    To format as QDateTime::toString(), QDate::toString() and
+    QTime::toString() do, with the conventions of the C locale, construct
+    the formatter with QLocale::c().
+
+    \sa QLocale::toString(), QNumberFormatter
+*/
+
+/*!
+    Constructs a date-time formatter with an empty format, whose results are
+    always empty.
+*/
+QDateTimeFormatter::QDateTimeFormatter()
+    : d(new QDateTimeFormatterPrivate({}, QLocale(), QCalendar()))
+{
+}
+
+/*!
+    Constructs a date-time formatter that formats dates and times as \a locale
+    does, according to \a format and in the calendar \a cal.
+
+    \sa QLocale::toString()
+*/
+QDateTimeFormatter::QDateTimeFormatter(QStringView format, const QLocale &locale, QCalendar cal)
+    : d(new QDateTimeFormatterPrivate(format, locale, cal))
+{
+}
+
+/*!
+    Copies the \a other date-time formatter to this one.
+*/
+QDateTimeFormatter::QDateTimeFormatter(const QDateTimeFormatter &other) = default;
+
+/*!
+    \fn QDateTimeFormatter::QDateTimeFormatter(QDateTimeFormatter &&other)
+
+    Move-constructs a date-time formatter from \a other.
+
+    \note The moved-from object \a other is placed in a partially-formed
+    state, in which the only valid operations are destruction and assignment
+    of a new value.
+*/
+
+/*!
+    Destroys the date-time formatter.
+*/
+QDateTimeFormatter::~QDateTimeFormatter() = default;
+
+QT_DEFINE_QSDP_SPECIALIZATION_DTOR(QDateTimeFormatterPrivate)
+
+/*!
+    Assigns the \a other date-time formatter to this one.
+*/
+QDateTimeFormatter &QDateTimeFormatter::operator=(const QDateTimeFormatter &other) = default;
+
+/*!
+    \fn QDateTimeFormatter &QDateTimeFormatter::operator=(QDateTimeFormatter &&other)
+
+    Move-assigns \a other to this date-time formatter.
+*/
+
+/*!
+    \fn void QDateTimeFormatter::swap(QDateTimeFormatter &other)
+
+    Swaps the date-time formatter \a other with this one. This operation is
+    very fast and never fails.
+*/
+
+/*!
+    Returns the format this formatter formats dates and times in.
+*/
+QString QDateTimeFormatter::format() const
+{
+    return d->pattern;
+}
+
+/*!
+    Returns the locale whose conventions this formatter follows.
+*/
+QLocale QDateTimeFormatter::locale() const
+{
+    return d->locale;
+}
+
+/*!
+    Returns the calendar in which this formatter formats dates.
+*/
+QCalendar QDateTimeFormatter::calendar() const
+{
+    return d->calendar;
+}
+
+/*!
+    Returns \a dateTime as a string in the formatter's format, the same as
+    QLocale::toString() does. If \a dateTime is not valid, the string is
+    empty.
+*/
+QString QDateTimeFormatter::toString(const QDateTime &dateTime) const
+{
+    return qFormatToString(d->sizeHint, [&](QChar *buffer, qsizetype size) {
+        return formatTo(buffer, size, dateTime);
+    });
+}
+
+/*!
+    \overload
+
+    Returns \a date as a string in the formatter's format, in which only the
+    expressions for dates are replaced. If \a date is not valid, the string
+    is empty.
+*/
+QString QDateTimeFormatter::toString(QDate date) const
+{
+    return qFormatToString(d->sizeHint, [&](QChar *buffer, qsizetype size) {
+        return formatTo(buffer, size, date);
+    });
+}
+
+/*!
+    \overload
+
+    Returns \a time as a string in the formatter's format, in which only the
+    expressions for times are replaced. If \a time is not valid, the string
+    is empty.
+*/
+QString QDateTimeFormatter::toString(QTime time) const
+{
+    return qFormatToString(d->sizeHint, [&](QChar *buffer, qsizetype size) {
+        return formatTo(buffer, size, time);
+    });
+}
+
+/*!
+    Writes \a dateTime in the formatter's format to \a buffer, which has room
+    for \a size characters, and returns the length of the complete text.
+
+    If the returned length is greater than \a size, only the first \a size
+    characters were written; call again with a buffer of at least the
+    returned length to get all of it. No terminating null character is
+    written. If \a dateTime is not valid, nothing is written and 0 is
+    returned.
+
+    \sa toString()
+*/
+qsizetype QDateTimeFormatter::formatTo(QChar *buffer, qsizetype size,
+                                       const QDateTime &dateTime) const
+{
+    if (!dateTime.isValid())
+        return 0;
+    return d->format(buffer, size, &dateTime, dateTime.date(), dateTime.time());
+}
+
+/*!
+    \overload
+*/
+qsizetype QDateTimeFormatter::formatTo(QChar *buffer, qsizetype size, QDate date) const
+{
+    return d->format(buffer, size, nullptr, date, QTime());
+}
+
+/*!
+    \overload
+*/
+qsizetype QDateTimeFormatter::formatTo(QChar *buffer, qsizetype size, QTime time) const
+{
+    return d->format(buffer, size, nullptr, QDate(), time);
+}
+
+QT_END_NAMESPACE
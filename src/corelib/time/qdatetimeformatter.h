@@ -0,0 +1,55 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QDATETIMEFORMATTER_H
+#define QDATETIMEFORMATTER_H
+
+#include <QtCore/qcalendar.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qlocale.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstring.h>
+
+QT_REQUIRE_CONFIG(datestring);
+
+QT_BEGIN_NAMESPACE
+
+class QDateTimeFormatterPrivate;
+QT_DECLARE_QSDP_SPECIALIZATION_DTOR_WITH_EXPORT(QDateTimeFormatterPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QDateTimeFormatter
+{
+public:
+    QDateTimeFormatter();
+    explicit QDateTimeFormatter(QStringView format, const QLocale &locale = QLocale(),
+                                QCalendar cal = QCalendar());
+    QDateTimeFormatter(const QDateTimeFormatter &other);
+    QDateTimeFormatter(QDateTimeFormatter &&other) noexcept = default;
+    ~QDateTimeFormatter();
+
+    QDateTimeFormatter &operator=(const QDateTimeFormatter &other);
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QDateTimeFormatter)
+
+    void swap(QDateTimeFormatter &other) noexcept { d.swap(other.d); }
+
+    QString format() const;
+    QLocale locale() const;
+    QCalendar calendar() const;
+
+    QString toString(const QDateTime &dateTime) const;
+    QString toString(QDate date) const;
+    QString toString(QTime time) const;
+
+    qsizetype formatTo(QChar *buffer, qsizetype size, const QDateTime &dateTime) const;
+    qsizetype formatTo(QChar *buffer, qsizetype size, QDate date) const;
+    qsizetype formatTo(QChar *buffer, qsizetype size, QTime time) const;
+
+private:
+    QSharedDataPointer<QDateTimeFormatterPrivate> d;
+};
+
+Q_DECLARE_SHARED(QDateTimeFormatter)
+
+QT_END_NAMESPACE
+
+#endif // QDATETIMEFORMATTER_H
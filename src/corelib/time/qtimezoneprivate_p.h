@@ -267,10 +267,13 @@ struct QTzTimeZoneCacheEntry
 {
     QList<QTzTransitionTime> m_tranTimes;
     QList<QTzTransitionRule> m_tranRules;
-    QList<QByteArray> m_abbreviations;
+    QList<QString> m_abbreviations;
     QByteArray m_posixRule;
     QTzTransitionRule m_preZoneRule;
     bool m_hasDst;
+    // m_tranTimes holds every transition up to this time, including those
+    // that the POSIX rule implies; only later ones need to be calculated.
+    qint64 m_tranTimesEnd = std::numeric_limits<qint64>::min();
 };
 
 class Q_AUTOTEST_EXPORT QTzTimeZonePrivate final : public QTimeZonePrivate
@@ -321,6 +324,7 @@ private:
 
     Data dataForTzTransition(QTzTransitionTime tran) const;
     Data dataFromRule(QTzTransitionRule rule, qint64 msecsSinceEpoch) const;
+    const QTzTransitionRule *ruleFromTransitions(qint64 msecsSinceEpoch) const;
 #if QT_CONFIG(icu)
 # ifdef __cpp_lib_is_final
     static_assert(std::is_final<QIcuTimeZonePrivate>::value,
@@ -330,7 +334,7 @@ private:
     mutable QExplicitlySharedDataPointer<const QIcuTimeZonePrivate> m_icu;
 #endif
     QTzTimeZoneCacheEntry cached_data;
-    QList<QTzTransitionTime> tranCache() const { return cached_data.m_tranTimes; }
+    const QList<QTzTransitionTime> &tranCache() const { return cached_data.m_tranTimes; }
 };
 #endif // Q_OS_UNIX
 
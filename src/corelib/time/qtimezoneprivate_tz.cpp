@@ -689,6 +689,76 @@ static QList<QTimeZonePrivate::Data> calculatePosixTransitions(const QByteArray
     return result;
 }
 
+/*
+    Most zones follow their POSIX rule for the present and the future, so that
+    every lookup of a current or future time would otherwise calculate the
+    transitions of three years from the rule. Instead, the transitions the rule
+    implies up to the end of PosixRuleHorizonYear are appended to the ones from
+    the file once, when the zone is loaded. Only later times still use the rule
+    directly.
+*/
+static constexpr int PosixRuleHorizonYear = 2100;
+
+static void expandPosixRule(QTzTimeZoneCacheEntry *entry)
+{
+    const qint64 lastTranMSecs = entry->m_tranTimes.last().atMSecsSinceEpoch;
+    const int startYear = QDateTime::fromMSecsSinceEpoch(lastTranMSecs, Qt::UTC).date().year();
+    if (startYear > PosixRuleHorizonYear)
+        return;
+    const QList<QTimeZonePrivate::Data> posixTrans =
+            calculatePosixTransitions(entry->m_posixRule, startYear, PosixRuleHorizonYear,
+                                      lastTranMSecs);
+    if (posixTrans.isEmpty()) // Malformed
+        return;
+
+    QList<QTzTransitionTime> tranTimes = entry->m_tranTimes;
+    QList<QTzTransitionRule> tranRules = entry->m_tranRules;
+    QList<QString> abbreviations = entry->m_abbreviations;
+    // Rule and abbreviation indices have to fit in a quint8:
+    constexpr qsizetype MaxIndex = std::numeric_limits<quint8>::max();
+    const auto ruleFor = [&](const QTimeZonePrivate::Data &data) -> qsizetype {
+        qsizetype abbreviationIndex = abbreviations.indexOf(data.abbreviation);
+        if (abbreviationIndex < 0) {
+            abbreviationIndex = abbreviations.size();
+            abbreviations.append(data.abbreviation);
+        }
+        if (abbreviationIndex > MaxIndex)
+            return -1;
+        const QTzTransitionRule rule = { data.standardTimeOffset, data.daylightTimeOffset,
+                                         quint8(abbreviationIndex) };
+        qsizetype ruleIndex = tranRules.indexOf(rule);
+        if (ruleIndex < 0) {
+            ruleIndex = tranRules.size();
+            tranRules.append(rule);
+        }
+        return ruleIndex > MaxIndex ? -1 : ruleIndex;
+    };
+
+    if (posixTrans.size() == 1 && posixTrans.first().atMSecsSinceEpoch == lastTranMSecs) {
+        // A rule without transitions; if it only continues the last
+        // transition's, the list of transitions describes all time.
+        if (ruleFor(posixTrans.first()) == tranTimes.last().ruleIndex)
+            entry->m_tranTimesEnd = std::numeric_limits<qint64>::max();
+        return;
+    }
+
+    for (const QTimeZonePrivate::Data &data : posixTrans) {
+        if (data.atMSecsSinceEpoch <= lastTranMSecs)
+            continue;
+        const qsizetype ruleIndex = ruleFor(data);
+        if (ruleIndex < 0)
+            return;
+        tranTimes.append({ data.atMSecsSinceEpoch, quint8(ruleIndex) });
+    }
+
+    entry->m_tranTimes = std::move(tranTimes);
+    entry->m_tranRules = std::move(tranRules);
+    entry->m_abbreviations = std::move(abbreviations);
+    // The transitions of the next year happen in it, by local time, but the
+    // time of day of a POSIX rule can be up to a week away from its date.
+    entry->m_tranTimesEnd = QDate(PosixRuleHorizonYear, 12, 1).startOfDay(Qt::UTC).toMSecsSinceEpoch();
+}
+
 // Create the system default time zone
 QTzTimeZonePrivate::QTzTimeZonePrivate()
     : QTzTimeZonePrivate(staticSystemTimeZoneId())
@@ -710,6 +780,11 @@ QTzTimeZonePrivate *QTzTimeZonePrivate::clone() const
 class QTzTimeZoneCache
 {
 public:
+    // Large enough for all the zones of a typical tzdata installation,
+    // including the aliases, so that programs using many zones don't keep
+    // loading them again
+    QTzTimeZoneCache() : m_cache(1024) {}
+
     QTzTimeZoneCacheEntry fetchEntry(const QByteArray &ianaId);
 
 private:
@@ -810,7 +885,7 @@ QTzTimeZoneCacheEntry QTzTimeZoneCache::findEntry(const QByteArray &ianaId)
     QList<int> abbrindList;
     abbrindList.reserve(size);
     for (auto it = abbrevMap.cbegin(), end = abbrevMap.cend(); it != end; ++it) {
-        ret.m_abbreviations.append(it.value());
+        ret.m_abbreviations.append(QString::fromUtf8(it.value()));
         abbrindList.append(it.key());
     }
     // Map tz_abbrind from map's keys (as initially read) to abbrindList's
@@ -904,6 +979,11 @@ QTzTimeZoneCacheEntry QTzTimeZoneCache::findEntry(const QByteArray &ianaId)
         ret.m_tranTimes.append(tran);
     }
 
+    if (!ret.m_tranTimes.isEmpty()) {
+        ret.m_tranTimesEnd = ret.m_tranTimes.last().atMSecsSinceEpoch;
+        if (!ret.m_posixRule.isEmpty())
+            expandPosixRule(&ret);
+    }
     return ret;
 }
 
@@ -1055,17 +1135,23 @@ QString QTzTimeZonePrivate::abbreviation(qint64 atMSecsSinceEpoch) const
 
 int QTzTimeZonePrivate::offsetFromUtc(qint64 atMSecsSinceEpoch) const
 {
+    if (const QTzTransitionRule *rule = ruleFromTransitions(atMSecsSinceEpoch))
+        return rule->stdOffset + rule->dstOffset;
     const QTimeZonePrivate::Data tran = data(atMSecsSinceEpoch);
     return tran.offsetFromUtc; // == tran.standardTimeOffset + tran.daylightTimeOffset
 }
 
 int QTzTimeZonePrivate::standardTimeOffset(qint64 atMSecsSinceEpoch) const
 {
+    if (const QTzTransitionRule *rule = ruleFromTransitions(atMSecsSinceEpoch))
+        return rule->stdOffset;
     return data(atMSecsSinceEpoch).standardTimeOffset;
 }
 
 int QTzTimeZonePrivate::daylightTimeOffset(qint64 atMSecsSinceEpoch) const
 {
+    if (const QTzTransitionRule *rule = ruleFromTransitions(atMSecsSinceEpoch))
+        return rule->dstOffset;
     return data(atMSecsSinceEpoch).daylightTimeOffset;
 }
 
@@ -1087,10 +1173,33 @@ QTimeZonePrivate::Data QTzTimeZonePrivate::dataForTzTransition(QTzTransitionTime
 QTimeZonePrivate::Data QTzTimeZonePrivate::dataFromRule(QTzTransitionRule rule,
                                                         qint64 msecsSinceEpoch) const
 {
-    return { QString::fromUtf8(cached_data.m_abbreviations.at(rule.abbreviationIndex)),
+    return { cached_data.m_abbreviations.at(rule.abbreviationIndex),
              msecsSinceEpoch, rule.stdOffset + rule.dstOffset, rule.stdOffset, rule.dstOffset };
 }
 
+// Whether the time is after the known transitions and has to be looked up
+// by applying the POSIX rule
+static bool needsPosixRule(const QTzTimeZoneCacheEntry &entry, qint64 msecsSinceEpoch)
+{
+    return !entry.m_posixRule.isEmpty()
+            && (entry.m_tranTimes.isEmpty() || entry.m_tranTimesEnd < msecsSinceEpoch);
+}
+
+// Returns the rule of the last transition at or before the given time, or
+// nullptr if the transitions don't tell, so that data() has to be used
+const QTzTransitionRule *QTzTimeZonePrivate::ruleFromTransitions(qint64 msecsSinceEpoch) const
+{
+    if (tranCache().isEmpty() || needsPosixRule(cached_data, msecsSinceEpoch))
+        return nullptr;
+    auto last = std::partition_point(tranCache().cbegin(), tranCache().cend(),
+                                     [msecsSinceEpoch] (const QTzTransitionTime &at) {
+                                         return at.atMSecsSinceEpoch <= msecsSinceEpoch;
+                                     });
+    if (last == tranCache().cbegin())
+        return &cached_data.m_preZoneRule;
+    return &cached_data.m_tranRules.at((last - 1)->ruleIndex);
+}
+
 QList<QTimeZonePrivate::Data> QTzTimeZonePrivate::getPosixTransitions(qint64 msNear) const
 {
     const int year = QDateTime::fromMSecsSinceEpoch(msNear, Qt::UTC).date().year();
@@ -1101,10 +1210,9 @@ QList<QTimeZonePrivate::Data> QTzTimeZonePrivate::getPosixTransitions(qint64 msN
 
 QTimeZonePrivate::Data QTzTimeZonePrivate::data(qint64 forMSecsSinceEpoch) const
 {
-    // If the required time is after the last transition (or there were none)
-    // and we have a POSIX rule, then use it:
-    if (!cached_data.m_posixRule.isEmpty()
-        && (tranCache().isEmpty() || tranCache().last().atMSecsSinceEpoch < forMSecsSinceEpoch)) {
+    // If the required time is after the known transitions (or there were
+    // none) and we have a POSIX rule, then use it:
+    if (needsPosixRule(cached_data, forMSecsSinceEpoch)) {
         QList<QTimeZonePrivate::Data> posixTrans = getPosixTransitions(forMSecsSinceEpoch);
         auto it = std::partition_point(posixTrans.cbegin(), posixTrans.cend(),
                                        [forMSecsSinceEpoch] (const QTimeZonePrivate::Data &at) {
@@ -1139,10 +1247,16 @@ bool QTzTimeZonePrivate::hasTransitions() const
 
 QTimeZonePrivate::Data QTzTimeZonePrivate::nextTransition(qint64 afterMSecsSinceEpoch) const
 {
-    // If the required time is after the last transition (or there were none)
-    // and we have a POSIX rule, then use it:
-    if (!cached_data.m_posixRule.isEmpty()
-        && (tranCache().isEmpty() || tranCache().last().atMSecsSinceEpoch < afterMSecsSinceEpoch)) {
+    // If the required time is after the known transitions (or there were
+    // none) and we have a POSIX rule, then use it; the same goes if none of
+    // them is later than it, but the rule may have more:
+    auto last = std::partition_point(tranCache().cbegin(), tranCache().cend(),
+                                     [afterMSecsSinceEpoch] (const QTzTransitionTime &at) {
+                                         return at.atMSecsSinceEpoch <= afterMSecsSinceEpoch;
+                                     });
+    if (needsPosixRule(cached_data, afterMSecsSinceEpoch)
+        || (last == tranCache().cend() && !cached_data.m_posixRule.isEmpty()
+            && cached_data.m_tranTimesEnd != std::numeric_limits<qint64>::max())) {
         QList<QTimeZonePrivate::Data> posixTrans = getPosixTransitions(afterMSecsSinceEpoch);
         auto it = std::partition_point(posixTrans.cbegin(), posixTrans.cend(),
                                        [afterMSecsSinceEpoch] (const QTimeZonePrivate::Data &at) {
@@ -1153,19 +1267,14 @@ QTimeZonePrivate::Data QTzTimeZonePrivate::nextTransition(qint64 afterMSecsSince
     }
 
     // Otherwise, if we can find a valid tran, use its rule:
-    auto last = std::partition_point(tranCache().cbegin(), tranCache().cend(),
-                                     [afterMSecsSinceEpoch] (const QTzTransitionTime &at) {
-                                         return at.atMSecsSinceEpoch <= afterMSecsSinceEpoch;
-                                     });
     return last != tranCache().cend() ? dataForTzTransition(*last) : invalidData();
 }
 
 QTimeZonePrivate::Data QTzTimeZonePrivate::previousTransition(qint64 beforeMSecsSinceEpoch) const
 {
-    // If the required time is after the last transition (or there were none)
-    // and we have a POSIX rule, then use it:
-    if (!cached_data.m_posixRule.isEmpty()
-        && (tranCache().isEmpty() || tranCache().last().atMSecsSinceEpoch < beforeMSecsSinceEpoch)) {
+    // If the required time is after the known transitions (or there were
+    // none) and we have a POSIX rule, then use it:
+    if (needsPosixRule(cached_data, beforeMSecsSinceEpoch)) {
         QList<QTimeZonePrivate::Data> posixTrans = getPosixTransitions(beforeMSecsSinceEpoch);
         auto it = std::partition_point(posixTrans.cbegin(), posixTrans.cend(),
                                        [beforeMSecsSinceEpoch] (const QTimeZonePrivate::Data &at) {
@@ -7,6 +7,7 @@
 #define QCRYPTOGRAPHICHASH_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qcontainerfwd.h>
 #include <QtCore/qobjectdefs.h>
 
 QT_BEGIN_NAMESPACE
@@ -59,6 +60,7 @@ public:
         Blake2s_160,
         Blake2s_224,
         Blake2s_256,
+        Blake3_256,
 #endif
     };
     Q_ENUM(Algorithm)
@@ -90,6 +92,8 @@ public:
     static QByteArray hash(const QByteArray &data, Algorithm method);
 #endif
     static QByteArray hash(QByteArrayView data, Algorithm method);
+    static QByteArray hashDevice(QIODevice *device, Algorithm method);
+    static QByteArrayList hashMany(const QList<QByteArrayView> &messages, Algorithm method);
     static int hashLength(Algorithm method);
 private:
     Q_DISABLE_COPY(QCryptographicHash)
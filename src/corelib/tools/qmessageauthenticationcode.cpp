@@ -56,6 +56,8 @@ static int qt_hash_block_size(QCryptographicHash::Algorithm method)
     case QCryptographicHash::Blake2s_224:
     case QCryptographicHash::Blake2s_256:
         return BLAKE2S_BLOCKBYTES;
+    case QCryptographicHash::Blake3_256:
+        return 64;
     }
     return 0;
 }
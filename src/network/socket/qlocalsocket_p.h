@@ -90,6 +90,7 @@ public:
     QLocalUnixSocket* tcpSocket;
     bool ownsTcpSocket;
     void setSocket(QLocalUnixSocket*);
+    QList<QByteArrayView> readableChunks() override;
     QString generateErrorString(QLocalSocket::LocalSocketError, const QString &function) const;
     void setErrorAndEmit(QLocalSocket::LocalSocketError, const QString &function);
     void _q_stateChanged(QAbstractSocket::SocketState newState);
@@ -108,6 +109,7 @@ public:
     QLocalSocket::LocalSocketError error;
 #else
     QLocalUnixSocket unixSocket;
+    QList<QByteArrayView> readableChunks() override;
     QString generateErrorString(QLocalSocket::LocalSocketError, const QString &function) const;
     void setErrorAndEmit(QLocalSocket::LocalSocketError, const QString &function);
     void _q_stateChanged(QAbstractSocket::SocketState newState);
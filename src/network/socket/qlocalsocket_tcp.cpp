@@ -258,6 +258,15 @@ qintptr QLocalSocket::socketDescriptor() const
     return d->tcpSocket->socketDescriptor();
 }
 
+QList<QByteArrayView> QLocalSocketPrivate::readableChunks()
+{
+    // Most of the data is still buffered by the underlying socket
+    QList<QByteArrayView> chunks = QIODevicePrivate::readableChunks();
+    if (tcpSocket->isReadable())
+        chunks.append(tcpSocket->readableChunks());
+    return chunks;
+}
+
 qint64 QLocalSocket::readData(char *data, qint64 c)
 {
     Q_D(QLocalSocket);
@@ -282,6 +291,10 @@ qint64 QLocalSocket::skipData(qint64 maxSize)
 qint64 QLocalSocket::writeData(const char *data, qint64 c)
 {
     Q_D(QLocalSocket);
+    // Pass on the chunk of write(const QByteArray &), so that the socket
+    // can queue it without copying.
+    if (d->isWriteChunkCached(data, c))
+        return d->tcpSocket->write(*d->currentWriteChunk);
     return d->tcpSocket->writeData(data, c);
 }
 
@@ -441,6 +441,15 @@ qintptr QLocalSocket::socketDescriptor() const
     return d->unixSocket.socketDescriptor();
 }
 
+QList<QByteArrayView> QLocalSocketPrivate::readableChunks()
+{
+    // Most of the data is still buffered by the underlying socket
+    QList<QByteArrayView> chunks = QIODevicePrivate::readableChunks();
+    if (unixSocket.isReadable())
+        chunks.append(unixSocket.readableChunks());
+    return chunks;
+}
+
 qint64 QLocalSocket::readData(char *data, qint64 c)
 {
     Q_D(QLocalSocket);
@@ -465,6 +474,10 @@ qint64 QLocalSocket::skipData(qint64 maxSize)
 qint64 QLocalSocket::writeData(const char *data, qint64 c)
 {
     Q_D(QLocalSocket);
+    // Pass on the chunk of write(const QByteArray &), so that the socket
+    // can queue it without copying.
+    if (d->isWriteChunkCached(data, c))
+        return d->unixSocket.write(*d->currentWriteChunk);
     return d->unixSocket.writeData(data, c);
 }
 
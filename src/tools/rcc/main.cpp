@@ -160,6 +160,15 @@ int runRcc(int argc, char *argv[])
     QCommandLineOption noZstdOption(QStringLiteral("no-zstd"), QStringLiteral("Disable usage of zstd compression."));
     parser.addOption(noZstdOption);
 
+    QCommandLineOption zstdFrameSizeOption(QStringLiteral("zstd-frame-size"), QStringLiteral("Compress files with zstd in independent frames of <size> bytes."), QStringLiteral("size"));
+    parser.addOption(zstdFrameSizeOption);
+
+    QCommandLineOption jobsOption(QStringList{QStringLiteral("j"), QStringLiteral("jobs")}, QStringLiteral("Compress input files using <count> threads (default: one per processor)."), QStringLiteral("count"));
+    parser.addOption(jobsOption);
+
+    QCommandLineOption cacheDirOption(QStringLiteral("cache-dir"), QStringLiteral("Reuse the compressed data of previous runs stored in <directory>."), QStringLiteral("directory"));
+    parser.addOption(cacheDirOption);
+
     QCommandLineOption thresholdOption(QStringLiteral("threshold"), QStringLiteral("Threshold to consider compressing files."), QStringLiteral("level"));
     parser.addOption(thresholdOption);
 
@@ -229,6 +238,24 @@ int runRcc(int argc, char *argv[])
         library.setCompressionAlgorithm(RCCResourceLibrary::parseCompressionAlgorithm(parser.value(compressionAlgoOption), &errorMsg));
     if (parser.isSet(noZstdOption))
         library.setNoZstd(true);
+    if (parser.isSet(zstdFrameSizeOption)) {
+        bool ok = false;
+        const qlonglong frameSize = parser.value(zstdFrameSizeOption).toLongLong(&ok);
+        if (!ok || frameSize <= 0)
+            errorMsg = "Invalid zstd frame size: "_L1 + parser.value(zstdFrameSizeOption);
+        else
+            library.setZstdFrameSize(frameSize);
+    }
+    if (parser.isSet(jobsOption)) {
+        bool ok = false;
+        const int jobs = parser.value(jobsOption).toInt(&ok);
+        if (!ok || jobs <= 0)
+            errorMsg = "Invalid number of jobs: "_L1 + parser.value(jobsOption);
+        else
+            library.setJobs(jobs);
+    }
+    if (parser.isSet(cacheDirOption))
+        library.setCacheDirectory(parser.value(cacheDirOption));
     if (library.compressionAlgorithm() == RCCResourceLibrary::CompressionAlgorithm::Zstd) {
         if (formatVersion < 3)
             errorMsg = "Zstandard compression requires format version 3 or higher"_L1;
@@ -5,6 +5,7 @@
 #include "rcc.h"
 
 #include <qbytearray.h>
+#include <qcryptographichash.h>
 #include <qdatetime.h>
 #include <qdebug.h>
 #include <qdir.h>
@@ -12,10 +13,16 @@
 #include <qfile.h>
 #include <qiodevice.h>
 #include <qlocale.h>
+#include <qsavefile.h>
+#include <qscopeguard.h>
 #include <qstack.h>
 #include <qxmlstream.h>
 
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #if QT_CONFIG(zstd)
 #  include <zstd.h>
@@ -63,6 +70,16 @@ static inline QString msgOpenReadFailed(const QString &fname, const QString &why
 //
 ///////////////////////////////////////////////////////////
 
+// State of the compressors, one per thread
+struct RCCCompressionContext
+{
+#if QT_CONFIG(zstd)
+    ZSTD_CCtx *zstdCCtx = nullptr;
+
+    ~RCCCompressionContext() { ZSTD_freeCCtx(zstdCCtx); }
+#endif
+};
+
 class RCCFileInfo
 {
 public:
@@ -88,7 +105,9 @@ public:
     QString resourceName() const;
 
 public:
-    qint64 writeDataBlob(RCCResourceLibrary &lib, qint64 offset, QString *errorMessage);
+    bool readData(QString *errorMessage);
+    void compressData(const RCCResourceLibrary &lib, RCCCompressionContext &context);
+    qint64 writeDataBlob(RCCResourceLibrary &lib, qint64 offset);
     qint64 writeDataName(RCCResourceLibrary &, qint64 offset);
     void writeDataInfo(RCCResourceLibrary &lib);
 
@@ -107,6 +126,11 @@ public:
     qint64 m_dataOffset;
     qint64 m_childOffset;
     bool m_noZstd;
+
+    QByteArray m_data;
+    QByteArray m_dataHash;      // of the uncompressed contents
+    QString m_compressionLog;
+    RCCFileInfo *m_sameDataAs;  // file with identical contents written earlier
 };
 
 RCCFileInfo::RCCFileInfo(const QString &name, const QFileInfo &fileInfo,
@@ -123,6 +147,7 @@ RCCFileInfo::RCCFileInfo(const QString &name, const QFileInfo &fileInfo,
     m_nameOffset = 0;
     m_dataOffset = 0;
     m_childOffset = 0;
+    m_sameDataAs = nullptr;
     m_compressAlgo = compressAlgo;
     m_compressLevel = compressLevel;
     m_compressThreshold = compressThreshold;
@@ -214,38 +239,41 @@ void RCCFileInfo::writeDataInfo(RCCResourceLibrary &lib)
     }
 }
 
-qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
-    QString *errorMessage)
+bool RCCFileInfo::readData(QString *errorMessage)
 {
-    const bool text = lib.m_format == RCCResourceLibrary::C_Code;
-    const bool pass1 = lib.m_format == RCCResourceLibrary::Pass1;
-    const bool pass2 = lib.m_format == RCCResourceLibrary::Pass2;
-    const bool binary = lib.m_format == RCCResourceLibrary::Binary;
-    const bool python = lib.m_format == RCCResourceLibrary::Python_Code;
-
-    //capture the offset
-    m_dataOffset = offset;
-
-    //find the data to be written
     QFile file(m_fileInfo.absoluteFilePath());
     if (!file.open(QFile::ReadOnly)) {
         *errorMessage = msgOpenReadFailed(m_fileInfo.absoluteFilePath(), file.errorString());
-        return 0;
+        return false;
     }
-    QByteArray data = file.readAll();
+    m_data = file.readAll();
+    return true;
+}
 
+// Runs in worker threads: notes are collected in m_compressionLog, so that
+// they are printed in the same order as without threads.
+void RCCFileInfo::compressData(const RCCResourceLibrary &lib, RCCCompressionContext &context)
+{
+#if !QT_CONFIG(zstd)
+    Q_UNUSED(context);
+#endif
     // Check if compression is useful for this file
-    if (data.size() != 0) {
+    if (m_data.size() != 0) {
 #if QT_CONFIG(zstd)
         if (m_compressAlgo == RCCResourceLibrary::CompressionAlgorithm::Best && !m_noZstd) {
             m_compressAlgo = RCCResourceLibrary::CompressionAlgorithm::Zstd;
             m_compressLevel = 19;   // not ZSTD_maxCLevel(), as 20+ are experimental
         }
         if (m_compressAlgo == RCCResourceLibrary::CompressionAlgorithm::Zstd && !m_noZstd) {
-            if (lib.m_zstdCCtx == nullptr)
-                lib.m_zstdCCtx = ZSTD_createCCtx();
-            qsizetype size = data.size();
-            size = ZSTD_COMPRESSBOUND(size);
+            if (context.zstdCCtx == nullptr)
+                context.zstdCCtx = ZSTD_createCCtx();
+            // Store big files as a sequence of independent frames if asked
+            // to, so that QFile can decompress only the parts that are read.
+            const qsizetype frameSize = lib.m_zstdFrameSize > 0 ? lib.m_zstdFrameSize
+                                                                : m_data.size();
+            qsizetype size = 0;
+            for (qsizetype pos = 0; pos < m_data.size(); pos += frameSize)
+                size += ZSTD_COMPRESSBOUND(qMin(frameSize, m_data.size() - pos));
 
             int compressLevel = m_compressLevel;
             if (compressLevel < 0)
@@ -253,34 +281,38 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
 
             QByteArray compressed(size, Qt::Uninitialized);
             char *dst = const_cast<char *>(compressed.constData());
-            size_t n = ZSTD_compressCCtx(lib.m_zstdCCtx, dst, size,
-                                         data.constData(), data.size(),
-                                         compressLevel);
-            if (n * 100.0 < data.size() * 1.0 * (100 - m_compressThreshold) ) {
+            auto compress = [&](int level) {
+                size_t total = 0;
+                for (qsizetype pos = 0; pos < m_data.size(); pos += frameSize) {
+                    size_t n = ZSTD_compressCCtx(context.zstdCCtx, dst + total, size - total,
+                                                 m_data.constData() + pos,
+                                                 qMin(frameSize, m_data.size() - pos), level);
+                    if (ZSTD_isError(n))
+                        return n;
+                    total += n;
+                }
+                return total;
+            };
+            size_t n = compress(compressLevel);
+            if (n * 100.0 < m_data.size() * 1.0 * (100 - m_compressThreshold) ) {
                 // compressing is worth it
                 if (m_compressLevel < 0) {
                     // heuristic compression, so recompress
-                    n = ZSTD_compressCCtx(lib.m_zstdCCtx, dst, size,
-                                          data.constData(), data.size(),
-                                          CONSTANT_ZSTDCOMPRESSLEVEL_STORE);
+                    n = compress(CONSTANT_ZSTDCOMPRESSLEVEL_STORE);
                 }
                 if (ZSTD_isError(n)) {
-                    QString msg = QString::fromLatin1("%1: error: compression with zstd failed: %2\n")
+                    m_compressionLog += QString::fromLatin1("%1: error: compression with zstd failed: %2\n")
                             .arg(m_name, QString::fromUtf8(ZSTD_getErrorName(n)));
-                    lib.m_errorDevice->write(msg.toUtf8());
                 } else if (lib.verbose()) {
-                    QString msg = QString::fromLatin1("%1: note: compressed using zstd (%2 -> %3)\n")
-                            .arg(m_name).arg(data.size()).arg(n);
-                    lib.m_errorDevice->write(msg.toUtf8());
+                    m_compressionLog += QString::fromLatin1("%1: note: compressed using zstd (%2 -> %3)\n")
+                            .arg(m_name).arg(m_data.size()).arg(n);
                 }
 
-                lib.m_overallFlags |= CompressedZstd;
                 m_flags |= CompressedZstd;
-                data = std::move(compressed);
-                data.truncate(n);
+                m_data = std::move(compressed);
+                m_data.truncate(n);
             } else if (lib.verbose()) {
-                QString msg = QString::fromLatin1("%1: note: not compressed\n").arg(m_name);
-                lib.m_errorDevice->write(msg.toUtf8());
+                m_compressionLog += QString::fromLatin1("%1: note: not compressed\n").arg(m_name);
             }
         }
 #endif
@@ -291,25 +323,35 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
         }
         if (m_compressAlgo == RCCResourceLibrary::CompressionAlgorithm::Zlib) {
             QByteArray compressed =
-                    qCompress(reinterpret_cast<uchar *>(data.data()), data.size(), m_compressLevel);
+                    qCompress(reinterpret_cast<uchar *>(m_data.data()), m_data.size(), m_compressLevel);
 
-            int compressRatio = int(100.0 * (data.size() - compressed.size()) / data.size());
+            int compressRatio = int(100.0 * (m_data.size() - compressed.size()) / m_data.size());
             if (compressRatio >= m_compressThreshold) {
                 if (lib.verbose()) {
-                    QString msg = QString::fromLatin1("%1: note: compressed using zlib (%2 -> %3)\n")
-                            .arg(m_name).arg(data.size()).arg(compressed.size());
-                    lib.m_errorDevice->write(msg.toUtf8());
+                    m_compressionLog += QString::fromLatin1("%1: note: compressed using zlib (%2 -> %3)\n")
+                            .arg(m_name).arg(m_data.size()).arg(compressed.size());
                 }
-                data = compressed;
-                lib.m_overallFlags |= Compressed;
+                m_data = compressed;
                 m_flags |= Compressed;
             } else if (lib.verbose()) {
-                QString msg = QString::fromLatin1("%1: note: not compressed\n").arg(m_name);
-                lib.m_errorDevice->write(msg.toUtf8());
+                m_compressionLog += QString::fromLatin1("%1: note: not compressed\n").arg(m_name);
             }
         }
 #endif // QT_NO_COMPRESS
     }
+}
+
+qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset)
+{
+    const bool text = lib.m_format == RCCResourceLibrary::C_Code;
+    const bool pass1 = lib.m_format == RCCResourceLibrary::Pass1;
+    const bool pass2 = lib.m_format == RCCResourceLibrary::Pass2;
+    const bool binary = lib.m_format == RCCResourceLibrary::Binary;
+    const bool python = lib.m_format == RCCResourceLibrary::Python_Code;
+
+    //capture the offset
+    m_dataOffset = offset;
+    const QByteArray data = std::exchange(m_data, QByteArray());
 
     // some info
     if (text || pass1) {
@@ -441,20 +483,16 @@ RCCResourceLibrary::RCCResourceLibrary(quint8 formatVersion)
     m_errorDevice(nullptr),
     m_outDevice(nullptr),
     m_formatVersion(formatVersion),
-    m_noZstd(false)
+    m_noZstd(false),
+    m_zstdFrameSize(0),
+    m_jobs(0)
 {
     m_out.reserve(30 * 1000 * 1000);
-#if QT_CONFIG(zstd)
-    m_zstdCCtx = nullptr;
-#endif
 }
 
 RCCResourceLibrary::~RCCResourceLibrary()
 {
     delete m_root;
-#if QT_CONFIG(zstd)
-    ZSTD_freeCCtx(m_zstdCCtx);
-#endif
 }
 
 enum RCCXmlTag {
@@ -1092,6 +1130,121 @@ bool RCCResourceLibrary::writeHeader()
     return true;
 }
 
+namespace {
+struct RCCDataKey
+{
+    QByteArray dataHash;
+    RCCResourceLibrary::CompressionAlgorithm compressAlgo;
+    int compressLevel;
+    int compressThreshold;
+    bool noZstd;
+
+    friend bool operator==(const RCCDataKey &lhs, const RCCDataKey &rhs) noexcept
+    {
+        return lhs.compressAlgo == rhs.compressAlgo && lhs.compressLevel == rhs.compressLevel
+                && lhs.compressThreshold == rhs.compressThreshold && lhs.noZstd == rhs.noZstd
+                && lhs.dataHash == rhs.dataHash;
+    }
+    friend size_t qHash(const RCCDataKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, key.dataHash, int(key.compressAlgo), key.compressLevel,
+                          key.compressThreshold, key.noZstd);
+    }
+};
+} // unnamed namespace
+
+QString RCCResourceLibrary::cachedDataPath(const RCCFileInfo *file) const
+{
+    // Everything that affects the compressed payload, including the tool and
+    // library versions, so that entries written by an older rcc are not reused
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    QByteArray settings = QByteArray::number(int(file->m_compressAlgo)) + ' '
+            + QByteArray::number(file->m_compressLevel) + ' '
+            + QByteArray::number(file->m_compressThreshold) + ' '
+            + QByteArray::number(file->m_noZstd) + ' '
+            + QByteArray::number(m_zstdFrameSize) + ' '
+            + QByteArray::number(m_formatVersion) + ' '
+            + QByteArray(QT_VERSION_STR);
+#if QT_CONFIG(zstd)
+    settings += ' ' + QByteArray::number(ZSTD_versionNumber());
+#endif
+    settings += '\n';
+    hash.addData(settings);
+    hash.addData(file->m_dataHash);
+    return m_cacheDirectory + u'/' + QString::fromLatin1(hash.result().toHex());
+}
+
+/*
+    Finds the files in \a files with the same contents and compression
+    settings as an earlier one, which share its data. Only the hashes of the
+    contents are kept, so that no more than one file is in memory at a time.
+*/
+bool RCCResourceLibrary::findSharedData(const QList<RCCFileInfo *> &files,
+                                        QString *errorMessage)
+{
+    QHash<RCCDataKey, RCCFileInfo *> uniqueFiles;
+    for (RCCFileInfo *file : files) {
+        QFile input(file->m_fileInfo.absoluteFilePath());
+        if (!input.open(QFile::ReadOnly)) {
+            *errorMessage = msgOpenReadFailed(file->m_fileInfo.absoluteFilePath(),
+                                              input.errorString());
+            return false;
+        }
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        hash.addData(&input);
+        file->m_dataHash = hash.result();
+
+        const RCCDataKey key = { file->m_dataHash, file->m_compressAlgo, file->m_compressLevel,
+                                 file->m_compressThreshold, file->m_noZstd };
+        if (RCCFileInfo *original = uniqueFiles.value(key))
+            file->m_sameDataAs = original;
+        else
+            uniqueFiles.insert(key, file);
+    }
+    return true;
+}
+
+/*
+    Reads the data of \a file from the cache directory, or reads and
+    compresses its contents and stores the result in the cache. Runs in
+    worker threads.
+*/
+bool RCCResourceLibrary::prepareDataBlob(RCCFileInfo *file, RCCCompressionContext &context,
+                                         QString *errorMessage) const
+{
+    QString path;
+    if (!m_cacheDirectory.isEmpty()) {
+        path = cachedDataPath(file);
+        QFile cached(path);
+        if (cached.open(QIODevice::ReadOnly)) {
+            char flags;
+            if (cached.getChar(&flags)) {
+                file->m_data = cached.readAll();
+                file->m_flags |= quint8(flags);
+                if (m_verbose) {
+                    file->m_compressionLog = QString::fromLatin1("%1: note: read from cache\n")
+                            .arg(file->m_name);
+                }
+                return true;
+            }
+        }
+    }
+
+    if (!file->readData(errorMessage))
+        return false;
+    file->compressData(*this, context);
+
+    if (!path.isEmpty()) {
+        QSaveFile cached(path);
+        if (cached.open(QIODevice::WriteOnly)) {
+            cached.putChar(char(file->m_flags & (RCCFileInfo::Compressed | RCCFileInfo::CompressedZstd)));
+            cached.write(file->m_data);
+            cached.commit();
+        }
+    }
+    return true;
+}
+
 bool RCCResourceLibrary::writeDataBlobs()
 {
     Q_ASSERT(m_errorDevice);
@@ -1112,24 +1265,107 @@ bool RCCResourceLibrary::writeDataBlobs()
     if (!m_root)
         return false;
 
+    QList<RCCFileInfo *> files;
     QStack<RCCFileInfo*> pending;
     pending.push(m_root);
-    qint64 offset = 0;
-    QString errorMessage;
     while (!pending.isEmpty()) {
         RCCFileInfo *file = pending.pop();
         for (auto it = file->m_children.cbegin(); it != file->m_children.cend(); ++it) {
             RCCFileInfo *child = it.value();
             if (child->m_flags & RCCFileInfo::Directory)
                 pending.push(child);
-            else {
-                offset = child->writeDataBlob(*this, offset, &errorMessage);
-                if (offset == 0) {
-                    m_errorDevice->write(errorMessage.toUtf8());
-                    return false;
-                }
-            }
+            else
+                files.append(child);
+        }
+    }
+
+    QString errorMessage;
+    if (!findSharedData(files, &errorMessage)) {
+        m_errorDevice->write(errorMessage.toUtf8());
+        return false;
+    }
+    if (!m_cacheDirectory.isEmpty())
+        QDir().mkpath(m_cacheDirectory);
+    QList<RCCFileInfo *> uniqueFiles;
+    for (RCCFileInfo *file : std::as_const(files)) {
+        if (!file->m_sameDataAs)
+            uniqueFiles.append(file);
+    }
+
+    // Compression is the expensive part: worker threads prepare the blobs,
+    // while this thread writes them in order and releases their data. The
+    // workers stay at most a few blobs ahead, which bounds the memory used,
+    // and the output does not depend on the number of threads.
+    const int jobs = m_jobs > 0 ? m_jobs : int(std::thread::hardware_concurrency());
+    const qsizetype threadCount = qBound(qsizetype(1), qsizetype(jobs), uniqueFiles.size());
+    const qsizetype window = 2 * threadCount;
+    std::mutex mutex;
+    std::condition_variable condition;
+    qsizetype next = 0;
+    qsizetype written = 0;
+    bool stop = false;
+    std::vector<signed char> prepared(uniqueFiles.size());
+    std::vector<QString> errors(uniqueFiles.size());
+
+    auto prepare = [&] {
+        RCCCompressionContext context;
+        std::unique_lock lock(mutex);
+        for (;;) {
+            condition.wait(lock, [&] {
+                return stop || next == uniqueFiles.size() || next < written + window;
+            });
+            if (stop || next == uniqueFiles.size())
+                return;
+            const qsizetype i = next++;
+            lock.unlock();
+            const bool ok = prepareDataBlob(uniqueFiles.at(i), context, &errors[i]);
+            lock.lock();
+            prepared[i] = ok ? 1 : -1;
+            condition.notify_all();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (qsizetype i = 0; i < threadCount; ++i)
+        threads.emplace_back(prepare);
+    const auto joinThreads = qScopeGuard([&] {
+        {
+            std::lock_guard lock(mutex);
+            stop = true;
+        }
+        condition.notify_all();
+        for (std::thread &thread : threads)
+            thread.join();
+    });
+
+    qint64 offset = 0;
+    for (RCCFileInfo *file : std::as_const(files)) {
+        if (RCCFileInfo *original = file->m_sameDataAs) {
+            file->m_dataOffset = original->m_dataOffset;
+            file->m_flags |= original->m_flags
+                    & (RCCFileInfo::Compressed | RCCFileInfo::CompressedZstd);
+            continue;
+        }
+
+        bool ok;
+        {
+            std::unique_lock lock(mutex);
+            condition.wait(lock, [&] { return prepared[written] != 0; });
+            ok = prepared[written] > 0;
+        }
+        if (!ok) {
+            m_errorDevice->write(errors[written].toUtf8());
+            return false;
+        }
+        m_errorDevice->write(file->m_compressionLog.toUtf8());
+        file->m_compressionLog.clear();
+        m_overallFlags |= file->m_flags & (RCCFileInfo::Compressed | RCCFileInfo::CompressedZstd);
+        offset = file->writeDataBlob(*this, offset);
+
+        {
+            std::lock_guard lock(mutex);
+            ++written;
         }
+        condition.notify_all();
     }
     switch (m_format) {
     case C_Code:
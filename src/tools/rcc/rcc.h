@@ -11,11 +11,10 @@
 #include <qhash.h>
 #include <qstring.h>
 
-typedef struct ZSTD_CCtx_s ZSTD_CCtx;
-
 QT_BEGIN_NAMESPACE
 
 class RCCFileInfo;
+struct RCCCompressionContext;
 class QIODevice;
 class QTextStream;
 
@@ -87,6 +86,15 @@ public:
     void setNoZstd(bool v) { m_noZstd = v; }
     bool noZstd() const { return m_noZstd; }
 
+    void setZstdFrameSize(qsizetype size) { m_zstdFrameSize = size; }
+    qsizetype zstdFrameSize() const { return m_zstdFrameSize; }
+
+    void setJobs(int jobs) { m_jobs = jobs; }
+    int jobs() const { return m_jobs; }
+
+    void setCacheDirectory(const QString &directory) { m_cacheDirectory = directory; }
+    QString cacheDirectory() const { return m_cacheDirectory; }
+
 private:
     struct Strings {
         Strings();
@@ -106,6 +114,10 @@ private:
     bool interpretResourceFile(QIODevice *inputDevice, const QString &file,
         QString currentPath = QString(), bool listMode = false);
     bool writeHeader();
+    QString cachedDataPath(const RCCFileInfo *file) const;
+    bool findSharedData(const QList<RCCFileInfo *> &files, QString *errorMessage);
+    bool prepareDataBlob(RCCFileInfo *file, RCCCompressionContext &context,
+                         QString *errorMessage) const;
     bool writeDataBlobs();
     bool writeDataNames();
     bool writeDataStructure();
@@ -123,10 +135,6 @@ private:
     void write(const char *, int len);
     void writeString(const char *s) { write(s, static_cast<int>(strlen(s))); }
 
-#if QT_CONFIG(zstd)
-    ZSTD_CCtx *m_zstdCCtx;
-#endif
-
     const Strings m_strings;
     RCCFileInfo *m_root;
     QStringList m_fileNames;
@@ -149,6 +157,9 @@ private:
     QByteArray m_out;
     quint8 m_formatVersion;
     bool m_noZstd;
+    qsizetype m_zstdFrameSize;
+    int m_jobs;
+    QString m_cacheDirectory;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,210 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtConcurrent/qtaskgraph.h>
+
+#include <QTest>
+#include <QMutex>
+#include <QSemaphore>
+#include <QThreadPool>
+
+using namespace QtConcurrent;
+
+class tst_QTaskGraph : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void emptyGraph();
+    void independentTasks();
+    void dependencies();
+    void diamond();
+    void invalidDependency();
+    void cycle();
+    void implicitSharing();
+    void cancel();
+#ifndef QT_NO_EXCEPTIONS
+    void exception();
+#endif
+};
+
+void tst_QTaskGraph::emptyGraph()
+{
+    QTaskGraph graph;
+    QVERIFY(graph.isEmpty());
+    QCOMPARE(graph.size(), 0);
+
+    QFuture<void> future = graph.run();
+    QVERIFY(future.isFinished());
+    QVERIFY(!future.isCanceled());
+}
+
+void tst_QTaskGraph::independentTasks()
+{
+    QTaskGraph graph;
+    QAtomicInt counter;
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(graph.addTask([&counter] { counter.ref(); }), i);
+    QCOMPARE(graph.size(), 100);
+
+    QThreadPool pool;
+    graph.run(&pool).waitForFinished();
+    QCOMPARE(counter.loadRelaxed(), 100);
+
+    // a graph can be run several times
+    graph.run(&pool).waitForFinished();
+    QCOMPARE(counter.loadRelaxed(), 200);
+}
+
+void tst_QTaskGraph::dependencies()
+{
+    QMutex mutex;
+    QList<int> order;
+    auto record = [&](int i) {
+        return [&, i] {
+            QMutexLocker locker(&mutex);
+            order.append(i);
+        };
+    };
+
+    // 0 -> 1 -> 2 -> 3, declared in reverse order
+    QTaskGraph graph;
+    const auto t3 = graph.addTask(record(3));
+    const auto t2 = graph.addTask(record(2));
+    const auto t1 = graph.addTask(record(1));
+    const auto t0 = graph.addTask(record(0));
+    QVERIFY(graph.addDependency(t3, t2));
+    QVERIFY(graph.addDependency(t2, t1));
+    QVERIFY(graph.addDependency(t1, t0));
+
+    QThreadPool pool;
+    QFuture<void> future = graph.run(&pool);
+    future.waitForFinished();
+    QVERIFY(!future.isCanceled());
+    QCOMPARE(order, QList<int>({ 0, 1, 2, 3 }));
+}
+
+void tst_QTaskGraph::diamond()
+{
+    QAtomicInt top, left, right;
+    bool bottomSawAll = false;
+
+    QTaskGraph graph;
+    const auto tTop = graph.addTask([&] { top.storeRelease(1); });
+    const auto tLeft = graph.addTask([&] { left.storeRelease(top.loadAcquire()); });
+    const auto tRight = graph.addTask([&] { right.storeRelease(top.loadAcquire()); }, 10);
+    const auto tBottom = graph.addTask([&] {
+        bottomSawAll = left.loadAcquire() && right.loadAcquire();
+    });
+    graph.addDependency(tLeft, tTop);
+    graph.addDependency(tRight, tTop);
+    graph.addDependency(tBottom, tLeft);
+    graph.addDependency(tBottom, tRight);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    graph.run(&pool).waitForFinished();
+    QVERIFY(bottomSawAll);
+}
+
+void tst_QTaskGraph::invalidDependency()
+{
+    QTaskGraph graph;
+    const auto task = graph.addTask([] {});
+
+    QTest::ignoreMessage(QtWarningMsg, "QTaskGraph::addDependency: Invalid tasks 0 and 0");
+    QVERIFY(!graph.addDependency(task, task));
+    QTest::ignoreMessage(QtWarningMsg, "QTaskGraph::addDependency: Invalid tasks 0 and 1");
+    QVERIFY(!graph.addDependency(task, 1));
+    QTest::ignoreMessage(QtWarningMsg, "QTaskGraph::addDependency: Invalid tasks -1 and 0");
+    QVERIFY(!graph.addDependency(-1, task));
+}
+
+void tst_QTaskGraph::cycle()
+{
+    bool ran = false;
+    QTaskGraph graph;
+    const auto a = graph.addTask([&ran] { ran = true; });
+    const auto b = graph.addTask([&ran] { ran = true; });
+    const auto c = graph.addTask([&ran] { ran = true; });
+    graph.addDependency(b, a);
+    graph.addDependency(c, b);
+    graph.addDependency(a, c);
+
+    QTest::ignoreMessage(QtWarningMsg, "QTaskGraph::run: The graph has a cycle");
+    QFuture<void> future = graph.run();
+    QVERIFY(future.isCanceled());
+    QVERIFY(!ran);
+}
+
+void tst_QTaskGraph::implicitSharing()
+{
+    QAtomicInt counter;
+    QTaskGraph graph;
+    graph.addTask([&counter] { counter.ref(); });
+
+    QTaskGraph copy = graph;
+    copy.addTask([&counter] { counter.ref(); });
+    QCOMPARE(graph.size(), 1);
+    QCOMPARE(copy.size(), 2);
+
+    QThreadPool pool;
+    graph.run(&pool).waitForFinished();
+    QCOMPARE(counter.loadRelaxed(), 1);
+    copy.run(&pool).waitForFinished();
+    QCOMPARE(counter.loadRelaxed(), 3);
+
+    QTaskGraph moved = std::move(copy);
+    QCOMPARE(moved.size(), 2);
+    moved.swap(graph);
+    QCOMPARE(graph.size(), 2);
+    QCOMPARE(moved.size(), 1);
+}
+
+void tst_QTaskGraph::cancel()
+{
+    QSemaphore started;
+    QSemaphore release;
+    bool dependentRan = false;
+
+    QTaskGraph graph;
+    const auto first = graph.addTask([&] {
+        started.release();
+        release.acquire();
+    });
+    const auto second = graph.addTask([&dependentRan] { dependentRan = true; });
+    graph.addDependency(second, first);
+
+    QThreadPool pool;
+    QFuture<void> future = graph.run(&pool);
+    started.acquire();
+    future.cancel();
+    release.release();
+    future.waitForFinished();
+    pool.waitForDone();
+
+    QVERIFY(future.isCanceled());
+    QVERIFY(!dependentRan);
+}
+
+#ifndef QT_NO_EXCEPTIONS
+void tst_QTaskGraph::exception()
+{
+    bool dependentRan = false;
+
+    QTaskGraph graph;
+    const auto first = graph.addTask([] { throw QException(); });
+    const auto second = graph.addTask([&dependentRan] { dependentRan = true; });
+    graph.addDependency(second, first);
+
+    QThreadPool pool;
+    QFuture<void> future = graph.run(&pool);
+    QVERIFY_THROWS_EXCEPTION(QException, future.waitForFinished());
+    pool.waitForDone();
+    QVERIFY(future.isCanceled());
+    QVERIFY(!dependentRan);
+}
+#endif
+
+QTEST_MAIN(tst_QTaskGraph)
+#include "tst_qtaskgraph.moc"
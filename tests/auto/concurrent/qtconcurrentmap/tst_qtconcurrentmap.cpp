@@ -10,6 +10,8 @@
 #include <QSet>
 #include <QRandomGenerator>
 
+#include <numeric>
+
 #include "../testhelper_functions.h"
 
 class tst_QtConcurrentMap : public QObject
@@ -31,6 +33,8 @@ private slots:
     void mappedReducedInitialValueWithMoveOnlyCallable();
     void mappedReducedDifferentTypeInitialValue();
     void mappedReduceOptionConvertableToResultType();
+    void mapBlocks();
+    void mappedReducedBlocks();
     void assignResult();
     void functionOverloads();
     void noExceptFunctionOverloads();
@@ -1651,6 +1655,80 @@ void tst_QtConcurrentMap::mappedReduceOptionConvertableToResultType()
                                                       multiplyBy2, intSumReduce, ro), sum);
 }
 
+void tst_QtConcurrentMap::mapBlocks()
+{
+    QList<int> list(1000);
+    std::iota(list.begin(), list.end(), 0);
+    QThreadPool pool;
+
+    QMutex mutex;
+    QList<qsizetype> blockSizes;
+    auto multiplyBlock = [&](QList<int>::iterator begin, QList<int>::iterator end) {
+        for (auto it = begin; it != end; ++it)
+            *it *= 2;
+        QMutexLocker locker(&mutex);
+        blockSizes.append(end - begin);
+    };
+
+    // fixed grain size
+    QtConcurrent::blockingMapBlocks(&pool, list, multiplyBlock, 64);
+    QCOMPARE(blockSizes.size(), 16);
+    QCOMPARE(std::count(blockSizes.cbegin(), blockSizes.cend(), 64), 15);
+    QVERIFY(blockSizes.contains(1000 % 64));
+    for (int i = 0; i < list.size(); ++i)
+        QCOMPARE(list.at(i), i * 2);
+
+    // adaptive grain size
+    blockSizes.clear();
+    QtConcurrent::mapBlocks(list.begin(), list.end(), multiplyBlock).waitForFinished();
+    QCOMPARE(std::accumulate(blockSizes.cbegin(), blockSizes.cend(), qsizetype(0)), 1000);
+    for (int i = 0; i < list.size(); ++i)
+        QCOMPARE(list.at(i), i * 4);
+
+    // empty range
+    QList<int> empty;
+    QtConcurrent::blockingMapBlocks(empty, [](auto, auto) { QFAIL("unexpected call"); });
+}
+
+void tst_QtConcurrentMap::mappedReducedBlocks()
+{
+    QList<int> list(10000);
+    std::iota(list.begin(), list.end(), 1);
+    const qint64 expected = qint64(10000) * 10001 / 2;
+    QThreadPool pool;
+
+    auto sumBlock = [](QList<int>::const_iterator begin, QList<int>::const_iterator end) {
+        return std::accumulate(begin, end, qint64(0));
+    };
+    auto sumReduce = [](qint64 &result, qint64 partial) { result += partial; };
+
+    QCOMPARE(QtConcurrent::blockingMappedReducedBlocks(&pool, list.cbegin(), list.cend(),
+                                                       sumBlock, sumReduce, 100),
+             expected);
+    QCOMPARE(QtConcurrent::blockingMappedReducedBlocks(list.cbegin(), list.cend(), sumBlock,
+                                                       sumReduce),
+             expected);
+    QCOMPARE(QtConcurrent::mappedReducedBlocks(&pool, list.cbegin(), list.cend(), sumBlock,
+                                               sumReduce, 1).result(),
+             expected);
+
+    // a product has no neutral default value; the first block starts each accumulator
+    const QList<int> factors { 2, 3, 5, 7, 11 };
+    auto productBlock = [](QList<int>::const_iterator begin, QList<int>::const_iterator end) {
+        return std::accumulate(begin, end, qint64(1), std::multiplies<>());
+    };
+    auto productReduce = [](qint64 &result, qint64 partial) { result *= partial; };
+    QCOMPARE(QtConcurrent::blockingMappedReducedBlocks(&pool, factors.cbegin(), factors.cend(),
+                                                       productBlock, productReduce, 1),
+             qint64(2310));
+
+    // empty range
+    const QList<int> empty;
+    QCOMPARE(QtConcurrent::blockingMappedReducedBlocks(empty.cbegin(), empty.cend(), sumBlock,
+                                                       sumReduce),
+             qint64(0));
+}
+
 int sleeper(int val)
 {
     QTest::qSleep(100);
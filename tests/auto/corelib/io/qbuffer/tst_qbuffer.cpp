@@ -37,6 +37,7 @@ private slots:
     void readLineBoundaries();
     void getAndUngetChar();
     void writeAfterQByteArrayResize();
+    void writeSharesLargeChunks();
     void writeOfMoreThan2GiB();
     void read_null();
 
@@ -602,6 +603,29 @@ void tst_QBuffer::writeAfterQByteArrayResize()
     QCOMPARE(buffer.buffer().size(), 1000);
 }
 
+void tst_QBuffer::writeSharesLargeChunks()
+{
+    const QByteArray data(64 * 1024, 'a');
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::ReadWrite));
+    QCOMPARE(buffer.write(data), qint64(data.size()));
+    QCOMPARE(buffer.pos(), qint64(data.size()));
+    // written into an empty buffer, so no copy was needed
+    QCOMPARE(buffer.buffer().constData(), data.constData());
+
+    // further writes must not modify the original chunk
+    QCOMPARE(buffer.write(data), qint64(data.size()));
+    QCOMPARE(buffer.size(), qint64(2 * data.size()));
+    QCOMPARE(data, QByteArray(64 * 1024, 'a'));
+
+    buffer.seek(data.size() / 2);
+    const QList<QByteArrayView> chunks = buffer.readableChunks();
+    QCOMPARE(chunks.size(), 1);
+    QCOMPARE(qint64(chunks.first().size()), buffer.size() - buffer.pos());
+    QCOMPARE(chunks.first().data(), buffer.buffer().constData() + buffer.pos());
+}
+
 void tst_QBuffer::writeOfMoreThan2GiB()
 {
     if constexpr (sizeof(void*) == 4)
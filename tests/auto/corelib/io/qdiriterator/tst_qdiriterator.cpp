@@ -11,6 +11,12 @@
 #include <qstringlist.h>
 #include <QSet>
 #include <QString>
+#if QT_CONFIG(future)
+#include <QFuture>
+#include <QSemaphore>
+#include <QTemporaryDir>
+#include <QThreadPool>
+#endif
 
 #include <QtCore/private/qfsfileengine_p.h>
 
@@ -89,6 +95,13 @@ private slots:
 #ifndef Q_OS_WIN
     void hiddenDirs_hiddenFiles();
 #endif
+#if QT_CONFIG(future)
+    void walkParallel_data();
+    void walkParallel();
+    void walkParallelTree();
+    void walkParallelLinkLoop();
+    void walkParallelCancel();
+#endif
 #ifdef BUILTIN_TESTDATA
 private:
     QSharedPointer<QTemporaryDir> m_dataDir;
@@ -614,6 +627,144 @@ void tst_QDirIterator::hiddenDirs_hiddenFiles()
 }
 #endif // Q_OS_WIN
 
+#if QT_CONFIG(future)
+static QStringList sequentialWalk(const QString &path, const QStringList &nameFilters,
+                                  QDir::Filters filters, QDirIterator::IteratorFlags flags)
+{
+    QStringList list;
+    QDirIterator it(path, nameFilters, filters, flags | QDirIterator::Subdirectories);
+    while (it.hasNext())
+        list << it.next();
+    list.sort();
+    return list;
+}
+
+static QStringList parallelWalk(const QString &path, const QStringList &nameFilters,
+                                QDir::Filters filters, QDirIterator::IteratorFlags flags,
+                                QThreadPool *pool = nullptr)
+{
+    QFuture<QFileInfoList> future =
+            QDirIterator::walkParallel(path, nameFilters, filters, flags, pool);
+    QStringList list;
+    for (const QFileInfoList &batch : future.results()) {
+        for (const QFileInfo &info : batch)
+            list << info.filePath();
+    }
+    list.sort();
+    return list;
+}
+
+void tst_QDirIterator::walkParallel_data()
+{
+    iterateRelativeDirectory_data();
+
+    QTest::newRow("resources")
+        << QString(":/testdata") << QDirIterator::IteratorFlags{}
+        << QDir::Filters(QDir::NoFilter) << QStringList("*") << QStringList();
+    QTest::newRow("name filters")
+        << QString("recursiveDirs") << QDirIterator::IteratorFlags{}
+        << QDir::Filters(QDir::Files) << QStringList("*.txt") << QStringList();
+    QTest::newRow("name filters, AllDirs")
+        << QString("recursiveDirs") << QDirIterator::IteratorFlags{}
+        << QDir::Filters(QDir::Files | QDir::AllDirs) << QStringList("*.html") << QStringList();
+#ifndef Q_OS_WIN
+    QTest::newRow("hidden")
+        << QString("hiddenDirs_hiddenFiles") << QDirIterator::IteratorFlags{}
+        << QDir::Filters(QDir::AllEntries | QDir::Hidden | QDir::NoDotAndDotDot)
+        << QStringList("*") << QStringList();
+    QTest::newRow("not hidden")
+        << QString("hiddenDirs_hiddenFiles") << QDirIterator::IteratorFlags{}
+        << QDir::Filters(QDir::AllEntries | QDir::NoDotAndDotDot)
+        << QStringList("*") << QStringList();
+#endif
+}
+
+void tst_QDirIterator::walkParallel()
+{
+    QFETCH(QString, dirName);
+    QFETCH(QDirIterator::IteratorFlags, flags);
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QStringList, nameFilters);
+
+    // The walk lists what a recursive QDirIterator would, in any order
+    const QStringList expected = sequentialWalk(dirName, nameFilters, filters, flags);
+    QCOMPARE(parallelWalk(dirName, nameFilters, filters, flags), expected);
+}
+
+void tst_QDirIterator::walkParallelTree()
+{
+    QTemporaryDir tree;
+    QVERIFY2(tree.isValid(), qPrintable(tree.errorString()));
+    QDir root(tree.path());
+    for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            const QString dirName = QString("%1/%2").arg(i).arg(j);
+            QVERIFY(root.mkpath(dirName));
+            for (int k = 0; k < 4; ++k) {
+                QFile file(root.filePath(dirName + "/file" + QString::number(k)));
+                QVERIFY(file.open(QIODevice::WriteOnly));
+            }
+        }
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(2);
+    const QDir::Filters filters = QDir::AllEntries | QDir::NoDotAndDotDot;
+    const QStringList expected = sequentialWalk(tree.path(), {}, filters, {});
+    QCOMPARE(expected.size(), 8 + 8 * 8 + 8 * 8 * 4);
+    QCOMPARE(parallelWalk(tree.path(), {}, filters, {}, &pool), expected);
+    QCOMPARE(parallelWalk(tree.path(), {}, QDir::Files, {}, &pool),
+             sequentialWalk(tree.path(), {}, QDir::Files, {}));
+}
+
+void tst_QDirIterator::walkParallelLinkLoop()
+{
+#if defined(Q_NO_SYMLINKS) || defined(Q_OS_WIN)
+    QSKIP("Test requires symlinks to directories");
+#else
+    QTemporaryDir tree;
+    QVERIFY2(tree.isValid(), qPrintable(tree.errorString()));
+    QDir root(tree.path());
+    QVERIFY(root.mkpath("a/b"));
+    QVERIFY(QFile::link("..", root.filePath("a/b/up.lnk")));
+    QVERIFY(QFile::link(".", root.filePath("a/self.lnk")));
+    QVERIFY(QFile::link(root.filePath("a"), root.filePath("a/b/absolute.lnk")));
+
+    const QDir::Filters filters = QDir::AllEntries | QDir::NoDotAndDotDot;
+    const QDirIterator::IteratorFlags flags = QDirIterator::FollowSymlinks;
+    const QStringList list = parallelWalk(tree.path(), {}, filters, flags);
+    QVERIFY(!list.isEmpty());
+    QVERIFY(list.size() < 100);
+    QCOMPARE(list.size(), sequentialWalk(tree.path(), {}, filters, flags).size());
+#endif
+}
+
+void tst_QDirIterator::walkParallelCancel()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+
+    // Keep the only thread of the pool busy, so that the walk cannot start
+    QSemaphore started;
+    QSemaphore release;
+    pool.start([&] {
+        started.release();
+        release.acquire();
+    });
+    started.acquire();
+
+    QFuture<QFileInfoList> future = QDirIterator::walkParallel("entrylist", QDir::NoFilter,
+                                                               {}, &pool);
+    QVERIFY(future.isRunning());
+    future.cancel();
+    release.release();
+
+    future.waitForFinished();
+    QVERIFY(future.isCanceled());
+    QCOMPARE(future.resultCount(), 0);
+}
+#endif
+
 QTEST_MAIN(tst_QDirIterator)
 
 #include "tst_qdiriterator.moc"
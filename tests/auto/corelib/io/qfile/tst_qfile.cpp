@@ -18,10 +18,17 @@
 #include <QOperatingSystemVersion>
 #include <QStorageInfo>
 #include <QScopeGuard>
+#if QT_CONFIG(future)
+#include <QFuture>
+#endif
 
 #include <private/qabstractfileengine_p.h>
 #include <private/qfsfileengine_p.h>
 #include <private/qfilesystemengine_p.h>
+#if QT_CONFIG(future)
+#include <private/qfileasyncio_p.h>
+#include <system_error>
+#endif
 
 #ifdef Q_OS_WIN
 #include <QtCore/private/qfunctions_win_p.h>
@@ -278,6 +285,13 @@ private slots:
 
     void stdfilesystem();
 
+#if QT_CONFIG(future)
+    void readWriteAsync();
+    void readWriteAsyncConcurrent();
+    void readWriteAsyncInvalid();
+    void readWriteAsyncErrors();
+#endif
+
 private:
 #ifdef BUILTIN_TESTDATA
     QSharedPointer<QTemporaryDir> m_dataDir;
@@ -3981,5 +3995,122 @@ void tst_QFile::stdfilesystem()
 #endif
 }
 
+#if QT_CONFIG(future)
+void tst_QFile::readWriteAsync()
+{
+    QFile file("readWriteAsync.txt");
+    QVERIFY2(file.open(QIODevice::ReadWrite | QIODevice::Truncate), msgOpenFailed(file).constData());
+
+    // buffered data is flushed before the asynchronous write
+    QCOMPARE(file.write("0123456789"), 10);
+    QFuture<qint64> written = file.writeAsync(10, "abcdefghij");
+    QCOMPARE(written.result(), 10);
+    QVERIFY(!written.isCanceled());
+    QCOMPARE(file.pos(), 10);
+
+    QCOMPARE(file.readAsync(0, 20).result(), QByteArray("0123456789abcdefghij"));
+    QCOMPARE(file.readAsync(5, 10).result(), QByteArray("56789abcde"));
+
+    // short read at the end of the file
+    QCOMPARE(file.readAsync(15, 100).result(), QByteArray("fghij"));
+    QFuture<QByteArray> pastEnd = file.readAsync(100, 10);
+    QCOMPARE(pastEnd.result(), QByteArray());
+    QVERIFY(!pastEnd.isCanceled());
+    // only what exists is allocated
+    const QByteArray huge = file.readAsync(0, qint64(1) << 30).result();
+    QCOMPARE(huge, QByteArray("0123456789abcdefghij"));
+    QVERIFY(huge.capacity() < 4096);
+    QCOMPARE(file.readAsync(0, 0).result(), QByteArray());
+
+    // the file can be closed while a read is in flight
+    QFuture<QByteArray> afterClose = file.readAsync(0, 4);
+    file.close();
+    QCOMPARE(afterClose.result(), QByteArray("0123"));
+
+    // continuation in the context of an object
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QObject context;
+    QByteArray received;
+    file.readAsync(2, 3).then(&context, [&](const QByteArray &data) { received = data; });
+    QTRY_COMPARE(received, QByteArray("234"));
+}
+
+void tst_QFile::readWriteAsyncConcurrent()
+{
+    QFile file("readWriteAsyncConcurrent.bin");
+    QVERIFY2(file.open(QIODevice::ReadWrite | QIODevice::Truncate), msgOpenFailed(file).constData());
+
+    const int blockCount = 512;
+    const int blockSize = 4096;
+    QList<QFuture<qint64>> writes;
+    for (int i = 0; i < blockCount; ++i)
+        writes.append(file.writeAsync(qint64(i) * blockSize, QByteArray(blockSize, char('a' + i % 26))));
+    for (QFuture<qint64> &write : writes)
+        QCOMPARE(write.result(), blockSize);
+    QCOMPARE(file.size(), qint64(blockCount) * blockSize);
+
+    QList<QFuture<QByteArray>> reads;
+    for (int i = 0; i < blockCount; ++i)
+        reads.append(file.readAsync(qint64(i) * blockSize, blockSize));
+    for (int i = 0; i < blockCount; ++i)
+        QCOMPARE(reads[i].result(), QByteArray(blockSize, char('a' + i % 26)));
+}
+
+void tst_QFile::readWriteAsyncInvalid()
+{
+    QFile file("readWriteAsyncInvalid.txt");
+
+    QTest::ignoreMessage(QtWarningMsg, "QFile::readAsync: File (readWriteAsyncInvalid.txt) "
+                                       "is not open for reading, or is sequential");
+    QVERIFY(file.readAsync(0, 10).isCanceled());
+
+    QVERIFY2(file.open(QIODevice::WriteOnly), msgOpenFailed(file).constData());
+    QTest::ignoreMessage(QtWarningMsg, "QFile::readAsync: File (readWriteAsyncInvalid.txt) "
+                                       "is not open for reading, or is sequential");
+    QVERIFY(file.readAsync(0, 10).isCanceled());
+    QTest::ignoreMessage(QtWarningMsg, "QFile::writeAsync: Called with a negative offset");
+    QVERIFY(file.writeAsync(-1, "x").isCanceled());
+    file.close();
+
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QTest::ignoreMessage(QtWarningMsg, "QFile::writeAsync: File (readWriteAsyncInvalid.txt) "
+                                       "is not open for writing, or is sequential");
+    QVERIFY(file.writeAsync(0, "x").isCanceled());
+    QTest::ignoreMessage(QtWarningMsg, "QFile::readAsync: Called with a negative offset or size");
+    QVERIFY(file.readAsync(0, -1).isCanceled());
+}
+
+void tst_QFile::readWriteAsyncErrors()
+{
+#if !defined(Q_OS_UNIX) || defined(QT_NO_EXCEPTIONS) || !defined(QT_BUILD_INTERNAL)
+    QSKIP("This test needs file descriptors, exceptions and a developer build");
+#else
+    const auto errorOf = [](auto future) {
+        try {
+            future.waitForFinished();
+        } catch (const std::system_error &e) {
+            return e.code().value();
+        }
+        return 0;
+    };
+
+    // a failed read is not merely canceled, it carries the error
+    const int dir = qt_safe_open(".", O_RDONLY);
+    QVERIFY(dir >= 0);
+    QCOMPARE(errorOf(QFileAsyncIo::read(dir, QString(), 0, 10)), EISDIR);
+
+    QFile file("readWriteAsyncErrors.txt");
+    QVERIFY2(file.open(QIODevice::WriteOnly), msgOpenFailed(file).constData());
+    file.close();
+    const int readOnly = qt_safe_open("readWriteAsyncErrors.txt", O_RDONLY);
+    QVERIFY(readOnly >= 0);
+    QCOMPARE(errorOf(QFileAsyncIo::write(readOnly, QString(), 0, "x")), EBADF);
+
+    // files opened again by name report their errors too
+    QVERIFY(errorOf(QFileAsyncIo::read(-1, "nonexistent-file.txt", 0, 10)) != 0);
+#endif
+}
+#endif // QT_CONFIG(future)
+
 QTEST_MAIN(tst_QFile)
 #include "tst_qfile.moc"
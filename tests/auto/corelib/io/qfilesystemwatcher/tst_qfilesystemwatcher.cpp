@@ -9,11 +9,13 @@
 #include <QElapsedTimer>
 #include <QTextStream>
 #include <QMap>
+#include <QSet>
 #include <QString>
 #include <QDir>
 #include <QSignalSpy>
 #include <QTimer>
 #include <QTemporaryFile>
+#include <QScopeGuard>
 #if defined(Q_OS_WIN)
 #include <qt_windows.h>
 #endif
@@ -70,6 +72,13 @@ private slots:
     void watchDirectoryAttributeChanges();
 #endif
 
+    void recursiveWatch();
+    void recursiveWatchNewDirectories();
+    void recursiveWatchRenamedDirectory();
+    void recursiveWatchDebounce();
+    void recursiveWatchRemove();
+    void recursiveWatchUncleanRoot();
+
 private:
     QString m_tempDirPattern;
 };
@@ -825,5 +834,201 @@ void tst_QFileSystemWatcher::watchDirectoryAttributeChanges()
 }
 #endif
 
+static QSet<QString> changedPaths(const QSignalSpy &spy)
+{
+    QSet<QString> paths;
+    for (const QList<QVariant> &arguments : spy) {
+        const QStringList changes = arguments.at(0).toStringList();
+        paths.unite(QSet<QString>(changes.cbegin(), changes.cend()));
+    }
+    return paths;
+}
+
+void tst_QFileSystemWatcher::recursiveWatch()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+    QDir testDir(temporaryDirectory.path());
+    QVERIFY(testDir.mkpath("a/b/c"));
+    QVERIFY(testDir.mkpath(".hidden/d"));
+
+    QFileSystemWatcher watcher;
+    if (!watcher.addRecursivePath(testDir.path()))
+        QSKIP("Watching directory trees is not supported on this platform");
+    QCOMPARE(watcher.recursiveDirectories(), QStringList(testDir.path()));
+    QVERIFY(watcher.directories().isEmpty());
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::pathsChanged);
+
+    // Adding the same tree twice fails, like for addPath()
+    QVERIFY(!watcher.addRecursivePath(testDir.path()));
+
+    const QString deepFile = testDir.filePath("a/b/c/file");
+    const QString hiddenFile = testDir.filePath(".hidden/d/file");
+    for (const QString &path : { deepFile, hiddenFile }) {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("data");
+    }
+    QTRY_VERIFY(changedPaths(changedSpy).contains(deepFile));
+    QTRY_VERIFY(changedPaths(changedSpy).contains(hiddenFile));
+
+    changedSpy.clear();
+    QVERIFY(QFile::remove(deepFile));
+    QTRY_VERIFY(changedPaths(changedSpy).contains(deepFile));
+}
+
+void tst_QFileSystemWatcher::recursiveWatchNewDirectories()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+    QDir testDir(temporaryDirectory.path());
+
+    QFileSystemWatcher watcher;
+    if (!watcher.addRecursivePath(testDir.path()))
+        QSKIP("Watching directory trees is not supported on this platform");
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::pathsChanged);
+
+    // The entries of a new tree are reported, even those created before
+    // its directories were watched
+    QVERIFY(testDir.mkpath("new/sub"));
+    QFile early(testDir.filePath("new/sub/early"));
+    QVERIFY(early.open(QIODevice::WriteOnly));
+    early.close();
+    QTRY_VERIFY(changedPaths(changedSpy).contains(testDir.filePath("new/sub/early")));
+    QVERIFY(changedPaths(changedSpy).contains(testDir.filePath("new")));
+
+    // ...and the new directories are watched from then on
+    changedSpy.clear();
+    QFile late(testDir.filePath("new/sub/late"));
+    QVERIFY(late.open(QIODevice::WriteOnly));
+    late.close();
+    QTRY_VERIFY(changedPaths(changedSpy).contains(late.fileName()));
+}
+
+void tst_QFileSystemWatcher::recursiveWatchRenamedDirectory()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+    QDir testDir(temporaryDirectory.path());
+    QVERIFY(testDir.mkpath("before/sub"));
+
+    QFileSystemWatcher watcher;
+    if (!watcher.addRecursivePath(testDir.path()))
+        QSKIP("Watching directory trees is not supported on this platform");
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::pathsChanged);
+
+    QVERIFY(testDir.rename("before", "after"));
+    QTRY_VERIFY(changedPaths(changedSpy).contains(testDir.filePath("after/sub")));
+    QVERIFY(changedPaths(changedSpy).contains(testDir.filePath("before")));
+
+    // Changes are reported with the new paths
+    changedSpy.clear();
+    QFile file(testDir.filePath("after/sub/file"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+    QTRY_VERIFY(changedPaths(changedSpy).contains(file.fileName()));
+    QVERIFY(!changedPaths(changedSpy).contains(testDir.filePath("before/sub/file")));
+}
+
+void tst_QFileSystemWatcher::recursiveWatchDebounce()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+    QDir testDir(temporaryDirectory.path());
+    QVERIFY(testDir.mkpath("sub"));
+
+    QFileSystemWatcher watcher;
+    QCOMPARE(watcher.debounceInterval(), 0);
+    watcher.setDebounceInterval(500);
+    QCOMPARE(watcher.debounceInterval(), 500);
+    if (!watcher.addRecursivePath(testDir.path()))
+        QSKIP("Watching directory trees is not supported on this platform");
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::pathsChanged);
+
+    QStringList expected;
+    for (int i = 0; i < 10; ++i) {
+        QFile file(testDir.filePath("sub/file" + QString::number(i)));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("data");
+        file.close();
+        QCoreApplication::processEvents();
+        expected << file.fileName();
+    }
+
+    QTRY_COMPARE(changedSpy.size(), 1);
+    const QStringList changes = changedSpy.at(0).at(0).toStringList();
+    for (const QString &path : std::as_const(expected))
+        QVERIFY(changes.contains(path));
+    // Each path is reported once per batch
+    QCOMPARE(QSet<QString>(changes.cbegin(), changes.cend()).size(), changes.size());
+}
+
+void tst_QFileSystemWatcher::recursiveWatchRemove()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+    QDir testDir(temporaryDirectory.path());
+    QVERIFY(testDir.mkpath("watched/sub"));
+    const QString watchedPath = testDir.filePath("watched");
+
+    QFileSystemWatcher watcher;
+    if (!watcher.addRecursivePath(watchedPath))
+        QSKIP("Watching directory trees is not supported on this platform");
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::pathsChanged);
+
+    QVERIFY(watcher.removeRecursivePath(watchedPath));
+    QVERIFY(!watcher.removeRecursivePath(watchedPath));
+    QVERIFY(watcher.recursiveDirectories().isEmpty());
+    QFile file(testDir.filePath("watched/sub/file"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+    QTest::qWait(200);
+    QCOMPARE(changedSpy.size(), 0);
+
+    // A tree that is removed from disk is not watched anymore
+    QVERIFY(watcher.addRecursivePath(watchedPath));
+    QVERIFY(QDir(watchedPath).removeRecursively());
+    QTRY_VERIFY(watcher.recursiveDirectories().isEmpty());
+    QVERIFY(changedPaths(changedSpy).contains(watchedPath));
+}
+
+void tst_QFileSystemWatcher::recursiveWatchUncleanRoot()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+    QDir testDir(temporaryDirectory.path());
+    QVERIFY(testDir.mkpath("watched/sub"));
+    const QString watchedPath = testDir.filePath("watched");
+
+    // A root with a trailing slash is stored, and matched, without it
+    QFileSystemWatcher watcher;
+    if (!watcher.addRecursivePath(watchedPath + u'/'))
+        QSKIP("Watching directory trees is not supported on this platform");
+    QCOMPARE(watcher.recursiveDirectories(), QStringList(watchedPath));
+    QVERIFY(!watcher.addRecursivePath(watchedPath));
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::pathsChanged);
+
+    QFile file(testDir.filePath("watched/sub/file"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+    QTRY_VERIFY(changedPaths(changedSpy).contains(file.fileName()));
+    QVERIFY(watcher.removeRecursivePath(testDir.filePath("watched/sub/..")));
+    QVERIFY(watcher.recursiveDirectories().isEmpty());
+
+    // A relative root is made absolute
+    const QString oldCurrent = QDir::currentPath();
+    auto restoreCurrent = qScopeGuard([&oldCurrent] { QDir::setCurrent(oldCurrent); });
+    QVERIFY(QDir::setCurrent(testDir.path()));
+    // the current path may differ from testDir's by symbolic links
+    const QString absolutePath = QDir::current().filePath("watched");
+    QVERIFY(watcher.addRecursivePath("watched/"));
+    QCOMPARE(watcher.recursiveDirectories(), QStringList(absolutePath));
+    changedSpy.clear();
+    QVERIFY(QFile::remove(file.fileName()));
+    QTRY_VERIFY(changedPaths(changedSpy).contains(absolutePath + "/sub/file"));
+    QVERIFY(watcher.removeRecursivePath("./watched"));
+    QVERIFY(watcher.recursiveDirectories().isEmpty());
+}
+
 QTEST_MAIN(tst_QFileSystemWatcher)
 #include "tst_qfilesystemwatcher.moc"
@@ -34,6 +34,9 @@ private slots:
     void skip();
     void skipAfterPeek_data();
     void skipAfterPeek();
+    void readableChunks_data();
+    void readableChunks();
+    void readableChunksInTransaction();
 
     void transaction_data();
     void transaction();
@@ -711,6 +714,85 @@ void tst_QIODevice::skipAfterPeek()
     QCOMPARE(readSoFar, data.size());
 }
 
+void tst_QIODevice::readableChunks_data()
+{
+    QTest::addColumn<bool>("sequential");
+    QTest::addColumn<QByteArray>("data");
+
+    QByteArray bigData;
+    for (int i = 0; i < 2000; ++i)
+        bigData += "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    QTest::newRow("sequential") << true << bigData;
+    QTest::newRow("random-access") << false << bigData;
+}
+
+void tst_QIODevice::readableChunks()
+{
+    QFETCH(bool, sequential);
+    QFETCH(QByteArray, data);
+
+    QScopedPointer<QIODevice> dev(sequential ? (QIODevice *) new SequentialReadBuffer(&data)
+                                             : (QIODevice *) new QBuffer(&data));
+    QVERIFY(dev->open(QIODevice::ReadOnly));
+
+    // Sequential devices only return what has been buffered already
+    if (sequential) {
+        QVERIFY(dev->readableChunks().isEmpty());
+        QCOMPARE(dev->consume(10), qint64(0));
+    }
+
+    qsizetype readSoFar = 0;
+    forever {
+        QList<QByteArrayView> chunks = dev->readableChunks();
+        if (chunks.isEmpty()) {
+            char c;
+            if (!dev->getChar(&c))
+                break;
+            QCOMPARE(c, data.at(readSoFar));
+            ++readSoFar;
+            continue;
+        }
+
+        qsizetype available = 0;
+        for (QByteArrayView chunk : std::as_const(chunks)) {
+            QVERIFY(!chunk.isEmpty());
+            QCOMPARE(chunk.toByteArray(), data.sliced(readSoFar + available, chunk.size()));
+            available += chunk.size();
+        }
+
+        // never consumes more than what was returned
+        const qint64 toConsume = qMax(available / 2, qsizetype(1));
+        QCOMPARE(dev->consume(toConsume), toConsume);
+        readSoFar += toConsume;
+        QCOMPARE(dev->consume(available * 2), qint64(available - toConsume));
+        readSoFar += available - toConsume;
+    }
+    QCOMPARE(readSoFar, data.size());
+    QVERIFY(dev->atEnd());
+}
+
+void tst_QIODevice::readableChunksInTransaction()
+{
+    SequentialReadBuffer dev("Hello world!");
+    QVERIFY(dev.open(QIODevice::ReadOnly));
+
+    dev.startTransaction();
+    QCOMPARE(dev.read(6), QByteArray("Hello "));
+    QList<QByteArrayView> chunks = dev.readableChunks();
+    QCOMPARE(chunks.size(), 1);
+    QCOMPARE(chunks.first().toByteArray(), QByteArray("world!"));
+    QCOMPARE(dev.consume(5), qint64(5));
+    chunks = dev.readableChunks();
+    QCOMPARE(chunks.size(), 1);
+    QCOMPARE(chunks.first().toByteArray(), QByteArray("!"));
+
+    dev.rollbackTransaction();
+    chunks = dev.readableChunks();
+    QCOMPARE(chunks.size(), 1);
+    QCOMPARE(chunks.first().toByteArray(), QByteArray("Hello world!"));
+}
+
 void tst_QIODevice::transaction_data()
 {
     QTest::addColumn<bool>("sequential");
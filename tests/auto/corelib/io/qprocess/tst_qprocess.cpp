@@ -43,6 +43,7 @@ private slots:
     void constructing();
     void simpleStart();
     void setChildProcessModifier();
+    void childProcessModifierDoesNotShareMemory();
     void startCommand();
     void startWithOpen();
     void startWithOldOpen();
@@ -288,6 +289,23 @@ void tst_QProcess::setChildProcessModifier()
 #endif
 }
 
+void tst_QProcess::childProcessModifierDoesNotShareMemory()
+{
+#ifdef Q_OS_UNIX
+    // the modifier must run in a forked child, not in a vfork()ed one
+    int value = 0;
+    QProcess process;
+    process.setChildProcessModifier([&value]() { value = 1; });
+    process.start("testProcessNormal/testProcessNormal");
+    QVERIFY2(process.waitForStarted(5000), qPrintable(process.errorString()));
+    QVERIFY2(process.waitForFinished(5000), qPrintable(process.errorString()));
+    QCOMPARE(process.exitCode(), 0);
+    QCOMPARE(value, 0);
+#else
+    QSKIP("Unix-only test");
+#endif
+}
+
 void tst_QProcess::startCommand()
 {
     QProcess process;
@@ -32,6 +32,7 @@ private slots:
     void checkUnregisterResource();
     void compressedResource_data();
     void compressedResource();
+    void uncompressedDataCache();
     void checkStructure_data();
     void checkStructure();
     void searchPath_data();
@@ -95,6 +96,8 @@ void tst_QResourceEngine::compressedResource_data()
             << QFINDTESTDATA("zlib.rcc") << int(QResource::ZlibCompression) << true;
     QTest::newRow("zstd")
             << QFINDTESTDATA("zstd.rcc") << int(QResource::ZstdCompression) << QT_CONFIG(zstd);
+    QTest::newRow("zstd-frames")
+            << QFINDTESTDATA("zstd-frames.rcc") << int(QResource::ZstdCompression) << QT_CONFIG(zstd);
 }
 
 // Note: generateResource.sh parses this line. Make sure it's a simple number.
@@ -149,6 +152,53 @@ void tst_QResourceEngine::compressedResource()
     data = f.readAll();
     QCOMPARE(data.size(), expectedData.size());
     QCOMPARE(data, expectedData);
+
+    // partial reads
+    QVERIFY(f.seek(ZERO_FILE_LEN / 2 - 10));
+    data = f.read(20);
+    QCOMPARE(data, expectedData.mid(ZERO_FILE_LEN / 2 - 10, 20));
+    QVERIFY(f.seek(10));
+    data = f.read(ZERO_FILE_LEN);
+    QCOMPARE(data, expectedData.mid(10));
+}
+
+void tst_QResourceEngine::uncompressedDataCache()
+{
+    const QString fileName = QFINDTESTDATA("zlib.rcc");
+    QVERIFY(QResource::registerResource(fileName));
+    auto cleanup = qScopeGuard([=] {
+        QResource::setUncompressedDataCacheLimit(0);
+        QResource::unregisterResource(fileName);
+    });
+
+    QResource resource("zero.txt");
+    QVERIFY(resource.isValid());
+    QCOMPARE(QResource::uncompressedDataCacheLimit(), 0);
+
+    // disabled by default
+    QByteArray first = resource.uncompressedData();
+    QByteArray second = resource.uncompressedData();
+    QCOMPARE(first, QByteArray(ZERO_FILE_LEN, '\0'));
+    QVERIFY(first.constData() != second.constData());
+
+    QResource::setUncompressedDataCacheLimit(ZERO_FILE_LEN);
+    QCOMPARE(QResource::uncompressedDataCacheLimit(), ZERO_FILE_LEN);
+    first = resource.uncompressedData();
+    second = resource.uncompressedData();
+    QCOMPARE(first, QByteArray(ZERO_FILE_LEN, '\0'));
+    QCOMPARE(static_cast<const void *>(second.constData()),
+             static_cast<const void *>(first.constData()));
+
+    QFile f(":/zero.txt");
+    QVERIFY(f.open(QIODevice::ReadOnly));
+    QCOMPARE(f.readAll(), first);
+
+    // lowering the limit evicts the data that does not fit anymore
+    QResource::setUncompressedDataCacheLimit(ZERO_FILE_LEN - 1);
+    first = resource.uncompressedData();
+    second = resource.uncompressedData();
+    QCOMPARE(second, first);
+    QVERIFY(first.constData() != second.constData());
 }
 
 
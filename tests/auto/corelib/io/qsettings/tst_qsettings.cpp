@@ -140,6 +140,7 @@ private slots:
     void setPath();
     void setDefaultFormat();
     void dontCreateNeedlessPaths();
+    void largeIniFile();
 #if !defined(Q_OS_WIN) && !defined(QT_QSETTINGS_ALWAYS_CASE_SENSITIVE_AND_FORGET_ORIGINAL_KEY_ORDER)
     void dontReorderIniKeysNeedlessly();
 #endif
@@ -3357,6 +3358,62 @@ void tst_QSettings::dontCreateNeedlessPaths()
     QVERIFY(!fileInfo.dir().exists());
 }
 
+void tst_QSettings::largeIniFile()
+{
+    // Many sections, most of which are never parsed
+    QByteArray contents = "[General]\nversion=2\n";
+    for (int i = 0; i < 2000; ++i) {
+        contents += "[group" + QByteArray::number(i) + "]\n"
+                    "name=group " + QByteArray::number(i) + "\n"
+                    "value=" + QByteArray(32, 'a' + i % 26) + "\n";
+    }
+    contents += "[empty]\n; no keys\n";
+
+    QTemporaryDir tempDir;
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    const QString fileName = tempDir.filePath("large.ini");
+    {
+        QFile file(fileName);
+        QVERIFY2(file.open(QIODevice::WriteOnly), qPrintable(file.errorString()));
+        QCOMPARE(file.write(contents), qint64(contents.size()));
+    }
+
+    {
+        QSettings settings(fileName, QSettings::IniFormat);
+        QCOMPARE(settings.status(), QSettings::NoError);
+        QCOMPARE(settings.childKeys(), QStringList("version"));
+        const QStringList groups = settings.childGroups();
+        QCOMPARE(groups.size(), 2000);
+        QVERIFY(groups.contains("group1999"));
+        QVERIFY(!groups.contains("empty"));
+        QCOMPARE(settings.value("group1234/name").toString(), QString("group 1234"));
+        QCOMPARE(settings.value("group25/value").toByteArray(), QByteArray(32, 'z'));
+
+        // Reading one key does not lose the other keys of its section
+        settings.beginGroup("group1234");
+        QCOMPARE(settings.childKeys(), (QStringList{"name", "value"}));
+        settings.endGroup();
+        settings.remove("group1234/value");
+        QVERIFY(!settings.contains("group1234/value"));
+        QVERIFY(settings.contains("group1234/name"));
+
+        settings.setValue("group7/name", "seven");
+        settings.remove("group8");
+        settings.sync();
+        QCOMPARE(settings.status(), QSettings::NoError);
+        QCOMPARE(settings.value("group9/name").toString(), QString("group 9"));
+    }
+
+    QSettings settings(fileName, QSettings::IniFormat);
+    QCOMPARE(settings.value("version").toInt(), 2);
+    QCOMPARE(settings.value("group7/name").toString(), QString("seven"));
+    QVERIFY(!settings.contains("group8/name"));
+    QCOMPARE(settings.value("group1999/name").toString(), QString("group 1999"));
+    QVERIFY(!settings.contains("group1234/value"));
+    QCOMPARE(settings.value("group1234/name").toString(), QString("group 1234"));
+    QCOMPARE(settings.allKeys().size(), 1 + 2 * 1999 - 1);
+}
+
 #if !defined(Q_OS_WIN) && !defined(QT_QSETTINGS_ALWAYS_CASE_SENSITIVE_AND_FORGET_ORIGINAL_KEY_ORDER)
 // This Qt build does not preserve ordering, as a code size optimization.
 void tst_QSettings::dontReorderIniKeysNeedlessly()
@@ -145,6 +145,7 @@ private slots:
     void functorReferencesConnection();
     void disconnectDisconnects();
     void singleShotConnection();
+    void coalescedConnection();
     void objectNameBinding();
     void emitToDestroyedClass();
     void declarativeData();
@@ -8139,6 +8140,124 @@ void tst_QObject::singleShotConnection()
     }
 }
 
+void tst_QObject::coalescedConnection()
+{
+    {
+        // Queued calls through the same connection are merged, the latest arguments win
+        QObject sender;
+        QObject receiver;
+        QStringList names;
+        QVERIFY(connect(&sender, &QObject::objectNameChanged, &receiver,
+                        [&](const QString &name) { names << name; },
+                        Qt::ConnectionType(Qt::QueuedConnection | Qt::CoalescedConnection)));
+
+        sender.setObjectName("a");
+        sender.setObjectName("b");
+        sender.setObjectName("c");
+        QVERIFY(names.isEmpty());
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        QCOMPARE(names, QStringList{"c"});
+
+        // a delivered call is not updated anymore
+        sender.setObjectName("d");
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        sender.setObjectName("e");
+        sender.setObjectName("f");
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        QCOMPARE(names, (QStringList{"c", "d", "f"}));
+    }
+
+    {
+        // Other connections to the same receiver are not affected
+        QObject sender;
+        QObject receiver;
+        QStringList coalesced;
+        QStringList queued;
+        QVERIFY(connect(&sender, &QObject::objectNameChanged, &receiver,
+                        [&](const QString &name) { coalesced << name; },
+                        Qt::ConnectionType(Qt::QueuedConnection | Qt::CoalescedConnection)));
+        QVERIFY(connect(&sender, &QObject::objectNameChanged, &receiver,
+                        [&](const QString &name) { queued << name; },
+                        Qt::QueuedConnection));
+
+        sender.setObjectName("a");
+        sender.setObjectName("b");
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        QCOMPARE(coalesced, QStringList{"b"});
+        QCOMPARE(queued, (QStringList{"a", "b"}));
+    }
+
+    {
+        // A call pending for a connection that is gone does not take the
+        // arguments of a new connection's call
+        QObject sender;
+        QObject receiver;
+        QStringList first;
+        QStringList second;
+        QVERIFY(connect(&sender, &QObject::objectNameChanged, &receiver,
+                        [&](const QString &name) { first << name; },
+                        Qt::ConnectionType(Qt::QueuedConnection | Qt::CoalescedConnection)));
+        sender.setObjectName("a");
+        QVERIFY(sender.disconnect(&receiver));
+        for (int i = 0; i < 10; ++i) {
+            QVERIFY(connect(&sender, &QObject::objectNameChanged, &receiver,
+                            [&](const QString &name) { second << name; },
+                            Qt::ConnectionType(Qt::QueuedConnection | Qt::CoalescedConnection)));
+            sender.setObjectName(QString::number(i));
+            QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+            QVERIFY(sender.disconnect(&receiver));
+        }
+        QVERIFY(!first.contains("0"));
+        QCOMPARE(second.size(), 10);
+        QCOMPARE(second.first(), QString("0"));
+    }
+
+    {
+        // A call removed from the queue is not updated anymore
+        QObject sender;
+        QObject receiver;
+        QStringList names;
+        QVERIFY(connect(&sender, &QObject::objectNameChanged, &receiver,
+                        [&](const QString &name) { names << name; },
+                        Qt::ConnectionType(Qt::QueuedConnection | Qt::CoalescedConnection)));
+        sender.setObjectName("a");
+        QCoreApplication::removePostedEvents(&receiver, QEvent::MetaCall);
+        sender.setObjectName("b");
+        sender.setObjectName("c");
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        QCOMPARE(names, QStringList{"c"});
+    }
+
+    {
+        // Neither is a call removed with all of the receiver's events
+        QObject sender;
+        QObject receiver;
+        QStringList names;
+        QVERIFY(connect(&sender, &QObject::objectNameChanged, &receiver,
+                        [&](const QString &name) { names << name; },
+                        Qt::ConnectionType(Qt::QueuedConnection | Qt::CoalescedConnection)));
+        sender.setObjectName("a");
+        QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User));
+        QCoreApplication::removePostedEvents(&receiver);
+        sender.setObjectName("b");
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        QCOMPARE(names, QStringList{"b"});
+        sender.setObjectName("c");
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        QCOMPARE(names, (QStringList{"b", "c"}));
+    }
+
+    {
+        // Direct calls are not coalesced
+        SenderObject sender;
+        QVERIFY(connect(&sender, &SenderObject::signal1, &sender, &SenderObject::aPublicSlot,
+                        Qt::ConnectionType(Qt::DirectConnection | Qt::CoalescedConnection)));
+        sender.emitSignal1();
+        sender.emitSignal1();
+        QCOMPARE(sender.aPublicSlotCalled, 2);
+    }
+}
+
 void tst_QObject::objectNameBinding()
 {
     QObject obj;
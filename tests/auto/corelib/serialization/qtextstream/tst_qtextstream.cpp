@@ -176,6 +176,10 @@ private slots:
     void nanInf();
     void utf8IncompleteAtBufferBoundary_data();
     void utf8IncompleteAtBufferBoundary();
+    void numbersAcrossRefills_data();
+    void numbersAcrossRefills();
+    void delimitersAcrossRefills_data();
+    void delimitersAcrossRefills();
     void writeSeekWriteNoBOM();
 
     // status
@@ -1788,6 +1792,187 @@ void tst_QTextStream::utf8IncompleteAtBufferBoundary()
     } while (!in.atEnd());
 }
 
+// A sequential device that hands out its data a few bytes at a time, so that
+// QTextStream has to refill its buffer in the middle of tokens
+class ChunkedDevice : public QIODevice
+{
+public:
+    ChunkedDevice(const QByteArray &data, qsizetype chunkSize)
+        : data(data), chunkSize(chunkSize)
+    {
+        open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    }
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override
+    {
+        return data.size() - pos + QIODevice::bytesAvailable();
+    }
+
+protected:
+    qint64 readData(char *out, qint64 maxlen) override
+    {
+        const qint64 n = qMin(qMin(maxlen, qint64(chunkSize)), qint64(data.size() - pos));
+        memcpy(out, data.constData() + pos, size_t(n));
+        pos += n;
+        return n;
+    }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    const QByteArray data;
+    const qsizetype chunkSize;
+    qsizetype pos = 0;
+};
+
+// Reads numbers of type T until the stream fails or ends, and records the
+// values, the statuses and what is left
+template <typename T>
+static QStringList readNumbers(QTextStream &stream)
+{
+    QStringList result;
+    for (int i = 0; i < 100 && !stream.atEnd(); ++i) {
+        T value = 0;
+        stream >> value;
+        if constexpr (std::is_floating_point_v<T>)
+            result << QString::number(value, 'g', std::numeric_limits<T>::max_digits10);
+        else
+            result << QString::number(value);
+        result.last() += QLatin1Char('/') + QString::number(stream.status());
+        if (stream.status() != QTextStream::Ok)
+            break;
+    }
+    stream.resetStatus();
+    result << QString("rest:") + stream.readAll();
+    return result;
+}
+
+template <typename T>
+static void compareNumbersAcrossRefills(const QString &input)
+{
+    // The general parser, which the C locale with other number options uses.
+    // Unlike the plain C locale, it accepts ',' as a group separator.
+    QLocale reference = QLocale::c();
+    reference.setNumberOptions(QLocale::RejectGroupSeparator);
+    QString copy = input;
+    QTextStream referenceStream(&copy);
+    referenceStream.setLocale(reference);
+    const QStringList expected = readNumbers<T>(referenceStream);
+
+    QTextStream fromString(&copy);
+    QCOMPARE(readNumbers<T>(fromString), expected);
+
+    const QByteArray utf8 = input.toUtf8();
+    for (qsizetype chunkSize : { 1, 2, 3, 4, 5, 7, 16 }) {
+        ChunkedDevice device(utf8, chunkSize);
+        QTextStream stream(&device);
+        stream.setEncoding(QStringConverter::Utf8);
+        QCOMPARE(readNumbers<T>(stream), expected);
+    }
+
+    // Numbers that end right at, or just before or after, the end of the
+    // first buffer of a random-access device
+    for (qsizetype shift = 0; shift < 4; ++shift) {
+        QByteArray padded = QByteArray(16384 - 1 - shift, ' ') + utf8;
+        QBuffer buffer(&padded);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QTextStream stream(&buffer);
+        stream.setEncoding(QStringConverter::Utf8);
+        QCOMPARE(readNumbers<T>(stream), expected);
+    }
+}
+
+void tst_QTextStream::numbersAcrossRefills_data()
+{
+    QTest::addColumn<QString>("input");
+
+    QTest::newRow("decimal") << QString("0 1 12 123456789 -42 +42 007");
+    QTest::newRow("prefixes") << QString("0x1f 0X1F 017 08 0b101 -0x10 0");
+    QTest::newRow("signs") << QString("- + -+1 +-1");
+    QTest::newRow("dot") << QString("5. 5.e3 .5 5.5.");
+    QTest::newRow("exponent") << QString("1e 1e+ 1e3 1.5e-3x 2E+2");
+    QTest::newRow("overflow")
+            << QString("2147483647 2147483648 -2147483649 9223372036854775807 "
+                       "9223372036854775808 -9223372036854775808 -9223372036854775809 "
+                       "18446744073709551615 18446744073709551616 99999999999999999999999");
+    QTest::newRow("doubles")
+            << QString("1.7976931348623157e308 1.8e308 4.9e-324 1e-400 3.4028235e38 3.5e38");
+    QTest::newRow("separators") << QString("12 34\n56\t78  90\r\n1");
+    QTest::newRow("trailing") << QString("1;2 3abc 4- inf -nan");
+    QTest::newRow("non-ascii") << QString::fromUtf8("12٣ ١٢ 7");
+}
+
+void tst_QTextStream::numbersAcrossRefills()
+{
+    QFETCH(QString, input);
+
+    compareNumbersAcrossRefills<int>(input);
+    if (QTest::currentTestFailed())
+        return;
+    compareNumbersAcrossRefills<qlonglong>(input);
+    if (QTest::currentTestFailed())
+        return;
+    compareNumbersAcrossRefills<qulonglong>(input);
+    if (QTest::currentTestFailed())
+        return;
+    compareNumbersAcrossRefills<float>(input);
+    if (QTest::currentTestFailed())
+        return;
+    compareNumbersAcrossRefills<double>(input);
+}
+
+void tst_QTextStream::delimitersAcrossRefills_data()
+{
+    QTest::addColumn<QString>("input");
+
+    QTest::newRow("lines") << QString("ab\ncd\r\nef\r\r\ngh\n\nij\r");
+    QTest::newRow("words") << QString("ab  cd\tef\n\ngh  ij kl ");
+    QTest::newRow("long") << (QString(20, u'x') + QString("\r\n ") + QString(30, u'y') + QString("\r\n"));
+}
+
+void tst_QTextStream::delimitersAcrossRefills()
+{
+    QFETCH(QString, input);
+
+    const auto readLines = [](QTextStream &stream) {
+        QStringList lines;
+        while (!stream.atEnd())
+            lines << stream.readLine();
+        return lines;
+    };
+    const auto readWords = [](QTextStream &stream) {
+        QStringList words;
+        while (!stream.atEnd()) {
+            QString word;
+            stream >> word;
+            words << word;
+        }
+        return words;
+    };
+
+    QString copy = input;
+    QTextStream linesFromString(&copy);
+    const QStringList lines = readLines(linesFromString);
+    QTextStream wordsFromString(&copy);
+    const QStringList words = readWords(wordsFromString);
+
+    const QByteArray utf8 = input.toUtf8();
+    for (qsizetype chunkSize : { 1, 2, 3, 5, 8, 9 }) {
+        {
+            ChunkedDevice device(utf8, chunkSize);
+            QTextStream stream(&device);
+            stream.setEncoding(QStringConverter::Utf8);
+            QCOMPARE(readLines(stream), lines);
+        }
+        {
+            ChunkedDevice device(utf8, chunkSize);
+            QTextStream stream(&device);
+            stream.setEncoding(QStringConverter::Utf8);
+            QCOMPARE(readWords(stream), words);
+        }
+    }
+}
+
 // ------------------------------------------------------------------------------
 
 // Make sure we don't write a BOM after seek()ing
@@ -7,9 +7,15 @@
 #include <qcollator.h>
 #include <private/qglobal_p.h>
 #include <QScopeGuard>
+#if QT_CONFIG(thread)
+#include <QThreadPool>
+#endif
 
+#include <algorithm>
 #include <cstring>
 
+using namespace Qt::StringLiterals;
+
 class tst_QCollator : public QObject
 {
     Q_OBJECT
@@ -22,6 +28,10 @@ private Q_SLOTS:
     void compare();
 
     void state();
+
+    void sort_data();
+    void sort();
+    void parallelSort();
 };
 
 static bool dpointer_is_null(QCollator &c)
@@ -293,6 +303,7 @@ void tst_QCollator::compare()
     // NOTE: currently QCollatorSortKey::compare is not working
     // properly without icu: see QTBUG-88704 for details
     QCOMPARE(asSign(collator.compare(s1, s2)), result);
+    QCOMPARE(asSign(collator.binarySortKey(s1).compare(collator.binarySortKey(s2))), result);
     if (!numericMode)
         QCOMPARE(asSign(QCollator::defaultCompare(s1, s2)), result);
 #if QT_CONFIG(icu)
@@ -307,6 +318,8 @@ void tst_QCollator::compare()
 #endif
     collator.setCaseSensitivity(Qt::CaseInsensitive);
     QCOMPARE(asSign(collator.compare(s1, s2)), caseInsensitiveResult);
+    QCOMPARE(asSign(collator.binarySortKey(s1).compare(collator.binarySortKey(s2))),
+             caseInsensitiveResult);
 #if QT_CONFIG(icu)
     key1 = collator.sortKey(s1);
     key2 = collator.sortKey(s2);
@@ -314,6 +327,8 @@ void tst_QCollator::compare()
 #endif
     collator.setIgnorePunctuation(ignorePunctuation);
     QCOMPARE(asSign(collator.compare(s1, s2)), punctuationResult);
+    QCOMPARE(asSign(collator.binarySortKey(s1).compare(collator.binarySortKey(s2))),
+             punctuationResult);
 #if QT_CONFIG(icu)
     key1 = collator.sortKey(s1);
     key2 = collator.sortKey(s2);
@@ -344,6 +359,139 @@ void tst_QCollator::state()
     QCOMPARE(c.locale(), QLocale(QLocale::NorwegianBokmal));
 }
 
+// Strings with shared prefixes, case and accent differences, digits,
+// punctuation, surrogate pairs and duplicates
+static QStringList sortTestStrings(qsizetype count)
+{
+    static const char16_t *const parts[] = {
+        u"a", u"A", u"b", u"\u00e4", u"\u00c4", u"z", u"o", u"\u00f6", u"ss", u"\u00df",
+        u"1", u"2", u"10", u"-", u" ", u".", u"\U0001F600", u"\U00010428", u"\U00010400",
+        u"\u0130", u"i", u"\u0131", u"cote", u"c\u00f4te", u"\u4e2d"
+    };
+    constexpr int partCount = int(std::size(parts));
+
+    QStringList strings;
+    strings.reserve(count);
+    quint32 seed = 1;
+    const auto next = [&seed](int bound) {
+        seed = seed * 1664525 + 1013904223;
+        return int((seed >> 16) % quint32(bound));
+    };
+    for (qsizetype i = 0; i < count; ++i) {
+        QString string;
+        for (int length = next(7); length > 0; --length)
+            string += QStringView(parts[next(partCount)]);
+        strings.append(string);
+    }
+    return strings;
+}
+
+void tst_QCollator::sort_data()
+{
+    QTest::addColumn<QLocale>("locale");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+    QTest::addColumn<bool>("numericMode");
+    QTest::addColumn<bool>("ignorePunctuation");
+
+    const QLocale locales[] = {
+        QLocale::c(), QLocale(QLocale::English, QLocale::UnitedStates),
+        QLocale(QLocale::German, QLocale::Germany), QLocale(QLocale::Swedish, QLocale::Sweden),
+        QLocale(QLocale::Turkish, QLocale::Turkey), QLocale(QLocale::French, QLocale::France)
+    };
+    for (const QLocale &locale : locales) {
+        const QByteArray name = locale.name().toLatin1();
+        QTest::addRow("%s", name.constData()) << locale << Qt::CaseSensitive << false << false;
+        QTest::addRow("%s-insensitive", name.constData())
+                << locale << Qt::CaseInsensitive << false << false;
+        if (locale != QLocale::c()) {
+            QTest::addRow("%s-numeric", name.constData())
+                    << locale << Qt::CaseSensitive << true << false;
+            QTest::addRow("%s-punctuation", name.constData())
+                    << locale << Qt::CaseInsensitive << false << true;
+        }
+    }
+}
+
+void tst_QCollator::sort()
+{
+    QFETCH(QLocale, locale);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(bool, numericMode);
+    QFETCH(bool, ignorePunctuation);
+
+#if defined(Q_OS_ANDROID) || defined(Q_OS_INTEGRITY)
+    if (locale != QLocale::c() && locale != QLocale::system().collation())
+        QSKIP("POSIX implementation of collation only supports C and system collation locales");
+#endif
+
+    QCollator collator(locale);
+    collator.setCaseSensitivity(cs);
+    collator.setNumericMode(numericMode);
+    collator.setIgnorePunctuation(ignorePunctuation);
+
+    const QStringList strings = sortTestStrings(2000);
+    QStringList expected = strings;
+    std::stable_sort(expected.begin(), expected.end(), collator);
+
+    QStringList sorted = strings;
+    collator.sort(sorted);
+    QCOMPARE(sorted, expected);
+
+    // The keys themselves sort the same way
+    for (qsizetype i = 1; i < sorted.size(); ++i) {
+        QVERIFY2(collator.binarySortKey(sorted.at(i - 1)) <= collator.binarySortKey(sorted.at(i)),
+                 qPrintable(sorted.at(i - 1) + u" > "_s + sorted.at(i)));
+    }
+
+    // Keys that are prefixes of each other, which must not recurse as deep
+    // as there are strings
+    QStringList prefixes;
+    for (qsizetype length = 2000; length > 0; --length)
+        prefixes.append(QString(length, u'a'));
+    expected = prefixes;
+    std::stable_sort(expected.begin(), expected.end(), collator);
+    collator.sort(prefixes);
+    QCOMPARE(prefixes, expected);
+
+    // Nothing to do for short lists
+    QStringList single = { u"x"_s };
+    collator.sort(single);
+    QCOMPARE(single, QStringList{ u"x"_s });
+    QStringList empty;
+    collator.sort(empty);
+    QVERIFY(empty.isEmpty());
+}
+
+void tst_QCollator::parallelSort()
+{
+#if QT_CONFIG(thread)
+    // Make sure the list gets split, even on a single core
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const auto restoreThreads = qScopeGuard([pool, count = pool->maxThreadCount()] {
+        pool->setMaxThreadCount(count);
+    });
+    pool->setMaxThreadCount(qMax(pool->maxThreadCount(), 4));
+#endif
+
+    const QStringList strings = sortTestStrings(50000);
+    for (Qt::CaseSensitivity cs : { Qt::CaseSensitive, Qt::CaseInsensitive }) {
+        for (const QLocale &locale : { QLocale::c(), QLocale(QLocale::German, QLocale::Germany) }) {
+#if defined(Q_OS_ANDROID) || defined(Q_OS_INTEGRITY)
+            if (locale != QLocale::c() && locale != QLocale::system().collation())
+                continue;
+#endif
+            QCollator collator(locale);
+            collator.setCaseSensitivity(cs);
+
+            QStringList expected = strings;
+            collator.sort(expected);
+            QStringList sorted = strings;
+            collator.parallelSort(sorted);
+            QCOMPARE(sorted, expected);
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QCollator)
 
 #include "tst_qcollator.moc"
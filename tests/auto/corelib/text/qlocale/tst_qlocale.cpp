@@ -3721,6 +3721,16 @@ void tst_QLocale::numberFormatChakma()
     const quint64 uint64 = Q_UINT64_C(6005004003002001000);
     QCOMPARE(chakma.toString(uint64), strResult64);
     QCOMPARE(chakma.toULongLong(strResult64), uint64);
+
+    // The exponent is zero-padded to a precision of two, which is compared
+    // with the size in UTF-16 code units, so a single surrogate-pair digit
+    // gets no padding. A zero exponent is no exception (it used to get two
+    // digits, unlike any other):
+    const QString mantissa = one + chakma.decimalPoint() + zero + chakma.exponential();
+    QCOMPARE(chakma.toString(1.0, 'e', 1), mantissa + chakma.positiveSign() + zero);
+    QCOMPARE(chakma.toString(1e5, 'e', 1), mantissa + chakma.positiveSign() + five);
+    QCOMPARE(chakma.toString(1e-5, 'e', 1), mantissa + chakma.negativeSign() + five);
+    QCOMPARE(chakma.toDouble(mantissa + chakma.positiveSign() + zero), 1.0);
 }
 
 void tst_QLocale::lcsToCode()
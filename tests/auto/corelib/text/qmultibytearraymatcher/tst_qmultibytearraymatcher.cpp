@@ -0,0 +1,261 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QRandomGenerator>
+
+#include <qmultibytearraymatcher.h>
+
+using Match = QMultiByteArrayMatcher::Match;
+
+namespace QTest {
+template <>
+char *toString(const Match &match)
+{
+    return qstrdup(QByteArray("Match(" + QByteArray::number(match.position) + ", "
+                              + QByteArray::number(match.length) + ", "
+                              + QByteArray::number(match.pattern) + ')').constData());
+}
+}
+
+class tst_QMultiByteArrayMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultConstructor();
+    void patterns();
+    void indexIn_data();
+    void indexIn();
+    void findAll_data();
+    void findAll();
+    void random_data();
+    void random();
+    void copy();
+};
+
+// Looks for each pattern at each position
+static QList<Match> expectedMatches(const QByteArrayList &patterns, Qt::CaseSensitivity cs,
+                                    QByteArrayView data, qsizetype from = 0)
+{
+    QList<Match> result;
+    for (qsizetype position = qMax(from, qsizetype(0)); position <= data.size(); ++position) {
+        for (qsizetype i = 0; i < patterns.size(); ++i) {
+            const QByteArray &pattern = patterns.at(i);
+            if (data.size() - position >= pattern.size()
+                    && data.sliced(position, pattern.size()).compare(pattern, cs) == 0) {
+                result.append(Match{ position, pattern.size(), i });
+            }
+        }
+    }
+    return result;
+}
+
+void tst_QMultiByteArrayMatcher::defaultConstructor()
+{
+    QMultiByteArrayMatcher matcher;
+    QVERIFY(matcher.patterns().isEmpty());
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+
+    qsizetype pattern = 42;
+    QCOMPARE(matcher.indexIn("data", 0, &pattern), qsizetype(-1));
+    QCOMPARE(pattern, qsizetype(-1));
+    QVERIFY(matcher.findAll("data").isEmpty());
+}
+
+void tst_QMultiByteArrayMatcher::patterns()
+{
+    const QByteArrayList patterns = { "Host", "Content-Length" };
+    QMultiByteArrayMatcher matcher(patterns, Qt::CaseInsensitive);
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+
+    qsizetype pattern = -1;
+    QCOMPARE(matcher.indexIn("GET / HTTP/1.1\r\ncontent-length: 0\r\n", 0, &pattern), qsizetype(16));
+    QCOMPARE(pattern, qsizetype(1));
+
+    matcher.setCaseSensitivity(Qt::CaseSensitive);
+    QCOMPARE(matcher.indexIn("GET / HTTP/1.1\r\ncontent-length: 0\r\n"), qsizetype(-1));
+
+    matcher.setPatterns({ "HTTP" });
+    QCOMPARE(matcher.indexIn("GET / HTTP/1.1\r\n", 0, &pattern), qsizetype(6));
+    QCOMPARE(pattern, qsizetype(0));
+}
+
+void tst_QMultiByteArrayMatcher::indexIn_data()
+{
+    QTest::addColumn<QByteArrayList>("patterns");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<qsizetype>("from");
+    QTest::addColumn<qsizetype>("position");
+    QTest::addColumn<qsizetype>("pattern");
+
+    const QByteArrayList few = { "he", "she", "his", "hers" };
+    QByteArrayList many = few;
+    for (int i = 0; i < 20; ++i)
+        many.append("unused" + QByteArray::number(i));
+
+    for (const auto &[name, patterns] : { std::pair{ "few", few }, std::pair{ "many", many } }) {
+        QTest::addRow("%s-first", name) << patterns << Qt::CaseSensitive
+                                        << QByteArray("ushers") << qsizetype(0)
+                                        << qsizetype(1) << qsizetype(1);
+        QTest::addRow("%s-from", name) << patterns << Qt::CaseSensitive
+                                       << QByteArray("ushers") << qsizetype(2)
+                                       << qsizetype(2) << qsizetype(0);
+        QTest::addRow("%s-negative-from", name) << patterns << Qt::CaseSensitive
+                                                << QByteArray("ushers") << qsizetype(-5)
+                                                << qsizetype(1) << qsizetype(1);
+        QTest::addRow("%s-from-end", name) << patterns << Qt::CaseSensitive
+                                           << QByteArray("ushers") << qsizetype(6)
+                                           << qsizetype(-1) << qsizetype(-1);
+        QTest::addRow("%s-none", name) << patterns << Qt::CaseSensitive
+                                       << QByteArray("nothing to see") << qsizetype(0)
+                                       << qsizetype(-1) << qsizetype(-1);
+        QTest::addRow("%s-case", name) << patterns << Qt::CaseSensitive
+                                       << QByteArray("USHERS") << qsizetype(0)
+                                       << qsizetype(-1) << qsizetype(-1);
+        QTest::addRow("%s-no-case", name) << patterns << Qt::CaseInsensitive
+                                          << QByteArray("USHERS") << qsizetype(0)
+                                          << qsizetype(1) << qsizetype(1);
+        QTest::addRow("%s-lowest-index", name) << patterns << Qt::CaseSensitive
+                                               << QByteArray("xhers") << qsizetype(0)
+                                               << qsizetype(1) << qsizetype(0);
+        QTest::addRow("%s-long", name) << patterns << Qt::CaseSensitive
+                                       << QByteArray(100, 'x') + "his" + QByteArray(100, 'x')
+                                       << qsizetype(0) << qsizetype(100) << qsizetype(2);
+        QTest::addRow("%s-at-end", name) << patterns << Qt::CaseSensitive
+                                         << QByteArray(45, 'x') + "she"
+                                         << qsizetype(0) << qsizetype(45) << qsizetype(1);
+    }
+
+    QTest::newRow("empty-pattern") << QByteArrayList{ "abc", "" } << Qt::CaseSensitive
+                                   << QByteArray("xabc") << qsizetype(2)
+                                   << qsizetype(2) << qsizetype(1);
+    QTest::newRow("empty-pattern-at-end") << QByteArrayList{ "" } << Qt::CaseSensitive
+                                          << QByteArray("xabc") << qsizetype(4)
+                                          << qsizetype(4) << qsizetype(0);
+    QTest::newRow("empty-pattern-lower-index") << QByteArrayList{ "abc", "" } << Qt::CaseSensitive
+                                               << QByteArray("xabc") << qsizetype(1)
+                                               << qsizetype(1) << qsizetype(0);
+    QTest::newRow("binary") << QByteArrayList{ QByteArray("\0\xff", 2), QByteArray("\x80") }
+                            << Qt::CaseInsensitive << QByteArray("ab\xff\0\xff", 5)
+                            << qsizetype(0) << qsizetype(3) << qsizetype(0);
+    QTest::newRow("latin1-case") << QByteArrayList{ "\xe9t\xe9" } << Qt::CaseInsensitive
+                                 << QByteArray("\xc9T\xc9 \xe9T\xe9") << qsizetype(0)
+                                 << qsizetype(4) << qsizetype(0);
+}
+
+void tst_QMultiByteArrayMatcher::indexIn()
+{
+    QFETCH(QByteArrayList, patterns);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(QByteArray, data);
+    QFETCH(qsizetype, from);
+    QFETCH(qsizetype, position);
+    QFETCH(qsizetype, pattern);
+
+    const QMultiByteArrayMatcher matcher(patterns, cs);
+    qsizetype foundPattern = -2;
+    QCOMPARE(matcher.indexIn(data, from, &foundPattern), position);
+    QCOMPARE(foundPattern, pattern);
+    QCOMPARE(matcher.indexIn(data, from), position);
+}
+
+void tst_QMultiByteArrayMatcher::findAll_data()
+{
+    QTest::addColumn<QByteArrayList>("patterns");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+    QTest::addColumn<QByteArray>("data");
+
+    const QByteArrayList few = { "he", "she", "his", "hers" };
+    QByteArrayList many = few;
+    for (int i = 0; i < 20; ++i)
+        many.append("unused" + QByteArray::number(i));
+
+    QTest::newRow("few") << few << Qt::CaseSensitive << QByteArray("ushers and his hers");
+    QTest::newRow("many") << many << Qt::CaseSensitive << QByteArray("ushers and his hers");
+    QTest::newRow("few-no-case") << few << Qt::CaseInsensitive << QByteArray("USHERS and His hErS");
+    QTest::newRow("many-no-case") << many << Qt::CaseInsensitive << QByteArray("USHERS and His hErS");
+    QTest::newRow("overlapping") << QByteArrayList{ "aa", "aaa", "a" } << Qt::CaseSensitive
+                                 << QByteArray("aaaa");
+    QTest::newRow("duplicates") << QByteArrayList{ "ab", "ab" } << Qt::CaseSensitive
+                                << QByteArray("abab");
+    QTest::newRow("empty-pattern") << QByteArrayList{ "", "b" } << Qt::CaseSensitive
+                                   << QByteArray("abc");
+    QTest::newRow("empty-data") << few << Qt::CaseSensitive << QByteArray();
+}
+
+void tst_QMultiByteArrayMatcher::findAll()
+{
+    QFETCH(QByteArrayList, patterns);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(QByteArray, data);
+
+    const QMultiByteArrayMatcher matcher(patterns, cs);
+    for (qsizetype from = 0; from <= data.size() + 1; ++from)
+        QCOMPARE(matcher.findAll(data, from), expectedMatches(patterns, cs, data, from));
+}
+
+void tst_QMultiByteArrayMatcher::random_data()
+{
+    QTest::addColumn<int>("patternCount");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    for (int count : { 1, 3, 8, 9, 40 }) {
+        QTest::addRow("%d-case-sensitive", count) << count << Qt::CaseSensitive;
+        QTest::addRow("%d-case-insensitive", count) << count << Qt::CaseInsensitive;
+    }
+}
+
+void tst_QMultiByteArrayMatcher::random()
+{
+    QFETCH(int, patternCount);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    // A small alphabet, so that the patterns occur often, with bytes whose
+    // low nibbles are the same as those of the letters
+    static const char alphabet[] = "abcABC!\xe1\x61";
+    QRandomGenerator random(patternCount);
+    const auto randomBytes = [&](qsizetype length) {
+        QByteArray result(length, Qt::Uninitialized);
+        for (char &c : result)
+            c = alphabet[random.bounded(int(sizeof(alphabet) - 1))];
+        return result;
+    };
+
+    for (int round = 0; round < 50; ++round) {
+        QByteArrayList patterns;
+        for (int i = 0; i < patternCount; ++i)
+            patterns.append(randomBytes(random.bounded(1, 6)));
+        const QMultiByteArrayMatcher matcher(patterns, cs);
+
+        const QByteArray data = randomBytes(random.bounded(200));
+        const QList<Match> expected = expectedMatches(patterns, cs, data);
+        QCOMPARE(matcher.findAll(data), expected);
+
+        qsizetype pattern = -2;
+        QCOMPARE(matcher.indexIn(data, 0, &pattern),
+                 expected.isEmpty() ? qsizetype(-1) : expected.first().position);
+        QCOMPARE(pattern, expected.isEmpty() ? qsizetype(-1) : expected.first().pattern);
+    }
+}
+
+void tst_QMultiByteArrayMatcher::copy()
+{
+    QMultiByteArrayMatcher matcher({ "one", "two" });
+    QMultiByteArrayMatcher copy = matcher;
+    copy.setPatterns({ "three" });
+    QCOMPARE(matcher.indexIn("one two three"), qsizetype(0));
+    QCOMPARE(copy.indexIn("one two three"), qsizetype(8));
+
+    copy = matcher;
+    QCOMPARE(copy.patterns(), matcher.patterns());
+
+    QMultiByteArrayMatcher moved = std::move(copy);
+    QCOMPARE(moved.indexIn("two"), qsizetype(0));
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiByteArrayMatcher)
+
+#include "tst_qmultibytearraymatcher.moc"
@@ -0,0 +1,272 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QRandomGenerator>
+
+#include <qmultistringmatcher.h>
+
+using Match = QMultiStringMatcher::Match;
+
+namespace QTest {
+template <>
+char *toString(const Match &match)
+{
+    return qstrdup(QByteArray("Match(" + QByteArray::number(match.position) + ", "
+                              + QByteArray::number(match.length) + ", "
+                              + QByteArray::number(match.pattern) + ')').constData());
+}
+}
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultConstructor();
+    void patterns();
+    void indexIn_data();
+    void indexIn();
+    void findAll_data();
+    void findAll();
+    void random_data();
+    void random();
+    void copy();
+};
+
+// Looks for each pattern at each position
+static QList<Match> expectedMatches(const QStringList &patterns, Qt::CaseSensitivity cs,
+                                    QStringView str, qsizetype from = 0)
+{
+    QList<Match> result;
+    for (qsizetype position = qMax(from, qsizetype(0)); position <= str.size(); ++position) {
+        for (qsizetype i = 0; i < patterns.size(); ++i) {
+            const QString &pattern = patterns.at(i);
+            if (str.size() - position >= pattern.size()
+                    && str.sliced(position, pattern.size()).compare(pattern, cs) == 0) {
+                result.append(Match{ position, pattern.size(), i });
+            }
+        }
+    }
+    return result;
+}
+
+void tst_QMultiStringMatcher::defaultConstructor()
+{
+    QMultiStringMatcher matcher;
+    QVERIFY(matcher.patterns().isEmpty());
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+
+    qsizetype pattern = 42;
+    QCOMPARE(matcher.indexIn(u"string", 0, &pattern), qsizetype(-1));
+    QCOMPARE(pattern, qsizetype(-1));
+    QVERIFY(matcher.findAll(u"string").isEmpty());
+}
+
+void tst_QMultiStringMatcher::patterns()
+{
+    const QStringList patterns = { "fox", "dog" };
+    QMultiStringMatcher matcher(patterns, Qt::CaseInsensitive);
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+
+    qsizetype pattern = -1;
+    QCOMPARE(matcher.indexIn(u"The lazy DOG and the quick Fox", 0, &pattern), qsizetype(9));
+    QCOMPARE(pattern, qsizetype(1));
+
+    matcher.setCaseSensitivity(Qt::CaseSensitive);
+    QCOMPARE(matcher.indexIn(u"The lazy DOG and the quick Fox"), qsizetype(-1));
+
+    matcher.setPatterns({ "quick" });
+    QCOMPARE(matcher.indexIn(u"The lazy DOG and the quick Fox", 0, &pattern), qsizetype(21));
+    QCOMPARE(pattern, qsizetype(0));
+}
+
+void tst_QMultiStringMatcher::indexIn_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+    QTest::addColumn<QString>("str");
+    QTest::addColumn<qsizetype>("from");
+    QTest::addColumn<qsizetype>("position");
+    QTest::addColumn<qsizetype>("pattern");
+
+    const QStringList few = { "he", "she", "his", "hers" };
+    QStringList many = few;
+    for (int i = 0; i < 20; ++i)
+        many.append("unused" + QString::number(i));
+
+    for (const auto &[name, patterns] : { std::pair{ "few", few }, std::pair{ "many", many } }) {
+        QTest::addRow("%s-first", name) << patterns << Qt::CaseSensitive
+                                        << QString("ushers") << qsizetype(0)
+                                        << qsizetype(1) << qsizetype(1);
+        QTest::addRow("%s-from", name) << patterns << Qt::CaseSensitive
+                                       << QString("ushers") << qsizetype(2)
+                                       << qsizetype(2) << qsizetype(0);
+        QTest::addRow("%s-negative-from", name) << patterns << Qt::CaseSensitive
+                                                << QString("ushers") << qsizetype(-5)
+                                                << qsizetype(1) << qsizetype(1);
+        QTest::addRow("%s-from-end", name) << patterns << Qt::CaseSensitive
+                                           << QString("ushers") << qsizetype(6)
+                                           << qsizetype(-1) << qsizetype(-1);
+        QTest::addRow("%s-none", name) << patterns << Qt::CaseSensitive
+                                       << QString("nothing to see") << qsizetype(0)
+                                       << qsizetype(-1) << qsizetype(-1);
+        QTest::addRow("%s-case", name) << patterns << Qt::CaseSensitive
+                                       << QString("USHERS") << qsizetype(0)
+                                       << qsizetype(-1) << qsizetype(-1);
+        QTest::addRow("%s-no-case", name) << patterns << Qt::CaseInsensitive
+                                          << QString("USHERS") << qsizetype(0)
+                                          << qsizetype(1) << qsizetype(1);
+        QTest::addRow("%s-long-s", name) << patterns << Qt::CaseInsensitive
+                                         << QString::fromUtf16(u"uſhers") << qsizetype(0)
+                                         << qsizetype(1) << qsizetype(1);
+        QTest::addRow("%s-lowest-index", name) << patterns << Qt::CaseSensitive
+                                               << QString("xhers") << qsizetype(0)
+                                               << qsizetype(1) << qsizetype(0);
+        QTest::addRow("%s-low-byte", name) << patterns << Qt::CaseSensitive
+                                           << QString::fromUtf16(u"Ũť he")
+                                           << qsizetype(0) << qsizetype(3) << qsizetype(0);
+        QTest::addRow("%s-long", name) << patterns << Qt::CaseSensitive
+                                       << QString(100, u'x') + "his" + QString(100, u'x')
+                                       << qsizetype(0) << qsizetype(100) << qsizetype(2);
+        QTest::addRow("%s-at-end", name) << patterns << Qt::CaseSensitive
+                                         << QString(45, u'x') + "she"
+                                         << qsizetype(0) << qsizetype(45) << qsizetype(1);
+    }
+
+    QTest::newRow("kelvin") << QStringList{ "kg", "ok" } << Qt::CaseInsensitive
+                            << QString::fromUtf16(u"5 \u212AG") << qsizetype(0)
+                            << qsizetype(2) << qsizetype(0);
+    QTest::newRow("non-ascii") << QStringList{ QString::fromUtf16(u"été") }
+                               << Qt::CaseInsensitive << QString::fromUtf16(u"l'ÉTÉ")
+                               << qsizetype(0) << qsizetype(2) << qsizetype(0);
+    QTest::newRow("greek") << QStringList{ QString::fromUtf16(u"σοφία"), "x" }
+                           << Qt::CaseInsensitive
+                           << QString::fromUtf16(u"ΣΟΦΊΑ")
+                           << qsizetype(0) << qsizetype(0) << qsizetype(0);
+    QTest::newRow("surrogates") << QStringList{ QString::fromUtf16(u"\U00010428x") }
+                                << Qt::CaseInsensitive
+                                << QString::fromUtf16(u"a\U00010400X") << qsizetype(0)
+                                << qsizetype(1) << qsizetype(0);
+    QTest::newRow("empty-pattern") << QStringList{ "abc", "" } << Qt::CaseSensitive
+                                   << QString("xabc") << qsizetype(2)
+                                   << qsizetype(2) << qsizetype(1);
+    QTest::newRow("empty-pattern-lower-index") << QStringList{ "abc", "" } << Qt::CaseSensitive
+                                               << QString("xabc") << qsizetype(1)
+                                               << qsizetype(1) << qsizetype(0);
+}
+
+void tst_QMultiStringMatcher::indexIn()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(QString, str);
+    QFETCH(qsizetype, from);
+    QFETCH(qsizetype, position);
+    QFETCH(qsizetype, pattern);
+
+    const QMultiStringMatcher matcher(patterns, cs);
+    qsizetype foundPattern = -2;
+    QCOMPARE(matcher.indexIn(str, from, &foundPattern), position);
+    QCOMPARE(foundPattern, pattern);
+    QCOMPARE(matcher.indexIn(str, from), position);
+}
+
+void tst_QMultiStringMatcher::findAll_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+    QTest::addColumn<QString>("str");
+
+    const QStringList few = { "he", "she", "his", "hers" };
+    QStringList many = few;
+    for (int i = 0; i < 20; ++i)
+        many.append("unused" + QString::number(i));
+
+    QTest::newRow("few") << few << Qt::CaseSensitive << QString("ushers and his hers");
+    QTest::newRow("many") << many << Qt::CaseSensitive << QString("ushers and his hers");
+    QTest::newRow("few-no-case") << few << Qt::CaseInsensitive << QString("USHERS and His hErS");
+    QTest::newRow("many-no-case") << many << Qt::CaseInsensitive << QString("USHERS and His hErS");
+    QTest::newRow("overlapping") << QStringList{ "aa", "aaa", "a" } << Qt::CaseSensitive
+                                 << QString("aaaa");
+    QTest::newRow("duplicates") << QStringList{ "ab", "ab" } << Qt::CaseSensitive
+                                << QString("abab");
+    QTest::newRow("empty-pattern") << QStringList{ "", "b" } << Qt::CaseSensitive
+                                   << QString("abc");
+    QTest::newRow("empty-string") << few << Qt::CaseSensitive << QString();
+}
+
+void tst_QMultiStringMatcher::findAll()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(QString, str);
+
+    const QMultiStringMatcher matcher(patterns, cs);
+    for (qsizetype from = 0; from <= str.size() + 1; ++from)
+        QCOMPARE(matcher.findAll(str, from), expectedMatches(patterns, cs, str, from));
+}
+
+void tst_QMultiStringMatcher::random_data()
+{
+    QTest::addColumn<int>("patternCount");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    for (int count : { 1, 3, 8, 9, 40 }) {
+        QTest::addRow("%d-case-sensitive", count) << count << Qt::CaseSensitive;
+        QTest::addRow("%d-case-insensitive", count) << count << Qt::CaseInsensitive;
+    }
+}
+
+void tst_QMultiStringMatcher::random()
+{
+    QFETCH(int, patternCount);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    // A small alphabet, so that the patterns occur often, with characters
+    // that fold to ASCII letters and ones with the same low byte as them
+    static const char16_t alphabet[] = u"skSK!ſKųéÉ";
+    QRandomGenerator random(patternCount);
+    const auto randomString = [&](qsizetype length) {
+        QString result(length, Qt::Uninitialized);
+        for (QChar &c : result)
+            c = alphabet[random.bounded(int(std::size(alphabet) - 1))];
+        return result;
+    };
+
+    for (int round = 0; round < 50; ++round) {
+        QStringList patterns;
+        for (int i = 0; i < patternCount; ++i)
+            patterns.append(randomString(random.bounded(1, 6)));
+        const QMultiStringMatcher matcher(patterns, cs);
+
+        const QString str = randomString(random.bounded(200));
+        const QList<Match> expected = expectedMatches(patterns, cs, str);
+        QCOMPARE(matcher.findAll(str), expected);
+
+        qsizetype pattern = -2;
+        QCOMPARE(matcher.indexIn(str, 0, &pattern),
+                 expected.isEmpty() ? qsizetype(-1) : expected.first().position);
+        QCOMPARE(pattern, expected.isEmpty() ? qsizetype(-1) : expected.first().pattern);
+    }
+}
+
+void tst_QMultiStringMatcher::copy()
+{
+    QMultiStringMatcher matcher({ "one", "two" });
+    QMultiStringMatcher copy = matcher;
+    copy.setPatterns({ "three" });
+    QCOMPARE(matcher.indexIn(u"one two three"), qsizetype(0));
+    QCOMPARE(copy.indexIn(u"one two three"), qsizetype(8));
+
+    copy = matcher;
+    QCOMPARE(copy.patterns(), matcher.patterns());
+
+    QMultiStringMatcher moved = std::move(copy);
+    QCOMPARE(moved.indexIn(u"two"), qsizetype(0));
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiStringMatcher)
+
+#include "tst_qmultistringmatcher.moc"
@@ -0,0 +1,159 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <qnumberformatter.h>
+
+#include <limits>
+
+class tst_QNumberFormatter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultConstructor();
+    void integers_data();
+    void integers();
+    void doubles_data();
+    void doubles();
+    void formatTo();
+    void copy();
+};
+
+static void addLocaleRows()
+{
+    QTest::addColumn<QLocale>("locale");
+
+    for (const char *name : { "C", "en_US", "de_DE", "fr_FR", "en_IN", "ar_EG", "fa_IR",
+                              "ccp_BD", "de_CH", "sv_SE" }) {
+        QTest::newRow(name) << QLocale(QLatin1StringView(name));
+    }
+
+    QLocale omitGroup(QLocale::German, QLocale::Germany);
+    omitGroup.setNumberOptions(QLocale::OmitGroupSeparator);
+    QTest::newRow("de_DE-omit-group") << omitGroup;
+
+    QLocale exponent(QLocale::English, QLocale::UnitedStates);
+    exponent.setNumberOptions(QLocale::OmitLeadingZeroInExponent
+                              | QLocale::IncludeTrailingZeroesAfterDot);
+    QTest::newRow("en_US-exponent-options") << exponent;
+
+    QLocale trailing(QLocale::Arabic, QLocale::Egypt);
+    trailing.setNumberOptions(QLocale::IncludeTrailingZeroesAfterDot);
+    QTest::newRow("ar_EG-trailing-zeros") << trailing;
+}
+
+void tst_QNumberFormatter::defaultConstructor()
+{
+    QLocale::setDefault(QLocale(QLocale::German, QLocale::Germany));
+    const QNumberFormatter formatter;
+    QLocale::setDefault(QLocale::c());
+
+    QCOMPARE(formatter.locale(), QLocale(QLocale::German, QLocale::Germany));
+    QCOMPARE(formatter.toString(1234567), QStringLiteral("1.234.567"));
+}
+
+void tst_QNumberFormatter::integers_data()
+{
+    addLocaleRows();
+}
+
+void tst_QNumberFormatter::integers()
+{
+    QFETCH(QLocale, locale);
+
+    const QNumberFormatter formatter(locale);
+    QCOMPARE(formatter.locale(), locale);
+
+    const qlonglong signedValues[] = {
+        0, 1, -1, 9, 10, -99, 999, 1000, -1000, 12345, 100000, -1234567, 12345678,
+        std::numeric_limits<int>::min(), std::numeric_limits<int>::max(),
+        std::numeric_limits<qlonglong>::min(), std::numeric_limits<qlonglong>::max()
+    };
+    for (qlonglong value : signedValues) {
+        QCOMPARE(formatter.toString(value), locale.toString(value));
+        QCOMPARE(formatter.toString(int(value)), locale.toString(int(value)));
+    }
+
+    const qulonglong unsignedValues[] = {
+        0, 1, 999, 1000, 1234567, std::numeric_limits<uint>::max(),
+        std::numeric_limits<qulonglong>::max()
+    };
+    for (qulonglong value : unsignedValues) {
+        QCOMPARE(formatter.toString(value), locale.toString(value));
+        QCOMPARE(formatter.toString(uint(value)), locale.toString(uint(value)));
+    }
+}
+
+void tst_QNumberFormatter::doubles_data()
+{
+    addLocaleRows();
+}
+
+void tst_QNumberFormatter::doubles()
+{
+    QFETCH(QLocale, locale);
+
+    const QNumberFormatter formatter(locale);
+    const double values[] = {
+        0, -0.0, 1, -1, 0.5, 0.1, -0.001234, 1e-5, 1.5e-10, 3.14159265358979, 42,
+        999.9996, 1000, 12345.678, -1234567.891, 1e10, 123456789012.0, 1e21, 1e-300,
+        6.02214076e23, std::numeric_limits<double>::max(), std::numeric_limits<double>::min(),
+        std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN()
+    };
+    const int precisions[] = { QLocale::FloatingPointShortest, -1, 0, 1, 2, 6, 10, 17 };
+
+    for (double value : values) {
+        for (char format : { 'e', 'E', 'f', 'F', 'g', 'G' }) {
+            for (int precision : precisions) {
+                QCOMPARE(formatter.toString(value, format, precision),
+                         locale.toString(value, format, precision));
+            }
+        }
+        QCOMPARE(formatter.toString(value), locale.toString(value));
+    }
+}
+
+void tst_QNumberFormatter::formatTo()
+{
+    const QNumberFormatter formatter(QLocale(QLocale::English, QLocale::UnitedStates));
+
+    QChar buffer[16];
+    std::fill(std::begin(buffer), std::end(buffer), u'#');
+    qsizetype length = formatter.formatTo(buffer, 16, -1234567);
+    QCOMPARE(length, qsizetype(10));
+    QCOMPARE(QStringView(buffer, length), u"-1,234,567");
+    QCOMPARE(buffer[length], u'#');
+
+    // Too little room: only the start is written, but the full length returned
+    std::fill(std::begin(buffer), std::end(buffer), u'#');
+    length = formatter.formatTo(buffer, 4, 1234.5);
+    QCOMPARE(length, qsizetype(7));
+    QCOMPARE(QStringView(buffer, 5), u"1,23#");
+
+    QCOMPARE(formatter.formatTo(nullptr, 0, 1e100, 'f', 2), qsizetype(137));
+    QCOMPARE(formatter.toString(1e100, 'f', 2).size(), qsizetype(137));
+
+    length = formatter.formatTo(buffer, 16, 2.5e-7, 'E', 2);
+    QCOMPARE(QStringView(buffer, length), u"2.50E-07");
+}
+
+void tst_QNumberFormatter::copy()
+{
+    QNumberFormatter formatter(QLocale(QLocale::French, QLocale::France));
+    QNumberFormatter copy = formatter;
+    QCOMPARE(copy.toString(1.5), QStringLiteral("1,5"));
+
+    copy = QNumberFormatter(QLocale::c());
+    QCOMPARE(copy.toString(1.5), QStringLiteral("1.5"));
+    QCOMPARE(formatter.toString(1.5), QStringLiteral("1,5"));
+
+    QNumberFormatter moved = std::move(copy);
+    QCOMPARE(moved.locale(), QLocale::c());
+}
+
+QTEST_APPLESS_MAIN(tst_QNumberFormatter)
+
+#include "tst_qnumberformatter.moc"
@@ -0,0 +1,285 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <qregularexpression.h>
+#include <qregularexpressionset.h>
+#include <qstringlist.h>
+
+Q_DECLARE_METATYPE(QRegularExpression::PatternOptions)
+
+class tst_QRegularExpressionSet : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultConstructors();
+    void patterns();
+    void match_data();
+    void match();
+    void matchWithOffset();
+    void captures();
+    void partialMatch();
+    void invalidPattern();
+    void detach();
+};
+
+// The results of matching each pattern on its own
+static QList<qsizetype> expectedMatches(const QStringList &patterns,
+                                        QRegularExpression::PatternOptions options,
+                                        const QString &subject, qsizetype offset = 0)
+{
+    QList<qsizetype> result;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        if (QRegularExpression(patterns.at(i), options).match(subject, offset).hasMatch())
+            result.append(i);
+    }
+    return result;
+}
+
+void tst_QRegularExpressionSet::defaultConstructors()
+{
+    QRegularExpressionSet set;
+    QVERIFY(set.isEmpty());
+    QCOMPARE(set.size(), 0);
+    QVERIFY(set.isValid());
+    QCOMPARE(set.patternOptions(), QRegularExpression::NoPatternOption);
+
+    const QRegularExpressionSetMatch match = set.match("subject");
+    QVERIFY(match.isValid());
+    QVERIFY(!match.hasMatch());
+    QVERIFY(match.matchedPatterns().isEmpty());
+
+    QRegularExpressionSetMatch defaultMatch;
+    QVERIFY(defaultMatch.isValid());
+    QVERIFY(!defaultMatch.hasMatch());
+    QVERIFY(!defaultMatch.hasPartialMatch());
+    QVERIFY(!defaultMatch.match(0).hasMatch());
+}
+
+void tst_QRegularExpressionSet::patterns()
+{
+    const QStringList patterns = { "abc", "d+", "(?<name>x)y" };
+    QRegularExpressionSet set(patterns, QRegularExpression::CaseInsensitiveOption);
+    QCOMPARE(set.patterns(), patterns);
+    QCOMPARE(set.size(), 3);
+    QCOMPARE(set.regularExpression(2).pattern(), patterns.at(2));
+    QCOMPARE(set.regularExpression(2).patternOptions(), QRegularExpression::CaseInsensitiveOption);
+
+    QCOMPARE(set.addPattern("z"), qsizetype(3));
+    QCOMPARE(set.patterns(), patterns + QStringList("z"));
+    QVERIFY(set.match("Z").hasMatch(3));
+
+    set.setPatternOptions(QRegularExpression::NoPatternOption);
+    QCOMPARE(set.regularExpression(0).patternOptions(), QRegularExpression::NoPatternOption);
+    QVERIFY(!set.match("Z").hasMatch());
+
+    set.setPatterns({ "only" });
+    QCOMPARE(set.size(), 1);
+    QCOMPARE(set.match("the only one").matchedPatterns(), QList<qsizetype>{ 0 });
+}
+
+void tst_QRegularExpressionSet::match_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QRegularExpression::PatternOptions>("options");
+    QTest::addColumn<QStringList>("subjects");
+
+    const QStringList subjects = {
+        QString(),
+        "colour and color",
+        "colr",
+        "the cat sat on the mat",
+        "hot dog",
+        "foobar",
+        "bar",
+        "ERROR: disk sda full",
+        "AN ERROR",
+        "xERRORx",
+        "ABC abc",
+        "a.b",
+        "axb",
+        "ac abbc abbbc",
+        "{x}",
+        "12345",
+        "kKſ",
+        "KS",
+        "ends with \\",
+        QString::fromUtf16(u"\U0001F600\U0001F600 smile"),
+        "[abc]def",
+        "Straße",
+    };
+
+    const QStringList literalPatterns = {
+        "colou?r",
+        "cat|dog",
+        "(foo)?bar",
+        "\\bERROR\\b",
+        "\\x41BC",
+        "\\p{Lu}BC",
+        "[abc]def",
+        "a.b",
+        "a\\.b",
+        "ab{0,2}c",
+        "ab{2}c",
+        "ab+c",
+        "\\Qa.b\\E",
+        "\\{x\\}",
+        "{x}",
+        "\\d+",
+        "(?i)abc",
+        "(?:sat|mat) on",
+        "the (?=cat)",
+        "(?<=the )cat",
+        "^ERROR: disk (\\w+) full$",
+        "\\cJ?x",
+        QString::fromUtf16(u"\U0001F600?\U0001F600 smile"),
+        "sm(i)le",
+        "\\\\$",
+        "Straße",
+        "ks",
+        "",
+    };
+
+    QTest::newRow("case-sensitive") << literalPatterns
+                                    << QRegularExpression::PatternOptions() << subjects;
+    QTest::newRow("case-insensitive") << literalPatterns
+                                      << QRegularExpression::PatternOptions(QRegularExpression::CaseInsensitiveOption)
+                                      << subjects;
+    QTest::newRow("extended") << literalPatterns
+                              << QRegularExpression::PatternOptions(QRegularExpression::ExtendedPatternSyntaxOption)
+                              << subjects;
+    QTest::newRow("multiline") << literalPatterns
+                               << QRegularExpression::PatternOptions(QRegularExpression::MultilineOption)
+                               << QStringList{ "foo\nERROR: disk a full\nbar", "colour\ncat" };
+    // literals after a verb are not needed for the match
+    QTest::newRow("verbs") << QStringList{ "a(*ACCEPT)bc", "(*UCP)x\\b", "x(*COMMIT)yz|w" }
+                           << QRegularExpression::PatternOptions()
+                           << QStringList{ "a", "abc", "x", "xy", "xyz", "w", "bc" };
+    // a quantifier with newer PCRE2 versions, a literal with older ones
+    QTest::newRow("brace without minimum") << QStringList{ "ab{,2}c", "x{,}" }
+                                           << QRegularExpression::PatternOptions()
+                                           << QStringList{ "ac", "abbc", "ab{,2}c", "x", "x{,}" };
+    QTest::newRow("brace with spaces") << QStringList{ "xa{ 0 }y", "ab{ 1, 2 }c", "p{q" }
+                                       << QRegularExpression::PatternOptions()
+                                       << QStringList{ "xy", "xay", "xa{ 0 }y", "abc", "abbc",
+                                                       "ab{ 1, 2 }c", "p{q", "pq" };
+    // neither a lone \E nor a comment is an atom of its own
+    QTest::newRow("ignored items") << QStringList{ "ab\\E*", "ab(?#c)*", "ab(?#c)?", "x\\Ey" }
+                                   << QRegularExpression::PatternOptions()
+                                   << QStringList{ "a", "ab", "abb", "ac", "xy", "x\\Ey" };
+}
+
+void tst_QRegularExpressionSet::match()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QRegularExpression::PatternOptions, options);
+    QFETCH(QStringList, subjects);
+
+    const QRegularExpressionSet set(patterns, options);
+    QVERIFY(set.isValid());
+    for (const QString &subject : subjects) {
+        const QList<qsizetype> expected = expectedMatches(patterns, options, subject);
+
+        const QRegularExpressionSetMatch match = set.match(subject);
+        QVERIFY(match.isValid());
+        QCOMPARE(match.matchedPatterns(), expected);
+        QCOMPARE(match.hasMatch(), !expected.isEmpty());
+        for (qsizetype i = 0; i < patterns.size(); ++i)
+            QCOMPARE(match.hasMatch(i), expected.contains(i));
+
+        QCOMPARE(set.matchView(subject).matchedPatterns(), expected);
+    }
+}
+
+void tst_QRegularExpressionSet::matchWithOffset()
+{
+    const QStringList patterns = { "abc", "(?<=x)def", "^ghi", "a" };
+    const QRegularExpressionSet set(patterns);
+    const QString subject = "abc xdef ghi";
+    for (qsizetype offset = -15; offset <= subject.size() + 1; ++offset) {
+        QCOMPARE(set.match(subject, offset).matchedPatterns(),
+                 expectedMatches(patterns, {}, subject, offset));
+    }
+
+    const QRegularExpressionSetMatch anchored =
+            set.match(subject, 5, QRegularExpression::NormalMatch,
+                      QRegularExpression::AnchorAtOffsetMatchOption);
+    QCOMPARE(anchored.matchedPatterns(), QList<qsizetype>{ 1 });
+    QCOMPARE(anchored.matchOptions(), QRegularExpression::AnchorAtOffsetMatchOption);
+}
+
+void tst_QRegularExpressionSet::captures()
+{
+    const QRegularExpressionSet set({ "user (\\w+) logged (in|out)", "timeout after (\\d+) ms",
+                                      "logged" });
+    const QRegularExpressionSetMatch match = set.match("user alice logged out");
+    QCOMPARE(match.matchedPatterns(), QList<qsizetype>({ 0, 2 }));
+
+    const QRegularExpressionMatch first = match.match(0);
+    QVERIFY(first.hasMatch());
+    QCOMPARE(first.captured(1), QString("alice"));
+    QCOMPARE(first.captured(2), QString("out"));
+    QCOMPARE(first.regularExpression(), set.regularExpression(0));
+    QVERIFY(!match.match(1).hasMatch());
+    QCOMPARE(match.match(2).capturedStart(), qsizetype(11));
+    QCOMPARE(match.regularExpressionSet().patterns(), set.patterns());
+}
+
+void tst_QRegularExpressionSet::partialMatch()
+{
+    const QRegularExpressionSet set({ "abc", "xyz", "ab" });
+
+    QRegularExpressionSetMatch match = set.match("xa", 0, QRegularExpression::PartialPreferCompleteMatch);
+    QVERIFY(!match.hasMatch());
+    QVERIFY(match.hasPartialMatch());
+    QCOMPARE(match.matchedPatterns(), QList<qsizetype>({ 0, 2 }));
+    QVERIFY(match.match(0).hasPartialMatch());
+    QCOMPARE(match.matchType(), QRegularExpression::PartialPreferCompleteMatch);
+
+    match = set.match("xab", 0, QRegularExpression::PartialPreferCompleteMatch);
+    QVERIFY(match.hasMatch());
+    QVERIFY(!match.hasPartialMatch());
+    QCOMPARE(match.matchedPatterns(), QList<qsizetype>({ 0, 2 }));
+
+    match = set.match("abc", 0, QRegularExpression::NoMatch);
+    QVERIFY(match.isValid());
+    QVERIFY(!match.hasMatch());
+}
+
+void tst_QRegularExpressionSet::invalidPattern()
+{
+    QRegularExpressionSet set({ "abc", "(unbalanced" });
+    QVERIFY(!set.isValid());
+    QVERIFY(set.regularExpression(0).isValid());
+    QVERIFY(!set.regularExpression(1).isValid());
+
+    QTest::ignoreMessage(QtWarningMsg, "QRegularExpressionSet::match(): called on a set with an invalid pattern");
+    const QRegularExpressionSetMatch match = set.match("abc");
+    QVERIFY(!match.isValid());
+    QVERIFY(!match.hasMatch());
+
+    set.setPatterns({ "abc", "(balanced)" });
+    QVERIFY(set.isValid());
+    QVERIFY(set.match("abc").isValid());
+}
+
+void tst_QRegularExpressionSet::detach()
+{
+    QRegularExpressionSet set({ "abc" });
+    QVERIFY(set.match("abc").hasMatch());
+
+    QRegularExpressionSet copy = set;
+    copy.addPattern("def");
+    QCOMPARE(set.size(), 1);
+    QCOMPARE(copy.size(), 2);
+    QCOMPARE(set.match("def").matchedPatterns(), QList<qsizetype>());
+    QCOMPARE(copy.match("def").matchedPatterns(), QList<qsizetype>{ 1 });
+
+    copy = set;
+    QCOMPARE(copy.match("abc def").matchedPatterns(), QList<qsizetype>{ 0 });
+}
+
+QTEST_APPLESS_MAIN(tst_QRegularExpressionSet)
+
+#include "tst_qregularexpressionset.moc"
@@ -162,6 +162,10 @@ private slots:
     void utf8stateful_data();
     void utf8stateful();
 
+    void utf8LongRuns_data();
+    void utf8LongRuns();
+    void utf8ValidateEmpty();
+
     void utfHeaders_data();
     void utfHeaders();
 
@@ -1955,6 +1959,95 @@ void tst_QStringConverter::utf8stateful()
     }
 }
 
+void tst_QStringConverter::utf8LongRuns_data()
+{
+    QTest::addColumn<QString>("text");
+
+    // Long enough for the SIMD code paths, in the scripts that take them
+    QTest::newRow("ascii") << u"The quick brown fox jumps over the lazy dog. "_s.repeated(4);
+    QTest::newRow("latin") << u"Voix ambiguë d'un cœur qui, au zéphyr, préfère les jattes de kiwis. "_s.repeated(3);
+    QTest::newRow("cyrillic") << u"Съешь же ещё этих мягких французских булок, да выпей чаю. "_s.repeated(3);
+    QTest::newRow("cjk") << u"我能吞下玻璃而不伤身体。私はガラスを食べられます。"_s.repeated(6);
+    QTest::newRow("emoji") << u"\U0001F600\U0001F4A9 \U0001F680\U00010428\U0010FFFF\U00010000"_s.repeated(12);
+    QTest::newRow("mixed") << u"Ёж 刺猬 hedgehog \U0001F994 ежи ヤマアラシ \u00e9\u07ff\u0800\uffff\ufffd "_s.repeated(5);
+}
+
+void tst_QStringConverter::utf8LongRuns()
+{
+    QFETCH(QString, text);
+
+    // Encode each character on its own, which is too short for SIMD
+    QByteArray utf8;
+    QList<qsizetype> boundaries;    // in utf8, and in text
+    QList<qsizetype> textBoundaries;
+    for (qsizetype i = 0; i < text.size(); ) {
+        const qsizetype length = text.at(i).isHighSurrogate() ? 2 : 1;
+        boundaries.append(utf8.size());
+        textBoundaries.append(i);
+        utf8 += text.mid(i, length).toUtf8();
+        i += length;
+    }
+    boundaries.append(utf8.size());
+    textBoundaries.append(text.size());
+
+    QCOMPARE(text.toUtf8(), utf8);
+    QCOMPARE(QStringEncoder(QStringConverter::Utf8).encode(text), utf8);
+    QCOMPARE(QString::fromUtf8(utf8), text);
+    QCOMPARE(QStringDecoder(QStringConverter::Utf8).decode(utf8), text);
+    QVERIFY(QUtf8StringView(utf8).isValidUtf8());
+
+    const QString replacement(QChar::ReplacementCharacter);
+    for (qsizetype n = 0; n < boundaries.size(); ++n) {
+        const QByteArray before = utf8.left(boundaries.at(n));
+        const QByteArray after = utf8.mid(boundaries.at(n));
+        const QString expected = text.left(textBoundaries.at(n)) + replacement
+                + text.mid(textBoundaries.at(n));
+
+        // a byte that is never valid, a stray continuation byte, and a lead
+        // byte without its continuation
+        for (const char *invalid : { "\xff", "\x80", "\xe4" }) {
+            const QByteArray broken = before + invalid + after;
+            QCOMPARE(QString::fromUtf8(broken), expected);
+            // (a stateful decoder would wait for the rest of a lead byte at the end)
+            QStringDecoder decoder(QStringConverter::Utf8, QStringConverter::Flag::Stateless);
+            QCOMPARE(decoder.decode(broken), expected);
+            QVERIFY(decoder.hasError());
+            QVERIFY(!QUtf8StringView(broken).isValidUtf8());
+        }
+
+        // the sequence split in the middle
+        if (n + 1 < boundaries.size() && boundaries.at(n + 1) - boundaries.at(n) > 1) {
+            QStringDecoder decoder(QStringConverter::Utf8);
+            const QByteArrayView split = QByteArrayView(utf8).first(boundaries.at(n) + 1);
+            QString decoded = decoder.decode(split);
+            decoded += decoder.decode(QByteArrayView(utf8).sliced(split.size()));
+            QVERIFY(!decoder.hasError());
+            QCOMPARE(decoded, text);
+            QVERIFY(!QUtf8StringView(split).isValidUtf8());
+        }
+
+        // a lone surrogate
+        if (n + 1 < boundaries.size()) {
+            const QString lone = text.left(textBoundaries.at(n)) + QChar(0xdc00)
+                    + text.mid(textBoundaries.at(n));
+            QCOMPARE(lone.toUtf8(), before + "?" + after);
+            QCOMPARE(QStringEncoder(QStringConverter::Utf8).encode(lone),
+                     before + "\xef\xbf\xbd" + after);
+        }
+    }
+}
+
+void tst_QStringConverter::utf8ValidateEmpty()
+{
+    QVERIFY(QByteArrayView().isValidUtf8());
+    QVERIFY(QByteArrayView("").isValidUtf8());
+    QVERIFY(QUtf8StringView().isValidUtf8());
+    QVERIFY(QUtf8StringView("").isValidUtf8());
+    QVERIFY(QByteArray().isValidUtf8());
+    QCOMPARE(QString::fromUtf8(QByteArrayView()), QString());
+    QCOMPARE(QStringDecoder(QStringConverter::Utf8).decode(QByteArrayView()), QString());
+}
+
 void tst_QStringConverter::utfHeaders_data()
 {
     QTest::addColumn<QStringConverter::Encoding>("encoding");
@@ -5,6 +5,7 @@
 #include <qchar.h>
 #include <qfile.h>
 #include <qstringlist.h>
+#include <qrandom.h>
 #include <private/qunicodetables_p.h>
 #include <private/qunicodetools_p.h>
 
@@ -19,6 +20,8 @@ private slots:
     void wordBreakClass();
     void sentenceBreakClass_data();
     void sentenceBreakClass();
+    void updateCharAttributes_data();
+    void updateCharAttributes();
 };
 
 void tst_QUnicodeTools::lineBreakClass()
@@ -195,5 +198,80 @@ void tst_QUnicodeTools::sentenceBreakClass()
     verifyCharClassPattern(str, pattern, QUnicodeTools::SentenceBreaks);
 }
 
+void tst_QUnicodeTools::updateCharAttributes_data()
+{
+    QTest::addColumn<int>("options");
+
+    QTest::addRow("graphemes") << int(QUnicodeTools::GraphemeBreaks);
+    QTest::addRow("words") << int(QUnicodeTools::WordBreaks);
+    QTest::addRow("sentences") << int(QUnicodeTools::SentenceBreaks);
+    QTest::addRow("lines") << int(QUnicodeTools::LineBreaks);
+    QTest::addRow("hangul-lines") << int(QUnicodeTools::LineBreaks
+                                         | QUnicodeTools::HangulLineBreakTailoring);
+    QTest::addRow("whitespaces") << int(QUnicodeTools::WhiteSpaces);
+}
+
+static QList<QCharAttributes> charAttributes(const QString &str,
+                                             QUnicodeTools::CharAttributeOptions options)
+{
+    QUnicodeTools::ScriptItemArray scriptItems;
+    QUnicodeTools::initScripts(str, &scriptItems);
+    QList<QCharAttributes> attributes(str.size() + 1);
+    QUnicodeTools::initCharAttributes(str, scriptItems.data(), scriptItems.size(),
+                                      attributes.data(), options);
+    return attributes;
+}
+
+void tst_QUnicodeTools::updateCharAttributes()
+{
+    QFETCH(int, options);
+    const auto charAttributeOptions = QUnicodeTools::CharAttributeOptions::fromInt(options);
+
+    const char16_t *const pieces[] = {
+        u"The", u"quick", u"brown", u"fox", u" ", u" ", u"  ", u"ab ", u"Mr. ", u"e.g. ",
+        u"can\u2019t", u"3.14", u"(42)", u"$5", u"\"Hi!\" ", u"? ", u"\r\n", u"\n", u"\t",
+        u"\u00e9t\u00e9", u"\u00a9", u"\u00ad", u"\u0301", u"\u200d", u"\u0416\u0443\u043a",
+        u"\u4e2d\u6587", u"\u3002", u"\u0e01\u0e33", u"\u0915\u094d\u0937\u093f",
+        u"\uac00\uac01", u"\U0001F600", u"\U0001F1E9\U0001F1EA", u"\U0001F44D\U0001F3FD",
+        u"\u05d0-\u05d1", u"\u05e9\u05dc\u05d5\u05dd", u"\u0627\u0644\u0639", u"\u3053\u308c",
+        u"\u30ab\u30bf", u"\u1100\u1161\u11a8", u"\u2212", u"\u00b5", u"\u3000",
+    };
+    QRandomGenerator random(options);
+    const auto randomText = [&](int pieceCount) {
+        QString text;
+        for (int i = 0; i < pieceCount; ++i)
+            text += QStringView(pieces[random.bounded(int(std::size(pieces)))]);
+        return text;
+    };
+
+    QString text = randomText(60);
+    QList<QCharAttributes> attributes = charAttributes(text, charAttributeOptions);
+    for (int round = 0; round < 500; ++round) {
+        // Replace some characters, and move the attributes of the others along
+        const qsizetype from = random.bounded(text.size() + 1);
+        const qsizetype removed = text.size() < 100
+                ? 0 : random.bounded(qMin<qsizetype>(text.size() - from, 12) + 1);
+        const QString inserted = randomText(random.bounded(4));
+        text.replace(from, removed, inserted);
+
+        QList<QCharAttributes> moved = attributes.mid(0, from);
+        moved.resize(from + inserted.size());
+        moved += attributes.mid(from + removed);
+        QCOMPARE(moved.size(), text.size() + 1);
+
+        QUnicodeTools::ScriptItemArray scriptItems;
+        QUnicodeTools::initScripts(text, &scriptItems);
+        QUnicodeTools::updateCharAttributes(text, from, inserted.size(), scriptItems.data(),
+                                            scriptItems.size(), moved.data(), charAttributeOptions);
+
+        attributes = charAttributes(text, charAttributeOptions);
+        for (qsizetype i = 0; i <= text.size(); ++i) {
+            QVERIFY2(memcmp(&moved.at(i), &attributes.at(i), sizeof(QCharAttributes)) == 0,
+                     qPrintable(QString("Round %1, character #%2 of \"%3\"")
+                                .arg(round).arg(i).arg(text)));
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QUnicodeTools)
 #include "tst_qunicodetools.moc"
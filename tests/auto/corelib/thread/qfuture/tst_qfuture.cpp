@@ -224,6 +224,12 @@ private slots:
 
     void unwrap();
 
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    void coroutines();
+    void coroutinesCanceled();
+    void coroutinesResumeInContextThread();
+#endif
+
 private:
     using size_type = std::vector<int>::size_type;
 
@@ -4977,5 +4983,175 @@ void tst_QFuture::unwrap()
     }
 }
 
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+template<class T, class = void>
+constexpr bool hasPromiseType = false;
+template<class T>
+constexpr bool hasPromiseType<T, std::void_t<typename std::coroutine_traits<T>::promise_type>> = true;
+
+// Functions returning QFuture only become coroutines by opting in
+static_assert(!hasPromiseType<QFuture<int>>);
+static_assert(hasPromiseType<QtFuture::Coroutine<int>>);
+
+static QtFuture::Coroutine<int> coroutineAdd(QFuture<int> a, QFuture<int> b)
+{
+    const int x = co_await a;
+    const int y = co_await b;
+    co_return x + y;
+}
+
+static QtFuture::Coroutine<void> coroutineStore(QFuture<int> f, int *out)
+{
+    *out = co_await coroutineAdd(f, QtFuture::makeReadyFuture(1));
+}
+
+void tst_QFuture::coroutines()
+{
+    {
+        // Ready futures don't suspend
+        auto f = coroutineAdd(QtFuture::makeReadyFuture(2), QtFuture::makeReadyFuture(3));
+        QVERIFY(f.isFinished());
+        QCOMPARE(f.result(), 5);
+    }
+
+    {
+        // Resumes when the awaited future finishes
+        QPromise<int> promise;
+        int result = 0;
+        auto f = coroutineStore(promise.future(), &result);
+        QVERIFY(!f.isFinished());
+
+        promise.start();
+        promise.addResult(41);
+        promise.finish();
+        QVERIFY(f.isFinished());
+        QVERIFY(!f.isCanceled());
+        QCOMPARE(result, 42);
+    }
+
+    {
+        // Awaiting a signal
+        QObject sender;
+        auto f = [](QObject *sender) -> QtFuture::Coroutine<QString> {
+            co_return co_await QtFuture::connect(sender, &QObject::objectNameChanged);
+        }(&sender);
+        QVERIFY(!f.isFinished());
+        sender.setObjectName("name");
+        QTRY_VERIFY(f.isFinished());
+        QCOMPARE(f.result(), "name");
+    }
+
+#ifndef QT_NO_EXCEPTIONS
+    {
+        // Exceptions propagate through co_await
+        auto f = coroutineAdd(QtFuture::makeExceptionalFuture<int>(QException()),
+                              QtFuture::makeReadyFuture(1));
+        QVERIFY(f.isFinished());
+        QVERIFY_THROWS_EXCEPTION(QException, f.result());
+    }
+#endif
+}
+
+void tst_QFuture::coroutinesCanceled()
+{
+    {
+        // Canceling the awaited future cancels the coroutine
+        int result = 0;
+        QFuture<void> f;
+        {
+            QPromise<int> promise;
+            f = coroutineStore(promise.future(), &result);
+            QVERIFY(!f.isFinished());
+        }
+        QVERIFY(f.isFinished());
+        QVERIFY(f.isCanceled());
+        QCOMPARE(result, 0);
+    }
+
+    {
+        // Canceling the coroutine's future stops it at the next co_await
+        QPromise<int> promise;
+        int result = 0;
+        auto f = coroutineStore(promise.future(), &result);
+        f.cancel();
+        promise.start();
+        promise.addResult(1);
+        promise.finish();
+        QVERIFY(f.isFinished());
+        QVERIFY(f.isCanceled());
+        QCOMPARE(result, 0);
+    }
+}
+
+class CoroutineObject : public QObject
+{
+public:
+    QtFuture::Coroutine<void> run(QFuture<int> f)
+    {
+        co_await f;
+        resumedIn = QThread::currentThread();
+    }
+
+    QThread *resumedIn = nullptr;
+};
+
+void tst_QFuture::coroutinesResumeInContextThread()
+{
+    {
+        CoroutineObject object;
+        QPromise<int> promise;
+        QFuture<void> f = object.run(promise.future());
+
+        QScopedPointer<QThread> thread(QThread::create([&promise] {
+            promise.start();
+            promise.addResult(1);
+            promise.finish();
+        }));
+        thread->start();
+        QVERIFY(thread->wait());
+        QTRY_VERIFY(f.isFinished());
+        QVERIFY(!f.isCanceled());
+        QCOMPARE(object.resumedIn, QThread::currentThread());
+    }
+
+    {
+        // Not resumed once the context object is gone
+        auto object = std::make_unique<CoroutineObject>();
+        QPromise<int> promise;
+        QFuture<void> f = object->run(promise.future());
+        object.reset();
+
+        QScopedPointer<QThread> thread(QThread::create([&promise] {
+            promise.start();
+            promise.addResult(1);
+            promise.finish();
+        }));
+        thread->start();
+        QVERIFY(thread->wait());
+        QTRY_VERIFY(f.isFinished());
+        QVERIFY(f.isCanceled());
+    }
+
+    {
+        // Resumed in the thread that the context object lives in by then
+        QThread worker;
+        worker.start();
+        auto object = std::make_unique<CoroutineObject>();
+        QPromise<int> promise;
+        QFuture<void> f = object->run(promise.future());
+        object->moveToThread(&worker);
+
+        promise.start();
+        promise.addResult(1);
+        promise.finish();
+        QTRY_VERIFY(f.isFinished());
+        QVERIFY(!f.isCanceled());
+        QCOMPARE(object->resumedIn, &worker);
+        worker.quit();
+        QVERIFY(worker.wait());
+    }
+}
+#endif
+
 QTEST_MAIN(tst_QFuture)
 #include "tst_qfuture.moc"
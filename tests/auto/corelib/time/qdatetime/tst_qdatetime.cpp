@@ -59,6 +59,8 @@ private Q_SLOTS:
     void toString_rfcDate();
     void toString_enumformat();
     void toString_strformat();
+    void msecsSinceEpochToString_data();
+    void msecsSinceEpochToString();
 #endif
     void addDays();
     void addInvalid();
@@ -92,6 +94,7 @@ private Q_SLOTS:
 #if QT_CONFIG(datestring)
     void fromStringDateFormat_data();
     void fromStringDateFormat();
+    void msecsSinceEpochFromStrings();
 #  if QT_CONFIG(datetimeparser)
     void fromStringStringFormat_data();
     void fromStringStringFormat();
@@ -1083,6 +1086,78 @@ void tst_QDateTime::toString_rfcDate()
     QCOMPARE(actual, formatted);
 }
 
+void tst_QDateTime::msecsSinceEpochToString_data()
+{
+    QTest::addColumn<qint64>("msecs");
+    QTest::addColumn<int>("offset");
+    QTest::addColumn<QString>("iso");
+    QTest::addColumn<QString>("isoWithMs");
+    QTest::addColumn<QString>("rfc");
+
+    const qint64 pi =
+            QDateTime(QDate(2023, 3, 14), QTime(15, 9, 26, 535), Qt::UTC).toMSecsSinceEpoch();
+    const qint64 last =
+            QDateTime(QDate(9999, 12, 31), QTime(23, 59, 59, 999), Qt::UTC).toMSecsSinceEpoch();
+    QTest::newRow("epoch")
+        << qint64(0) << 0 << QString("1970-01-01T00:00:00Z")
+        << QString("1970-01-01T00:00:00.000Z") << QString("01 Jan 1970 00:00:00 +0000");
+    QTest::newRow("UTC")
+        << pi << 0 << QString("2023-03-14T15:09:26Z")
+        << QString("2023-03-14T15:09:26.535Z") << QString("14 Mar 2023 15:09:26 +0000");
+    QTest::newRow("positive offset")
+        << pi << 19800 << QString("2023-03-14T20:39:26+05:30")
+        << QString("2023-03-14T20:39:26.535+05:30") << QString("14 Mar 2023 20:39:26 +0530");
+    QTest::newRow("negative offset")
+        << pi << -28800 << QString("2023-03-14T07:09:26-08:00")
+        << QString("2023-03-14T07:09:26.535-08:00") << QString("14 Mar 2023 07:09:26 -0800");
+    QTest::newRow("seconds offset")
+        << pi << 30 << QString("2023-03-14T15:09:56+00:00")
+        << QString("2023-03-14T15:09:56.535+00:00") << QString("14 Mar 2023 15:09:56 +0000");
+    QTest::newRow("before epoch")
+        << QDateTime(QDate(1066, 10, 14), QTime(9, 0, 0, 1), Qt::UTC).toMSecsSinceEpoch() << 0
+        << QString("1066-10-14T09:00:00Z") << QString("1066-10-14T09:00:00.001Z")
+        << QString("14 Oct 1066 09:00:00 +0000");
+    QTest::newRow("first")
+        << QDateTime(QDate(1, 1, 1), QTime(0, 0), Qt::UTC).toMSecsSinceEpoch() << 0
+        << QString("0001-01-01T00:00:00Z") << QString("0001-01-01T00:00:00.000Z")
+        << QString("01 Jan 0001 00:00:00 +0000");
+    QTest::newRow("last")
+        << last << 0 << QString("9999-12-31T23:59:59Z") << QString("9999-12-31T23:59:59.999Z")
+        << QString("31 Dec 9999 23:59:59 +0000");
+    QTest::newRow("too late") << last << 3600 << QString() << QString() << QString();
+    QTest::newRow("BCE")
+        << QDateTime(QDate(-1, 12, 31), QTime(0, 0), Qt::UTC).toMSecsSinceEpoch() << 0
+        << QString() << QString() << QString();
+    QTest::newRow("overflow")
+        << std::numeric_limits<qint64>::max() << 3600 << QString() << QString() << QString();
+}
+
+void tst_QDateTime::msecsSinceEpochToString()
+{
+    QFETCH(qint64, msecs);
+    QFETCH(int, offset);
+    QFETCH(QString, iso);
+    QFETCH(QString, isoWithMs);
+    QFETCH(QString, rfc);
+
+    const QDateTime dateTime = QDateTime::fromMSecsSinceEpoch(msecs, Qt::OffsetFromUTC, offset);
+    const std::pair<Qt::DateFormat, QString> formats[] = {
+        { Qt::ISODate, iso }, { Qt::ISODateWithMs, isoWithMs }, { Qt::RFC2822Date, rfc }
+    };
+    for (const auto &[format, expected] : formats) {
+        char buffer[32];
+        const qsizetype length =
+                QDateTime::msecsSinceEpochToString(msecs, buffer, sizeof(buffer), format, offset);
+        QCOMPARE(QLatin1StringView(buffer, length), expected);
+        if (!expected.isEmpty()) {
+            QCOMPARE(dateTime.toString(format), expected);
+            // Too small a buffer:
+            QCOMPARE(QDateTime::msecsSinceEpochToString(msecs, buffer, length - 1, format, offset),
+                     qsizetype(0));
+        }
+    }
+}
+
 void tst_QDateTime::toString_enumformat()
 {
     QDateTime dt1(QDate(1995, 5, 20), QTime(12, 34, 56));
@@ -2709,6 +2784,67 @@ void tst_QDateTime::fromStringDateFormat()
 
     QDateTime dateTime = QDateTime::fromString(dateTimeStr, dateFormat);
     QCOMPARE(dateTime, expected);
+
+    bool ok = !dateTime.isValid();
+    const QByteArray utf8 = dateTimeStr.toUtf8();
+    qint64 msecs = QDateTime::msecsSinceEpochFromString(QUtf8StringView(utf8), dateFormat, &ok);
+    QCOMPARE(ok, dateTime.isValid());
+    QCOMPARE(msecs, ok ? dateTime.toMSecsSinceEpoch() : 0);
+
+    const QByteArray latin1 = dateTimeStr.toLatin1();
+    if (QString::fromLatin1(latin1) == dateTimeStr) {
+        ok = !dateTime.isValid();
+        msecs = QDateTime::msecsSinceEpochFromString(QLatin1StringView(latin1), dateFormat, &ok);
+        QCOMPARE(ok, dateTime.isValid());
+        QCOMPARE(msecs, ok ? dateTime.toMSecsSinceEpoch() : 0);
+    }
+}
+
+void tst_QDateTime::msecsSinceEpochFromStrings()
+{
+    const QLatin1StringView strings[] = {
+        "2023-03-14T15:09:26.535Z"_L1,
+        "2023-03-14T15:09:26.535+01:00"_L1,
+        "2023-03-14 15:09:26,5358979-0530"_L1,
+        "2023-02-29T00:00:00Z"_L1,
+        "2023-03-14T24:00Z"_L1,
+        "2023-03-14T23:59:59.9999Z"_L1,
+        "not a date"_L1,
+        ""_L1,
+    };
+    constexpr qsizetype count = std::size(strings);
+    const qint64 invalid = std::numeric_limits<qint64>::min();
+    const QDateTime pi(QDate(2023, 3, 14), QTime(15, 9, 26, 535), Qt::UTC);
+    const QDateTime midnight(QDate(2023, 3, 15), QTime(0, 0), Qt::UTC);
+    const qint64 expected[count] = {
+        pi.toMSecsSinceEpoch(), pi.addSecs(-3600).toMSecsSinceEpoch(),
+        pi.addMSecs(1).addSecs(19800).toMSecsSinceEpoch(), invalid,
+        midnight.toMSecsSinceEpoch(), midnight.toMSecsSinceEpoch(), invalid, invalid
+    };
+
+    qint64 msecs[count] = {};
+    QCOMPARE(QDateTime::msecsSinceEpochFromStrings(strings, msecs, count, Qt::ISODate), qsizetype(5));
+    for (qsizetype i = 0; i < count; ++i)
+        QCOMPARE(msecs[i], expected[i]);
+
+    QUtf8StringView utf8[count];
+    for (qsizetype i = 0; i < count; ++i)
+        utf8[i] = QUtf8StringView(strings[i].data(), strings[i].size());
+    std::fill(std::begin(msecs), std::end(msecs), 0);
+    QCOMPARE(QDateTime::msecsSinceEpochFromStrings(utf8, msecs, count, Qt::ISODate), qsizetype(5));
+    for (qsizetype i = 0; i < count; ++i)
+        QCOMPARE(msecs[i], expected[i]);
+
+    const QLatin1StringView rfc[] = {
+        "Tue, 14 Mar 2023 15:09:26 +0000"_L1,
+        "14 Mar 2023 16:09 +0100"_L1,
+        "Wed, 14 Mar 2023 15:09:26 +0000"_L1, // Wrong day of the week
+    };
+    QCOMPARE(QDateTime::msecsSinceEpochFromStrings(rfc, msecs, std::size(rfc), Qt::RFC2822Date),
+             qsizetype(2));
+    QCOMPARE(msecs[0], pi.addMSecs(-535).toMSecsSinceEpoch());
+    QCOMPARE(msecs[1], pi.addSecs(-26).addMSecs(-535).toMSecsSinceEpoch());
+    QCOMPARE(msecs[2], invalid);
 }
 
 # if QT_CONFIG(datetimeparser)
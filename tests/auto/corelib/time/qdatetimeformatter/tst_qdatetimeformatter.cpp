@@ -0,0 +1,172 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <qdatetimeformatter.h>
+#if QT_CONFIG(timezone)
+#include <qtimezone.h>
+#endif
+
+using namespace Qt::StringLiterals;
+
+class tst_QDateTimeFormatter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultConstructor();
+    void accessors();
+    void matchesLocale_data();
+    void matchesLocale();
+    void timeZone();
+    void invalid();
+    void formatTo();
+    void copy();
+};
+
+void tst_QDateTimeFormatter::defaultConstructor()
+{
+    const QDateTimeFormatter formatter;
+    QVERIFY(formatter.format().isEmpty());
+    QVERIFY(formatter.toString(QDateTime(QDate(2022, 11, 4), QTime(12, 0))).isEmpty());
+}
+
+void tst_QDateTimeFormatter::accessors()
+{
+    const QLocale locale(QLocale::Persian, QLocale::Iran);
+    const QCalendar calendar(QCalendar::System::Julian);
+    const QDateTimeFormatter formatter(u"yyyy-MM-dd", locale, calendar);
+    QCOMPARE(formatter.format(), u"yyyy-MM-dd"_s);
+    QCOMPARE(formatter.locale(), locale);
+    QCOMPARE(formatter.calendar().name(), calendar.name());
+}
+
+void tst_QDateTimeFormatter::matchesLocale_data()
+{
+    QTest::addColumn<QString>("format");
+
+    QTest::newRow("iso-like") << u"yyyy-MM-ddTHH:mm:ss.zzz"_s;
+    QTest::newRow("names") << u"dddd d MMMM yyyy"_s;
+    QTest::newRow("short-names") << u"ddd, dd MMM yy"_s;
+    QTest::newRow("ampm-upper") << u"h:mm:ss AP"_s;
+    QTest::newRow("ampm-lower") << u"hh:mm a"_s;
+    QTest::newRow("ampm-verbatim") << u"h 'h' Ap, aP"_s;
+    QTest::newRow("msec-chopped") << u"s.z"_s;
+    QTest::newRow("repeats") << u"yyyyyy MMMMM ddddd hhh HHH mmm sss zzzz y"_s;
+    QTest::newRow("quotes") << u"'It''s' H 'o''clock' '' 'yyyy'"_s;
+    QTest::newRow("unknown-letters") << u"[qwerty] xx Q"_s;
+    QTest::newRow("unterminated-quote") << u"HH:mm 'at dd"_s;
+    QTest::newRow("empty") << QString();
+}
+
+void tst_QDateTimeFormatter::matchesLocale()
+{
+    QFETCH(QString, format);
+
+    QList<QCalendar> calendars = { QCalendar(), QCalendar(QCalendar::System::Julian) };
+#if QT_CONFIG(jalalicalendar)
+    calendars.append(QCalendar(QCalendar::System::Jalali));
+#endif
+#if QT_CONFIG(islamiccivilcalendar)
+    calendars.append(QCalendar(QCalendar::System::IslamicCivil));
+#endif
+
+    const QDate dates[] = {
+        QDate(2022, 1, 1), QDate(1999, 12, 31), QDate(2024, 2, 29), QDate(5, 6, 7),
+        QDate(-44, 3, 15), QDate(-1, 1, 1), QDate(12345, 10, 20)
+    };
+    const QTime times[] = {
+        QTime(0, 0), QTime(0, 30, 5, 1), QTime(11, 59, 59, 999), QTime(12, 0, 0, 500),
+        QTime(13, 7, 9, 50), QTime(23, 45, 0, 120)
+    };
+
+    for (const char *name : { "C", "en_US", "de_DE", "ar_EG", "fa_IR", "ccp_BD", "ko_KR" }) {
+        const QLocale locale{QLatin1StringView(name)};
+        for (const QCalendar &calendar : calendars) {
+            const QDateTimeFormatter formatter(format, locale, calendar);
+            for (QDate date : dates) {
+                QCOMPARE(formatter.toString(date), locale.toString(date, format, calendar));
+                for (QTime time : times) {
+                    const QDateTime dateTime(date, time, Qt::UTC);
+                    QCOMPARE(formatter.toString(dateTime),
+                             locale.toString(dateTime, format, calendar));
+                }
+            }
+            for (QTime time : times)
+                QCOMPARE(formatter.toString(time), locale.toString(time, format));
+        }
+    }
+}
+
+void tst_QDateTimeFormatter::timeZone()
+{
+    const QLocale locale = QLocale::c();
+    const QDateTimeFormatter formatter(u"yyyy-MM-dd HH:mm t tt ttt tttt"_s, locale);
+
+    QList<QDateTime> dateTimes = {
+        QDateTime(QDate(2022, 7, 1), QTime(12, 0), Qt::UTC),
+        QDateTime(QDate(2022, 7, 1), QTime(12, 0), Qt::OffsetFromUTC, 5 * 3600 + 1800),
+        QDateTime(QDate(2022, 1, 1), QTime(12, 0), Qt::OffsetFromUTC, -8 * 3600),
+        QDateTime(QDate(2022, 7, 1), QTime(12, 0), Qt::LocalTime),
+    };
+#if QT_CONFIG(timezone)
+    const QTimeZone berlin("Europe/Berlin");
+    if (berlin.isValid()) {
+        dateTimes.append(QDateTime(QDate(2022, 7, 1), QTime(12, 0), berlin));
+        dateTimes.append(QDateTime(QDate(2022, 12, 1), QTime(12, 0), berlin));
+    }
+#endif
+    for (const QDateTime &dateTime : std::as_const(dateTimes))
+        QCOMPARE(formatter.toString(dateTime), locale.toString(dateTime, formatter.format()));
+}
+
+void tst_QDateTimeFormatter::invalid()
+{
+    const QDateTimeFormatter formatter(u"yyyy-MM-dd HH:mm"_s, QLocale::c());
+    QVERIFY(formatter.toString(QDateTime()).isEmpty());
+    QVERIFY(formatter.toString(QDate()).isEmpty());
+    QVERIFY(formatter.toString(QTime()).isEmpty());
+
+    QChar buffer[4];
+    QCOMPARE(formatter.formatTo(buffer, 4, QDate()), qsizetype(0));
+}
+
+void tst_QDateTimeFormatter::formatTo()
+{
+    const QDateTimeFormatter formatter(u"dddd, d MMMM yyyy"_s,
+                                       QLocale(QLocale::English, QLocale::UnitedKingdom));
+    const QDate date(2022, 11, 4);
+    const QString expected = u"Friday, 4 November 2022"_s;
+
+    QChar buffer[32];
+    std::fill(std::begin(buffer), std::end(buffer), u'#');
+    qsizetype length = formatter.formatTo(buffer, 32, date);
+    QCOMPARE(QStringView(buffer, length), expected);
+    QCOMPARE(buffer[length], u'#');
+
+    // Too little room: only the start is written, but the full length returned
+    std::fill(std::begin(buffer), std::end(buffer), u'#');
+    length = formatter.formatTo(buffer, 10, date);
+    QCOMPARE(length, expected.size());
+    QCOMPARE(QStringView(buffer, 11), u"Friday, 4 #");
+    QCOMPARE(formatter.formatTo(nullptr, 0, date), expected.size());
+}
+
+void tst_QDateTimeFormatter::copy()
+{
+    QDateTimeFormatter formatter(u"d/M/yy"_s);
+    QDateTimeFormatter copy = formatter;
+    QCOMPARE(copy.format(), u"d/M/yy"_s);
+
+    copy = QDateTimeFormatter(u"yyyy"_s);
+    QCOMPARE(copy.toString(QDate(2022, 11, 4)), u"2022"_s);
+    QCOMPARE(formatter.format(), u"d/M/yy"_s);
+
+    QDateTimeFormatter moved = std::move(copy);
+    QCOMPARE(moved.format(), u"yyyy"_s);
+}
+
+QTEST_APPLESS_MAIN(tst_QDateTimeFormatter)
+
+#include "tst_qdatetimeformatter.moc"
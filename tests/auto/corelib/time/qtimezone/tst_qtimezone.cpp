@@ -1256,6 +1256,26 @@ void tst_QTimeZone::tzTest()
     QCOMPARE(dat.standardTimeOffset, 3600);
     QCOMPARE(dat.daylightTimeOffset, 0);
 
+    // Transitions the POSIX rule implies are precomputed for some decades;
+    // walk through the end of those from the file, and past the precomputed
+    // ones, without losing any:
+    dat = tzp.nextTransition(QDate(2030, 1, 1).startOfDay(Qt::UTC).toMSecsSinceEpoch());
+    for (int year = 2030; year < 2130; ++year) {
+        for (bool summer : { true, false }) {
+            QCOMPARE(QDateTime::fromMSecsSinceEpoch(dat.atMSecsSinceEpoch, Qt::UTC).date().year(),
+                     year);
+            QCOMPARE(dat.abbreviation, summer ? QStringLiteral("CEST") : QStringLiteral("CET"));
+            QCOMPARE(dat.daylightTimeOffset, summer ? 3600 : 0);
+            QCOMPARE(tzp.offsetFromUtc(dat.atMSecsSinceEpoch), dat.offsetFromUtc);
+            QCOMPARE(tzp.daylightTimeOffset(dat.atMSecsSinceEpoch - 1), summer ? 0 : 3600);
+            QCOMPARE(tzp.data(dat.atMSecsSinceEpoch - 1).offsetFromUtc,
+                     tzp.offsetFromUtc(dat.atMSecsSinceEpoch - 1));
+            const qint64 at = dat.atMSecsSinceEpoch;
+            dat = tzp.nextTransition(at);
+            QCOMPARE(tzp.previousTransition(dat.atMSecsSinceEpoch).atMSecsSinceEpoch, at);
+        }
+    }
+
     // Test TZ timezone vs UTC timezone for non-whole-hour negative offset:
     QTzTimeZonePrivate  tztz1("America/Caracas");
     QUtcTimeZonePrivate tzutc1("UTC-04:30");
@@ -4,14 +4,25 @@
 
 #include <QtCore/QCoreApplication>
 #include <QTest>
+#include <QBuffer>
 #include <QScopeGuard>
+#include <QScopedValueRollback>
 #include <QCryptographicHash>
+#include <QTemporaryFile>
 #include <QtCore/QMetaEnum>
+#include <QtCore/private/qsimd_p.h>
 
 #if QT_CONFIG(cxx11_future)
 #  include <thread>
 #endif
 
+// Mirrors the condition for the SHA extensions in qcryptographichash.cpp
+#if defined(QT_BUILD_INTERNAL) && defined(Q_PROCESSOR_X86) \
+    && QT_COMPILER_SUPPORTS_HERE(SHA) && QT_COMPILER_SUPPORTS_HERE(SSE4_1) \
+    && !(QT_CONFIG(opensslv30) && QT_CONFIG(openssl_linked))
+#  define TST_QCRYPTOGRAPHICHASH_FORCE_LANES
+#endif
+
 Q_DECLARE_METATYPE(QCryptographicHash::Algorithm)
 
 class tst_QCryptographicHash : public QObject
@@ -27,6 +38,18 @@ private slots:
     void sha3();
     void blake2_data();
     void blake2();
+    void blake3_data();
+    void blake3();
+    void blockBoundaries_data();
+    void blockBoundaries();
+    void devices_data();
+    void devices();
+    void hashMany_data();
+    void hashMany();
+#ifdef TST_QCRYPTOGRAPHICHASH_FORCE_LANES
+    void hashManyLanes_data() { hashMany_data(); }
+    void hashManyLanes();
+#endif
     void files_data();
     void files();
     void hashLength_data();
@@ -358,6 +381,235 @@ void tst_QCryptographicHash::blake2()
     QCOMPARE(result, expectedResult);
 }
 
+// The input of the official BLAKE3 test vectors
+static QByteArray blake3TestInput(qsizetype size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (qsizetype i = 0; i < size; ++i)
+        data[i] = char(i % 251);
+    return data;
+}
+
+void tst_QCryptographicHash::blake3_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QByteArray>("expectedResult");
+
+    QTest::newRow("empty") << QByteArray()
+        << QByteArray::fromHex("af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262");
+    QTest::newRow("abc") << QByteArray("abc")
+        << QByteArray::fromHex("6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85");
+    QTest::newRow("pangram") << QByteArray("The quick brown fox jumps over the lazy dog")
+        << QByteArray::fromHex("2f1514181aadccd913abd94cfa592701a5686ab23f8df1dff1b74710febc6d4a");
+
+    const auto row = [](qsizetype size, const char *result) {
+        QTest::addRow("%lld", qlonglong(size)) << blake3TestInput(size) << QByteArray::fromHex(result);
+    };
+    row(1, "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213");
+    row(1023, "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11");
+    row(1024, "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7");
+    row(1025, "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444");
+    row(2048, "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a");
+    row(2049, "5f4d72f40d7a5f82b15ca2b2e44b1de3c2ef86c426c95c1af0b6879522563030");
+    row(3072, "b98cb0ff3623be03326b373de6b9095218513e64f1ee2edd2525c7ad1e5cffd2");
+    row(3073, "7124b49501012f81cc7f11ca069ec9226cecb8a2c850cfe644e327d22d3e1cd3");
+    row(4096, "015094013f57a5277b59d8475c0501042c0b642e531b0a1c8f58d2163229e969");
+    row(4097, "9b4052b38f1c5fc8b1f9ff7ac7b27cd242487b3d890d15c96a1c25b8aa0fb995");
+    row(5120, "9cadc15fed8b5d854562b26a9536d9707cadeda9b143978f319ab34230535833");
+    row(5121, "628bd2cb2004694adaab7bbd778a25df25c47b9d4155a55f8fbd79f2fe154cff");
+    row(6144, "3e2e5b74e048f3add6d21faab3f83aa44d3b2278afb83b80b3c35164ebeca205");
+    row(6145, "f1323a8631446cc50536a9f705ee5cb619424d46887f3c376c695b70e0f0507f");
+    row(7168, "61da957ec2499a95d6b8023e2b0e604ec7f6b50e80a9678b89d2628e99ada77a");
+    row(7169, "a003fc7a51754a9b3c7fae0367ab3d782dccf28855a03d435f8cfe74605e7817");
+    row(8192, "aae792484c8efe4f19e2ca7d371d8c467ffb10748d8a5a1ae579948f718a2a63");
+    row(8193, "bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b");
+    row(16384, "f875d6646de28985646f34ee13be9a576fd515f76b5b0a26bb324735041ddde4");
+    row(31744, "62b6960e1a44bcc1eb1a611a8d6235b6b4b78f32e7abc4fb4c6cdcce94895c47");
+    row(102400, "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085");
+    // large enough to be hashed on several threads
+    row(1024 * 1024, "74cb441fd087764ca9c3694da742ebe30cbeb3060a17009ca81825c7a8d10343");
+    row(3 * 1024 * 1024 + 5, "a7bb55bed0c04f58879d1fc1cafb27e14e931f4411fe63baf5b2d5a60357bffb");
+    row(17 * 1024 * 1024 + 1, "4f63a14b81a965e0d82c230882d1a69193f42b5e6826ff97d0c8dd8fd80331ae");
+}
+
+void tst_QCryptographicHash::blake3()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QByteArray, expectedResult);
+
+    QCOMPARE(QCryptographicHash::hash(data, QCryptographicHash::Blake3_256), expectedResult);
+
+    // feeding the data in pieces must not change the tree
+    for (qsizetype step : { 1, 63, 1000, 1024, 5000, 1024 * 1024 + 1 }) {
+        if (step < 1000 && data.size() > 100'000)
+            continue;
+        QCryptographicHash hash(QCryptographicHash::Blake3_256);
+        for (qsizetype i = 0; i < data.size(); i += step)
+            hash.addData(QByteArrayView(data).sliced(i, qMin(step, data.size() - i)));
+        QCOMPARE(hash.resultView(), expectedResult);
+    }
+}
+
+void tst_QCryptographicHash::blockBoundaries_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<QByteArray>("expectedResult");
+
+    // 1000 bytes of the BLAKE3 test input
+    QTest::newRow("sha1") << QCryptographicHash::Sha1
+        << QByteArray::fromHex("c9c960a0b925474fab83942cc27d504fc24ac37b");
+    QTest::newRow("sha224") << QCryptographicHash::Sha224
+        << QByteArray::fromHex("c182669a7f6629dc7fd8a9198f15af15adbbaeffa1842e854f681357");
+    QTest::newRow("sha256") << QCryptographicHash::Sha256
+        << QByteArray::fromHex("4e4c294b331f7a2099a379bec34b9f9fc03dc46ab465d998f4d683da53487e6d");
+    QTest::newRow("sha384") << QCryptographicHash::Sha384
+        << QByteArray::fromHex("7a2f8c7f12344964a13cb9260492b845e56615d6152b9eb9e54b580fc88405e6"
+                               "4f31813bfda10de2a642fdf1676c61b4");
+    QTest::newRow("sha512") << QCryptographicHash::Sha512
+        << QByteArray::fromHex("5096498d96f50f9a137c4db5b8b0cd38383ad55350fb5a98805fedc31fa1262f"
+                               "1f0cf4d6f12d7ecd8dedd933a4c9126344fe22e937a8ad35fdeae1e876ae698b");
+    QTest::newRow("blake3") << QCryptographicHash::Blake3_256
+        << QByteArray::fromHex("b43670a52d1af24abdac5d2c3ed19ff4e62b60a618e823ad555888b1b0b91cff");
+}
+
+void tst_QCryptographicHash::blockBoundaries()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+    QFETCH(const QByteArray, expectedResult);
+
+    // whole blocks take a different path than partial ones
+    const QByteArray data = blake3TestInput(1000);
+    for (qsizetype step : { 1, 7, 63, 64, 65, 127, 128, 129, 500, 1000 }) {
+        QCryptographicHash hash(algorithm);
+        for (qsizetype i = 0; i < data.size(); i += step)
+            hash.addData(QByteArrayView(data).sliced(i, qMin(step, data.size() - i)));
+        QCOMPARE(hash.resultView(), expectedResult);
+    }
+    QCryptographicHash hash(algorithm);
+    hash.addData(QByteArrayView(data).first(3));
+    hash.addData(QByteArrayView(data).sliced(3, 900));
+    hash.addData(QByteArrayView(data).sliced(903));
+    QCOMPARE(hash.resultView(), expectedResult);
+}
+
+void tst_QCryptographicHash::devices_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<qsizetype>("size");
+    QTest::addColumn<qsizetype>("offset");
+
+    for (auto algorithm : { QCryptographicHash::Sha256, QCryptographicHash::Blake3_256 }) {
+        const char *name = QMetaEnum::fromType<QCryptographicHash::Algorithm>().valueToKey(algorithm);
+        QTest::addRow("%s-small", name) << algorithm << qsizetype(1000) << qsizetype(0);
+        QTest::addRow("%s-large", name) << algorithm << qsizetype(2 * 1024 * 1024 + 3) << qsizetype(0);
+        QTest::addRow("%s-large-offset", name) << algorithm << qsizetype(2 * 1024 * 1024 + 3)
+                                               << qsizetype(4097);
+    }
+}
+
+void tst_QCryptographicHash::devices()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+    QFETCH(const qsizetype, size);
+    QFETCH(const qsizetype, offset);
+
+    QByteArray data = blake3TestInput(size);
+    const QByteArray expected = QCryptographicHash::hash(QByteArrayView(data).sliced(offset),
+                                                         algorithm);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), qint64(size));
+    QVERIFY(file.seek(offset));
+    QCOMPARE(QCryptographicHash::hashDevice(&file, algorithm), expected);
+    QVERIFY(file.atEnd());
+
+    QVERIFY(file.seek(offset));
+    QCryptographicHash hash(algorithm);
+    QVERIFY(hash.addData(&file));
+    QCOMPARE(hash.resultView(), expected);
+
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QVERIFY(buffer.seek(offset));
+    QCOMPARE(QCryptographicHash::hashDevice(&buffer, algorithm), expected);
+
+    buffer.close();
+    QVERIFY(QCryptographicHash::hashDevice(&buffer, algorithm).isNull());
+    QVERIFY(QCryptographicHash::hashDevice(nullptr, algorithm).isNull());
+
+    // hashing empty data is not ambiguous with hashing a device
+    const QByteArray empty = QCryptographicHash::hash(QByteArrayView(), algorithm);
+    QVERIFY(!empty.isEmpty());
+    QCOMPARE(QCryptographicHash::hash({}, algorithm), empty);
+    QCOMPARE(QCryptographicHash::hash(nullptr, algorithm), empty);
+    QCOMPARE(QCryptographicHash::hash(0, algorithm), empty);
+}
+
+void tst_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<QList<qsizetype>>("lengths");
+
+    // lengths around the block sizes, with groups of equal and of mixed
+    // lengths, and a last group that is not complete
+    QList<qsizetype> mixed(8, 60);
+    mixed += { 0, 55, 56, 63, 64, 65, 71, 72, 103, 104, 135, 136, 143, 144,
+               4096, 1, 200, 300, 64, 64, 64, 64, 64, 64, 64, 64 };
+    for (int i = 0; i < 8; ++i)
+        mixed.append(136 * 3);
+    for (int i = 0; i < 11; ++i)
+        mixed.append(1000 + i);
+    // enough data to be split across threads
+    const QList<qsizetype> large(300, 4096);
+
+    auto metaEnum = QMetaEnum::fromType<QCryptographicHash::Algorithm>();
+    for (int i = 0, value = metaEnum.value(i); value != -1; value = metaEnum.value(++i)) {
+        auto algorithm = QCryptographicHash::Algorithm(value);
+        QTest::addRow("%s-empty", metaEnum.key(i)) << algorithm << QList<qsizetype>();
+        QTest::addRow("%s-mixed", metaEnum.key(i)) << algorithm << mixed;
+        QTest::addRow("%s-large", metaEnum.key(i)) << algorithm << large;
+    }
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+    QFETCH(const QList<qsizetype>, lengths);
+
+    qsizetype total = 0;
+    for (qsizetype length : lengths)
+        total += length;
+    const QByteArray data = blake3TestInput(total + lengths.size());
+
+    // messages at different offsets, so that they differ from each other
+    QList<QByteArrayView> messages;
+    qsizetype offset = 0;
+    for (qsizetype length : lengths) {
+        messages.append(QByteArrayView(data).sliced(offset, length));
+        offset += length + 1;
+    }
+
+    const QByteArrayList results = QCryptographicHash::hashMany(messages, algorithm);
+    QCOMPARE(results.size(), messages.size());
+    for (qsizetype i = 0; i < messages.size(); ++i)
+        QCOMPARE(results.at(i), QCryptographicHash::hash(messages.at(i), algorithm));
+}
+
+#ifdef TST_QCRYPTOGRAPHICHASH_FORCE_LANES
+QT_BEGIN_NAMESPACE
+extern Q_AUTOTEST_EXPORT int qt_cryptographichash_force_lanes;
+QT_END_NAMESPACE
+
+void tst_QCryptographicHash::hashManyLanes()
+{
+    // the AVX2 lanes for SHA-256 even on CPUs with the SHA extensions
+    QScopedValueRollback<int> forceLanes(qt_cryptographichash_force_lanes);
+    qt_cryptographichash_force_lanes++;
+    hashMany();
+}
+#endif
+
 void tst_QCryptographicHash::files_data() {
     QTest::addColumn<QString>("filename");
     QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
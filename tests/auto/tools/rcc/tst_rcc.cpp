@@ -15,6 +15,7 @@
 #include <QtCore/QList>
 #include <QtCore/QResource>
 #include <QtCore/QLocale>
+#include <QtCore/QTemporaryDir>
 #include <QtCore/QtGlobal>
 
 #include <algorithm>
@@ -70,6 +71,9 @@ private slots:
 
     void python();
 
+    void duplicateFiles();
+    void parallelCompression();
+
     void cleanupTestCase();
 
 private:
@@ -467,10 +471,105 @@ void tst_rcc::python()
         QFAIL(qPrintable(diff));
 }
 
+static bool writeFile(const QString &fileName, const QByteArray &contents)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && file.write(contents) == contents.size();
+}
+
+static QByteArray runRcc(const QString &rcc, const QString &directory, const QStringList &arguments)
+{
+    QProcess process;
+    process.setWorkingDirectory(directory);
+    process.start(rcc, arguments);
+    if (!process.waitForStarted())
+        return msgProcessStartFailed(process);
+    if (!process.waitForFinished()) {
+        process.kill();
+        return msgProcessTimeout(process);
+    }
+    if (process.exitStatus() != QProcess::NormalExit)
+        return msgProcessCrashed(process);
+    if (process.exitCode() != 0)
+        return msgProcessFailed(process);
+    return QByteArray();
+}
+
+void tst_rcc::duplicateFiles()
+{
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+
+    const QByteArray contents(1000, 'a');
+    QVERIFY(writeFile(dir.filePath("a.txt"), contents));
+    QVERIFY(writeFile(dir.filePath("b.txt"), contents));
+    QVERIFY(writeFile(dir.filePath("c.txt"), contents + 'c'));
+    QVERIFY(writeFile(dir.filePath("duplicates.qrc"),
+                      "<RCC><qresource prefix=\"/duplicates\">"
+                      "<file>a.txt</file><file>b.txt</file><file>c.txt</file>"
+                      "</qresource></RCC>"));
+
+    const QString rccFile = dir.filePath("duplicates.rcc");
+    const QByteArray error = runRcc(m_rcc, dir.path(),
+                                    { "-binary", "-o", rccFile, "duplicates.qrc" });
+    QVERIFY2(error.isEmpty(), error.constData());
+    QVERIFY(QResource::registerResource(rccFile));
+    auto unregister = qScopeGuard([&] { QResource::unregisterResource(rccFile); });
+
+    // identical files share their data
+    QResource a(":/duplicates/a.txt");
+    QResource b(":/duplicates/b.txt");
+    QResource c(":/duplicates/c.txt");
+    QVERIFY(a.isValid());
+    QVERIFY(b.isValid());
+    QVERIFY(c.isValid());
+    QCOMPARE(a.data(), b.data());
+    QVERIFY(a.data() != c.data());
+    QCOMPARE(a.uncompressedData(), contents);
+    QCOMPARE(b.uncompressedData(), contents);
+    QCOMPARE(c.uncompressedData(), contents + 'c');
+}
+
+void tst_rcc::parallelCompression()
+{
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+
+    QByteArray qrc = "<RCC><qresource>";
+    for (int i = 0; i < 50; ++i) {
+        const QString fileName = QString("file%1.txt").arg(i);
+        QVERIFY(writeFile(dir.filePath(fileName), QByteArray::number(i).repeated(1000)));
+        qrc += "<file>" + fileName.toLatin1() + "</file>";
+    }
+    qrc += "</qresource></RCC>";
+    QVERIFY(writeFile(dir.filePath("files.qrc"), qrc));
+
+    auto generate = [&](const QString &output, const QStringList &options) {
+        const QByteArray error = runRcc(m_rcc, dir.path(),
+                                        QStringList{ "-o", output } + options + QStringList{ "files.qrc" });
+        QFile file(dir.filePath(output));
+        if (!error.isEmpty() || !file.open(QIODevice::ReadOnly))
+            return QByteArray();
+        return file.readAll();
+    };
+
+    // the output does not depend on the number of threads, or on the cache
+    const QByteArray serial = generate("serial.cpp", { "-j", "1" });
+    QVERIFY(!serial.isEmpty());
+    QCOMPARE(generate("parallel.cpp", { "-j", "4" }), serial);
+
+    const QString cacheDir = dir.filePath("cache");
+    QCOMPARE(generate("cached1.cpp", { "--cache-dir", cacheDir }), serial);
+    QCOMPARE(QDir(cacheDir).entryList(QDir::Files).size(), 50);
+    QCOMPARE(generate("cached2.cpp", { "--cache-dir", cacheDir }), serial);
+}
+
 void tst_rcc::cleanupTestCase()
 {
     QDir dataDir(m_dataPath + QLatin1String("/binary"));
     QFileInfoList entries = dataDir.entryInfoList(QStringList() << QLatin1String("*.rcc"));
+    QDir dataSizesDir(m_dataPath + QLatin1String("/sizes"));
+    entries += dataSizesDir.entryInfoList(QStringList() << QLatin1String("*.rcc"));
     QDir dataDepDir(m_dataPath + QLatin1String("/depfile"));
     entries += dataDepDir.entryInfoList({QLatin1String("*.d"), QLatin1String("*.qrc.cpp")});
     foreach (const QFileInfo &entry, entries)
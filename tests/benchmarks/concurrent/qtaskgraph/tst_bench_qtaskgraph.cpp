@@ -0,0 +1,97 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QThreadPool>
+#include <QtConcurrent/qtaskgraph.h>
+
+using namespace QtConcurrent;
+
+class tst_QTaskGraph : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void independentTasks_data() { nodeCounts(); }
+    void independentTasks();
+    void chain_data() { nodeCounts(); }
+    void chain();
+    void layered_data() { nodeCounts(); }
+    void layered();
+
+private:
+    void nodeCounts();
+};
+
+static void noop()
+{
+}
+
+void tst_QTaskGraph::nodeCounts()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("100k") << 100000;
+}
+
+// Measures the per-task overhead of dispatching to the pool.
+void tst_QTaskGraph::independentTasks()
+{
+    QFETCH(int, count);
+
+    QTaskGraph graph;
+    for (int i = 0; i < count; ++i)
+        graph.addTask(noop);
+
+    QThreadPool pool;
+    QBENCHMARK {
+        graph.run(&pool).waitForFinished();
+    }
+}
+
+// Measures the per-task overhead of releasing a dependent, which
+// continues inline on the same thread.
+void tst_QTaskGraph::chain()
+{
+    QFETCH(int, count);
+
+    QTaskGraph graph;
+    for (int i = 0; i < count; ++i) {
+        graph.addTask(noop);
+        if (i > 0)
+            graph.addDependency(i, i - 1);
+    }
+
+    QThreadPool pool;
+    QBENCHMARK {
+        graph.run(&pool).waitForFinished();
+    }
+}
+
+// Layers of 100 tasks, each depending on two tasks of the previous layer.
+void tst_QTaskGraph::layered()
+{
+    QFETCH(int, count);
+    const int width = 100;
+
+    QTaskGraph graph;
+    for (int i = 0; i < count; ++i) {
+        graph.addTask(noop);
+        if (i >= width) {
+            const int column = i % width;
+            const int previousLayer = i - column - width;
+            graph.addDependency(i, previousLayer + column);
+            graph.addDependency(i, previousLayer + (column + 1) % width);
+        }
+    }
+
+    QThreadPool pool;
+    QBENCHMARK {
+        graph.run(&pool).waitForFinished();
+    }
+}
+
+QTEST_MAIN(tst_QTaskGraph)
+
+#include "tst_bench_qtaskgraph.moc"
@@ -2,7 +2,11 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 #include <QDebug>
 #include <QDirIterator>
+#if QT_CONFIG(future)
+#include <QFuture>
+#endif
 #include <QString>
+#include <QTemporaryDir>
 #include <qplatformdefs.h>
 
 #ifdef Q_OS_WIN
@@ -27,19 +31,44 @@ class tst_QDirIterator : public QObject
 {
     Q_OBJECT
 
+    QList<std::pair<QByteArray, QByteArray>> directories() const;
     void data();
+
+    QTemporaryDir generatedTree;
 private slots:
+    void initTestCase();
     void posix();
     void posix_data() { data(); }
     void diriterator();
     void diriterator_data() { data(); }
+    void diriteratorFilters();
+    void diriteratorFilters_data();
+    void walkParallel();
+    void walkParallel_data() { data(); }
     void fsiterator();
     void fsiterator_data() { data(); }
     void stdRecursiveDirectoryIterator();
     void stdRecursiveDirectoryIterator_data() { data(); }
 };
 
-void tst_QDirIterator::data()
+void tst_QDirIterator::initTestCase()
+{
+    // A tree of small directories, like the ones of a source checkout, but
+    // with more entries than the Qt sources provide
+    QVERIFY2(generatedTree.isValid(), qPrintable(generatedTree.errorString()));
+    QDir root(generatedTree.path());
+    for (int i = 0; i < 64; ++i) {
+        const QString dirName = QString::number(i);
+        QVERIFY(root.mkpath(dirName + "/sub"));
+        for (int j = 0; j < 128; ++j) {
+            const QString name = dirName + (j % 2 ? "/sub/" : "/") + QString::number(j);
+            QFile file(root.filePath(name));
+            QVERIFY2(file.open(QIODevice::WriteOnly), qPrintable(file.errorString()));
+        }
+    }
+}
+
+QList<std::pair<QByteArray, QByteArray>> tst_QDirIterator::directories() const
 {
     const char hereRelative[] = "tests/benchmarks/corelib/io/qdiriterator";
     QByteArray dir(QT_TESTCASE_SOURCEDIR);
@@ -47,14 +76,27 @@ void tst_QDirIterator::data()
     dir.chop(sizeof(hereRelative)); // Counts the '\0', making up for the omitted leading '/'
     // qDebug("Root dir: %s", dir.constData());
 
-    QTest::addColumn<QByteArray>("dirpath");
     const QByteArray ba = dir + "/src/corelib";
-
     if (!QFileInfo(QString::fromLocal8Bit(ba)).isDir())
+        return {};
+
+    return {
+        { "corelib", ba },
+        { "corelib/io", ba + "/io" },
+        { "generated", QFile::encodeName(generatedTree.path()) },
+    };
+}
+
+void tst_QDirIterator::data()
+{
+    QTest::addColumn<QByteArray>("dirpath");
+
+    const auto dirs = directories();
+    if (dirs.isEmpty())
         QSKIP("Missing Qt directory");
 
-    QTest::newRow("corelib") << ba;
-    QTest::newRow("corelib/io") << (ba + "/io");
+    for (const auto &dir : dirs)
+        QTest::newRow(dir.first.constData()) << dir.second;
 }
 
 #ifdef Q_OS_WIN
@@ -178,6 +220,72 @@ void tst_QDirIterator::diriterator()
     qDebug() << count;
 }
 
+void tst_QDirIterator::diriteratorFilters_data()
+{
+    QTest::addColumn<QByteArray>("dirpath");
+    QTest::addColumn<QDir::Filters>("filters");
+
+    if (directories().isEmpty())
+        QSKIP("Missing Qt directory");
+
+    // Filters that only depend on the type of the entries, and so can be
+    // answered from the directory listing itself, followed by some that
+    // need more metadata
+    const std::pair<const char *, QDir::Filters> filters[] = {
+        { "Dirs", QDir::Dirs | QDir::NoDotAndDotDot },
+        { "Files", QDir::Files },
+        { "AllEntries|NoSymLinks", QDir::AllEntries | QDir::NoSymLinks },
+        { "AllEntries|Hidden|System", QDir::AllEntries | QDir::Hidden | QDir::System },
+        { "Files|Readable", QDir::Files | QDir::Readable },
+    };
+
+    for (const auto &dir : directories()) {
+        for (const auto &filter : filters) {
+            QTest::addRow("%s:%s", dir.first.constData(), filter.first)
+                    << dir.second << filter.second;
+        }
+    }
+}
+
+void tst_QDirIterator::diriteratorFilters()
+{
+    QFETCH(QByteArray, dirpath);
+    QFETCH(QDir::Filters, filters);
+
+    int count = 0;
+
+    QBENCHMARK {
+        int c = 0;
+        QDirIterator dir(dirpath, filters, QDirIterator::Subdirectories);
+        while (dir.hasNext()) {
+            dir.next();
+            ++c;
+        }
+        count = c;
+    }
+    qDebug() << count;
+}
+
+void tst_QDirIterator::walkParallel()
+{
+#if QT_CONFIG(future)
+    QFETCH(QByteArray, dirpath);
+
+    qsizetype count = 0;
+
+    QBENCHMARK {
+        qsizetype c = 0;
+        const auto batches = QDirIterator::walkParallel(dirpath, QDir::Files).results();
+        for (const QFileInfoList &batch : batches)
+            c += batch.size();
+        count = c;
+    }
+    qDebug() << count;
+#else
+    QSKIP("Not supported.");
+#endif
+}
+
 void tst_QDirIterator::fsiterator()
 {
     QFETCH(QByteArray, dirpath);
@@ -7,6 +7,12 @@
 #include <QDirIterator>
 
 #include <private/qfsfileengine_p.h>
+#if QT_CONFIG(future)
+#include <QFuture>
+#ifdef QT_BUILD_INTERNAL
+#include <private/qfileasyncio_p.h>
+#endif
+#endif
 
 #include <qtest.h>
 
@@ -81,6 +87,11 @@ private slots:
     void readBigFile_posix() { readBigFile(); }
     void readBigFile_Win32() { readBigFile(); }
 
+#if QT_CONFIG(future)
+    void readSmallFilesAsync_data();
+    void readSmallFilesAsync();
+#endif
+
 private:
     void readFile_data(BenchmarkType type, QIODevice::OpenModeFlag t, QIODevice::OpenModeFlag b);
     void readBigFile();
@@ -588,6 +599,56 @@ void tst_qfile::readSmallFiles()
     }
 }
 
+#if QT_CONFIG(future)
+void tst_qfile::readSmallFilesAsync_data()
+{
+    QTest::addColumn<bool>("async");
+
+    QTest::newRow("read") << false;
+    QTest::newRow("readAsync") << true;
+}
+
+// Reads all small files concurrently with readAsync(), compared to
+// reading them one after the other.
+void tst_qfile::readSmallFilesAsync()
+{
+    QFETCH(bool, async);
+#ifdef QT_BUILD_INTERNAL
+    if (async)
+        qDebug() << "io_uring:" << QFileAsyncIo::usesIoUring();
+#endif
+
+    QDir dir(tempDir.path());
+    const QStringList files = dir.entryList(QDir::NoDotAndDotDot|QDir::NoSymLinks|QDir::Files);
+    QList<QFile *> fileList;
+    for (const QString &file : files) {
+        QFile *f = new QFile(tempDir.filePath(file));
+        f->open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+        fileList.append(f);
+    }
+
+    QList<QFuture<QByteArray>> futures;
+    futures.reserve(fileList.size());
+    char buffer[1024];
+    QBENCHMARK {
+        if (async) {
+            futures.clear();
+            for (QFile *const file : std::as_const(fileList))
+                futures.append(file->readAsync(0, sizeof(buffer)));
+            for (QFuture<QByteArray> &future : futures)
+                future.waitForFinished();
+        } else {
+            for (QFile *const file : std::as_const(fileList)) {
+                file->seek(0);
+                file->read(buffer, sizeof(buffer));
+            }
+        }
+    }
+
+    qDeleteAll(fileList);
+}
+#endif // QT_CONFIG(future)
+
 QTEST_MAIN(tst_qfile)
 
 #include "tst_bench_qfile.moc"
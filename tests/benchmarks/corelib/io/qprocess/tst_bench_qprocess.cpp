@@ -13,6 +13,8 @@ class tst_QProcess : public QObject
 private slots:
 
     void echoTest_performance();
+    void startProcess_data();
+    void startProcess();
 };
 
 #ifdef Q_OS_WIN
@@ -66,5 +68,46 @@ void tst_QProcess::echoTest_performance()
     QVERIFY(process.waitForFinished());
 }
 
+void tst_QProcess::startProcess_data()
+{
+    QTest::addColumn<int>("parentMemory");
+    QTest::addColumn<bool>("useModifier");
+
+    // Starting a child used to copy the page tables of the parent, so it got
+    // slower the more memory the parent had touched. With a child process
+    // modifier, QProcess still does.
+    QTest::newRow("small-parent") << 0 << false;
+    QTest::newRow("large-parent") << 512 << false;
+#ifdef Q_OS_UNIX
+    QTest::newRow("small-parent-modifier") << 0 << true;
+    QTest::newRow("large-parent-modifier") << 512 << true;
+#endif
+}
+
+void tst_QProcess::startProcess()
+{
+    QFETCH(int, parentMemory);
+    QFETCH(bool, useModifier);
+
+    // touch every page, so that they all have to be mapped in the child
+    const QByteArray ballast(qsizetype(parentMemory) * 1024 * 1024, 'x');
+
+    QProcess process;
+#ifdef Q_OS_UNIX
+    if (useModifier)
+        process.setChildProcessModifier([]() {});
+#else
+    Q_UNUSED(useModifier);
+#endif
+
+    QBENCHMARK {
+        process.start(QFINDTESTDATA("../testProcessLoopback/testProcessLoopback" EXE));
+        QVERIFY2(process.waitForStarted(), qPrintable(process.errorString()));
+        process.closeWriteChannel();
+        QVERIFY(process.waitForFinished());
+    }
+    QCOMPARE(ballast.size(), qsizetype(parentMemory) * 1024 * 1024);
+}
+
 QTEST_MAIN(tst_QProcess)
 #include "tst_bench_qprocess.moc"
@@ -13,6 +13,10 @@ class tst_QTextStream : public QObject
 private slots:
     void writeSingleChar_data();
     void writeSingleChar();
+    void readLine_data();
+    void readLine();
+    void readNumbers_data();
+    void readNumbers();
 
 private:
 };
@@ -90,6 +94,94 @@ void tst_QTextStream::writeSingleChar()
     QCOMPARE(result.left(10), QString("hhhhhhhhhh"));
 }
 
+void tst_QTextStream::readLine_data()
+{
+    QTest::addColumn<Output>("source");
+    QTest::addColumn<int>("lineLength");
+
+    QTest::newRow("string_short") << StringOutput << 16;
+    QTest::newRow("string_long") << StringOutput << 200;
+    QTest::newRow("device_short") << DeviceOutput << 16;
+    QTest::newRow("device_long") << DeviceOutput << 200;
+}
+
+void tst_QTextStream::readLine()
+{
+    QFETCH(Output, source);
+    QFETCH(int, lineLength);
+
+    const int lineCount = 1024 * 1024 / lineLength;
+    QByteArray data;
+    data.reserve(lineCount * (lineLength + 1));
+    for (int i = 0; i < lineCount; ++i)
+        data += QByteArray(lineLength, 'a' + i % 26) + '\n';
+    QString str = QString::fromLatin1(data);
+    QBuffer buffer(&data);
+
+    QBENCHMARK {
+        QTextStream stream;
+        if (source == StringOutput) {
+            stream.setString(&str, QIODevice::ReadOnly);
+        } else {
+            QVERIFY(buffer.open(QIODevice::ReadOnly));
+            stream.setDevice(&buffer);
+        }
+        QString line;
+        int lines = 0;
+        while (stream.readLineInto(&line))
+            ++lines;
+        QCOMPARE(lines, lineCount);
+        buffer.close();
+    }
+}
+
+void tst_QTextStream::readNumbers_data()
+{
+    QTest::addColumn<Output>("source");
+    QTest::addColumn<bool>("real");
+
+    QTest::newRow("string_int") << StringOutput << false;
+    QTest::newRow("string_double") << StringOutput << true;
+    QTest::newRow("device_int") << DeviceOutput << false;
+    QTest::newRow("device_double") << DeviceOutput << true;
+}
+
+void tst_QTextStream::readNumbers()
+{
+    QFETCH(Output, source);
+    QFETCH(bool, real);
+
+    const int count = 100000;
+    QByteArray data;
+    for (int i = 0; i < count; ++i) {
+        data += real ? QByteArray::number(i * 1.25 - 1000, 'g', 12) : QByteArray::number(i * 37 - 1000);
+        data += i % 8 == 7 ? '\n' : ' ';
+    }
+    QString str = QString::fromLatin1(data);
+    QBuffer buffer(&data);
+
+    QBENCHMARK {
+        QTextStream stream;
+        if (source == StringOutput) {
+            stream.setString(&str, QIODevice::ReadOnly);
+        } else {
+            QVERIFY(buffer.open(QIODevice::ReadOnly));
+            stream.setDevice(&buffer);
+        }
+        if (real) {
+            double d;
+            for (int i = 0; i < count; ++i)
+                stream >> d;
+        } else {
+            int n;
+            for (int i = 0; i < count; ++i)
+                stream >> n;
+        }
+        QCOMPARE(stream.status(), QTextStream::Ok);
+        buffer.close();
+    }
+}
+
 QTEST_MAIN(tst_QTextStream)
 
 #include "tst_bench_qtextstream.moc"
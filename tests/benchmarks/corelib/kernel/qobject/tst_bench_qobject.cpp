@@ -20,6 +20,8 @@ private slots:
     void signal_slot_benchmark_data();
     void signal_many_receivers();
     void signal_many_receivers_data();
+    void signal_many_receivers_churn();
+    void signal_many_receivers_churn_data();
     void qproperty_benchmark_data();
     void qproperty_benchmark();
     void dynamic_property_benchmark();
@@ -154,6 +156,8 @@ void tst_QObject::signal_slot_benchmark()
 void tst_QObject::signal_many_receivers_data()
 {
     QTest::addColumn<int>("receiverCount");
+    QTest::newRow("2 receivers") << 2;
+    QTest::newRow("50 receivers") << 50;
     QTest::newRow("100 receivers") << 100;
     QTest::newRow("1 000 receivers") << 1000;
     QTest::newRow("10 000 receivers") << 10000;
@@ -173,6 +177,31 @@ void tst_QObject::signal_many_receivers()
     }
 }
 
+void tst_QObject::signal_many_receivers_churn_data()
+{
+    signal_many_receivers_data();
+}
+
+void tst_QObject::signal_many_receivers_churn()
+{
+    // Every emission follows a change of the connection list
+    QFETCH(int, receiverCount);
+    Object sender;
+    Object extraReceiver;
+    std::vector<Object> receivers(receiverCount);
+
+    for (Object &receiver : receivers)
+        QObject::connect(&sender, &Object::signal0, &receiver, &Object::slot0);
+
+    QBENCHMARK {
+        auto connection = QObject::connect(&sender, &Object::signal0,
+                                           &extraReceiver, &Object::slot0);
+        sender.emitSignal0();
+        QObject::disconnect(connection);
+        sender.emitSignal0();
+    }
+}
+
 void tst_QObject::qproperty_benchmark_data()
 {
     QTest::addColumn<QByteArray>("name");
@@ -1,7 +1,9 @@
 // Copyright (C) 2020 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
+#include <QDateTimeFormatter>
 #include <QLocale>
+#include <QNumberFormatter>
 #include <QTest>
 
 using namespace Qt::StringLiterals;
@@ -37,6 +39,12 @@ private Q_SLOTS:
     void toULongLong();
     void toDouble_data();
     void toDouble();
+    void toString_longlong_data();
+    void toString_longlong();
+    void toString_double_data();
+    void toString_double();
+    void toString_dateTime_data();
+    void toString_dateTime();
 };
 
 static QString data()
@@ -597,6 +605,107 @@ void tst_QLocale::toDouble()
     QCOMPARE(actual, expected);
 }
 
+void tst_QLocale::toString_longlong_data()
+{
+    QTest::addColumn<QString>("locale");
+    QTest::addColumn<bool>("formatter");
+
+    for (const QString &locale : { u"C"_s, u"en_US"_s, u"ar_EG"_s }) {
+        QTest::addRow("%s: QLocale", qPrintable(locale)) << locale << false;
+        QTest::addRow("%s: QNumberFormatter", qPrintable(locale)) << locale << true;
+    }
+}
+
+void tst_QLocale::toString_longlong()
+{
+    QFETCH(QString, locale);
+    QFETCH(bool, formatter);
+
+    const QLocale loc(locale);
+    const QNumberFormatter numbers(loc);
+    const qlonglong value = -1234567890;
+    if (formatter) {
+        QBENCHMARK { LOOP(QString t(numbers.toString(value + i))) }
+    } else {
+        QBENCHMARK { LOOP(QString t(loc.toString(value + i))) }
+    }
+}
+
+void tst_QLocale::toString_double_data()
+{
+    QTest::addColumn<QString>("locale");
+    QTest::addColumn<char>("format");
+    QTest::addColumn<bool>("formatter");
+
+    for (const QString &locale : { u"C"_s, u"en_US"_s, u"ar_EG"_s }) {
+        for (char format : { 'f', 'e', 'g' }) {
+            QTest::addRow("%s: %c: QLocale", qPrintable(locale), format)
+                    << locale << format << false;
+            QTest::addRow("%s: %c: QNumberFormatter", qPrintable(locale), format)
+                    << locale << format << true;
+        }
+    }
+}
+
+void tst_QLocale::toString_double()
+{
+    QFETCH(QString, locale);
+    QFETCH(char, format);
+    QFETCH(bool, formatter);
+
+    const QLocale loc(locale);
+    const QNumberFormatter numbers(loc);
+    const double value = 12345.6789;
+    if (formatter) {
+        QBENCHMARK { LOOP(QString t(numbers.toString(value + i, format, 3))) }
+    } else {
+        QBENCHMARK { LOOP(QString t(loc.toString(value + i, format, 3))) }
+    }
+}
+
+void tst_QLocale::toString_dateTime_data()
+{
+    QTest::addColumn<QString>("locale");
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<int>("method"); // 0: QLocale, 1: toString(), 2: formatTo()
+
+    const QString formats[] = { u"yyyy-MM-dd HH:mm:ss.zzz"_s, u"dddd, d MMMM yyyy h:mm AP"_s };
+    for (const QString &locale : { u"C"_s, u"de_DE"_s, u"ar_EG"_s }) {
+        for (const QString &format : formats) {
+            QTest::addRow("%s: %s: QLocale", qPrintable(locale), qPrintable(format))
+                    << locale << format << 0;
+            QTest::addRow("%s: %s: QDateTimeFormatter", qPrintable(locale), qPrintable(format))
+                    << locale << format << 1;
+            QTest::addRow("%s: %s: formatTo", qPrintable(locale), qPrintable(format))
+                    << locale << format << 2;
+        }
+    }
+}
+
+void tst_QLocale::toString_dateTime()
+{
+    QFETCH(QString, locale);
+    QFETCH(QString, format);
+    QFETCH(int, method);
+
+    const QLocale loc(locale);
+    const QDateTimeFormatter formatter(format, loc);
+    const QDateTime dateTime(QDate(2022, 11, 4), QTime(14, 35, 12, 345), Qt::UTC);
+    switch (method) {
+    case 0:
+        QBENCHMARK { LOOP(QString t(loc.toString(dateTime.addSecs(i), format))) }
+        break;
+    case 1:
+        QBENCHMARK { LOOP(QString t(formatter.toString(dateTime.addSecs(i)))) }
+        break;
+    case 2: {
+        QChar buffer[64];
+        QBENCHMARK { LOOP(formatter.formatTo(buffer, 64, dateTime.addSecs(i))) }
+        break;
+    }
+    }
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "tst_bench_qlocale.moc"
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include <QRegularExpression>
+#include <QRegularExpressionSet>
 #include <QTest>
 
 /*!
@@ -45,6 +46,9 @@ private slots:
     void queryMatchResultsByGroupIndex();
     void queryMatchResultsByGroupName();
     void iterateThroughGlobalMatchResults();
+
+    void matchManyPatterns_data();
+    void matchManyPatterns();
 };
 
 void tst_QRegularExpressionBenchmark::createDefault()
@@ -270,6 +274,88 @@ void tst_QRegularExpressionBenchmark::iterateThroughGlobalMatchResults()
     }
 }
 
+// Patterns and lines in the style of log routing rules
+static QStringList routingPatterns(int count)
+{
+    QStringList patterns;
+    patterns.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        switch (i % 4) {
+        case 0:
+            patterns.append(QStringLiteral("^ERROR: service%1 failed with code (\\d+)").arg(i));
+            break;
+        case 1:
+            patterns.append(QStringLiteral("timeout after \\d+ ms in module%1").arg(i));
+            break;
+        case 2:
+            patterns.append(QStringLiteral("user (\\w+) logged (in|out) from host%1").arg(i));
+            break;
+        case 3:
+            patterns.append(QStringLiteral("\\bdisk%1\\b.*(full|degraded)").arg(i));
+            break;
+        }
+    }
+    return patterns;
+}
+
+static QStringList routingLines()
+{
+    QStringList lines;
+    for (int i = 0; i < 100; ++i) {
+        lines.append(QStringLiteral("2022-10-18 12:00:%1 INFO: request %2 served in %3 ms")
+                     .arg(i % 60).arg(i * 7919).arg(i % 17));
+    }
+    lines.append("ERROR: service40 failed with code 3");
+    lines.append("user alice logged out from host42");
+    lines.append("warning: disk43 is almost full");
+    return lines;
+}
+
+void tst_QRegularExpressionBenchmark::matchManyPatterns_data()
+{
+    QTest::addColumn<int>("patternCount");
+    QTest::addColumn<bool>("useSet");
+
+    for (int count : { 10, 100, 800 }) {
+        QTest::addRow("separate-%d", count) << count << false;
+        QTest::addRow("set-%d", count) << count << true;
+    }
+}
+
+void tst_QRegularExpressionBenchmark::matchManyPatterns()
+{
+    QFETCH(int, patternCount);
+    QFETCH(bool, useSet);
+
+    const QStringList patterns = routingPatterns(patternCount);
+    const QStringList lines = routingLines();
+
+    if (useSet) {
+        QRegularExpressionSet set(patterns);
+        set.optimize();
+        QBENCHMARK {
+            for (const QString &line : lines) {
+                auto matchResult = set.match(line);
+                Q_UNUSED(matchResult);
+            }
+        }
+    } else {
+        QList<QRegularExpression> expressions;
+        for (const QString &pattern : patterns) {
+            expressions.append(QRegularExpression(pattern));
+            expressions.constLast().optimize();
+        }
+        QBENCHMARK {
+            for (const QString &line : lines) {
+                for (const QRegularExpression &re : std::as_const(expressions)) {
+                    auto matchResult = re.match(line);
+                    Q_UNUSED(matchResult);
+                }
+            }
+        }
+    }
+}
+
 QTEST_MAIN(tst_QRegularExpressionBenchmark)
 
 #include "tst_bench_qregularexpression.moc"
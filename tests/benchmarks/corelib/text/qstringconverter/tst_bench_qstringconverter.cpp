@@ -0,0 +1,95 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QStringConverter>
+#include <QTest>
+
+using namespace Qt::StringLiterals;
+
+class tst_QStringConverter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fromUtf8_data() { textData(); }
+    void fromUtf8();
+    void decodeUtf8_data() { textData(); }
+    void decodeUtf8();
+    void toUtf8_data() { textData(); }
+    void toUtf8();
+    void isValidUtf8_data() { textData(); }
+    void isValidUtf8();
+
+private:
+    void textData();
+};
+
+void tst_QStringConverter::textData()
+{
+    QTest::addColumn<QString>("text");
+
+    // about 64k characters each
+    const auto row = [](const char *name, const QString &sample) {
+        QTest::newRow(name) << sample.repeated(65536 / sample.size());
+    };
+    row("ascii", u"The quick brown fox jumps over the lazy dog. "_s);
+    row("latin", u"Voix ambiguë d'un cœur qui, au zéphyr, préfère les jattes de kiwis. "_s);
+    row("cyrillic", u"Съешь же ещё этих мягких французских булок, да выпей чаю. "_s);
+    row("cjk", u"我能吞下玻璃而不伤身体。私はガラスを食べられます。"_s);
+    row("emoji", u"\U0001F600\U0001F4A9\U0001F680 "_s);
+    // about 70% of the characters are not US-ASCII
+    row("multilingual", u"Ёж 刺猬 hedgehog; ежи — ヤマアラシ 고슴도치 Igel. "_s);
+}
+
+void tst_QStringConverter::fromUtf8()
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+
+    QBENCHMARK {
+        QString result = QString::fromUtf8(utf8);
+        Q_UNUSED(result);
+    }
+}
+
+void tst_QStringConverter::decodeUtf8()
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+
+    // in the chunks of a stream
+    constexpr qsizetype ChunkSize = 4093;
+    QBENCHMARK {
+        QStringDecoder decoder(QStringConverter::Utf8);
+        QString result;
+        for (qsizetype i = 0; i < utf8.size(); i += ChunkSize)
+            result += decoder.decode(QByteArrayView(utf8).sliced(i, qMin(ChunkSize, utf8.size() - i)));
+        Q_UNUSED(result);
+    }
+}
+
+void tst_QStringConverter::toUtf8()
+{
+    QFETCH(QString, text);
+
+    QBENCHMARK {
+        QByteArray result = text.toUtf8();
+        Q_UNUSED(result);
+    }
+}
+
+void tst_QStringConverter::isValidUtf8()
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+
+    bool valid = false;
+    QBENCHMARK {
+        valid = QUtf8StringView(utf8).isValidUtf8();
+    }
+    QVERIFY(valid);
+}
+
+QTEST_APPLESS_MAIN(tst_QStringConverter)
+
+#include "tst_bench_qstringconverter.moc"
@@ -0,0 +1,129 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <private/qunicodetools_p.h>
+
+using namespace QUnicodeTools;
+
+class tst_QUnicodeTools : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initCharAttributes_data();
+    void initCharAttributes();
+    void updateCharAttributes_data();
+    void updateCharAttributes();
+};
+
+static const char16_t *const samples[][2] = {
+    { u"english",
+      u"The quick brown fox jumps over the lazy dog, while 42 sleepy cats watch from "
+      u"the window. \"Really?\" she asked; it was already half past nine. " },
+    { u"french",
+      u"Voilà l'été : les élèves déjà partis, la forêt où s'étend un crépuscule doré "
+      u"garde encore l'écho de leurs rêves. Ça coûte 12,50 € à peine. " },
+    { u"russian",
+      u"Съешь же ещё этих мягких французских булок, да выпей чаю. В 1812 году "
+      u"Москва горела, а Наполеон ждал ключей от города. " },
+    { u"chinese",
+      u"我能吞下玻璃而不伤身体。中文文本通常不使用空格分隔单词，因此断行需要在每个字符之间查找。"
+      u"今天是2022年11月4日。" },
+    { u"arabic",
+      u"أنا قادر على أكل الزجاج و هذا لا يؤلمني. يكتب النص العربي من اليمين إلى اليسار، "
+      u"وفيه ١٢٣ رقمًا. " },
+    { u"hindi",
+      u"मैं काँच खा सकता हूँ और मुझे उससे कोई चोट नहीं पहुंचती। हिन्दी देवनागरी लिपि में "
+      u"लिखी जाती है। " },
+    { u"mixed",
+      u"Qt 6.5 renders العربية, 中文, русский and English in one paragraph 👍🏽 — "
+      u"नमस्ते, Γειά σου κόσμε! " },
+};
+
+static QString corpus(const char16_t *sample)
+{
+    QString text;
+    const QStringView view(sample);
+    while (text.size() < 64 * 1024)
+        text += view;
+    return text;
+}
+
+static void addRows()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<int>("options");
+
+    const struct {
+        const char *name;
+        CharAttributeOptions options;
+    } kinds[] = {
+        // what QTextEngine asks for
+        { "layout", CharAttributeOptions(GraphemeBreaks) | LineBreaks | WhiteSpaces
+                    | HangulLineBreakTailoring },
+        // what QTextBoundaryFinder asks for
+        { "boundaries", CharAttributeOptions(GraphemeBreaks) | WordBreaks | SentenceBreaks
+                        | LineBreaks | WhiteSpaces },
+    };
+    for (const auto &sample : samples) {
+        const QString text = corpus(sample[1]);
+        for (const auto &kind : kinds) {
+            QTest::addRow("%s-%s", qPrintable(QStringView(sample[0]).toString()), kind.name)
+                    << text << int(kind.options.toInt());
+        }
+    }
+}
+
+void tst_QUnicodeTools::initCharAttributes_data()
+{
+    addRows();
+}
+
+void tst_QUnicodeTools::initCharAttributes()
+{
+    QFETCH(QString, text);
+    QFETCH(int, options);
+
+    ScriptItemArray scripts;
+    initScripts(text, &scripts);
+    QList<QCharAttributes> attributes(text.size() + 1);
+
+    QBENCHMARK {
+        QUnicodeTools::initCharAttributes(text, scripts.data(), scripts.size(),
+                                          attributes.data(), CharAttributeOptions(options));
+    }
+}
+
+void tst_QUnicodeTools::updateCharAttributes_data()
+{
+    addRows();
+}
+
+void tst_QUnicodeTools::updateCharAttributes()
+{
+    QFETCH(QString, text);
+    QFETCH(int, options);
+
+    // Typing a word in the middle of the paragraph
+    const qsizetype from = text.size() / 2;
+    const QString word = QStringLiteral("word ");
+    text.insert(from, word);
+
+    ScriptItemArray scripts;
+    initScripts(text, &scripts);
+    QList<QCharAttributes> attributes(text.size() + 1);
+    QUnicodeTools::initCharAttributes(text, scripts.data(), scripts.size(), attributes.data(),
+                                      CharAttributeOptions(options));
+
+    QBENCHMARK {
+        QUnicodeTools::updateCharAttributes(text, from, word.size(), scripts.data(),
+                                            scripts.size(), attributes.data(),
+                                            CharAttributeOptions(options));
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QUnicodeTools)
+
+#include "tst_bench_qunicodetools.moc"
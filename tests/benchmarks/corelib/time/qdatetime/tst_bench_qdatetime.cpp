@@ -38,6 +38,7 @@ private Q_SLOTS:
     void toString();
     void toStringTextFormat();
     void toStringIsoFormat();
+    void toStringRfcFormat();
     void addDays();
     void addDaysTz();
     void addMSecs();
@@ -58,6 +59,12 @@ private Q_SLOTS:
     void fromString();
     void fromStringText();
     void fromStringIso();
+    void fromStringRfc();
+    void msecsSinceEpochFromString_data();
+    void msecsSinceEpochFromString();
+    void msecsSinceEpochFromStrings();
+    void msecsSinceEpochToString_data();
+    void msecsSinceEpochToString();
     void fromMSecsSinceEpoch();
     void fromMSecsSinceEpochUtc();
     void fromMSecsSinceEpochTz();
@@ -293,6 +300,15 @@ void tst_QDateTime::toStringIsoFormat()
     }
 }
 
+void tst_QDateTime::toStringRfcFormat()
+{
+    const auto list = daily(JULIAN_DAY_2010, JULIAN_DAY_2011);
+    QBENCHMARK {
+        for (const QDateTime &test : list)
+            test.toString(Qt::RFC2822Date);
+    }
+}
+
 void tst_QDateTime::addDays()
 {
     const auto list = daily(JULIAN_DAY_2010, JULIAN_DAY_2020);
@@ -494,6 +510,86 @@ void tst_QDateTime::fromStringIso()
     }
 }
 
+void tst_QDateTime::fromStringRfc()
+{
+    QString input = "Fri, 01 Jan 2010 13:28:34 +0100";
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i)
+            QDateTime::fromString(input, Qt::RFC2822Date);
+    }
+}
+
+void tst_QDateTime::msecsSinceEpochFromString_data()
+{
+    QTest::addColumn<QByteArray>("input");
+    QTest::addColumn<Qt::DateFormat>("format");
+
+    QTest::newRow("iso-utc") << QByteArray("2010-01-01T13:28:34.999Z") << Qt::ISODate;
+    QTest::newRow("iso-offset") << QByteArray("2010-01-01T13:28:34+01:00") << Qt::ISODate;
+    QTest::newRow("rfc3339-micro") << QByteArray("2010-01-01 13:28:34.999999Z") << Qt::ISODate;
+    QTest::newRow("rfc2822") << QByteArray("Fri, 01 Jan 2010 13:28:34 +0100") << Qt::RFC2822Date;
+}
+
+void tst_QDateTime::msecsSinceEpochFromString()
+{
+    QFETCH(QByteArray, input);
+    QFETCH(Qt::DateFormat, format);
+    const QLatin1StringView string(input);
+    bool ok = false;
+    QDateTime::msecsSinceEpochFromString(string, format, &ok);
+    QVERIFY(ok);
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i)
+            QDateTime::msecsSinceEpochFromString(string, format);
+    }
+}
+
+void tst_QDateTime::msecsSinceEpochFromStrings()
+{
+    // A day's log timestamps, one every 10 seconds
+    const qint64 start = (JULIAN_DAY_2010 - JULIAN_DAY_1970) * MSECS_PER_DAY;
+    QList<QByteArray> log;
+    for (qint64 msecs = start; msecs < start + MSECS_PER_DAY; msecs += 10007) {
+        char buffer[32];
+        const qsizetype length = QDateTime::msecsSinceEpochToString(msecs, buffer, sizeof(buffer));
+        log.append(QByteArray(buffer, length));
+    }
+    QList<QLatin1StringView> strings;
+    for (const QByteArray &line : std::as_const(log))
+        strings.append(QLatin1StringView(line));
+    QList<qint64> results(strings.size());
+    QCOMPARE(QDateTime::msecsSinceEpochFromStrings(strings.constData(), results.data(),
+                                                   strings.size()),
+             strings.size());
+    QBENCHMARK {
+        QDateTime::msecsSinceEpochFromStrings(strings.constData(), results.data(), strings.size());
+    }
+}
+
+void tst_QDateTime::msecsSinceEpochToString_data()
+{
+    QTest::addColumn<Qt::DateFormat>("format");
+    QTest::addColumn<int>("offset");
+
+    QTest::newRow("iso-utc") << Qt::ISODateWithMs << 0;
+    QTest::newRow("iso-offset") << Qt::ISODate << 3600;
+    QTest::newRow("rfc2822") << Qt::RFC2822Date << 3600;
+}
+
+void tst_QDateTime::msecsSinceEpochToString()
+{
+    QFETCH(Qt::DateFormat, format);
+    QFETCH(int, offset);
+    const qint64 start = (JULIAN_DAY_2010 - JULIAN_DAY_1970) * MSECS_PER_DAY;
+    char buffer[32];
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i) {
+            QDateTime::msecsSinceEpochToString(start + i * 86400013LL, buffer, sizeof(buffer),
+                                               format, offset);
+        }
+    }
+}
+
 void tst_QDateTime::fromMSecsSinceEpoch()
 {
     const int start = JULIAN_DAY_2010 - JULIAN_DAY_1970;
@@ -24,6 +24,11 @@ private Q_SLOTS:
     void transitionsForward();
     void transitionsReverse_data() { transitionList_data(); }
     void transitionsReverse();
+    void offsetFromUtc_data() { transitionList_data(); }
+    void offsetFromUtc();
+    void toTimeZone_data() { transitionList_data(); }
+    void toTimeZone();
+    void allZones();
 };
 
 static QList<QByteArray> enoughZones()
@@ -143,6 +148,49 @@ void tst_QTimeZone::transitionsReverse()
     }
 }
 
+// Every 37 days from 1900 to 2150, so as to cover a few transitions a year
+static QList<QDateTime> manyTimes()
+{
+    QList<QDateTime> result;
+    const QDateTime end = QDate(2150, 1, 1).startOfDay(Qt::UTC);
+    for (QDateTime when = QDate(1900, 1, 1).startOfDay(Qt::UTC); when < end; when = when.addDays(37))
+        result << when;
+    return result;
+}
+
+void tst_QTimeZone::offsetFromUtc()
+{
+    QFETCH(QByteArray, name);
+    const QTimeZone zone = name.isEmpty() ? QTimeZone::systemTimeZone() : QTimeZone(name);
+    const QList<QDateTime> times = manyTimes();
+    QBENCHMARK {
+        for (const QDateTime &when : times)
+            zone.offsetFromUtc(when);
+    }
+}
+
+void tst_QTimeZone::toTimeZone()
+{
+    QFETCH(QByteArray, name);
+    const QTimeZone zone = name.isEmpty() ? QTimeZone::systemTimeZone() : QTimeZone(name);
+    const QList<QDateTime> times = manyTimes();
+    QBENCHMARK {
+        for (const QDateTime &when : times)
+            when.toTimeZone(zone).offsetFromUtc();
+    }
+}
+
+void tst_QTimeZone::allZones()
+{
+    // A program converting times to many zones, creating them as it needs them
+    const QList<QByteArray> available = QTimeZone::availableTimeZoneIds();
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    QBENCHMARK {
+        for (const QByteArray &id : available)
+            now.toTimeZone(QTimeZone(id)).offsetFromUtc();
+    }
+}
+
 QTEST_MAIN(tst_QTimeZone)
 
 #include "tst_bench_qtimezone.moc"
@@ -6,6 +6,7 @@
 #include <QFile>
 #include <QRandomGenerator>
 #include <QString>
+#include <QTemporaryFile>
 #include <QTest>
 
 #include <time.h>
@@ -25,9 +26,16 @@ private Q_SLOTS:
     void addData();
     void addDataChunked_data() { hash_data(); }
     void addDataChunked();
+    void hashLarge_data();
+    void hashLarge();
+    void hashDevice_data() { hashLarge_data(); }
+    void hashDevice();
+    void hashMany_data();
+    void hashMany();
 };
 
-const int MaxCryptoAlgorithm = QCryptographicHash::Sha3_512;
+const int MaxCryptoAlgorithm = QCryptographicHash::Blake3_256;
+const qsizetype LargeDataSize = 64 * 1024 * 1024;
 const int MaxBlockSize = 65536;
 
 const char *algoname(int i)
@@ -79,6 +87,8 @@ const char *algoname(int i)
         return "blake2s_224-";
     case QCryptographicHash::Blake2s_256:
         return "blake2s_256-";
+    case QCryptographicHash::Blake3_256:
+        return "blake3_256-";
     }
     Q_UNREACHABLE_RETURN(nullptr);
 }
@@ -157,6 +167,98 @@ void tst_QCryptographicHash::addDataChunked()
     }
 }
 
+void tst_QCryptographicHash::hashLarge_data()
+{
+    QTest::addColumn<int>("algorithm");
+
+    // the ones with hardware support or a parallel implementation
+    for (auto algo : { QCryptographicHash::Md5, QCryptographicHash::Sha1,
+                       QCryptographicHash::Sha256, QCryptographicHash::Sha512,
+                       QCryptographicHash::Blake2b_256, QCryptographicHash::Blake3_256 }) {
+        QTest::newRow(QByteArray(algoname(algo)).chopped(1)) << int(algo);
+    }
+}
+
+void tst_QCryptographicHash::hashLarge()
+{
+    QFETCH(int, algorithm);
+
+    QByteArray data(LargeDataSize, Qt::Uninitialized);
+    for (qsizetype i = 0; i < data.size(); i += blockOfData.size())
+        memcpy(data.data() + i, blockOfData.constData(), blockOfData.size());
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QBENCHMARK {
+        QCryptographicHash::hash(data, algo);
+    }
+}
+
+void tst_QCryptographicHash::hashDevice()
+{
+    QFETCH(int, algorithm);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    for (qsizetype i = 0; i < LargeDataSize; i += blockOfData.size())
+        QCOMPARE(file.write(blockOfData), qint64(blockOfData.size()));
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QBENCHMARK {
+        QVERIFY(file.seek(0));
+        QVERIFY(!QCryptographicHash::hashDevice(&file, algo).isNull());
+    }
+}
+
+void tst_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<int>("algorithm");
+    QTest::addColumn<qsizetype>("count");
+    QTest::addColumn<qsizetype>("size");
+    QTest::addColumn<bool>("batched");
+
+    // the ones with an implementation that hashes several messages at once
+    for (auto algo : { QCryptographicHash::Sha256, QCryptographicHash::Sha3_256 }) {
+        const QByteArray name = QByteArray(algoname(algo)).chopped(1);
+        for (auto [count, size] : { std::pair<qsizetype, qsizetype>{ 1024 * 1024, 4096 },
+                                    { 1024 * 1024, 64 }, { 256, 1024 } }) {
+            for (bool batched : { false, true }) {
+                QTest::addRow("%s-%lldx%lld-%s", name.constData(), qlonglong(count), qlonglong(size),
+                              batched ? "hashMany" : "hash")
+                        << int(algo) << count << size << batched;
+            }
+        }
+    }
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(int, algorithm);
+    QFETCH(qsizetype, count);
+    QFETCH(qsizetype, size);
+    QFETCH(bool, batched);
+
+    // the messages overlap, so that a million of them fit in 64 MiB
+    QByteArray data(LargeDataSize, Qt::Uninitialized);
+    for (qsizetype i = 0; i < data.size(); i += blockOfData.size())
+        memcpy(data.data() + i, blockOfData.constData(), blockOfData.size());
+    QList<QByteArrayView> messages;
+    messages.reserve(count);
+    for (qsizetype i = 0; i < count; ++i)
+        messages.append(QByteArrayView(data).sliced(i * 61 % (data.size() - size), size));
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    if (batched) {
+        QBENCHMARK {
+            QCryptographicHash::hashMany(messages, algo);
+        }
+    } else {
+        QBENCHMARK {
+            for (QByteArrayView message : std::as_const(messages))
+                QCryptographicHash::hash(message, algo);
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QCryptographicHash)
 
 #include "tst_bench_qcryptographichash.moc"
@@ -0,0 +1,105 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QtTest/qtesteventloop.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtNetwork/qhostaddress.h>
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/qtcpsocket.h>
+
+#include <tuple>
+#include <utility>
+
+class tst_QTcpSocket : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void forwarding_data();
+    void forwarding();
+};
+
+// Connects a new client socket to server and returns both ends
+static std::pair<QTcpSocket *, QTcpSocket *> connectedPair(QTcpServer *server, QObject *parent)
+{
+    auto client = new QTcpSocket(parent);
+    client->connectToHost(QHostAddress::LocalHost, server->serverPort());
+    if (!client->waitForConnected(5000) || !server->waitForNewConnection(5000))
+        return {};
+    QTcpSocket *accepted = server->nextPendingConnection();
+    accepted->setParent(parent);
+    return { client, accepted };
+}
+
+void tst_QTcpSocket::forwarding_data()
+{
+    QTest::addColumn<bool>("zeroCopy");
+    QTest::addColumn<int>("chunkSize");
+
+    for (int chunkSize : {4096, 65536, 1048576}) {
+        QTest::addRow("copying, chunk size: %d", chunkSize) << false << chunkSize;
+        QTest::addRow("zero-copy, chunk size: %d", chunkSize) << true << chunkSize;
+    }
+}
+
+// Forwards data from a producer to a sink through a proxy, which reads from
+// one socket and writes to another one, and reports the throughput.
+void tst_QTcpSocket::forwarding()
+{
+    QFETCH(bool, zeroCopy);
+    QFETCH(int, chunkSize);
+
+    const qint64 timeToTest = 2000;
+    QObject sockets;
+    QTcpServer server;
+    QVERIFY2(server.listen(QHostAddress::LocalHost), qPrintable(server.errorString()));
+
+    QTcpSocket *producer, *proxyIn, *proxyOut, *sink;
+    std::tie(producer, proxyIn) = connectedPair(&server, &sockets);
+    QVERIFY(producer);
+    std::tie(proxyOut, sink) = connectedPair(&server, &sockets);
+    QVERIFY(proxyOut);
+
+    const QByteArray chunk(chunkSize, 'a');
+    auto produce = [&]() {
+        while (producer->bytesToWrite() < 4 * chunkSize)
+            producer->write(chunk);
+    };
+    connect(producer, &QTcpSocket::bytesWritten, produce);
+
+    connect(proxyIn, &QTcpSocket::readyRead, [&]() {
+        if (!zeroCopy) {
+            proxyOut->write(proxyIn->readAll());
+            return;
+        }
+        for (;;) {
+            const QList<QByteArrayView> chunks = proxyIn->readableChunks();
+            if (chunks.isEmpty())
+                break;
+            proxyOut->write(proxyIn->read(chunks.first().size()));
+        }
+    });
+
+    QTestEventLoop eventLoop;
+    QElapsedTimer timer;
+    qint64 totalReceived = 0;
+    connect(sink, &QTcpSocket::readyRead, [&]() {
+        totalReceived += sink->skip(sink->bytesAvailable());
+        if (timer.elapsed() >= timeToTest)
+            eventLoop.exitLoop();
+    });
+
+    timer.start();
+    produce();
+    eventLoop.enterLoopMSecs(timeToTest * 2);
+
+    QVERIFY(totalReceived > 0);
+    qDebug("Transfer rate: %.1f MB/s", totalReceived / 1048.576 / timer.elapsed());
+}
+
+QTEST_MAIN(tst_QTcpSocket)
+
+#include "tst_bench_qtcpsocket.moc"